@@ -94,9 +94,11 @@ void RealChip::onTimer() {
 }
 
 EmulatedChip::EmulatedChip() :
+	_deferWrites(false),
 	_nextTick(0),
 	_samplesPerTick(0),
 	_baseFreq(0),
+	_writePos(-1),
 	_handle(new Audio::SoundHandle()) { }
 
 EmulatedChip::~EmulatedChip() {
@@ -110,6 +112,9 @@ EmulatedChip::~EmulatedChip() {
 }
 
 int EmulatedChip::readBuffer(int16 *buffer, const int numSamples) {
+	if (_deferWrites)
+		return readBufferDeferred(buffer, numSamples);
+
 	const int stereoFactor = isStereo() ? 2 : 1;
 	int len = numSamples / stereoFactor;
 	int step;
@@ -136,6 +141,67 @@ int EmulatedChip::readBuffer(int16 *buffer, const int numSamples) {
 	return numSamples;
 }
 
+int EmulatedChip::readBufferDeferred(int16 *buffer, const int numSamples) {
+	const int stereoFactor = isStereo() ? 2 : 1;
+	const int len = numSamples / stereoFactor;
+
+	// Run the timer callbacks for the whole buffer first, queuing the
+	// register writes they make at the same samples as readBuffer() would
+	int pos = 0;
+	do {
+		const int step = MIN(len - pos, _nextTick >> FIXP_SHIFT);
+
+		_nextTick -= step << FIXP_SHIFT;
+		pos += step;
+		if (!(_nextTick >> FIXP_SHIFT)) {
+			{
+				Common::StackLock lock(_writeMutex);
+				_writePos = pos;
+			}
+
+			if (_callback && _callback->isValid())
+				(*_callback)();
+
+			_nextTick += _samplesPerTick;
+		}
+	} while (pos < len);
+
+	{
+		Common::StackLock lock(_writeMutex);
+		_writePos = -1;
+	}
+
+	// Then generate the samples in as few runs as possible
+	int done = 0;
+	for (const DeferredWrite &write : _writes) {
+		if (write.pos > done) {
+			generateSamples(buffer + done * stereoFactor, (write.pos - done) * stereoFactor);
+			done = write.pos;
+		}
+		applyWrite(write.reg, write.val);
+	}
+	if (done < len)
+		generateSamples(buffer + done * stereoFactor, (len - done) * stereoFactor);
+
+	// Keep the storage for the next buffer
+	_writes.resize(0);
+
+	return numSamples;
+}
+
+bool EmulatedChip::deferWrite(int reg, int val) {
+	Common::StackLock lock(_writeMutex);
+	if (_writePos < 0)
+		return false;
+
+	DeferredWrite write;
+	write.pos = _writePos;
+	write.reg = reg;
+	write.val = val;
+	_writes.push_back(write);
+	return true;
+}
+
 int EmulatedChip::getRate() const {
 	return g_system->getMixer()->getOutputRate();
 }
@@ -22,7 +22,9 @@
 #ifndef AUDIO_CHIP_H
 #define AUDIO_CHIP_H
 
+#include "common/array.h"
 #include "common/func.h"
+#include "common/mutex.h"
 #include "common/ptr.h"
 
 #include "audio/audiostream.h"
@@ -142,12 +144,45 @@ protected:
 	 */
 	virtual void generateSamples(int16 *buffer, int numSamples) = 0;
 
+	/**
+	 * Chips which set this generate the samples for a whole readBuffer() call
+	 * in one go. The timer callbacks are run first, and the register writes
+	 * they make are queued through deferWrite() at the sample they are due.
+	 */
+	bool _deferWrites;
+
+	/**
+	 * Queue a register write made from the timer callback, to be made by
+	 * applyWrite() once the samples before it have been generated.
+	 *
+	 * @return False if the write isn't made from the timer callback while
+	 *         deferring writes, and should be made right away.
+	 */
+	bool deferWrite(int reg, int val);
+
+	/**
+	 * Make a register write queued by deferWrite().
+	 */
+	virtual void applyWrite(int reg, int val) {}
+
 private:
+	struct DeferredWrite {
+		int pos;
+		int reg;
+		int val;
+	};
+
+	int readBufferDeferred(int16 *buffer, const int numSamples);
+
 	int _baseFreq;
 
 	int _nextTick;
 	int _samplesPerTick;
 
+	Common::Array<DeferredWrite> _writes;
+	Common::Mutex _writeMutex;
+	int _writePos;	///< Sample the timer callback being run is due at, or -1
+
 	Audio::SoundHandle *_handle;
 };
 
@@ -70,20 +70,31 @@ bool ADPCMStream::rewind() {
 
 
 int Oki_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
-	int samples;
-	byte data;
+	int samples = 0;
 
-	for (samples = 0; samples < numSamples && !endOfData(); samples++) {
-		if (_decodedSampleCount == 0) {
-			data = _stream->readByte();
-			_decodedSamples[0] = decodeOKI((data >> 4) & 0x0f);
-			_decodedSamples[1] = decodeOKI((data >> 0) & 0x0f);
-			_decodedSampleCount = 2;
-		}
+	// The second sample of a byte may be left over from the previous call
+	if (_decodedSampleCount && numSamples) {
+		buffer[samples++] = _decodedSamples[1];
+		_decodedSampleCount = 0;
+	}
 
-		// (1 - (count - 1)) ensures that _decodedSamples acts as a FIFO of depth 2
-		buffer[samples] = _decodedSamples[1 - (_decodedSampleCount - 1)];
-		_decodedSampleCount--;
+	// Decode whole bytes straight into the buffer
+	byte data[256];
+	while (numSamples - samples >= 2 && !_stream->eos() && _stream->pos() < _endpos) {
+		const uint32 size = MIN<int64>(MIN<int64>((numSamples - samples) / 2, _endpos - _stream->pos()), sizeof(data));
+		const uint32 read = _stream->read(data, size);
+		decodeBytes(data, read, buffer + samples);
+		samples += read * 2;
+		if (read < size)
+			break;
+	}
+
+	// Keep the second sample of the last byte for the next call
+	if (samples < numSamples && !endOfData()) {
+		data[0] = _stream->readByte();
+		decodeBytes(data, 1, _decodedSamples);
+		buffer[samples++] = _decodedSamples[0];
+		_decodedSampleCount = 1;
 	}
 
 	return samples;
@@ -99,24 +110,40 @@ static const int16 okiStepSize[49] = {
 	 1552
 };
 
-// Decode Linear to ADPCM
-int16 Oki_ADPCMStream::decodeOKI(byte code) {
+static FORCEINLINE int16 decodeOKISample(byte code, int32 &last, int32 &stepIndex) {
 	int16 diff, E, samp;
 
-	E = (2 * (code & 0x7) + 1) * okiStepSize[_status.ima_ch[0].stepIndex] / 8;
+	E = (2 * (code & 0x7) + 1) * okiStepSize[stepIndex] / 8;
 	diff = (code & 0x08) ? -E : E;
-	samp = _status.ima_ch[0].last + diff;
+	samp = last + diff;
 	// Clip the values to +/- 2^11 (supposed to be 12 bits)
 	samp = CLIP<int16>(samp, -2048, 2047);
 
-	_status.ima_ch[0].last = samp;
-	_status.ima_ch[0].stepIndex += _stepAdjustTable[code];
-	_status.ima_ch[0].stepIndex = CLIP<int32>(_status.ima_ch[0].stepIndex, 0, ARRAYSIZE(okiStepSize) - 1);
+	last = samp;
+	stepIndex = CLIP<int32>(stepIndex + ADPCMStream::_stepAdjustTable[code], 0, ARRAYSIZE(okiStepSize) - 1);
 
 	// * 16 effectively converts 12-bit input to 16-bit output
 	return samp * 16;
 }
 
+// Decode Linear to ADPCM
+int16 Oki_ADPCMStream::decodeOKI(byte code) {
+	return decodeOKISample(code, _status.ima_ch[0].last, _status.ima_ch[0].stepIndex);
+}
+
+void Oki_ADPCMStream::decodeBytes(const byte *data, uint32 size, int16 *buffer) {
+	int32 last = _status.ima_ch[0].last;
+	int32 stepIndex = _status.ima_ch[0].stepIndex;
+
+	for (uint32 i = 0; i < size; i++) {
+		*buffer++ = decodeOKISample(data[i] >> 4, last, stepIndex);
+		*buffer++ = decodeOKISample(data[i] & 0x0f, last, stepIndex);
+	}
+
+	_status.ima_ch[0].last = last;
+	_status.ima_ch[0].stepIndex = stepIndex;
+}
+
 
 #pragma mark -
 
@@ -222,28 +249,110 @@ void XA_ADPCMStream::decodeXA(const byte *src) {
 
 
 int DVI_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
-	int samples;
-	byte data;
+	int samples = 0;
 
-	for (samples = 0; samples < numSamples && !endOfData(); samples++) {
-		if (_decodedSampleCount == 0) {
-			data = _stream->readByte();
-			_decodedSamples[0] = decodeIMA((data >> 4) & 0x0f, 0);
-			_decodedSamples[1] = decodeIMA((data >> 0) & 0x0f, _channels == 2 ? 1 : 0);
-			_decodedSampleCount = 2;
-		}
+	// The second sample of a byte may be left over from the previous call
+	if (_decodedSampleCount && numSamples) {
+		buffer[samples++] = _decodedSamples[1];
+		_decodedSampleCount = 0;
+	}
 
-		// (1 - (count - 1)) ensures that _decodedSamples acts as a FIFO of depth 2
-		buffer[samples] = _decodedSamples[1 - (_decodedSampleCount - 1)];
-		_decodedSampleCount--;
+	// Decode whole bytes straight into the buffer
+	byte data[256];
+	while (numSamples - samples >= 2 && !_stream->eos() && _stream->pos() < _endpos) {
+		const uint32 size = MIN<int64>(MIN<int64>((numSamples - samples) / 2, _endpos - _stream->pos()), sizeof(data));
+		const uint32 read = _stream->read(data, size);
+		decodeBytes(data, read, buffer + samples);
+		samples += read * 2;
+		if (read < size)
+			break;
+	}
+
+	// Keep the second sample of the last byte for the next call
+	if (samples < numSamples && !endOfData()) {
+		data[0] = _stream->readByte();
+		decodeBytes(data, 1, _decodedSamples);
+		buffer[samples++] = _decodedSamples[0];
+		_decodedSampleCount = 1;
 	}
 
 	return samples;
 }
 
+void DVI_ADPCMStream::decodeBytes(const byte *data, uint32 size, int16 *buffer) {
+	int32 last0 = _status.ima_ch[0].last;
+	int32 stepIndex0 = _status.ima_ch[0].stepIndex;
+
+	if (_channels == 2) {
+		// The high nibble is the left channel, the low nibble the right one
+		int32 last1 = _status.ima_ch[1].last;
+		int32 stepIndex1 = _status.ima_ch[1].stepIndex;
+
+		for (uint32 i = 0; i < size; i++) {
+			*buffer++ = decodeIMASample(data[i] >> 4, last0, stepIndex0);
+			*buffer++ = decodeIMASample(data[i] & 0x0f, last1, stepIndex1);
+		}
+
+		_status.ima_ch[1].last = last1;
+		_status.ima_ch[1].stepIndex = stepIndex1;
+	} else {
+		for (uint32 i = 0; i < size; i++) {
+			*buffer++ = decodeIMASample(data[i] >> 4, last0, stepIndex0);
+			*buffer++ = decodeIMASample(data[i] & 0x0f, last0, stepIndex0);
+		}
+	}
+
+	_status.ima_ch[0].last = last0;
+	_status.ima_ch[0].stepIndex = stepIndex0;
+}
+
 #pragma mark -
 
 
+void Apple_ADPCMStream::decodeBlock(int channel) {
+	_stream->seek(_streamPos[channel]);
+
+	// A block has a 2 byte header, which is read even from a truncated block,
+	// followed by two samples per byte
+	const uint32 size = MAX<int32>(MIN<int32>(_blockAlign, _endpos - _streamPos[channel]), 2);
+	_blockData.resize(size);
+	const uint32 read = _stream->read(_blockData.data(), size);
+	if (read < size)
+		memset(_blockData.data() + read, 0, size - read);
+
+	const byte *data = _blockData.data();
+	const uint16 header = READ_BE_UINT16(data);
+
+	// First 9 bits are the upper bits of the predictor, the lower 7 bits are the step index
+	int32 last = (int16)(header & 0xFF80);
+	int32 stepIndex = CLIP<int32>(header & 0x007F, 0, 88);
+
+	_blockSamples[channel].resize((size - 2) * 2);
+	int16 *buffer = _blockSamples[channel].data();
+	for (uint32 i = 2; i < size; i++) {
+		*buffer++ = decodeIMASample(data[i] & 0x0F, last, stepIndex);
+		*buffer++ = decodeIMASample(data[i] >> 4, last, stepIndex);
+	}
+	_blockSamplePos[channel] = 0;
+
+	_status.ima_ch[channel].last = last;
+	_status.ima_ch[channel].stepIndex = stepIndex;
+
+	// Since the channels are interleaved, skip the next block
+	_streamPos[channel] += size;
+	if (_channels == 2 && size == _blockAlign)
+		_streamPos[channel] += MIN<int32>(_blockAlign, _endpos - _streamPos[channel]);
+}
+
+bool Apple_ADPCMStream::endOfData() const {
+	for (int i = 0; i < _channels; i++) {
+		if (_streamPos[i] < _endpos || _blockSamplePos[i] < _blockSamples[i].size())
+			return false;
+	}
+
+	return true;
+}
+
 int Apple_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
 	// Need to write at least one samples per channel
 	assert((numSamples % _channels) == 0);
@@ -255,99 +364,88 @@ int Apple_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
 	int chanSamples = numSamples / _channels;
 
 	for (int i = 0; i < _channels; i++) {
-		_stream->seek(_streamPos[i]);
+		while (samples[i] < chanSamples) {
+			if (_blockSamplePos[i] == _blockSamples[i].size()) {
+				if (_streamPos[i] >= _endpos)
+					break;
+				decodeBlock(i);
+			}
 
-		while ((samples[i] < chanSamples) &&
-		       // Last byte read and a new one needed
-		       !((_stream->eos() || (_stream->pos() >= _endpos)) && (_chunkPos[i] == 0))) {
+			// The original is interleaved block-wise, we want it sample-wise
+			const uint32 count = MIN<uint32>(chanSamples - samples[i], _blockSamples[i].size() - _blockSamplePos[i]);
+			const int16 *src = _blockSamples[i].data() + _blockSamplePos[i];
+			int16 *dst = buffer + _channels * samples[i] + i;
+			for (uint32 j = 0; j < count; j++, dst += _channels)
+				*dst = src[j];
+
+			_blockSamplePos[i] += count;
+			samples[i] += count;
+		}
+	}
 
-			if (_blockPos[i] == _blockAlign) {
-				// 2 byte header per block
-				uint16 temp = _stream->readUint16BE();
+	return samples[0] + samples[1];
+}
 
-				// First 9 bits are the upper bits of the predictor
-				_status.ima_ch[i].last      = (int16) (temp & 0xFF80);
-				// Lower 7 bits are the step index
-				_status.ima_ch[i].stepIndex =          temp & 0x007F;
 
-				// Clip the step index
-				_status.ima_ch[i].stepIndex = CLIP<int32>(_status.ima_ch[i].stepIndex, 0, 88);
+#pragma mark -
 
-				_blockPos[i] = 2;
-			}
 
-			if (_chunkPos[i] == 0) {
-				// Decode data
-				byte data = _stream->readByte();
-				_buffer[i][0] = decodeIMA(data &  0x0F, i);
-				_buffer[i][1] = decodeIMA(data >>    4, i);
-			}
+void MSIma_ADPCMStream::decodeBlock() {
+	// The block header holds the predictor and step index of each channel. It
+	// is followed by groups of four bytes per channel, which are decoded as a
+	// whole even at the end of a truncated block.
+	const uint32 headerSize = _channels * 4;
+	const uint32 groupSize = _channels * 4;
+	const uint32 available = MIN<int32>(_blockAlign, _endpos - _stream->pos());
+	const uint32 groups = available > headerSize ? (available - headerSize + groupSize - 1) / groupSize : 1;
+	const uint32 size = headerSize + groups * groupSize;
 
-			// The original is interleaved block-wise, we want it sample-wise
-			buffer[_channels * samples[i] + i] = _buffer[i][_chunkPos[i]];
+	_blockData.resize(size);
+	const uint32 read = _stream->read(_blockData.data(), size);
+	if (read < size)
+		memset(_blockData.data() + read, 0, size - read);
 
-			if (++_chunkPos[i] > 1) {
-				// We're about to decode the next byte, so advance the block position
-				_chunkPos[i] = 0;
-				_blockPos[i]++;
+	_blockSamples.resize(groups * 8 * _channels);
+	for (int i = 0; i < _channels; i++) {
+		const byte *data = _blockData.data() + i * 4;
+		int32 last = (int16)READ_LE_UINT16(data);
+		int32 stepIndex = (int16)READ_LE_UINT16(data + 2);
+
+		data = _blockData.data() + headerSize + i * 4;
+		int16 *buffer = _blockSamples.data() + i;
+		for (uint32 j = 0; j < groups; j++, data += groupSize) {
+			for (int k = 0; k < 4; k++) {
+				*buffer = decodeIMASample(data[k] & 0x0f, last, stepIndex);
+				buffer += _channels;
+				*buffer = decodeIMASample(data[k] >> 4, last, stepIndex);
+				buffer += _channels;
 			}
-
-			samples[i]++;
-
-			if (_channels == 2)
-				if (_blockPos[i] == _blockAlign)
-					// We're at the end of the block.
-					// Since the channels are interleaved, skip the next block
-					_stream->skip(MIN<uint32>(_blockAlign, _endpos - _stream->pos()));
-
-			_streamPos[i] = _stream->pos();
 		}
+
+		_status.ima_ch[i].last = last;
+		_status.ima_ch[i].stepIndex = stepIndex;
 	}
 
-	return samples[0] + samples[1];
+	_blockSamplePos = 0;
 }
 
-
-#pragma mark -
-
-
 int MSIma_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
 	// Need to write at least one sample per channel
 	assert((numSamples % _channels) == 0);
 
 	int samples = 0;
 
-	while (samples < numSamples && !_stream->eos() && _stream->pos() < _endpos) {
-		if (_blockPos[0] == _blockAlign) {
-			for (int i = 0; i < _channels; i++) {
-				// read block header
-				_status.ima_ch[i].last = _stream->readSint16LE();
-				_status.ima_ch[i].stepIndex = _stream->readSint16LE();
-			}
-
-			_blockPos[0] = _channels * 4;
-		}
-
-		// Decode a set of samples
-		for (int i = 0; i < _channels; i++) {
-			// The stream encodes four bytes per channel at a time
-			for (int j = 0; j < 4; j++) {
-				byte data = _stream->readByte();
-				_blockPos[0]++;
-				_buffer[i][j * 2] = decodeIMA(data & 0x0f, i);
-				_buffer[i][j * 2 + 1] = decodeIMA((data >> 4) & 0x0f, i);
-				_samplesLeft[i] += 2;
-			}
+	while (samples < numSamples) {
+		if (_blockSamplePos == _blockSamples.size()) {
+			if (_stream->eos() || _stream->pos() >= _endpos)
+				break;
+			decodeBlock();
 		}
 
-		while (samples < numSamples && _samplesLeft[0] != 0) {
-			for (int i = 0; i < _channels; i++) {
-				buffer[samples + i] = _buffer[i][8 - _samplesLeft[i]];
-				_samplesLeft[i]--;
-			}
-
-			samples += _channels;
-		}
+		const uint32 count = MIN<uint32>(numSamples - samples, _blockSamples.size() - _blockSamplePos);
+		memcpy(buffer + samples, _blockSamples.data() + _blockSamplePos, count * sizeof(int16));
+		_blockSamplePos += count;
+		samples += count;
 	}
 
 	return samples;
@@ -388,46 +486,73 @@ int16 MS_ADPCMStream::decodeMS(ADPCMChannelStatus *c, byte code) {
 	return (int16)predictor;
 }
 
-int MS_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
-	int samples;
-	byte data;
+void MS_ADPCMStream::decodeBlock() {
+	// The block header, which is read even from a truncated block, is
+	// followed by two samples per byte
+	const uint32 headerSize = _channels * 7;
+	const uint32 size = MAX<int32>(MIN<int32>(_blockAlign, _endpos - _stream->pos()), headerSize);
+
+	_blockData.resize(size);
+	const uint32 read = _stream->read(_blockData.data(), size);
+	if (read < size)
+		memset(_blockData.data() + read, 0, size - read);
+
+	ADPCMChannelStatus status[2];
+	const byte *data = _blockData.data();
 	int i;
 
-	for (samples = 0; samples < numSamples && !endOfData(); samples++) {
-		if (_decodedSampleCount == 0) {
-			if (_blockPos[0] == _blockAlign) {
-				// read block header
-				for (i = 0; i < _channels; i++) {
-					_status.ch[i].predictor = CLIP(_stream->readByte(), (byte)0, (byte)6);
-					_status.ch[i].coeff1 = MSADPCMAdaptCoeff1[_status.ch[i].predictor];
-					_status.ch[i].coeff2 = MSADPCMAdaptCoeff2[_status.ch[i].predictor];
-				}
+	for (i = 0; i < _channels; i++) {
+		status[i].predictor = CLIP(*data++, (byte)0, (byte)6);
+		status[i].coeff1 = MSADPCMAdaptCoeff1[status[i].predictor];
+		status[i].coeff2 = MSADPCMAdaptCoeff2[status[i].predictor];
+	}
 
-				for (i = 0; i < _channels; i++)
-					_status.ch[i].delta = _stream->readSint16LE();
+	for (i = 0; i < _channels; i++, data += 2)
+		status[i].delta = READ_LE_INT16(data);
 
-				for (i = 0; i < _channels; i++)
-					_status.ch[i].sample1 = _stream->readSint16LE();
+	for (i = 0; i < _channels; i++, data += 2)
+		status[i].sample1 = READ_LE_INT16(data);
 
-				for (i = 0; i < _channels; i++)
-					_decodedSamples[_decodedSampleCount++] = _status.ch[i].sample2 = _stream->readSint16LE();
+	for (i = 0; i < _channels; i++, data += 2)
+		status[i].sample2 = READ_LE_INT16(data);
 
-				for (i = 0; i < _channels; i++)
-					_decodedSamples[_decodedSampleCount++] = _status.ch[i].sample1;
+	_blockSamples.resize(_channels * 2 + (size - headerSize) * 2);
+	int16 *buffer = _blockSamples.data();
 
-				_blockPos[0] = _channels * 7;
-			} else {
-				data = _stream->readByte();
-				_blockPos[0]++;
-				_decodedSamples[_decodedSampleCount++] = decodeMS(&_status.ch[0], (data >> 4) & 0x0f);
-				_decodedSamples[_decodedSampleCount++] = decodeMS(&_status.ch[_channels - 1], data & 0x0f);
-			}
-			_decodedSampleIndex = 0;
+	for (i = 0; i < _channels; i++)
+		*buffer++ = status[i].sample2;
+
+	for (i = 0; i < _channels; i++)
+		*buffer++ = status[i].sample1;
+
+	// The high nibble is the left channel, the low nibble the right one
+	ADPCMChannelStatus &left = status[0];
+	ADPCMChannelStatus &right = status[_channels - 1];
+	for (const byte *end = _blockData.data() + size; data < end; data++) {
+		*buffer++ = decodeMS(&left, *data >> 4);
+		*buffer++ = decodeMS(&right, *data & 0x0f);
+	}
+
+	for (i = 0; i < _channels; i++)
+		_status.ch[i] = status[i];
+
+	_blockSamplePos = 0;
+}
+
+int MS_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
+	int samples = 0;
+
+	while (samples < numSamples) {
+		if (_blockSamplePos == _blockSamples.size()) {
+			if (_stream->eos() || _stream->pos() >= _endpos)
+				break;
+			decodeBlock();
 		}
 
-		// _decodedSamples acts as a FIFO of depth 2 or 4;
-		buffer[samples] = _decodedSamples[_decodedSampleIndex++];
-		_decodedSampleCount--;
+		const uint32 count = MIN<uint32>(numSamples - samples, _blockSamples.size() - _blockSamplePos);
+		memcpy(buffer + samples, _blockSamples.data() + _blockSamplePos, count * sizeof(int16));
+		_blockSamplePos += count;
+		samples += count;
 	}
 
 	return samples;
@@ -548,15 +673,7 @@ const int16 Ima_ADPCMStream::_imaTable[89] = {
 };
 
 int16 Ima_ADPCMStream::decodeIMA(byte code, int channel, int shift) {
-	int32 E = ((2 * (code & 0x7) + 1) * _imaTable[_status.ima_ch[channel].stepIndex]) >> shift;
-	int32 diff = (code & 0x08) ? -E : E;
-	int32 samp = CLIP<int32>(_status.ima_ch[channel].last + diff, -32768, 32767);
-
-	_status.ima_ch[channel].last = samp;
-	_status.ima_ch[channel].stepIndex += _stepAdjustTable[code];
-	_status.ima_ch[channel].stepIndex = CLIP<int32>(_status.ima_ch[channel].stepIndex, 0, ARRAYSIZE(_imaTable) - 1);
-
-	return samp;
+	return decodeIMASample(code, _status.ima_ch[channel].last, _status.ima_ch[channel].stepIndex, shift);
 }
 
 void FOURXM_ADPCMStream::decode() {
@@ -94,6 +94,8 @@ protected:
 	int16 decodeOKI(byte);
 
 private:
+	void decodeBytes(const byte *data, uint32 size, int16 *buffer);
+
 	uint8 _decodedSampleCount;
 	int16 _decodedSamples[2];
 };
@@ -120,6 +122,18 @@ class Ima_ADPCMStream : public ADPCMStream {
 protected:
 	int16 decodeIMA(byte code, int channel = 0, int shift = 3); // Default to using the left channel/using one channel
 
+	/**
+	 * Decode a nibble using the given channel state. Block decoders keep the
+	 * state in local variables while decoding, so it can stay in registers.
+	 */
+	FORCEINLINE static int16 decodeIMASample(byte code, int32 &last, int32 &stepIndex, int shift = 3) {
+		const int32 E = ((2 * (code & 0x7) + 1) * _imaTable[stepIndex]) >> shift;
+		const int32 diff = (code & 0x08) ? -E : E;
+		last = CLIP<int32>(last + diff, -32768, 32767);
+		stepIndex = CLIP<int32>(stepIndex + _stepAdjustTable[code], 0, ARRAYSIZE(_imaTable) - 1);
+		return last;
+	}
+
 public:
 	Ima_ADPCMStream(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, uint32 size, int rate, int channels, uint32 blockAlign)
 		: ADPCMStream(stream, disposeAfterUse, size, rate, channels, blockAlign) {}
@@ -140,6 +154,8 @@ public:
 	virtual int readBuffer(int16 *buffer, const int numSamples);
 
 private:
+	void decodeBytes(const byte *data, uint32 size, int16 *buffer);
+
 	uint8 _decodedSampleCount;
 	int16 _decodedSamples[2];
 };
@@ -148,26 +164,32 @@ class Apple_ADPCMStream : public Ima_ADPCMStream {
 protected:
 	// Apple QuickTime IMA ADPCM
 	int32 _streamPos[2];
-	int16 _buffer[2][2];
-	uint8 _chunkPos[2];
+	Common::Array<byte> _blockData;
+	Common::Array<int16> _blockSamples[2];
+	uint32 _blockSamplePos[2];
 
 	void reset() {
 		Ima_ADPCMStream::reset();
-		_chunkPos[0] = 0;
-		_chunkPos[1] = 0;
-		_streamPos[0] = 0;
-		_streamPos[1] = _blockAlign;
+		_streamPos[0] = _startpos;
+		_streamPos[1] = _startpos + _blockAlign;
+		_blockSamples[0].resize(0);
+		_blockSamples[1].resize(0);
+		_blockSamplePos[0] = 0;
+		_blockSamplePos[1] = 0;
 	}
 
+	void decodeBlock(int channel);
+
 public:
 	Apple_ADPCMStream(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, uint32 size, int rate, int channels, uint32 blockAlign)
 		: Ima_ADPCMStream(stream, disposeAfterUse, size, rate, channels, blockAlign) {
-		_chunkPos[0] = 0;
-		_chunkPos[1] = 0;
-		_streamPos[0] = 0;
-		_streamPos[1] = _blockAlign;
+		_streamPos[0] = _startpos;
+		_streamPos[1] = _startpos + _blockAlign;
+		_blockSamplePos[0] = 0;
+		_blockSamplePos[1] = 0;
 	}
 
+	virtual bool endOfData() const;
 	virtual int readBuffer(int16 *buffer, const int numSamples);
 };
 
@@ -182,21 +204,25 @@ public:
 		if (blockAlign % (_channels * 4))
 			error("MSIma_ADPCMStream(): invalid blockAlign");
 
-		_samplesLeft[0] = 0;
-		_samplesLeft[1] = 0;
+		_blockSamplePos = 0;
 	}
 
+	virtual bool endOfData() const { return (_stream->eos() || _stream->pos() >= _endpos) && (_blockSamplePos == _blockSamples.size()); }
+
 	virtual int readBuffer(int16 *buffer, const int numSamples);
 
 	void reset() {
 		Ima_ADPCMStream::reset();
-		_samplesLeft[0] = 0;
-		_samplesLeft[1] = 0;
+		_blockSamples.resize(0);
+		_blockSamplePos = 0;
 	}
 
 private:
-	int16 _buffer[2][8];
-	int _samplesLeft[2];
+	void decodeBlock();
+
+	Common::Array<byte> _blockData;
+	Common::Array<int16> _blockSamples;
+	uint32 _blockSamplePos;
 };
 
 class MS_ADPCMStream : public ADPCMStream {
@@ -218,6 +244,8 @@ protected:
 	void reset() {
 		ADPCMStream::reset();
 		memset(&_status, 0, sizeof(_status));
+		_blockSamples.resize(0);
+		_blockSamplePos = 0;
 	}
 
 public:
@@ -226,11 +254,10 @@ public:
 		if (blockAlign == 0)
 			error("MS_ADPCMStream(): blockAlign isn't specified for MS ADPCM");
 		memset(&_status, 0, sizeof(_status));
-		_decodedSampleCount = 0;
-		_decodedSampleIndex = 0;
+		_blockSamplePos = 0;
 	}
 
-	virtual bool endOfData() const { return (_stream->eos() || _stream->pos() >= _endpos) && (_decodedSampleCount == 0); }
+	virtual bool endOfData() const { return (_stream->eos() || _stream->pos() >= _endpos) && (_blockSamplePos == _blockSamples.size()); }
 
 	virtual int readBuffer(int16 *buffer, const int numSamples);
 
@@ -238,9 +265,11 @@ protected:
 	int16 decodeMS(ADPCMChannelStatus *c, byte);
 
 private:
-	uint8 _decodedSampleCount;
-	uint8 _decodedSampleIndex;
-	int16 _decodedSamples[4];
+	void decodeBlock();
+
+	Common::Array<byte> _blockData;
+	Common::Array<int16> _blockSamples;
+	uint32 _blockSamplePos;
 };
 
 // Duck DK3 IMA ADPCM Decoder
@@ -23,7 +23,9 @@
 
 #ifdef USE_MAD
 
+#include "common/array.h"
 #include "common/debug.h"
+#include "common/endian.h"
 #include "common/mutex.h"
 #include "common/ptr.h"
 #include "common/queue.h"
@@ -66,6 +68,12 @@ protected:
 
 	int fillBuffer(Common::ReadStream &stream, int16 *buffer, const int numSamples);
 
+	/**
+	 * Called by readHeader() for every frame header it reads, before adding
+	 * the duration of the frame to _curTime.
+	 */
+	virtual void onFrameHeader() {}
+
 	enum State {
 		MP3_STATE_INIT,	// Need to init the decoder
 		MP3_STATE_READY,	// ready for processing data
@@ -106,8 +114,45 @@ protected:
 
 	Timestamp _length;
 
+	void onFrameHeader() override;
+
 private:
 	static Common::SeekableReadStream *skipID3(Common::SeekableReadStream *stream, DisposeAfterUse::Flag dispose);
+
+	/**
+	 * Read the number of frames from the Xing or VBRI header in the first
+	 * frame, if the encoder wrote one.
+	 */
+	bool readFrameCount(uint32 &frames) const;
+
+	void seekToIndex(uint entry);
+
+	enum {
+		// Number of frames between the entries of the seek index
+		INDEX_INTERVAL = 16
+	};
+
+	/**
+	 * Start of every INDEX_INTERVAL-th frame of the stream, from the first
+	 * one up to the furthest one a seek has read the header of. It is only
+	 * built by seeking, so streams which are just played don't keep one.
+	 *
+	 * The index belongs to the MP3Stream. The source stream passed in is all
+	 * it knows of the data, and has no identity that could tell whether two
+	 * MP3Streams read the same data.
+	 */
+	struct IndexEntry {
+		mad_timer_t time;
+		uint32 offset;
+	};
+
+	Common::Array<IndexEntry> _index;
+
+	/**
+	 * Number of the frame readHeader() will read next, or -1 if the stream
+	 * wasn't positioned through the index.
+	 */
+	int32 _frameNum;
 };
 
 class PacketizedMP3Stream : private BaseMP3Stream, public PacketizedAudioStream {
@@ -268,6 +313,8 @@ void BaseMP3Stream::readHeader(Common::ReadStream &stream) {
 			}
 		}
 
+		onFrameHeader();
+
 		// Sum up the total playback time so far
 		mad_timer_add(&_curTime, _frame.header.duration);
 		break;
@@ -328,7 +375,8 @@ int BaseMP3Stream::fillBuffer(Common::ReadStream &stream, int16 *buffer, const i
 MP3Stream::MP3Stream(Common::SeekableReadStream *inStream, DisposeAfterUse::Flag dispose) :
 		BaseMP3Stream(),
 		_inStream(skipID3(inStream, dispose)),
-		_length(0, 1000) {
+		_length(0, 1000),
+		_frameNum(-1) {
 
 	// Initialize the stream with some data and set the channels and rate
 	// variables
@@ -336,7 +384,19 @@ MP3Stream::MP3Stream(Common::SeekableReadStream *inStream, DisposeAfterUse::Flag
 	_channels = MAD_NCHANNELS(&_frame.header);
 	_rate = _frame.header.samplerate;
 
+	// VBR encoders store the number of frames, which spares reading all of
+	// the frame headers. The header frame itself is decoded as silence.
+	uint32 frames;
+	if (_state == MP3_STATE_READY && getRate() > 0 && readFrameCount(frames)) {
+		mad_timer_t length = _frame.header.duration;
+		mad_timer_multiply(&length, frames + 1);
+		_length = Timestamp(mad_timer_count(length, MAD_UNITS_MILLISECONDS), getRate());
+		return;
+	}
+
 	// Calculate the length of the stream
+	_inStream->seek(0);
+	initStream(*_inStream);
 	while (_state != MP3_STATE_EOS)
 		readHeader(*_inStream);
 
@@ -376,9 +436,34 @@ bool MP3Stream::seek(const Timestamp &where) {
 	mad_timer_t destination;
 	mad_timer_set(&destination, time / 1000, time % 1000, 1000);
 
-	if (_state != MP3_STATE_READY || mad_timer_compare(destination, _curTime) < 0) {
-		_inStream->seek(0);
-		initStream(*_inStream);
+	// Find the last indexed frame starting before the destination
+	uint first = 0, last = _index.size();
+	while (first < last) {
+		const uint middle = (first + last) / 2;
+		if (mad_timer_compare(_index[middle].time, destination) <= 0)
+			first = middle + 1;
+		else
+			last = middle;
+	}
+
+	// Keep reading from where the stream is now, if the destination is ahead
+	// of it and there is no indexed frame closer to the destination. Seeks
+	// past the end of the index start from its last entry instead, so that
+	// the index grows to cover the frames they read.
+	bool restart = _state != MP3_STATE_READY || mad_timer_compare(destination, _curTime) < 0;
+	if (first == _index.size())
+		restart = true;
+	else if (first > 0 && mad_timer_compare(_index[first - 1].time, _curTime) > 0)
+		restart = true;
+
+	if (restart) {
+		if (first > 0) {
+			seekToIndex(first - 1);
+		} else {
+			_inStream->seek(0);
+			initStream(*_inStream);
+			_frameNum = 0;
+		}
 	}
 
 	while (mad_timer_compare(destination, _curTime) > 0 && _state != MP3_STATE_EOS)
@@ -386,9 +471,68 @@ bool MP3Stream::seek(const Timestamp &where) {
 
 	decodeMP3Data(*_inStream);
 
+	// Decoding frames doesn't keep track of their numbers
+	_frameNum = -1;
+
 	return (_state != MP3_STATE_EOS);
 }
 
+void MP3Stream::seekToIndex(uint entry) {
+	_inStream->seek(_index[entry].offset);
+	initStream(*_inStream);
+	_curTime = _index[entry].time;
+	_frameNum = entry * INDEX_INTERVAL;
+}
+
+void MP3Stream::onFrameHeader() {
+	if (_frameNum < 0)
+		return;
+
+	if (_frameNum == (int32)_index.size() * INDEX_INTERVAL) {
+		// The frame starts where the data left in the buffer begins
+		IndexEntry entry;
+		entry.time = _curTime;
+		entry.offset = _inStream->pos() - (_stream.bufend - _stream.this_frame);
+		_index.push_back(entry);
+	}
+
+	_frameNum++;
+}
+
+bool MP3Stream::readFrameCount(uint32 &frames) const {
+	if (_frame.header.layer != MAD_LAYER_III || !_stream.this_frame)
+		return false;
+
+	const byte *frame = _stream.this_frame;
+	const uint32 frameSize = _stream.next_frame - _stream.this_frame;
+
+	// The Xing header follows the side information
+	uint32 offset;
+	if (_frame.header.flags & MAD_FLAG_LSF_EXT)
+		offset = (_channels == 1) ? 9 : 17;
+	else
+		offset = (_channels == 1) ? 17 : 32;
+	offset += 4;
+	if (_frame.header.flags & MAD_FLAG_PROTECTION)
+		offset += 2;
+
+	if (offset + 12 <= frameSize && (!memcmp(frame + offset, "Xing", 4) || !memcmp(frame + offset, "Info", 4))) {
+		// Only use it if the frame count is present
+		if (!(READ_BE_UINT32(frame + offset + 4) & 1))
+			return false;
+		frames = READ_BE_UINT32(frame + offset + 8);
+		return frames > 0;
+	}
+
+	// The VBRI header is always at the same place
+	if (4 + 32 + 18 <= frameSize && !memcmp(frame + 4 + 32, "VBRI", 4)) {
+		frames = READ_BE_UINT32(frame + 4 + 32 + 14);
+		return frames > 0;
+	}
+
+	return false;
+}
+
 Common::SeekableReadStream *MP3Stream::skipID3(Common::SeekableReadStream *stream, DisposeAfterUse::Flag dispose) {
 	// Skip ID3 TAG if any
 	// ID3v1 (beginning with with 'TAG') is located at the end of files. So we can ignore those.
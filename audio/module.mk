@@ -26,6 +26,7 @@ MODULE_OBJS := \
 	mt32gm.o \
 	musicplugin.o \
 	null.o \
+	pcmcache.o \
 	rate.o \
 	sid.o \
 	timestamp.o \
@@ -68,7 +69,9 @@ MODULE_OBJS := \
 	softsynth/appleiigs.o \
 	softsynth/fluidsynth.o \
 	softsynth/eas.o \
+	softsynth/emumidi.o \
 	softsynth/pcspk.o \
+	softsynth/renderahead.o \
 	softsynth/ay8912.o
 
 ifndef DISABLE_NUKED_OPL
@@ -0,0 +1,331 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "audio/pcmcache.h"
+#include "audio/audiostream.h"
+
+namespace Audio {
+
+/**
+ * Plays the decoded samples of a cached sound.
+ */
+class PCMCache::CachedStream : public SeekableAudioStream {
+public:
+	CachedStream(PCMCache *cache, Entry *entry) : _cache(cache), _entry(entry), _pos(0) {}
+
+	~CachedStream() override {
+		_cache->release(_entry);
+	}
+
+	int readBuffer(int16 *buffer, const int numSamples) override {
+		const uint32 count = MIN<uint32>(numSamples, _entry->numSamples - _pos);
+		memcpy(buffer, _entry->samples + _pos, count * sizeof(int16));
+		_pos += count;
+		return count;
+	}
+
+	bool isStereo() const override { return _entry->stereo; }
+	int getRate() const override { return _entry->rate; }
+	bool endOfData() const override { return _pos >= _entry->numSamples; }
+
+	bool seek(const Timestamp &where) override {
+		const uint32 pos = convertTimeToStreamPos(where, getRate(), isStereo()).totalNumberOfFrames();
+		if (pos > _entry->numSamples)
+			return false;
+		_pos = pos;
+		return true;
+	}
+
+	Timestamp getLength() const override {
+		return Timestamp(0, _entry->numSamples / (isStereo() ? 2 : 1), getRate());
+	}
+
+private:
+	PCMCache *_cache;
+	Entry *_entry;
+	uint32 _pos;
+};
+
+/**
+ * Decoded samples of a sound, in a buffer growing as needed.
+ */
+class PCMCache::SampleBuffer {
+public:
+	SampleBuffer(uint32 maxSamples, uint32 expectedSamples) :
+			_samples(nullptr), _size(0), _capacity(0), _maxSamples(maxSamples) {
+		grow(MIN(MAX<uint32>(expectedSamples, 4096), maxSamples));
+	}
+
+	~SampleBuffer() {
+		delete[] _samples;
+	}
+
+	/** Append samples, and return false if the sound gets too long to be cached. */
+	bool append(const int16 *samples, uint32 count) {
+		if (count > _maxSamples - _size)
+			return false;
+		if (_size + count > _capacity)
+			grow(MIN(MAX(_capacity * 2, _size + count), _maxSamples));
+		memcpy(_samples + _size, samples, count * sizeof(int16));
+		_size += count;
+		return true;
+	}
+
+	uint32 size() const { return _size; }
+
+	/** Return the samples, which the caller then owns. */
+	int16 *release() {
+		int16 *samples = _samples;
+		_samples = nullptr;
+		_size = _capacity = 0;
+		return samples;
+	}
+
+private:
+	int16 *_samples;
+	uint32 _size;
+	uint32 _capacity;
+	uint32 _maxSamples;
+
+	void grow(uint32 capacity) {
+		int16 *samples = new int16[capacity];
+		if (_size)
+			memcpy(samples, _samples, _size * sizeof(int16));
+		delete[] _samples;
+		_samples = samples;
+		_capacity = capacity;
+	}
+};
+
+/**
+ * Plays a sound which isn't cached yet, and caches its samples once it has
+ * been played to the end.
+ */
+class PCMCache::CachingStream : public SeekableAudioStream {
+public:
+	CachingStream(PCMCache *cache, const Common::String &key, SeekableAudioStream *stream) :
+			_cache(cache), _key(key), _stream(stream),
+			_samples(new SampleBuffer(cache->getMaxSamples(), cache->getExpectedSamples(stream))) {}
+
+	~CachingStream() override {
+		delete _samples;
+		delete _stream;
+	}
+
+	int readBuffer(int16 *buffer, const int numSamples) override {
+		const int count = _stream->readBuffer(buffer, numSamples);
+		if (!_samples)
+			return count;
+
+		if (count > 0 && !_samples->append(buffer, count)) {
+			stopCaching();
+		} else if (count < numSamples || _stream->endOfData()) {
+			if (_samples->size()) {
+				Common::StackLock lock(_cache->_mutex);
+				_cache->add(_key, *_samples, getRate(), isStereo());
+			}
+			stopCaching();
+		}
+		return count;
+	}
+
+	bool isStereo() const override { return _stream->isStereo(); }
+	int getRate() const override { return _stream->getRate(); }
+	bool endOfData() const override { return _stream->endOfData(); }
+
+	bool seek(const Timestamp &where) override {
+		// Only sounds played through from the start are cached, players
+		// like LoopingAudioStream rewind before playing though
+		if (!_samples || _samples->size() || where.totalNumberOfFrames())
+			stopCaching();
+		return _stream->seek(where);
+	}
+
+	Timestamp getLength() const override {
+		return _stream->getLength();
+	}
+
+private:
+	PCMCache *_cache;
+	Common::String _key;
+	SeekableAudioStream *_stream;
+	SampleBuffer *_samples;	///< Samples played so far, or nullptr once the sound won't be cached
+
+	void stopCaching() {
+		delete _samples;
+		_samples = nullptr;
+	}
+};
+
+PCMCache::PCMCache(uint32 maxSize) : _size(0), _maxSize(maxSize), _hits(0), _misses(0) {
+}
+
+PCMCache::~PCMCache() {
+	clear();
+}
+
+Common::String PCMCache::makeKey(const Common::String &archive, const Common::String &member, const Common::String &codec) {
+	return archive + '|' + member + '|' + codec;
+}
+
+SeekableAudioStream *PCMCache::find(const Common::String &key) {
+	Common::StackLock lock(_mutex);
+
+	EntryMap::iterator it = _map.find(key);
+	if (it == _map.end()) {
+		_misses++;
+		return nullptr;
+	}
+
+	// Move the sound to the front of the list
+	Entry *entry = *it->_value;
+	_entries.erase(it->_value);
+	_entries.push_front(entry);
+	it->_value = _entries.begin();
+
+	_hits++;
+	return createStream(entry);
+}
+
+SeekableAudioStream *PCMCache::insert(const Common::String &key, SeekableAudioStream *stream) {
+	if (!stream)
+		return nullptr;
+
+	// Decode the sound outside of the lock, the mixer might be waiting for
+	// it. The length streams report is only a hint, some stop short of it
+	// or go on after it.
+	SampleBuffer samples(getMaxSamples(), getExpectedSamples(stream));
+	int16 chunk[4096];
+	stream->rewind();
+	while (!stream->endOfData()) {
+		const int count = stream->readBuffer(chunk, ARRAYSIZE(chunk));
+		if (count <= 0)
+			break;
+		if (!samples.append(chunk, count)) {
+			// Too long to be cached
+			stream->rewind();
+			return stream;
+		}
+	}
+
+	const int rate = stream->getRate();
+	const bool stereo = stream->isStereo();
+	delete stream;
+
+	Common::StackLock lock(_mutex);
+	return createStream(add(key, samples, rate, stereo));
+}
+
+SeekableAudioStream *PCMCache::makeCachingStream(const Common::String &key, SeekableAudioStream *stream) {
+	if (!stream)
+		return nullptr;
+
+	return new CachingStream(this, key, stream);
+}
+
+void PCMCache::clear() {
+	Common::StackLock lock(_mutex);
+
+	while (!_entries.empty())
+		evict(_entries.begin());
+}
+
+uint32 PCMCache::getHits() const {
+	Common::StackLock lock(_mutex);
+	return _hits;
+}
+
+uint32 PCMCache::getMisses() const {
+	Common::StackLock lock(_mutex);
+	return _misses;
+}
+
+uint32 PCMCache::getSize() const {
+	Common::StackLock lock(_mutex);
+	return _size;
+}
+
+uint32 PCMCache::getMaxSamples() const {
+	// Sounds taking more than an eighth of the cache are never cached, and
+	// stereo sounds keep whole frames
+	return (_maxSize / 8 / sizeof(int16)) & ~1;
+}
+
+uint32 PCMCache::getExpectedSamples(SeekableAudioStream *stream) {
+	const int frames = stream->getLength().totalNumberOfFrames();
+	return frames > 0 ? frames * (stream->isStereo() ? 2 : 1) : 0;
+}
+
+PCMCache::Entry *PCMCache::add(const Common::String &key, SampleBuffer &samples, int rate, bool stereo) {
+	Entry *entry = new Entry();
+	entry->key = key;
+	entry->numSamples = samples.size();
+	entry->samples = samples.release();
+	entry->rate = rate;
+	entry->stereo = stereo;
+	entry->refCount = 0;
+	entry->cached = true;
+
+	// Replace any sound cached under the same key in the meantime
+	EntryMap::iterator it = _map.find(key);
+	if (it != _map.end())
+		evict(it->_value);
+
+	_entries.push_front(entry);
+	_map[key] = _entries.begin();
+	_size += entry->numSamples * sizeof(int16);
+
+	while (_size > _maxSize)
+		evict(--_entries.end());
+
+	return entry;
+}
+
+SeekableAudioStream *PCMCache::createStream(Entry *entry) {
+	entry->refCount++;
+	return new CachedStream(this, entry);
+}
+
+void PCMCache::release(Entry *entry) {
+	Common::StackLock lock(_mutex);
+
+	entry->refCount--;
+	if (!entry->cached && !entry->refCount) {
+		delete[] entry->samples;
+		delete entry;
+	}
+}
+
+void PCMCache::evict(EntryList::iterator it) {
+	Entry *entry = *it;
+	_map.erase(entry->key);
+	_entries.erase(it);
+	_size -= entry->numSamples * sizeof(int16);
+
+	// Streams still playing the sound free it once they are done
+	entry->cached = false;
+	if (!entry->refCount) {
+		delete[] entry->samples;
+		delete entry;
+	}
+}
+
+} // End of namespace Audio
@@ -0,0 +1,154 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AUDIO_PCMCACHE_H
+#define AUDIO_PCMCACHE_H
+
+#include "common/hash-str.h"
+#include "common/list.h"
+#include "common/mutex.h"
+#include "common/str.h"
+
+namespace Audio {
+
+/**
+ * @defgroup audio_pcmcache PCM cache
+ * @ingroup audio
+ *
+ * @brief Cache of decoded sounds which are played repeatedly.
+ * @{
+ */
+
+class SeekableAudioStream;
+
+/**
+ * Keeps the decoded samples of short compressed sounds, like footsteps or
+ * clicks, so that they are not decoded again every time they are played.
+ *
+ * Sounds are identified by a key chosen by the caller, which should tell
+ * apart the archive, the member and the codec of the sound, see makeKey().
+ * Streams returned by the cache share the decoded samples, and can be
+ * played and deleted by the mixer while the cache is used on another
+ * thread. The least recently used sounds are dropped once the cache grows
+ * beyond its size.
+ *
+ * The cache must be deleted after all the streams it returned.
+ */
+class PCMCache {
+public:
+	/**
+	 * Create a cache keeping up to maxSize bytes of decoded samples.
+	 * Sounds taking more than an eighth of that are never cached.
+	 */
+	explicit PCMCache(uint32 maxSize = 8 * 1024 * 1024);
+	~PCMCache();
+
+	/**
+	 * Build a key identifying a sound.
+	 *
+	 * @param archive  Name of the archive the sound is in, or an empty string.
+	 * @param member   Name of the sound in the archive.
+	 * @param codec    Name of the codec the sound is encoded with.
+	 */
+	static Common::String makeKey(const Common::String &archive, const Common::String &member, const Common::String &codec);
+
+	/**
+	 * Return a new stream playing the sound cached under key, or nullptr if
+	 * it isn't cached.
+	 */
+	SeekableAudioStream *find(const Common::String &key);
+
+	/**
+	 * Decode stream and cache its samples under key.
+	 *
+	 * @param key     Key to cache the sound under.
+	 * @param stream  Stream to decode. The cache takes ownership of it.
+	 *
+	 * @return A new stream playing the decoded sound. If the sound is too
+	 *         long to be cached, this is the stream passed in.
+	 */
+	SeekableAudioStream *insert(const Common::String &key, SeekableAudioStream *stream);
+
+	/**
+	 * Return a new stream playing stream, which caches its samples under key
+	 * once it has been played to the end. Unlike insert(), this does not
+	 * decode the sound up front, so that it can start playing right away.
+	 * Sounds which are seeked in or are too long are not cached.
+	 *
+	 * @param key     Key to cache the sound under.
+	 * @param stream  Stream to play. The returned stream takes ownership of it.
+	 */
+	SeekableAudioStream *makeCachingStream(const Common::String &key, SeekableAudioStream *stream);
+
+	/**
+	 * Drop all cached sounds. Streams still playing them are not affected.
+	 */
+	void clear();
+
+	/** Return the number of find() calls which found the sound. */
+	uint32 getHits() const;
+
+	/** Return the number of find() calls which did not find the sound. */
+	uint32 getMisses() const;
+
+	/** Return the number of bytes of decoded samples currently cached. */
+	uint32 getSize() const;
+
+private:
+	class CachedStream;
+	class CachingStream;
+	class SampleBuffer;
+
+	struct Entry {
+		Common::String key;
+		int16 *samples;
+		uint32 numSamples;
+		int rate;
+		bool stereo;
+		uint refCount;	///< Number of streams playing the sound
+		bool cached;	///< Whether the entry is still in the cache
+	};
+
+	typedef Common::List<Entry *> EntryList;
+	typedef Common::HashMap<Common::String, EntryList::iterator> EntryMap;
+
+	uint32 getMaxSamples() const;
+	static uint32 getExpectedSamples(SeekableAudioStream *stream);
+
+	/** Cache the samples under key. The mutex must be held. */
+	Entry *add(const Common::String &key, SampleBuffer &samples, int rate, bool stereo);
+	SeekableAudioStream *createStream(Entry *entry);
+	void release(Entry *entry);
+	void evict(EntryList::iterator entry);
+
+	mutable Common::Mutex _mutex;
+	EntryList _entries;	///< Most recently used first
+	EntryMap _map;
+	uint32 _size;
+	uint32 _maxSize;
+	uint32 _hits;
+	uint32 _misses;
+};
+
+/** @} */
+} // End of namespace Audio
+
+#endif
@@ -0,0 +1,82 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "audio/softsynth/emumidi.h"
+#include "common/config-manager.h"
+
+int MidiDriver_Emulated::readBuffer(int16 *data, const int numSamples) {
+	if (!_renderAhead.isRunning()) {
+		render(data, numSamples);
+		return numSamples;
+	}
+
+	_renderAhead.read(data, numSamples);
+
+	// The timer callbacks stay on the mixer thread, and are run without
+	// holding the render mutex, as they call back into the engine
+	render(nullptr, numSamples);
+
+	return numSamples;
+}
+
+void MidiDriver_Emulated::render(int16 *data, int numSamples) {
+	const int stereoFactor = isStereo() ? 2 : 1;
+	int len = numSamples / stereoFactor;
+	int step;
+
+	do {
+		step = len;
+		if (step > (_nextTick >> FIXP_SHIFT))
+			step = (_nextTick >> FIXP_SHIFT);
+
+		if (data) {
+			generateSamples(data, step);
+			data += step * stereoFactor;
+		}
+
+		_nextTick -= step << FIXP_SHIFT;
+		if (!(_nextTick >> FIXP_SHIFT)) {
+			if (_timerProc)
+				(*_timerProc)(_timerParam);
+
+			onTimer();
+
+			_nextTick += _samplesPerTick;
+		}
+
+		len -= step;
+	} while (len);
+}
+
+void MidiDriver_Emulated::startRenderAhead() {
+	// Without threads, samples keep being generated in the mixer callback
+	const int latency = ConfMan.getInt("midi_render_ahead");
+	if (latency > 0)
+		_renderAhead.start(getRate() * latency / 1000 * (isStereo() ? 2 : 1), isStereo());
+}
+
+void MidiDriver_Emulated::stopRenderAhead() {
+	_renderAhead.stop();
+}
+
+void MidiDriver_Emulated::generateProc(void *param, int16 *buf, int len) {
+	((MidiDriver_Emulated *)param)->generateSamples(buf, len);
+}
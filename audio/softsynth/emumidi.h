@@ -25,6 +25,7 @@
 #include "audio/audiostream.h"
 #include "audio/mididrv.h"
 #include "audio/mixer.h"
+#include "audio/softsynth/renderahead.h"
 
 class MidiDriver_Emulated : public Audio::AudioStream, public MidiDriver {
 protected:
@@ -43,12 +44,41 @@ private:
 	int _nextTick;
 	int _samplesPerTick;
 
+	Audio::RenderAheadBuffer _renderAhead;
+
+	/**
+	 * Generate samples and run the timer callbacks between them. If data
+	 * is nullptr, only run the timer callbacks for that many samples.
+	 */
+	void render(int16 *data, int numSamples);
+
+	static void generateProc(void *param, int16 *buf, int len);
+
 protected:
 	int _baseFreq;
 
 	virtual void generateSamples(int16 *buf, int len) = 0;
 	virtual void onTimer() {}
 
+	/**
+	 * Start generating samples ahead of time on a separate thread, if the
+	 * user set the "midi_render_ahead" option to the number of milliseconds
+	 * to render ahead. Call this once the driver can generate samples, and
+	 * before starting to play it.
+	 *
+	 * The timer callback still runs on the mixer thread, once the samples
+	 * it would have run between have been taken from the buffer. MIDI
+	 * events then take effect once the samples rendered ahead have been
+	 * played.
+	 */
+	void startRenderAhead();
+
+	/**
+	 * Stop generating samples ahead of time. Call this after the driver has
+	 * stopped playing, and before it stops being able to generate samples.
+	 */
+	void stopRenderAhead();
+
 public:
 	MidiDriver_Emulated(Audio::Mixer *mixer) :
 		_mixer(mixer),
@@ -57,6 +87,7 @@ public:
 		_timerParam(0),
 		_nextTick(0),
 		_samplesPerTick(0),
+		_renderAhead(generateProc, this),
 		_baseFreq(250) {
 	}
 
@@ -87,34 +118,7 @@ public:
 	}
 
 	// AudioStream API
-	virtual int readBuffer(int16 *data, const int numSamples) {
-		const int stereoFactor = isStereo() ? 2 : 1;
-		int len = numSamples / stereoFactor;
-		int step;
-
-		do {
-			step = len;
-			if (step > (_nextTick >> FIXP_SHIFT))
-				step = (_nextTick >> FIXP_SHIFT);
-
-			generateSamples(data, step);
-
-			_nextTick -= step << FIXP_SHIFT;
-			if (!(_nextTick >> FIXP_SHIFT)) {
-				if (_timerProc)
-					(*_timerProc)(_timerParam);
-
-				onTimer();
-
-				_nextTick += _samplesPerTick;
-			}
-
-			data += step * stereoFactor;
-			len -= step;
-		} while (len);
-
-		return numSamples;
-	}
+	virtual int readBuffer(int16 *data, const int numSamples);
 
 	virtual bool endOfData() const {
 		return false;
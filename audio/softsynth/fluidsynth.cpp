@@ -504,6 +504,7 @@ int MidiDriver_FluidSynth::open() {
 	}
 
 	MidiDriver_Emulated::open();
+	startRenderAhead();
 
 	_mixer->playStream(Audio::Mixer::kPlainSoundType, &_mixerSoundHandle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
 
@@ -516,6 +517,7 @@ void MidiDriver_FluidSynth::close() {
 	_isOpen = false;
 
 	_mixer->stopHandle(_mixerSoundHandle);
+	stopRenderAhead();
 
 	/*
 	 * Don't delete the soundfont before cleaning up
@@ -219,6 +219,7 @@ int MidiDriver_MT32::open() {
 	_outputRate = _service.getActualStereoOutputSamplerate();
 
 	MidiDriver_Emulated::open();
+	startRenderAhead();
 
 	_mixer->playStream(Audio::Mixer::kPlainSoundType, &_mixerSoundHandle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
 
@@ -272,6 +273,7 @@ void MidiDriver_MT32::close() {
 	setTimerCallback(nullptr, nullptr);
 	// Detach the mixer callback handler
 	_mixer->stopHandle(_mixerSoundHandle);
+	stopRenderAhead();
 
 	Common::StackLock lock(_mutex);
 	_service.closeSynth();
@@ -1533,6 +1533,7 @@ void OPL3_GenerateStream(opl3_chip *chip, int16_t *sndptr, uint32_t numsamples)
 }
 
 OPL::OPL(Config::OplType type) : _type(type), _rate(0) {
+	_deferWrites = true;
 }
 
 OPL::~OPL() {
@@ -1559,7 +1560,7 @@ void OPL::write(int port, int val) {
 		switch (_type) {
 		case Config::kOpl2:
 		case Config::kOpl3:
-			OPL3_WriteRegBuffered(&chip, (uint16_t)address[0], (uint8_t)val);
+			bufferedWrite(address[0], val);
 			break;
 		case Config::kDualOpl2:
 			// Not a 0x??8 port, then write to a specific port
@@ -1603,7 +1604,16 @@ void OPL::write(int port, int val) {
 
 
 void OPL::writeReg(int r, int v) {
-	OPL3_WriteRegBuffered(&chip, (uint16_t)r, (uint8_t)v);
+	bufferedWrite(r, v);
+}
+
+void OPL::bufferedWrite(uint16 reg, uint8 val) {
+	if (!deferWrite(reg, val))
+		OPL3_WriteRegBuffered(&chip, (uint16_t)reg, (uint8_t)val);
+}
+
+void OPL::applyWrite(int reg, int val) {
+	OPL3_WriteRegBuffered(&chip, (uint16_t)reg, (uint8_t)val);
 }
 
 void OPL::dualWrite(uint8 index, uint8 reg, uint8 val) {
@@ -1623,11 +1633,11 @@ void OPL::dualWrite(uint8 index, uint8 reg, uint8 val) {
 	}
 
 	uint32 fullReg = reg + (index ? 0x100 : 0);
-	OPL3_WriteRegBuffered(&chip, (uint16_t)fullReg, (uint8_t)val);
+	bufferedWrite(fullReg, val);
 }
 
 void OPL::generateSamples(int16*buffer, int length) {
-	OPL3_GenerateStream(&chip, (int16_t*)buffer, (uint16_t)length / 2);
+	OPL3_GenerateStream(&chip, (int16_t*)buffer, (uint32_t)length / 2);
 }
 
 }
@@ -171,6 +171,7 @@ private:
 	opl3_chip chip;
 	uint address[2];
 	void dualWrite(uint8 index, uint8 reg, uint8 val);
+	void bufferedWrite(uint16 reg, uint8 val);
 
 public:
 	OPL(Config::OplType type);
@@ -187,6 +188,7 @@ public:
 
 protected:
 	void generateSamples(int16 *buffer, int length);
+	void applyWrite(int reg, int val);
 };
 
 }
@@ -0,0 +1,157 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "audio/softsynth/renderahead.h"
+#include "common/system.h"
+#include "common/thread.h"
+
+namespace Audio {
+
+// Number of sample frames the render thread generates at a time
+static const uint kRenderChunkFrames = 256;
+
+RenderAheadBuffer::RenderAheadBuffer(GenerateProc proc, void *param) :
+		_proc(proc),
+		_param(param),
+		_stereoFactor(1),
+		_thread(nullptr),
+		_space(nullptr),
+		_buffer(nullptr),
+		_size(0),
+		_readPos(0),
+		_fill(0),
+		_quit(false) {
+}
+
+RenderAheadBuffer::~RenderAheadBuffer() {
+	stop();
+}
+
+bool RenderAheadBuffer::start(uint numSamples, bool stereo) {
+	if (_thread)
+		return true;
+
+	_space = g_system->createSemaphore(0);
+	if (!_space)
+		return false;
+
+	_stereoFactor = stereo ? 2 : 1;
+	_size = MAX<uint>(numSamples / _stereoFactor, kRenderChunkFrames) * _stereoFactor;
+	_buffer = new int16[_size];
+	_readPos = 0;
+	_fill = 0;
+	_quit = false;
+
+	_thread = g_system->createThread(threadProc, this, "Audio render ahead");
+	if (!_thread) {
+		delete _space;
+		_space = nullptr;
+		delete[] _buffer;
+		_buffer = nullptr;
+		return false;
+	}
+
+	return true;
+}
+
+void RenderAheadBuffer::stop() {
+	if (!_thread)
+		return;
+
+	{
+		Common::StackLock lock(_bufferMutex);
+		_quit = true;
+	}
+	_space->post();
+	_thread->join();
+
+	delete _thread;
+	_thread = nullptr;
+	delete _space;
+	_space = nullptr;
+	delete[] _buffer;
+	_buffer = nullptr;
+}
+
+void RenderAheadBuffer::read(int16 *data, int numSamples) {
+	int done = take(data, numSamples);
+	if (done < numSamples) {
+		// The thread fell behind, so wait for the samples it is generating,
+		// and then generate the rest right here
+		Common::StackLock lock(_renderMutex);
+		done += take(data + done, numSamples - done);
+		if (done < numSamples)
+			_proc(_param, data + done, (numSamples - done) / _stereoFactor);
+	}
+}
+
+int RenderAheadBuffer::take(int16 *data, int numSamples) {
+	int taken = 0;
+	{
+		Common::StackLock lock(_bufferMutex);
+		while (taken < numSamples && _fill) {
+			const uint count = MIN<uint>(numSamples - taken, MIN(_fill, _size - _readPos));
+			memcpy(data + taken, _buffer + _readPos, count * sizeof(int16));
+			taken += count;
+			_readPos = (_readPos + count) % _size;
+			_fill -= count;
+		}
+	}
+
+	if (taken)
+		_space->post();
+	return taken;
+}
+
+void RenderAheadBuffer::threadProc(void *param) {
+	((RenderAheadBuffer *)param)->renderAhead();
+}
+
+void RenderAheadBuffer::renderAhead() {
+	for (;;) {
+		uint writePos, count;
+		{
+			Common::StackLock lock(_bufferMutex);
+			if (_quit)
+				return;
+
+			// The reader only takes the samples already rendered, so the
+			// free part of the buffer can be written without holding the lock
+			writePos = (_readPos + _fill) % _size;
+			count = MIN(_size - _fill, _size - writePos);
+		}
+
+		if (!count) {
+			_space->wait();
+			continue;
+		}
+
+		count = MIN(count, kRenderChunkFrames * _stereoFactor);
+
+		Common::StackLock lock(_renderMutex);
+		_proc(_param, _buffer + writePos, count / _stereoFactor);
+
+		Common::StackLock bufferLock(_bufferMutex);
+		_fill += count;
+	}
+}
+
+} // End of namespace Audio
@@ -0,0 +1,97 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AUDIO_SOFTSYNTH_RENDERAHEAD_H
+#define AUDIO_SOFTSYNTH_RENDERAHEAD_H
+
+#include "common/mutex.h"
+
+namespace Common {
+class SemaphoreInternal;
+class ThreadInternal;
+}
+
+namespace Audio {
+
+/**
+ * Samples generated ahead of time on a separate thread, so that the mixer
+ * only has to copy them out.
+ */
+class RenderAheadBuffer {
+public:
+	/**
+	 * Generate len sample frames into buf. This is called on the render
+	 * thread, or on the thread reading the samples if the render thread
+	 * fell behind, but never on both at once.
+	 */
+	typedef void (*GenerateProc)(void *param, int16 *buf, int len);
+
+	RenderAheadBuffer(GenerateProc proc, void *param);
+	~RenderAheadBuffer();
+
+	/**
+	 * Start generating up to numSamples samples ahead of time. When stereo
+	 * is set, numSamples counts both channels, like the mixer does.
+	 *
+	 * @return false if the backend can't create threads.
+	 */
+	bool start(uint numSamples, bool stereo);
+
+	/**
+	 * Stop generating samples, and drop those which were not read.
+	 */
+	void stop();
+
+	bool isRunning() const { return _thread != nullptr; }
+
+	/**
+	 * Copy numSamples samples to data. The samples which weren't rendered
+	 * ahead yet are generated right here.
+	 */
+	void read(int16 *data, int numSamples);
+
+private:
+	GenerateProc _proc;
+	void *_param;
+	uint _stereoFactor;
+
+	Common::ThreadInternal *_thread;
+	Common::SemaphoreInternal *_space;	///< Posted when samples were taken from the buffer
+	Common::Mutex _renderMutex;			///< Held while generating samples
+	Common::Mutex _bufferMutex;			///< Guards the buffer positions
+	int16 *_buffer;
+	uint _size;
+	uint _readPos;
+	uint _fill;
+	bool _quit;
+
+	/**
+	 * Copy samples rendered ahead to data, and return how many there were.
+	 */
+	int take(int16 *data, int numSamples);
+
+	static void threadProc(void *param);
+	void renderAhead();
+};
+
+} // End of namespace Audio
+
+#endif
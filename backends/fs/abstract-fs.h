@@ -172,6 +172,20 @@ public:
 	 */
 	virtual bool isWritable() const = 0;
 
+	/**
+	 * Returns the time the object referred by this path was last modified,
+	 * in seconds since the Unix epoch.
+	 *
+	 * @return the modification time, 0 if it is not known
+	 */
+	virtual uint32 getModificationTime() const { return 0; }
+
+	/**
+	 * Returns the size of the file referred by this path, without opening it.
+	 *
+	 * @return the size in bytes, -1 if it is not known
+	 */
+	virtual int64 getFileSize() const { return -1; }
 
 	/**
 	 * Creates a SeekableReadStream instance corresponding to the file
@@ -182,6 +196,15 @@ public:
 	 */
 	virtual Common::SeekableReadStream *createReadStream() = 0;
 
+	/**
+	 * Like createReadStream(), but the data is always read from the file
+	 * as it is needed, instead of being mapped into memory. Use this for
+	 * files that may be truncated or rewritten while they are open.
+	 *
+	 * @return pointer to the stream object, 0 in case of a failure
+	 */
+	virtual Common::SeekableReadStream *createUnmappedReadStream() { return createReadStream(); }
+
 	/**
 	 * Creates a SeekableReadStream instance corresponding to an alternate
 	 * stream of the file referred by this node. This assumes that the node
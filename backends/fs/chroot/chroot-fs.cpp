@@ -100,6 +100,10 @@ Common::SeekableReadStream *ChRootFilesystemNode::createReadStream() {
 	return _realNode->createReadStream();
 }
 
+Common::SeekableReadStream *ChRootFilesystemNode::createUnmappedReadStream() {
+	return _realNode->createUnmappedReadStream();
+}
+
 Common::SeekableWriteStream *ChRootFilesystemNode::createWriteStream(bool atomic) {
 	return _realNode->createWriteStream(atomic);
 }
@@ -67,6 +67,22 @@ bool POSIXFilesystemNode::isWritable() const {
 	return access(_path.c_str(), W_OK) == 0;
 }
 
+uint32 POSIXFilesystemNode::getModificationTime() const {
+	struct stat st;
+
+	if (stat(_path.c_str(), &st) != 0)
+		return 0;
+	return (uint32)st.st_mtime;
+}
+
+int64 POSIXFilesystemNode::getFileSize() const {
+	struct stat st;
+
+	if (stat(_path.c_str(), &st) != 0 || !S_ISREG(st.st_mode))
+		return -1;
+	return st.st_size;
+}
+
 void POSIXFilesystemNode::setFlags() {
 	struct stat st;
 
@@ -276,6 +292,18 @@ AbstractFSNode *POSIXFilesystemNode::getParent() const {
 }
 
 Common::SeekableReadStream *POSIXFilesystemNode::createReadStream() {
+	// Large files are mapped into memory, so their data doesn't need to be
+	// copied. Reading a mapping past the end of a truncated file raises
+	// SIGBUS, so files which may be rewritten while they are open must use
+	// createUnmappedReadStream() instead.
+	Common::SeekableReadStream *stream = PosixMappedStream::makeFromPath(getPath());
+	if (stream)
+		return stream;
+
+	return PosixIoStream::makeFromPath(getPath(), StdioStream::WriteMode_Read);
+}
+
+Common::SeekableReadStream *POSIXFilesystemNode::createUnmappedReadStream() {
 	return PosixIoStream::makeFromPath(getPath(), StdioStream::WriteMode_Read);
 }
 
@@ -24,6 +24,13 @@
 #include "backends/fs/posix/posix-iostream.h"
 
 #include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
+#include <sys/mman.h>
+#define POSIX_HAS_MMAP
+#endif
 
 PosixIoStream::PosixIoStream(void *handle) :
 		StdioStream(handle) {
@@ -44,3 +51,63 @@ int64 PosixIoStream::size() const {
 
 	return st.st_size;
 }
+
+#ifdef POSIX_HAS_MMAP
+namespace {
+
+// Small files are read faster through stdio than by setting up a mapping
+const off_t kMinMappedSize = 64 * 1024;
+
+struct Unmapper {
+	size_t _size;
+
+	Unmapper(size_t size) : _size(size) {}
+
+	void operator()(byte *data) {
+		munmap(data, _size);
+	}
+};
+
+} // End of anonymous namespace
+#endif
+
+PosixMappedStream::PosixMappedStream(const Common::SharedPtr<byte> &mapping, const byte *data, uint32 size) :
+		MemoryReadStream(data, size, DisposeAfterUse::NO), _mapping(mapping) {
+}
+
+PosixMappedStream *PosixMappedStream::makeFromPath(const Common::String &path) {
+#ifdef POSIX_HAS_MMAP
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd == -1)
+		return nullptr;
+
+	struct stat st;
+	if (fstat(fd, &st) == -1 || !S_ISREG(st.st_mode) || st.st_size < kMinMappedSize || (uint64)st.st_size > 0xFFFFFFFF) {
+		close(fd);
+		return nullptr;
+	}
+
+	// The mapping stays valid after closing the file, and isn't affected by
+	// the file being replaced through a rename
+	void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED)
+		return nullptr;
+
+	const uint32 size = st.st_size;
+	Common::SharedPtr<byte> mapping((byte *)data, Unmapper(size));
+	return new PosixMappedStream(mapping, (const byte *)data, size);
+#else
+	return nullptr;
+#endif
+}
+
+Common::SeekableReadStream *PosixMappedStream::readStream(uint32 dataSize) {
+	// Reads running past the end are copied, so that they flag the end of the stream
+	if (dataSize == 0 || dataSize > size() - pos())
+		return MemoryReadStream::readStream(dataSize);
+
+	const byte *data = getData() + pos();
+	seek(dataSize, SEEK_CUR);
+	return new PosixMappedStream(_mapping, data, dataSize);
+}
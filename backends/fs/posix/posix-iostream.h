@@ -23,6 +23,8 @@
 #define BACKENDS_FS_POSIX_POSIXIOSTREAM_H
 
 #include "backends/fs/stdiostream.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
 
 /**
  * A file input / output stream using POSIX interfaces
@@ -39,4 +41,25 @@ public:
 	int64 size() const override;
 };
 
+/**
+ * A file input stream which maps the whole file into memory, so its data can
+ * be parsed, and shared by readStream(), without copying it.
+ */
+class PosixMappedStream final : public Common::MemoryReadStream {
+public:
+	/**
+	 * Map the file at the given path. Returns nullptr if the file is too small
+	 * to be worth mapping, or can't be mapped, in which case it should be read
+	 * through a PosixIoStream instead.
+	 */
+	static PosixMappedStream *makeFromPath(const Common::String &path);
+
+	Common::SeekableReadStream *readStream(uint32 dataSize) override;
+
+private:
+	PosixMappedStream(const Common::SharedPtr<byte> &mapping, const byte *data, uint32 size);
+
+	Common::SharedPtr<byte> _mapping; ///< Keeps the file mapped while any stream reads from it
+};
+
 #endif
@@ -44,6 +44,24 @@ bool WindowsFilesystemNode::isWritable() const {
 	return ((fileAttribs != INVALID_FILE_ATTRIBUTES) && (!(fileAttribs & FILE_ATTRIBUTE_READONLY)));
 }
 
+uint32 WindowsFilesystemNode::getModificationTime() const {
+	WIN32_FILE_ATTRIBUTE_DATA data;
+	if (!GetFileAttributesEx(charToTchar(_path.c_str()), GetFileExInfoStandard, &data))
+		return 0;
+
+	// File times count 100 nanosecond intervals since 1601
+	const uint64 time = ((uint64)data.ftLastWriteTime.dwHighDateTime << 32) | data.ftLastWriteTime.dwLowDateTime;
+	return (uint32)(time / 10000000 - 11644473600ULL);
+}
+
+int64 WindowsFilesystemNode::getFileSize() const {
+	WIN32_FILE_ATTRIBUTE_DATA data;
+	if (!GetFileAttributesEx(charToTchar(_path.c_str()), GetFileExInfoStandard, &data) ||
+		(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+		return -1;
+	return ((int64)data.nFileSizeHigh << 32) | data.nFileSizeLow;
+}
+
 void WindowsFilesystemNode::addFile(AbstractFSList &list, ListMode mode, const char *base, bool hidden, WIN32_FIND_DATA* find_data) {
 	// Skip local directory (.) and parent (..)
 	if (!_tcscmp(find_data->cFileName, TEXT(".")) ||
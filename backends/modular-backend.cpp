@@ -193,9 +193,12 @@ void ModularGraphicsBackend::updateScreen() {
 	g_system->getMillis();		// force event recorder to update the tick count
 	g_eventRec.processScreenUpdate();
 	g_eventRec.preDrawOverlayGui();
-#endif
 
-	_graphicsManager->updateScreen();
+	// Handled here rather than by the graphics managers, so that every
+	// backend can play recordings without a display
+	if (!g_eventRec.isDisplayDisabled())
+#endif
+		_graphicsManager->updateScreen();
 
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.postDrawOverlayGui();
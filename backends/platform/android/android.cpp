@@ -67,6 +67,7 @@
 #include "backends/audiocd/default/default-audiocd.h"
 #include "backends/events/default/default-events.h"
 #include "backends/mutex/pthread/pthread-mutex.h"
+#include "backends/threads/pthread/pthread-threads.h"
 #include "backends/saves/default/default-saves.h"
 #include "backends/timer/default/default-timer.h"
 
@@ -916,6 +917,18 @@ Common::MutexInternal *OSystem_Android::createMutex() {
 	return createPthreadMutexInternal();
 }
 
+Common::ThreadInternal *OSystem_Android::createThread(void (*proc)(void *param), void *param, const char *name) {
+	return createPthreadThreadInternal(proc, param, name);
+}
+
+Common::SemaphoreInternal *OSystem_Android::createSemaphore(uint initialValue) {
+	return createPthreadSemaphoreInternal(initialValue);
+}
+
+uint OSystem_Android::getCPUCoreCount() const {
+	return getPthreadCPUCoreCount();
+}
+
 void OSystem_Android::quit() {
 	ENTER();
 
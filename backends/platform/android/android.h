@@ -254,6 +254,9 @@ public:
 	uint32 getMillis(bool skipRecord = false) override;
 	void delayMillis(uint msecs) override;
 	Common::MutexInternal *createMutex() override;
+	Common::ThreadInternal *createThread(void (*proc)(void *param), void *param, const char *name) override;
+	Common::SemaphoreInternal *createSemaphore(uint initialValue) override;
+	uint getCPUCoreCount() const override;
 
 	void quit() override;
 
@@ -51,6 +51,7 @@
 #include "backends/saves/default/default-saves.h"
 #include "backends/timer/default/default-timer.h"
 #include "backends/mutex/pthread/pthread-mutex.h"
+#include "backends/threads/pthread/pthread-threads.h"
 #include "backends/fs/chroot/chroot-fs-factory.h"
 #include "backends/fs/posix/posix-fs.h"
 #include "backends/text-to-speech/avfaudio/avfaudio-text-to-speech.h"
@@ -365,6 +366,18 @@ Common::MutexInternal *OSystem_iOS7::createMutex() {
 	return createPthreadMutexInternal();
 }
 
+Common::ThreadInternal *OSystem_iOS7::createThread(void (*proc)(void *param), void *param, const char *name) {
+	return createPthreadThreadInternal(proc, param, name);
+}
+
+Common::SemaphoreInternal *OSystem_iOS7::createSemaphore(uint initialValue) {
+	return createPthreadSemaphoreInternal(initialValue);
+}
+
+uint OSystem_iOS7::getCPUCoreCount() const {
+	return getPthreadCPUCoreCount();
+}
+
 void OSystem_iOS7::quit() {
 }
 
@@ -48,15 +48,21 @@ typedef void (*sighandler_t)(int);
 
 #if defined(USE_NULL_DRIVER)
 #include "backends/modular-backend.h"
+#include "backends/mixer/null/null-mixer.h"
 #include "backends/mutex/null/null-mutex.h"
 #include "base/main.h"
 
+#if defined(NULL_DRIVER_USE_FOR_TEST) && defined(POSIX)
+#include "backends/mutex/pthread/pthread-mutex.h"
+#include "backends/threads/pthread/pthread-threads.h"
+#endif
+
+#include "backends/timer/default/default-timer.h"
+#include "backends/graphics/null/null-graphics.h"
+
 #ifndef NULL_DRIVER_USE_FOR_TEST
 #include "backends/saves/default/default-saves.h"
-#include "backends/timer/default/default-timer.h"
 #include "backends/events/default/default-events.h"
-#include "backends/mixer/null/null-mixer.h"
-#include "backends/graphics/null/null-graphics.h"
 #include "gui/debugger.h"
 #endif
 
@@ -95,6 +101,18 @@ public:
 
 	virtual void addSysArchivesToSearchSet(Common::SearchSet &s, int priority);
 
+#ifdef NULL_DRIVER_USE_FOR_TEST
+	// The tests run without a graphics manager to ask
+	virtual bool hasFeature(Feature f) { return false; }
+
+#ifdef POSIX
+	// Real threads, so that the tests can run code on several of them
+	virtual Common::ThreadInternal *createThread(void (*proc)(void *param), void *param, const char *name);
+	virtual Common::SemaphoreInternal *createSemaphore(uint initialValue);
+	virtual uint getCPUCoreCount() const;
+#endif
+#endif
+
 private:
 #ifdef POSIX
 	timeval _startTime;
@@ -147,14 +165,19 @@ void OSystem_NULL::initBackend() {
 	last_handler = signal(SIGINT, intHandler);
 #endif
 
-	_timerManager = new DefaultTimerManager();
 	_eventManager = new DefaultEventManager(this);
 	_savefileManager = new DefaultSaveFileManager();
+#endif
+
+	// The tests need these for code which draws or installs timers
+	_timerManager = new DefaultTimerManager();
 	_graphicsManager = new NullGraphicsManager();
+
+	// Setup and start mixer. The tests need one for emulated sound chips.
 	_mixerManager = new NullMixerManager();
-	// Setup and start mixer
 	_mixerManager->init();
 
+#ifndef NULL_DRIVER_USE_FOR_TEST
 	BaseBackend::initBackend();
 #endif
 }
@@ -187,9 +210,27 @@ bool OSystem_NULL::pollEvent(Common::Event &event) {
 }
 
 Common::MutexInternal *OSystem_NULL::createMutex() {
+#if defined(NULL_DRIVER_USE_FOR_TEST) && defined(POSIX)
+	return createPthreadMutexInternal();
+#else
 	return new NullMutexInternal();
+#endif
 }
 
+#if defined(NULL_DRIVER_USE_FOR_TEST) && defined(POSIX)
+Common::ThreadInternal *OSystem_NULL::createThread(void (*proc)(void *param), void *param, const char *name) {
+	return createPthreadThreadInternal(proc, param, name);
+}
+
+Common::SemaphoreInternal *OSystem_NULL::createSemaphore(uint initialValue) {
+	return createPthreadSemaphoreInternal(initialValue);
+}
+
+uint OSystem_NULL::getCPUCoreCount() const {
+	return getPthreadCPUCoreCount();
+}
+#endif
+
 uint32 OSystem_NULL::getMillis(bool skipRecord) {
 #ifdef POSIX
 	timeval curTime;
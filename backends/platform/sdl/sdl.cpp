@@ -46,6 +46,7 @@
 #include "backends/events/default/default-events.h"
 #include "backends/keymapper/hardware-input.h"
 #include "backends/mutex/sdl/sdl-mutex.h"
+#include "backends/threads/sdl/sdl-threads.h"
 #include "backends/timer/sdl/sdl-timer.h"
 #include "backends/graphics/surfacesdl/surfacesdl-graphics.h"
 #ifdef USE_OPENGL
@@ -866,6 +867,18 @@ Common::MutexInternal *OSystem_SDL::createMutex() {
 	return createSdlMutexInternal();
 }
 
+Common::ThreadInternal *OSystem_SDL::createThread(void (*proc)(void *param), void *param, const char *name) {
+	return createSdlThreadInternal(proc, param, name);
+}
+
+Common::SemaphoreInternal *OSystem_SDL::createSemaphore(uint initialValue) {
+	return createSdlSemaphoreInternal(initialValue);
+}
+
+uint OSystem_SDL::getCPUCoreCount() const {
+	return getSdlCPUCoreCount();
+}
+
 uint32 OSystem_SDL::getMillis(bool skipRecord) {
 	uint32 millis = SDL_GetTicks();
 
@@ -876,6 +889,16 @@ uint32 OSystem_SDL::getMillis(bool skipRecord) {
 	return millis;
 }
 
+uint64 OSystem_SDL::getMicros() {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	uint64 counter = SDL_GetPerformanceCounter();
+	uint64 frequency = SDL_GetPerformanceFrequency();
+	return counter / frequency * 1000000 + counter % frequency * 1000000 / frequency;
+#else
+	return (uint64)SDL_GetTicks() * 1000;
+#endif
+}
+
 void OSystem_SDL::delayMillis(uint msecs) {
 #ifdef ENABLE_EVENTRECORDER
 	if (g_eventRec.processDelayMillis())
@@ -89,7 +89,11 @@ public:
 	void setWindowCaption(const Common::U32String &caption) override;
 	void addSysArchivesToSearchSet(Common::SearchSet &s, int priority = 0) override;
 	Common::MutexInternal *createMutex() override;
+	Common::ThreadInternal *createThread(void (*proc)(void *param), void *param, const char *name) override;
+	Common::SemaphoreInternal *createSemaphore(uint initialValue) override;
+	uint getCPUCoreCount() const override;
 	uint32 getMillis(bool skipRecord = false) override;
+	uint64 getMicros() override;
 	void delayMillis(uint msecs) override;
 	void getTimeAndDate(TimeDate &td, bool skipRecord = false) const override;
 	MixerManager *getMixerManager() override;
@@ -37,6 +37,10 @@
 #include "common/archive.h"
 #include "common/config-manager.h"
 #include "common/compression/deflate.h"
+#include "common/endian.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
+#include "common/threadpool.h"
 
 #include <errno.h>	// for removeSavefile()
 
@@ -44,13 +48,129 @@
 const char *const DefaultSaveFileManager::TIMESTAMPS_FILENAME = "timestamps";
 #endif
 
-DefaultSaveFileManager::DefaultSaveFileManager() {
+const char *const DefaultSaveFileManager::METADATA_DIRNAME = "metadata";
+
+static const uint32 kMetadataIndexTag = MKTAG('S', 'V', 'M', 'I');
+// Bump this whenever the layout of the index files changes
+static const uint32 kMetadataIndexVersion = 2;
+
+/**
+ * Writes the data of a save file, optionally compressing it, on a background
+ * thread. The file only replaces the previous one once it is complete.
+ */
+class DefaultSaveFileManager::SaveJob : public Common::Job {
+public:
+	SaveJob(Common::Mutex &mutex, const Common::String &filename, const Common::FSNode &fileNode, byte *data, uint32 size, bool compress)
+		: _mutex(mutex), _filename(filename), _fileNode(fileNode), _data(data), _size(size), _compress(compress), _done(false), _success(false) {}
+
+	~SaveJob() override {
+		free(_data);
+	}
+
+	void run() override {
+		bool success = false;
+		Common::SeekableWriteStream *const sf = _fileNode.createWriteStream(true);
+		if (sf) {
+			Common::WriteStream *const out = _compress ? Common::wrapCompressedWriteStream(sf) : sf;
+			out->write(_data, _size);
+			out->finalize();
+			success = !out->err();
+			delete out;
+		}
+
+		free(_data);
+		_data = nullptr;
+
+		Common::StackLock lock(_mutex);
+		_success = success;
+		_done = true;
+	}
+
+	Common::Mutex &_mutex;
+	const Common::String _filename;
+	const Common::FSNode _fileNode;
+	byte *_data;
+	uint32 _size;
+	bool _compress;
+	bool _done;
+	bool _success;
+};
+
+/**
+ * Collects the data of a save file in memory, and hands it over to be
+ * written in the background once it is finalized. Checking err() after
+ * that waits for the data to be written, so that failing to write it is
+ * reported as well.
+ */
+class DefaultSaveFileManager::BackgroundSaveStream : public Common::SeekableWriteStream {
+public:
+	BackgroundSaveStream(DefaultSaveFileManager *manager, const Common::String &filename, const Common::FSNode &fileNode, bool compress)
+		: _manager(manager), _filename(filename), _fileNode(fileNode), _compress(compress), _buffer(DisposeAfterUse::NO), _submitted(false), _err(false) {}
+
+	~BackgroundSaveStream() override {
+		finalize();
+	}
+
+	uint32 write(const void *dataPtr, uint32 dataSize) override {
+		if (_submitted) {
+			_err = true;
+			return 0;
+		}
+		return _buffer.write(dataPtr, dataSize);
+	}
+
+	int64 pos() const override { return _buffer.pos(); }
+	int64 size() const override { return _buffer.size(); }
+	bool seek(int64 offset, int whence = SEEK_SET) override { return _buffer.seek(offset, whence); }
+
+	bool err() const override {
+		if (_job) {
+			_manager->waitForSave(_filename);
+			Common::StackLock lock(_manager->_saveMutex);
+			if (!_job->_success)
+				_err = true;
+			_job.reset();
+		}
+		return _err;
+	}
+
+	void clearErr() override { _err = false; }
+
+	void finalize() override {
+		if (_submitted)
+			return;
+		_submitted = true;
+
+		// The buffer is not disposed of by the stream, the job takes it over
+		_job = SaveJobPtr(new SaveJob(_manager->_saveMutex, _filename, _fileNode, _buffer.getData(), _buffer.size(), _compress));
+		_manager->submitSave(_job);
+	}
+
+private:
+	DefaultSaveFileManager *_manager;
+	const Common::String _filename;
+	const Common::FSNode _fileNode;
+	bool _compress;
+	Common::MemoryWriteStreamDynamic _buffer;
+	bool _submitted;
+	mutable bool _err;
+	/** The job writing the data, until err() has collected its result */
+	mutable SaveJobPtr _job;
+};
+
+DefaultSaveFileManager::DefaultSaveFileManager() : _savePool(nullptr) {
 }
 
-DefaultSaveFileManager::DefaultSaveFileManager(const Common::Path &defaultSavepath) {
+DefaultSaveFileManager::DefaultSaveFileManager(const Common::Path &defaultSavepath) : _savePool(nullptr) {
 	ConfMan.registerDefault("savepath", defaultSavepath);
 }
 
+DefaultSaveFileManager::~DefaultSaveFileManager() {
+	waitForSaves();
+	delete _savePool;
+	flushMetadata();
+}
+
 
 void DefaultSaveFileManager::checkPath(const Common::FSNode &dir) {
 	clearError();
@@ -69,6 +189,10 @@ void DefaultSaveFileManager::updateSavefilesList(Common::StringArray &lockedFile
 
 	//remember the locked files list because some of these files don't exist yet
 	_lockedFiles = lockedFiles;
+
+	// The locked files are being replaced by the synced ones
+	for (const auto &lockedFile : _lockedFiles)
+		invalidateMetadata(lockedFile);
 }
 
 Common::StringArray DefaultSaveFileManager::listSavefiles(const Common::String &pattern) {
@@ -97,12 +221,14 @@ Common::InSaveFile *DefaultSaveFileManager::openRawFile(const Common::String &fi
 	if (getError().getCode() != Common::kNoError)
 		return nullptr;
 
+	waitForSave(filename);
+
 	SaveFileCache::const_iterator file = _saveFileCache.find(filename);
 	if (file == _saveFileCache.end()) {
 		return nullptr;
 	} else {
 		// Open the file for loading.
-		Common::SeekableReadStream *sf = file->_value.createReadStream();
+		Common::SeekableReadStream *sf = file->_value.createUnmappedReadStream();
 		return sf;
 	}
 }
@@ -113,6 +239,8 @@ Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String
 	if (getError().getCode() != Common::kNoError)
 		return nullptr;
 
+	waitForSave(filename);
+
 	for (const auto &lockedFile : _lockedFiles) {
 		if (filename == lockedFile) {
 			setError(Common::kReadingFailed, Common::String::format("Savefile '%s' is locked and cannot be loaded", filename.c_str()));
@@ -126,24 +254,27 @@ Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String
 		return nullptr;
 	} else {
 		// Open the file for loading.
-		Common::SeekableReadStream *sf = file->_value.createReadStream();
+		Common::SeekableReadStream *sf = file->_value.createUnmappedReadStream();
 		return Common::wrapCompressedReadStream(sf);
 	}
 }
 
-Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String &filename, bool compress) {
+bool DefaultSaveFileManager::prepareForSaving(const Common::String &filename, Common::FSNode &fileNode) {
 	// Assure the savefile name cache is up-to-date.
 	const Common::Path savePathName = getSavePath();
 	assureCached(savePathName);
 	if (getError().getCode() != Common::kNoError)
-		return nullptr;
+		return false;
 
 	for (const auto &lockedFile : _lockedFiles) {
 		if (filename == lockedFile) {
-			return nullptr; // file is locked, no saving available
+			return false; // file is locked, no saving available
 		}
 	}
 
+	// Don't let an older version of the file still being written overwrite this one
+	waitForSave(filename);
+
 #ifdef USE_CLOUD
 	// Update file's timestamp
 	Common::HashMap<Common::String, uint32> timestamps = loadTimestamps();
@@ -151,9 +282,10 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 	saveTimestamps(timestamps);
 #endif
 
+	invalidateMetadata(filename);
+
 	// Obtain node.
 	SaveFileCache::const_iterator file = _saveFileCache.find(filename);
-	Common::FSNode fileNode;
 
 	// If the file did not exist before, we add it to the cache.
 	if (file == _saveFileCache.end()) {
@@ -163,6 +295,14 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 		fileNode = file->_value;
 	}
 
+	return true;
+}
+
+Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String &filename, bool compress) {
+	Common::FSNode fileNode;
+	if (!prepareForSaving(filename, fileNode))
+		return nullptr;
+
 	// Open the file for saving.
 	Common::SeekableWriteStream *const sf = fileNode.createWriteStream(false);
 	if (!sf)
@@ -175,12 +315,102 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 	return result;
 }
 
+Common::OutSaveFile *DefaultSaveFileManager::openForBackgroundSaving(const Common::String &filename, bool compress) {
+	Common::FSNode fileNode;
+	if (!prepareForSaving(filename, fileNode))
+		return nullptr;
+
+	// Add file to cache right away, opening it waits until it has been written.
+	_saveFileCache[filename] = Common::FSNode(fileNode.getPath());
+
+	return new Common::OutSaveFile(new BackgroundSaveStream(this, filename, fileNode, compress));
+}
+
+void DefaultSaveFileManager::submitSave(const SaveJobPtr &job) {
+	// Saves are written one at a time next to the calling thread
+	if (!_savePool)
+		_savePool = new Common::ThreadPool(2);
+
+	{
+		Common::StackLock lock(_saveMutex);
+		_saveJobs.push_back(job);
+	}
+	_savePool->submit(job.get());
+}
+
+void DefaultSaveFileManager::getSaveJobs(const Common::String &filename, Common::Array<SaveJobPtr> &jobs) {
+	Common::StackLock lock(_saveMutex);
+	for (const auto &job : _saveJobs) {
+		if (filename.empty() || job->_filename.equalsIgnoreCase(filename))
+			jobs.push_back(job);
+	}
+}
+
+void DefaultSaveFileManager::collectSaves() {
+	Common::Array<SaveJobPtr> finished;
+	{
+		Common::StackLock lock(_saveMutex);
+		for (uint i = 0; i < _saveJobs.size();) {
+			if (_saveJobs[i]->_done) {
+				finished.push_back(_saveJobs[i]);
+				_saveJobs.remove_at(i);
+			} else {
+				++i;
+			}
+		}
+	}
+
+	for (const auto &job : finished) {
+		_savePool->wait(job.get());
+		if (!job->_success) {
+			warning("DefaultSaveFileManager: Failed to write savefile '%s'", job->_filename.c_str());
+			setError(Common::kWritingFailed, Common::String::format("Failed to write savefile '%s'", job->_filename.c_str()));
+			// The file may not exist at all now
+			_cachedDirectory.clear();
+
+			Common::StackLock lock(_saveMutex);
+			_failedSaves.push_back(job->_filename);
+		}
+	}
+}
+
+void DefaultSaveFileManager::waitForSave(const Common::String &filename) {
+	// The pool can't be waited on with the mutex held, as the jobs take it
+	// when they finish
+	Common::Array<SaveJobPtr> jobs;
+	getSaveJobs(filename, jobs);
+	for (const auto &job : jobs)
+		_savePool->wait(job.get());
+	collectSaves();
+}
+
+bool DefaultSaveFileManager::isSaving(const Common::String &filename) {
+	collectSaves();
+
+	Common::Array<SaveJobPtr> jobs;
+	getSaveJobs(filename, jobs);
+	return !jobs.empty();
+}
+
+bool DefaultSaveFileManager::waitForSaves(Common::StringArray *failedSaves) {
+	waitForSave(Common::String());
+
+	Common::StackLock lock(_saveMutex);
+	const bool success = _failedSaves.empty();
+	if (failedSaves)
+		failedSaves->push_back(_failedSaves);
+	_failedSaves.clear();
+	return success;
+}
+
 bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
 		return false;
 
+	waitForSave(filename);
+
 #ifdef USE_CLOUD
 	// Update file's timestamp
 	Common::HashMap<Common::String, uint32> timestamps = loadTimestamps();
@@ -191,6 +421,8 @@ bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
 	}
 #endif
 
+	invalidateMetadata(filename);
+
 	// Obtain node if exists.
 	SaveFileCache::const_iterator file = _saveFileCache.find(filename);
 	if (file == _saveFileCache.end()) {
@@ -235,6 +467,181 @@ bool DefaultSaveFileManager::exists(const Common::String &filename) {
 	return _saveFileCache.contains(filename);
 }
 
+Common::SeekableReadStream *DefaultSaveFileManager::openMetadata(const Common::String &filename) {
+	if (!exists(filename))
+		return nullptr;
+
+	for (const auto &lockedFile : _lockedFiles) {
+		if (filename == lockedFile)
+			return nullptr;
+	}
+
+	MetadataIndex &index = loadMetadataIndex(getMetadataIndexName(filename));
+	SaveMetadataMap::iterator entry = index.entries.find(filename);
+	if (entry == index.entries.end())
+		return nullptr;
+
+	// Catch save files which were changed without going through the save
+	// file manager, e.g. by copying them over by hand
+	uint32 fileSize, modificationTime;
+	if (!getFileStamp(filename, fileSize, modificationTime) ||
+		entry->_value.fileSize != fileSize || entry->_value.modificationTime != modificationTime) {
+		index.entries.erase(entry);
+		index.dirty = true;
+		return nullptr;
+	}
+
+	const uint32 size = entry->_value.data.size();
+	byte *data = (byte *)malloc(size);
+	if (!data)
+		return nullptr;
+	memcpy(data, entry->_value.data.data(), size);
+	return new Common::MemoryReadStream(data, size, DisposeAfterUse::YES);
+}
+
+void DefaultSaveFileManager::setMetadata(const Common::String &filename, const byte *data, uint32 size) {
+	uint32 fileSize, modificationTime;
+	if (!getFileStamp(filename, fileSize, modificationTime) || !fileSize)
+		return;
+
+	MetadataIndex &index = loadMetadataIndex(getMetadataIndexName(filename));
+	SaveMetadata &entry = index.entries[filename];
+	entry.fileSize = fileSize;
+	entry.modificationTime = modificationTime;
+	entry.data.resize(size);
+	if (size)
+		memcpy(entry.data.data(), data, size);
+	index.dirty = true;
+}
+
+void DefaultSaveFileManager::flushMetadata() {
+	for (auto &index : _metadataIndexes) {
+		if (index._value.dirty)
+			saveMetadataIndex(index._key, index._value);
+	}
+}
+
+void DefaultSaveFileManager::invalidateMetadata(const Common::String &filename) {
+	MetadataIndex &index = loadMetadataIndex(getMetadataIndexName(filename));
+	SaveMetadataMap::iterator entry = index.entries.find(filename);
+	if (entry == index.entries.end())
+		return;
+
+	// Write the index right away, the game may well quit before anything else
+	// gets around to it
+	index.entries.erase(entry);
+	saveMetadataIndex(getMetadataIndexName(filename), index);
+}
+
+Common::String DefaultSaveFileManager::getMetadataIndexName(const Common::String &filename) {
+	const size_t dot = filename.findLastOf('.');
+	return (dot == Common::String::npos || dot == 0) ? filename : filename.substr(0, dot);
+}
+
+DefaultSaveFileManager::MetadataIndex &DefaultSaveFileManager::loadMetadataIndex(const Common::String &indexName) {
+	const Common::Path savePath = getSavePath();
+	if (savePath != _metadataDirectory) {
+		flushMetadata();
+		_metadataIndexes.clear();
+		_metadataDirectory = savePath;
+	}
+
+	MetadataIndexMap::iterator i = _metadataIndexes.find(indexName);
+	if (i != _metadataIndexes.end())
+		return i->_value;
+
+	MetadataIndex &index = _metadataIndexes[indexName];
+
+	const Common::FSNode node(savePath.join(METADATA_DIRNAME).join(indexName + ".idx"));
+	if (!node.exists())
+		return index;
+
+	Common::ScopedPtr<Common::SeekableReadStream> in(node.createUnmappedReadStream());
+	if (!in || in->readUint32BE() != kMetadataIndexTag || in->readUint32LE() != kMetadataIndexVersion)
+		return index;
+
+	const uint32 count = in->readUint32LE();
+	for (uint32 n = 0; n < count; ++n) {
+		const uint32 nameSize = in->readUint32LE();
+		const Common::String name = in->readString(0, nameSize);
+		SaveMetadata entry;
+		entry.fileSize = in->readUint32LE();
+		entry.modificationTime = in->readUint32LE();
+		const uint32 size = in->readUint32LE();
+		if (in->err() || in->eos() || size > in->size() - in->pos())
+			break;
+		entry.data.resize(size);
+		if (size && in->read(entry.data.data(), size) != size)
+			break;
+		index.entries[name] = entry;
+	}
+
+	return index;
+}
+
+void DefaultSaveFileManager::saveMetadataIndex(const Common::String &indexName, MetadataIndex &index) {
+	index.dirty = false;
+
+	const Common::FSNode dir(_metadataDirectory.join(METADATA_DIRNAME));
+	const Common::FSNode node(dir.getChild(indexName + ".idx"));
+	if (index.entries.empty()) {
+		if (node.exists())
+			removeFile(node);
+		return;
+	}
+
+	if (!dir.exists() && !dir.createDirectory()) {
+		warning("DefaultSaveFileManager: Failed to create directory '%s'", dir.getPath().toString(Common::Path::kNativeSeparator).c_str());
+		return;
+	}
+
+	Common::ScopedPtr<Common::SeekableWriteStream> out(node.createWriteStream());
+	if (!out) {
+		warning("DefaultSaveFileManager: Failed to write '%s'", node.getPath().toString(Common::Path::kNativeSeparator).c_str());
+		return;
+	}
+
+	out->writeUint32BE(kMetadataIndexTag);
+	out->writeUint32LE(kMetadataIndexVersion);
+	out->writeUint32LE(index.entries.size());
+	for (const auto &entry : index.entries) {
+		out->writeUint32LE(entry._key.size());
+		out->writeString(entry._key);
+		out->writeUint32LE(entry._value.fileSize);
+		out->writeUint32LE(entry._value.modificationTime);
+		out->writeUint32LE(entry._value.data.size());
+		out->write(entry._value.data.data(), entry._value.data.size());
+	}
+	out->finalize();
+}
+
+bool DefaultSaveFileManager::getFileStamp(const Common::String &filename, uint32 &size, uint32 &modificationTime) {
+	// Assure the savefile name cache is up-to-date.
+	assureCached(getSavePath());
+	if (getError().getCode() != Common::kNoError)
+		return false;
+
+	waitForSave(filename);
+
+	SaveFileCache::const_iterator file = _saveFileCache.find(filename);
+	if (file == _saveFileCache.end())
+		return false;
+
+	modificationTime = file->_value.getModificationTime();
+	const int64 fileSize = file->_value.getFileSize();
+	if (fileSize >= 0) {
+		size = (uint32)fileSize;
+		return true;
+	}
+
+	// The file system can't tell the size without opening the file
+	Common::ScopedPtr<Common::SeekableReadStream> sf(file->_value.createUnmappedReadStream());
+	if (!sf)
+		return false;
+	size = sf->size();
+	return true;
+}
+
 Common::Path DefaultSaveFileManager::getSavePath() const {
 
 	Common::Path dir;
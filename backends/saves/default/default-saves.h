@@ -27,6 +27,12 @@
 #include "common/str.h"
 #include "common/fs.h"
 #include "common/hash-str.h"
+#include "common/mutex.h"
+#include "common/ptr.h"
+
+namespace Common {
+class ThreadPool;
+}
 
 /**
  * Provides a default savefile manager implementation for common platforms.
@@ -35,14 +41,21 @@ class DefaultSaveFileManager : public Common::SaveFileManager {
 public:
 	DefaultSaveFileManager();
 	DefaultSaveFileManager(const Common::Path &defaultSavepath);
+	~DefaultSaveFileManager() override;
 
 	void updateSavefilesList(Common::StringArray &lockedFiles) override;
 	Common::StringArray listSavefiles(const Common::String &pattern) override;
 	Common::InSaveFile *openRawFile(const Common::String &filename) override;
 	Common::InSaveFile *openForLoading(const Common::String &filename) override;
 	Common::OutSaveFile *openForSaving(const Common::String &filename, bool compress = true) override;
+	Common::OutSaveFile *openForBackgroundSaving(const Common::String &filename, bool compress = true) override;
+	bool isSaving(const Common::String &filename = Common::String()) override;
+	bool waitForSaves(Common::StringArray *failedSaves = nullptr) override;
 	bool removeSavefile(const Common::String &filename) override;
 	bool exists(const Common::String &filename) override;
+	Common::SeekableReadStream *openMetadata(const Common::String &filename) override;
+	void setMetadata(const Common::String &filename, const byte *data, uint32 size) override;
+	void flushMetadata() override;
 
 #ifdef USE_CLOUD
 
@@ -55,6 +68,8 @@ public:
 
 	static Common::Path concatWithSavesPath(Common::String name);
 
+	static const char *const METADATA_DIRNAME;
+
 protected:
 	/**
 	 * Get the path to the savegame directory.
@@ -99,7 +114,95 @@ protected:
 	 */
 	Common::StringArray _lockedFiles;
 
+	/**
+	 * Discards the metadata stored for the given file, because it is about
+	 * to change. This is called from openForSaving() and removeSavefile().
+	 */
+	void invalidateMetadata(const Common::String &filename);
+
+	/**
+	 * Waits until any data still being written to the given file in the
+	 * background is on disk. This is called before accessing a save file.
+	 */
+	void waitForSave(const Common::String &filename);
+
 private:
+	class SaveJob;
+	class BackgroundSaveStream;
+	typedef Common::SharedPtr<SaveJob> SaveJobPtr;
+
+	/**
+	 * Does the checks shared by openForSaving() and openForBackgroundSaving(),
+	 * and obtains the node of the file to save to.
+	 */
+	bool prepareForSaving(const Common::String &filename, Common::FSNode &fileNode);
+
+	void submitSave(const SaveJobPtr &job);
+
+	/**
+	 * Gets the background saves of the given file, or all of them if the
+	 * name is empty.
+	 */
+	void getSaveJobs(const Common::String &filename, Common::Array<SaveJobPtr> &jobs);
+
+	/**
+	 * Deletes the background saves which have finished, and reports those
+	 * which failed.
+	 */
+	void collectSaves();
+
+	Common::ThreadPool *_savePool;
+
+	/**
+	 * Saves being written in the background, and the names of those which
+	 * failed since the last waitForSaves(). Both are guarded by _saveMutex,
+	 * as are the results of the jobs. The streams the jobs were written to
+	 * keep them around until err() has been checked.
+	 */
+	Common::Array<SaveJobPtr> _saveJobs;
+	Common::StringArray _failedSaves;
+	Common::Mutex _saveMutex;
+
+	struct SaveMetadata {
+		uint32 fileSize;			///< Size of the save file the metadata was stored for
+		uint32 modificationTime;	///< Modification time of the save file, 0 if not known
+		Common::Array<byte> data;
+	};
+
+	typedef Common::HashMap<Common::String, SaveMetadata, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> SaveMetadataMap;
+
+	/**
+	 * Metadata is kept in one index file per game, which is named after the
+	 * part of the save file names in front of the extension.
+	 */
+	struct MetadataIndex {
+		SaveMetadataMap entries;
+		bool dirty;
+
+		MetadataIndex() : dirty(false) {}
+	};
+
+	typedef Common::HashMap<Common::String, MetadataIndex, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> MetadataIndexMap;
+
+	static Common::String getMetadataIndexName(const Common::String &filename);
+	MetadataIndex &loadMetadataIndex(const Common::String &indexName);
+	void saveMetadataIndex(const Common::String &indexName, MetadataIndex &index);
+
+	/**
+	 * Get the size and modification time of a save file, which tell whether
+	 * its stored metadata is still valid. The file is only opened when the
+	 * file system can't tell its size.
+	 */
+	bool getFileStamp(const Common::String &filename, uint32 &size, uint32 &modificationTime);
+
+	MetadataIndexMap _metadataIndexes;
+
+	/**
+	 * The save directory the loaded metadata indexes belong to.
+	 */
+	Common::Path _metadataDirectory;
+
+
 	/**
 	 * The currently cached directory.
 	 */
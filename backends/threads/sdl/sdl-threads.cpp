@@ -0,0 +1,129 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#if defined(SDL_BACKEND)
+
+#include "backends/threads/sdl/sdl-threads.h"
+#include "backends/platform/sdl/sdl-sys.h"
+
+/**
+ * SDL thread implementation
+ */
+class SdlThreadInternal final : public Common::ThreadInternal {
+public:
+	SdlThreadInternal(Common::ThreadProc proc, void *param) : _proc(proc), _param(param), _thread(nullptr) {}
+	~SdlThreadInternal() override { assert(!_thread); }
+
+	bool start(const char *name) {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+		_thread = SDL_CreateThread(threadStart, name, this);
+#else
+		_thread = SDL_CreateThread(threadStart, this);
+#endif
+		return _thread != nullptr;
+	}
+
+	void join() override {
+		if (_thread) {
+			SDL_WaitThread(_thread, nullptr);
+			_thread = nullptr;
+		}
+	}
+
+private:
+	static int SDLCALL threadStart(void *arg) {
+		SdlThreadInternal *thread = static_cast<SdlThreadInternal *>(arg);
+		thread->_proc(thread->_param);
+		return 0;
+	}
+
+	Common::ThreadProc _proc;
+	void *_param;
+	SDL_Thread *_thread;
+};
+
+/**
+ * SDL semaphore implementation
+ */
+class SdlSemaphoreInternal final : public Common::SemaphoreInternal {
+public:
+	SdlSemaphoreInternal(uint initialValue) { _sem = SDL_CreateSemaphore(initialValue); }
+	~SdlSemaphoreInternal() override { SDL_DestroySemaphore(_sem); }
+
+	bool isValid() const { return _sem != nullptr; }
+
+	void wait() override {
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+		SDL_WaitSemaphore(_sem);
+#else
+		SDL_SemWait(_sem);
+#endif
+	}
+	void post() override {
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+		SDL_SignalSemaphore(_sem);
+#else
+		SDL_SemPost(_sem);
+#endif
+	}
+
+private:
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+	SDL_Semaphore *_sem;
+#else
+	SDL_sem *_sem;
+#endif
+};
+
+Common::ThreadInternal *createSdlThreadInternal(Common::ThreadProc proc, void *param, const char *name) {
+	SdlThreadInternal *thread = new SdlThreadInternal(proc, param);
+	if (!thread->start(name)) {
+		warning("Failed to create thread: %s", SDL_GetError());
+		delete thread;
+		return nullptr;
+	}
+	return thread;
+}
+
+Common::SemaphoreInternal *createSdlSemaphoreInternal(uint initialValue) {
+	SdlSemaphoreInternal *sem = new SdlSemaphoreInternal(initialValue);
+	if (!sem->isValid()) {
+		warning("Failed to create semaphore: %s", SDL_GetError());
+		delete sem;
+		return nullptr;
+	}
+	return sem;
+}
+
+uint getSdlCPUCoreCount() {
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+	int count = SDL_GetNumLogicalCPUCores();
+#elif SDL_VERSION_ATLEAST(2, 0, 0)
+	int count = SDL_GetCPUCount();
+#else
+	int count = 1;
+#endif
+	return count > 0 ? count : 1;
+}
+
+#endif
@@ -155,6 +155,8 @@ static const char HELP_STRING4[] =
 	"  -r, --speech-volume=NUM  Set the speech volume, 0-255 (default: 192)\n"
 	"  --midi-gain=NUM          Set the gain for MIDI playback, 0-1000 (default:\n"
 	"                           100) (only supported by some MIDI drivers)\n"
+	"  --midi-render-ahead=NUM  Generate MT-32 emulator and FluidSynth output NUM\n"
+	"                           milliseconds ahead on a separate thread (default: 0)\n"
 	"  -n, --subtitles          Enable subtitles (use with games that have voice)\n"
 	"  -b, --boot-param=NUM     Pass number to the boot script (boot param)\n"
 	"  -d, --debuglevel=NUM     Set debug verbosity level\n"
@@ -204,8 +206,11 @@ static const char HELP_STRING4[] =
 	"                           atari, macintosh, macintoshbw, vgaGray)\n"
 #ifdef ENABLE_EVENTRECORDER
 	"  --record-mode=MODE       Specify record mode for event recorder (record, playback,\n"
-	"                           fast_playback, info, update, passthrough [default])\n"
+	"                           fast_playback, benchmark, info, update, passthrough [default])\n"
 	"  --record-file-name=FILE  Specify record file name\n"
+	"  --record-benchmark-file=FILE\n"
+	"                           Write the frame timings measured in benchmark mode to FILE\n"
+	"                           (default: record file name with .json appended)\n"
 	"  --disable-display        Disable any gfx output. Used for headless events\n"
 	"                           playback by Event Recorder\n"
 	"  --screenshot-period=NUM  When recording, trigger a screenshot every NUM milliseconds\n"
@@ -329,6 +334,7 @@ void registerDefaults() {
 	ConfMan.registerDefault("dump_midi", false);
 	ConfMan.registerDefault("enable_gs", false);
 	ConfMan.registerDefault("midi_gain", 100);
+	ConfMan.registerDefault("midi_render_ahead", 0);
 
 	ConfMan.registerDefault("music_driver", "auto");
 	ConfMan.registerDefault("mt32_device", "null");
@@ -823,6 +829,9 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 			DO_LONG_OPTION("record-file-name")
 			END_OPTION
 
+			DO_LONG_OPTION("record-benchmark-file")
+			END_OPTION
+
 			DO_LONG_COMMAND("list-records")
 			END_COMMAND
 
@@ -874,6 +883,9 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 			DO_LONG_OPTION_INT("midi-gain")
 			END_OPTION
 
+			DO_LONG_OPTION_INT("midi-render-ahead")
+			END_OPTION
+
 			DO_OPTION_BOOL('u', "dump-scripts")
 			END_OPTION
 
@@ -2294,6 +2306,7 @@ bool processSettings(Common::String &command, Common::StringMap &settings, Commo
 		"sfx-volume",
 		"speech-volume",
 		"midi-gain",
+		"midi-render-ahead",
 		"subtitles",
 		"savepath",
 		"extrapath",
@@ -68,6 +68,8 @@
 #endif
 #include "graphics/scalerplugin.h"
 
+#include "image/codecs/dither.h"
+
 #include "backends/keymapper/action.h"
 #include "backends/keymapper/keymap.h"
 #include "backends/keymapper/keymapper.h"
@@ -316,6 +318,9 @@ static Common::Error runGame(const Plugin *enginePlugin, OSystem &system, const
 	// Run the engine
 	Common::Error result = engine->run();
 
+	// Finish writing the saves made in the background
+	engine->waitForSaves();
+
 	// Make sure we do not return to the launcher if this is not possible.
 	if (!engine->hasFeature(Engine::kSupportsReturnToLauncher))
 		ConfMan.setBool("gui_return_to_launcher_at_exit", false, Common::ConfigManager::kTransientDomain);
@@ -791,6 +796,10 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 			} else if (recordMode == "fast_playback") {
 				g_eventRec.init(recordFileName, GUI::EventRecorder::kRecorderPlayback);
 				g_eventRec.setFastPlayback(true);
+			} else if (recordMode == "benchmark") {
+				g_eventRec.init(recordFileName, GUI::EventRecorder::kRecorderPlayback);
+				g_eventRec.setFastPlayback(true);
+				g_eventRec.setBenchmark(ConfMan.hasKey("record_benchmark_file") ? ConfMan.get("record_benchmark_file") : recordFileName + ".json");
 			} else if ((recordMode == "info") && (!recordFileName.empty())) {
 				Common::PlaybackFile record;
 				record.openRead(recordFileName);
@@ -920,6 +929,7 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 #endif
 	EngineManager::destroy();
 	Graphics::YUVToRGBManager::destroy();
+	Image::QuickTimeDitherTableCache::destroy();
 
 	return 0;
 }
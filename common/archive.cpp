@@ -22,12 +22,15 @@
 #include "common/archive.h"
 #include "common/file.h"
 #include "common/fs.h"
+#include "common/mutex.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 #include "common/memstream.h"
 #include "common/punycode.h"
 #include "common/debug.h"
 
+#include <atomic>
+
 namespace Common {
 
 ArchiveMember::~ArchiveMember() {
@@ -41,6 +44,10 @@ bool ArchiveMember::isInMacArchive() const {
 	return false;
 }
 
+uint32 ArchiveMember::getModificationTime() const {
+	return 0;
+}
+
 bool ArchiveMember::isDirectory() const {
 	return false;
 }
@@ -308,6 +315,44 @@ uint MemcachingCaseInsensitiveArchive::CacheKey_Hash::operator()(const CacheKey
 	return static_cast<uint>(x.path.hashIgnoreCase() * 1000003u) ^ static_cast<uint>(x.altStreamType);
 }
 
+// Incremented whenever the archives of any search set change. As search sets
+// can contain each other, this invalidates the lookups of all of them.
+static std::atomic<uint32> lookupGeneration(0);
+
+// Guards the lookup caches of all search sets. It is only created once there
+// is a backend to create it, and until then there is only one thread.
+static std::atomic<Mutex *> lookupMutex(nullptr);
+
+namespace {
+
+class LookupLock {
+	Mutex *_mutex;
+
+public:
+	LookupLock() : _mutex(lookupMutex) {
+		if (!_mutex && g_system) {
+			Mutex *mutex = new Mutex();
+			if (lookupMutex.compare_exchange_strong(_mutex, mutex))
+				_mutex = mutex;
+			else
+				delete mutex;
+		}
+		if (_mutex)
+			_mutex->lock();
+	}
+
+	~LookupLock() {
+		if (_mutex)
+			_mutex->unlock();
+	}
+};
+
+} // End of anonymous namespace
+
+void SearchSet::invalidateLookupCaches() {
+	lookupGeneration++;
+}
+
 SearchSet::ArchiveNodeList::iterator SearchSet::find(const String &name) {
 	ArchiveNodeList::iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
@@ -338,6 +383,7 @@ void SearchSet::insert(const Node &node) {
 			break;
 	}
 	_list.insert(it, node);
+	invalidateLookupCaches();
 }
 
 void SearchSet::add(const String &name, Archive *archive, int priority, bool autoFree) {
@@ -434,6 +480,7 @@ void SearchSet::remove(const String &name) {
 		if (it->_autoFree)
 			delete it->_arc;
 		_list.erase(it);
+		invalidateLookupCaches();
 	}
 }
 
@@ -457,6 +504,7 @@ void SearchSet::clear() {
 	}
 
 	_list.clear();
+	invalidateLookupCaches();
 }
 
 void SearchSet::setPriority(const String &name, int priority) {
@@ -475,16 +523,74 @@ void SearchSet::setPriority(const String &name, int priority) {
 	insert(node);
 }
 
+uint32 SearchSet::getLookup(const Path &path, Lookup &result) const {
+	// Engines probing for many different files mustn't make the cache grow without bounds
+	const uint kMaxLookupCacheSize = 4096;
+
+	LookupLock lock;
+
+	const uint32 generation = lookupGeneration;
+	if (_lookupCacheGeneration != generation || _lookupCache.size() >= kMaxLookupCacheSize) {
+		_lookupCache.clear(true);
+		_lookupCacheGeneration = generation;
+	}
+
+	LookupCache::const_iterator it = _lookupCache.find(path);
+	if (it != _lookupCache.end()) {
+		result = it->_value;
+	} else {
+		result._file = nullptr;
+		result._stream = nullptr;
+		result._known = 0;
+	}
+	return generation;
+}
+
+void SearchSet::setLookup(const Path &path, const Lookup &result, uint32 generation) const {
+	LookupLock lock;
+
+	if (_lookupCacheGeneration != generation || lookupGeneration != generation)
+		return;
+
+	// Another thread may have looked up something else about the path meanwhile
+	LookupCache::iterator it = _lookupCache.find(path);
+	if (it == _lookupCache.end()) {
+		_lookupCache[path] = result;
+		return;
+	}
+
+	Lookup &cached = it->_value;
+	if (result._known & kLookupFile)
+		cached._file = result._file;
+	if (result._known & kLookupStream)
+		cached._stream = result._stream;
+	cached._known |= result._known;
+}
+
+Archive *SearchSet::findFile(const Path &path) const {
+	Lookup result;
+	const uint32 generation = getLookup(path, result);
+
+	if (!(result._known & kLookupFile)) {
+		result._file = nullptr;
+		for (const auto &archive : _list) {
+			if (archive._arc->hasFile(path)) {
+				result._file = archive._arc;
+				break;
+			}
+		}
+		result._known |= kLookupFile;
+		setLookup(path, result, generation);
+	}
+
+	return result._file;
+}
+
 bool SearchSet::hasFile(const Path &path) const {
 	if (path.empty())
 		return false;
 
-	for (const auto &archive : _list) {
-		if (archive._arc->hasFile(path))
-			return true;
-	}
-
-	return false;
+	return findFile(path) != nullptr;
 }
 
 bool SearchSet::isPathDirectory(const Path &path) const {
@@ -559,16 +665,14 @@ const ArchiveMemberPtr SearchSet::getMember(const Path &path, Archive **containe
 	if (path.empty())
 		return ArchiveMemberPtr();
 
-	for (const auto &archive : _list) {
-		if (archive._arc->hasFile(path)) {
-			if (container) {
-				*container = archive._arc;
-			}
-			return archive._arc->getMember(path);
-		}
-	}
+	Archive *archive = findFile(path);
+	if (!archive)
+		return ArchiveMemberPtr();
+
+	if (container)
+		*container = archive;
 
-	return ArchiveMemberPtr();
+	return archive->getMember(path);
 }
 
 const ArchiveMemberPtr SearchSet::getMember(const Path &path) const {
@@ -579,13 +683,36 @@ SeekableReadStream *SearchSet::createReadStreamForMember(const Path &path) const
 	if (path.empty())
 		return nullptr;
 
-	for (const auto &archive : _list) {
-		SeekableReadStream *stream = archive._arc->createReadStreamForMember(path);
+	Lookup result;
+	const uint32 generation = getLookup(path, result);
+
+	if (result._known & kLookupStream) {
+		if (!result._stream)
+			return nullptr;
+
+		SeekableReadStream *stream = result._stream->createReadStreamForMember(path);
 		if (stream)
 			return stream;
+
+		// The file couldn't be opened this time, so look through all of the archives again
 	}
 
-	return nullptr;
+	SeekableReadStream *stream = nullptr;
+	result._stream = nullptr;
+
+	for (const auto &archive : _list) {
+		stream = archive._arc->createReadStreamForMember(path);
+		if (stream) {
+			result._stream = archive._arc;
+			break;
+		}
+	}
+
+	// The lookup isn't kept if archives which are search sets themselves changed meanwhile
+	result._known |= kLookupStream;
+	setLookup(path, result, generation);
+
+	return stream;
 }
 
 SeekableReadStream *SearchSet::createReadStreamForMemberAltStream(const Path &path, AltStreamType altStreamType) const {
@@ -624,6 +751,11 @@ SearchManager::SearchManager() {
 	clear(); // Force a reset
 }
 
+SearchManager::~SearchManager() {
+	// SearchMan is the last search set to go away at exit
+	delete lookupMutex.exchange(nullptr);
+}
+
 void SearchManager::clear() {
 	SearchSet::clear();
 
@@ -83,6 +83,7 @@ public:
 	virtual void listChildren(ArchiveMemberList &childList, const char *pattern = nullptr) const; /*!< Adds the immediate children of this archive member to childList, optionally matching a pattern. */
 	virtual U32String getDisplayName() const; /*!< Get the display name of the archive member. */
 	virtual bool isInMacArchive() const; /*!< Checks if the ArchiveMember is in a Mac archive, in which case resource forks and Finder info can only be loaded via alt streams. */
+	virtual uint32 getModificationTime() const; /*!< Get the time the archive member was last modified, in seconds since the Unix epoch, or 0 if it is not known. */
 };
 
 struct ArchiveMemberDetails {
@@ -347,8 +348,40 @@ class SearchSet : public Archive {
 
 	bool _ignoreClashes;
 
+	/**
+	 * The archives found for a path looked up before. A null archive means that
+	 * none of the archives has it. The cache is only accessed under a lock, as
+	 * search sets are used from more than one thread.
+	 */
+	struct Lookup {
+		Archive *_file;		//!< First archive which has the file, if known
+		Archive *_stream;	//!< First archive which opened a stream for the file, if known
+		byte _known;
+	};
+	enum {
+		kLookupFile = 1 << 0,
+		kLookupStream = 1 << 1
+	};
+	typedef HashMap<Path, Lookup, Path::IgnoreCase_Hash, Path::IgnoreCase_EqualTo> LookupCache;
+	mutable LookupCache _lookupCache;
+	mutable uint32 _lookupCacheGeneration;
+
+	/**
+	 * Copy the lookup of path to result, and return the generation it belongs
+	 * to. Nothing is known yet for paths which weren't looked up before.
+	 */
+	uint32 getLookup(const Path &path, Lookup &result) const;
+
+	/**
+	 * Remember what was found out about path, unless the archives changed
+	 * since getLookup() returned generation.
+	 */
+	void setLookup(const Path &path, const Lookup &result, uint32 generation) const;
+
+	Archive *findFile(const Path &path) const;
+
 public:
-	SearchSet() : _ignoreClashes(false) { }
+	SearchSet() : _ignoreClashes(false), _lookupCacheGeneration(0) { }
 	virtual ~SearchSet() { clear(); }
 
 	char getPathSeparator() const override { return '/'; }
@@ -476,6 +509,19 @@ public:
 	 */
 	void setIgnoreClashes(bool ignoreClashes) { _ignoreClashes = ignoreClashes; }
 
+	/**
+	 * Forget which archives files were found in, or not found in, by all
+	 * search sets. This must be called when files are added to or removed
+	 * from an archive which is part of a search set.
+	 *
+	 * Adding, removing and reprioritising archives of a search set already
+	 * does this, as do changes to search sets nested in it. Archives which
+	 * read their list of members once, like FSDirectory and the compressed
+	 * archive formats, don't need it either. It is for archives which gain
+	 * members after being added, like in-memory resource stores.
+	 */
+	static void invalidateLookupCaches();
+
 	bool getChildren(const Common::Path &path, Common::Array<Common::String> &list, ListMode mode = kListDirectoriesOnly, bool hidden = true) const override;
 };
 
@@ -492,6 +538,7 @@ public:
 private:
 	friend class Singleton<SingletonBaseType>;
 	SearchManager();
+	~SearchManager();
 };
 
 /** Shortcut for accessing the Search Manager. */
@@ -40,6 +40,7 @@ public:
 	String getFileName() const override;
 	U32String getDisplayName() const override;
 	bool isDirectory() const override;
+	uint32 getModificationTime() const override;
 	void listChildren(ArchiveMemberList &list, const char *pattern) const override;
 
 private:
@@ -79,6 +80,10 @@ bool FSDirectoryFile::isDirectory() const {
 	return _fsNode.isDirectory();
 }
 
+uint32 FSDirectoryFile::getModificationTime() const {
+	return _fsNode.getModificationTime();
+}
+
 void FSDirectoryFile::listChildren(ArchiveMemberList &list, const char *pattern) const {
 	// We don't check for includeDirectories in the parent archive to determine the list mode here because it is implicit,
 	// i.e. if includeDirectories was set false, then this file isn't a directory in the first place.
@@ -233,6 +238,14 @@ bool FSNode::isWritable() const {
 	return _realNode && _realNode->isWritable();
 }
 
+uint32 FSNode::getModificationTime() const {
+	return _realNode ? _realNode->getModificationTime() : 0;
+}
+
+int64 FSNode::getFileSize() const {
+	return _realNode ? _realNode->getFileSize() : -1;
+}
+
 SeekableReadStream *FSNode::createReadStream() const {
 	if (_realNode == nullptr)
 		return nullptr;
@@ -248,6 +261,21 @@ SeekableReadStream *FSNode::createReadStream() const {
 	return _realNode->createReadStream();
 }
 
+SeekableReadStream *FSNode::createUnmappedReadStream() const {
+	if (_realNode == nullptr)
+		return nullptr;
+
+	if (!_realNode->exists()) {
+		warning("FSNode::createUnmappedReadStream: '%s' does not exist", getName().c_str());
+		return nullptr;
+	} else if (_realNode->isDirectory()) {
+		warning("FSNode::createUnmappedReadStream: '%s' is a directory", getName().c_str());
+		return nullptr;
+	}
+
+	return _realNode->createUnmappedReadStream();
+}
+
 SeekableReadStream *FSNode::createReadStreamForAltStream(AltStreamType altStreamType) const {
 	if (_realNode == nullptr)
 		return nullptr;
@@ -331,7 +359,10 @@ FSNode FSDirectory::getFSNode() const {
 FSNode *FSDirectory::lookupCache(NodeCache &cache, const Path &name) const {
 	// make caching as lazy as possible
 	if (!name.empty()) {
-		ensureCached();
+		if (_flat)
+			ensureCached();
+		else
+			ensureDirectoryCached(name.getParent());
 
 		if (cache.contains(name))
 			return &cache[name];
@@ -466,10 +497,92 @@ void FSDirectory::cacheDirectoryRecursive(FSNode node, int depth, const Path& pr
 
 }
 
+void FSDirectory::cacheDirectory(const FSNode &node, int depth, const Path &prefix, bool recursive) const {
+	if (depth <= 0)
+		return;
+
+	if (!_listedDirs.contains(prefix)) {
+		_listedDirs[prefix] = true;
+
+		FSList list;
+		node.getChildren(list, FSNode::kListAll);
+
+		// Make sure the directory has an entry even when it is empty
+		Array<String> &dirNames = _dirMapCache[prefix];
+
+		for (auto &curNode : list) {
+			Path name = prefix.appendComponent(curNode.getRealName());
+
+			// since the hashmap is case insensitive, we need to check for clashes when caching
+			if (curNode.isDirectory()) {
+				if (_subDirCache.contains(name)) {
+					// Always warn in this case as it's when there are 2 directories at the same place with different case
+					// That means a problem in user installation as lookups are always done case insensitive
+					warning("FSDirectory::cacheDirectory: name clash when building cache, ignoring sub-directory '%s'",
+					        Common::toPrintable(name.toString(Common::Path::kNativeSeparator)).c_str());
+				} else {
+					_subDirCache[name] = curNode;
+					dirNames.push_back(curNode.getRealName());
+				}
+			} else {
+				if (_fileCache.contains(name)) {
+					if (!_ignoreClashes) {
+						warning("FSDirectory::cacheDirectory: name clash when building cache, ignoring file '%s'",
+						        Common::toPrintable(name.toString(Common::Path::kNativeSeparator)).c_str());
+					}
+				} else {
+					_fileCache[name] = curNode;
+					_fileMapCache[prefix].push_back(curNode.getRealName());
+				}
+			}
+		}
+	}
+
+	if (!recursive || depth <= 1)
+		return;
+
+	// Copy the names, as caching the subdirectories adds entries to _dirMapCache
+	const Array<String> dirNames = _dirMapCache[prefix];
+	for (const auto &dirName : dirNames) {
+		Path name = prefix.appendComponent(dirName);
+		cacheDirectory(_subDirCache[name], depth - 1, name, true);
+	}
+}
+
+void FSDirectory::ensureDirectoryCached(const Path &dir) const {
+	if (_cached || !dir.isRelativeTo(_prefix))
+		return;
+
+	// Walk down from the root, only listing the directories on the way
+	FSNode node = _node;
+	Path key = _prefix;
+	int depth = _depth;
+	cacheDirectory(node, depth, key, false);
+
+	const StringArray components = dir.relativeTo(_prefix).splitComponents();
+	for (const auto &component : components) {
+		if (component.empty())
+			continue;
+		if (--depth <= 0)
+			return;
+
+		NodeCache::const_iterator it = _subDirCache.find(key.appendComponent(component));
+		if (it == _subDirCache.end())
+			return;
+
+		key = it->_key;
+		node = it->_value;
+		cacheDirectory(node, depth, key, false);
+	}
+}
+
 void FSDirectory::ensureCached() const  {
 	if (_cached)
 		return;
-	cacheDirectoryRecursive(_node, _depth, _prefix);
+	if (_flat)
+		cacheDirectoryRecursive(_node, _depth, _prefix);
+	else
+		cacheDirectory(_node, _depth, _prefix, true);
 	_cached = true;
 }
 
@@ -477,11 +590,14 @@ bool FSDirectory::getChildren(const Common::Path &path, Common::Array<Common::St
 	if (!_node.isDirectory())
 		return 0;
 
-	// Cache dir data
-	ensureCached();
-
 	Common::Path pathNormalized = path.normalize();
 
+	// Cache dir data
+	if (_flat)
+		ensureCached();
+	else
+		ensureDirectoryCached(pathNormalized);
+
 	int matches = 0;
 
 	if (mode == kListDirectoriesOnly || mode == kListAll) {
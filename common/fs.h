@@ -252,6 +252,20 @@ public:
 	 */
 	bool isWritable() const;
 
+	/**
+	 * Get the time the object referred by this node was last modified.
+	 *
+	 * @return Seconds since the Unix epoch, 0 if the file system can't tell.
+	 */
+	uint32 getModificationTime() const override;
+
+	/**
+	 * Get the size of the file referred by this node, without opening it.
+	 *
+	 * @return The size in bytes, -1 if the file system can't tell.
+	 */
+	int64 getFileSize() const;
+
 	/**
 	 * Create a SeekableReadStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -261,6 +275,15 @@ public:
 	 */
 	SeekableReadStream *createReadStream() const override;
 
+	/**
+	 * Like createReadStream(), but never map the file into memory, so that
+	 * it can be truncated or rewritten while the stream is open. Reads
+	 * past the new end of the file then fail instead of crashing.
+	 *
+	 * @return Pointer to the stream object, nullptr in case of a failure.
+	 */
+	SeekableReadStream *createUnmappedReadStream() const;
+
 	/**
 	 * Create a SeekableReadStream instance corresponding to an alternate stream
 	 * of the file referred by this node. This assumes that the node actually
@@ -356,11 +379,20 @@ class FSDirectory : public Archive {
 	mutable NodeMapCache	_fileMapCache, _dirMapCache;
 	mutable bool _cached;
 
+	// Directories whose children have been cached, used when not flat.
+	// Subdirectories are only listed when something inside them is looked up.
+	typedef HashMap<Path, bool, Path::IgnoreCaseAndMac_Hash, Path::IgnoreCaseAndMac_EqualTo> ListedDirCache;
+	mutable ListedDirCache	_listedDirs;
+
 	// look for a match
 	FSNode *lookupCache(NodeCache &cache, const Path &name) const;
 
 	// cache management
 	void cacheDirectoryRecursive(FSNode node, int depth, const Path& prefix) const;
+	void cacheDirectory(const FSNode &node, int depth, const Path &prefix, bool recursive) const;
+
+	// fill cache for the directory with the given key and the ones leading to it
+	void ensureDirectoryCached(const Path &dir) const;
 
 	// fill cache if not already cached
 	void ensureCached() const;
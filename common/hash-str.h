@@ -30,6 +30,7 @@ namespace Common {
 uint hashit(const char *str);
 uint hashit_lower(const char *str); // Generate a hash based on the lowercase version of the string
 inline uint hashit_lower(const String &str) { return hashit_lower(str.c_str()); }
+uint hashit_lower(const char *str, const char *end); // Same as hashit_lower(str), for the characters up to end
 
 // FIXME: The following functors obviously are not consistently named
 
@@ -51,6 +51,16 @@ uint hashit_lower(const char *p) {
 	return hash ^ size;
 }
 
+uint hashit_lower(const char *p, const char *end) {
+	uint hash = p < end ? tolower(*p) << 7 : 0;
+	int size = 0;
+	while (p < end) {
+		hash = (1000003 * hash) ^ tolower((byte)*p++);
+		size++;
+	}
+	return hash ^ size;
+}
+
 
 template<> void unknownKeyError(::Common::String key) {
 	error("Unknown key \"%s\"", key.c_str());
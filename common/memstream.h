@@ -93,6 +93,9 @@ public:
 	int64 size() const { return _size; }
 
 	bool seek(int64 offs, int whence = SEEK_SET);
+
+	/** Return a pointer to the start of the data of the stream. */
+	const byte *getData() const { return _ptrOrig.get(); }
 };
 
 
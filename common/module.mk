@@ -41,6 +41,7 @@ MODULE_OBJS := \
 	system.o \
 	textconsole.o \
 	text-to-speech.o \
+	threadpool.o \
 	tokenizer.o \
 	translation.o \
 	unicode-bidi.o \
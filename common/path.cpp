@@ -1134,8 +1134,43 @@ struct hasher {
 	uint mult;
 };
 
+bool Path::hasPlainComponents() const {
+	if (isEscaped())
+		return false;
+
+	for (const char *str = _str.c_str(); str; ) {
+		if (strncmp(str, "xn--", 4) == 0)
+			return false;
+		str = strchr(str, SEPARATOR);
+		if (str)
+			str++;
+	}
+	return true;
+}
+
 uint Path::hashIgnoreCaseAndMac() const {
 	hasher v = { 0x345678, 1000003 };
+
+	if (hasPlainComponents()) {
+		// Components don't need decoding: hash them in place, which gives
+		// the same result as below without building a string for each
+		if (_str.empty())
+			return v.result;
+
+		const char *str = _str.c_str();
+		const char *end = str + _str.size();
+		while (true) {
+			const char *sep = strchr(str, SEPARATOR);
+			uint hash = hashit_lower(str, sep ? sep : end);
+
+			v.result = (v.result + hash) * v.mult;
+			v.mult = (v.mult * 69069);
+			if (!sep)
+				return v.result;
+			str = sep + 1;
+		}
+	}
+
 	reduceComponents<hasher &>(
 		[](hasher &value, const String &in, bool last) -> hasher & {
 			uint hash = hashit_lower(getIdentifierComponent(in));
@@ -1159,6 +1194,9 @@ bool Path::equalsIgnoreCase(const Path &other) const {
 }
 
 bool Path::equalsIgnoreCaseAndMac(const Path &other) const {
+	if (hasPlainComponents() && other.hasPlainComponents())
+		return _str.equalsIgnoreCase(other._str);
+
 	return compareComponents(
 		[](const String &x, const String &y) {
 			return getIdentifierComponent(x).equalsIgnoreCase(getIdentifierComponent(y));
@@ -172,6 +172,12 @@ private:
 		return *_str.c_str() == ESCAPE;
 	}
 
+	/**
+	 * Determines if the path components can be compared as they are stored:
+	 * the path is not escaped and none of its components is punycode encoded.
+	 */
+	bool hasPlainComponents() const;
+
 	/**
 	 * Returns the suffix in this path after @p other path
 	 * Returns nullptr if @p other isn't a prefix
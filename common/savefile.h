@@ -201,6 +201,50 @@ public:
 	 */
 	virtual OutSaveFile *openForSaving(const String &name, bool compress = true) = 0;
 
+	/**
+	 * Open the save file with the specified @p name for saving in the background.
+	 *
+	 * The data written to the returned OutSaveFile is kept in memory. Once the
+	 * file is finalized or deleted, the data is compressed and written out on a
+	 * background thread, replacing any previous file of that name only once it
+	 * is complete. Opening the same file again waits until it has been written.
+	 *
+	 * Calling err() on the returned file after finalizing it waits until the
+	 * data has been written, and then also reports whether writing it failed.
+	 * Callers not checking err() do not wait, and only learn about such a
+	 * failure from waitForSaves().
+	 *
+	 * Save file managers without background saving save directly, like
+	 * openForSaving() does.
+	 *
+	 * @param name      Name of the save file.
+	 * @param compress  Whether to compress the resulting save file (default) or not.
+	 *
+	 * @return Pointer to an OutSaveFile, or NULL if an error occurred.
+	 */
+	virtual OutSaveFile *openForBackgroundSaving(const String &name, bool compress = true) { return openForSaving(name, compress); }
+
+	/**
+	 * Check whether a save file opened with openForBackgroundSaving() is still
+	 * being written.
+	 *
+	 * @param name  Name of the save file, or an empty string to check for any save file.
+	 *
+	 * @return True if the save file has not been completely written yet.
+	 */
+	virtual bool isSaving(const String &name = String()) { return false; }
+
+	/**
+	 * Wait until all save files opened with openForBackgroundSaving() have
+	 * been written.
+	 *
+	 * @param failedSaves  If given, the names of the save files which failed
+	 *                     to be written since the last call are added to it.
+	 *
+	 * @return False if writing any of them failed since the last call.
+	 */
+	virtual bool waitForSaves(StringArray *failedSaves = nullptr) { return true; }
+
 	/**
 	 * Open the file with the specified @p name in the given directory for loading.
 	 *
@@ -276,6 +320,33 @@ public:
 	 * @return true if the file exists. false otherwise.
 	 */
 	virtual bool exists(const String &name) = 0;
+
+	/**
+	 * Open the metadata stored for the given save file with setMetadata().
+	 *
+	 * The metadata is discarded whenever the save file is written or removed,
+	 * so it can be used instead of reading the same information from the save
+	 * file itself.
+	 *
+	 * @param name  Name of the save file.
+	 * @return Pointer to a stream with the metadata, or nullptr if there is none.
+	 */
+	virtual SeekableReadStream *openMetadata(const String &name) { return nullptr; }
+
+	/**
+	 * Store metadata, such as the description and thumbnail, for the given save file.
+	 * Save file managers that do not support this ignore it.
+	 *
+	 * @param name  Name of the save file.
+	 * @param data  Metadata to store.
+	 * @param size  Size of the metadata.
+	 */
+	virtual void setMetadata(const String &name, const byte *data, uint32 size) {}
+
+	/**
+	 * Write out any metadata stored with setMetadata() since the last call.
+	 */
+	virtual void flushMetadata() {}
 };
 
 /** @} */
@@ -714,8 +714,11 @@ public:
 	 * if reading more data failed. This is because of an I/O error or because
 	 * the end of the stream was reached. It can be determined by
 	 * calling err() and eos().
+	 *
+	 * Streams which already keep their data in memory can override this
+	 * to return a stream sharing that memory instead of copying it.
 	 */
-	SeekableReadStream *readStream(uint32 dataSize);
+	virtual SeekableReadStream *readStream(uint32 dataSize);
 
 	/**
 	 * Reads in a terminated string. Upon successful completion,
@@ -55,6 +55,8 @@ class Store;
 namespace Common {
 class EventManager;
 class MutexInternal;
+class SemaphoreInternal;
+class ThreadInternal;
 struct Rect;
 class SaveFileManager;
 class SearchSet;
@@ -1570,6 +1572,16 @@ public:
 	 */
 	virtual uint32 getMillis(bool skipRecord = false) = 0;
 
+	/**
+	 * Get a timestamp in microseconds, for measuring how long something
+	 * takes. Unlike getMillis(), it is never replaced by the recorded time
+	 * while the event recorder plays a recording back.
+	 *
+	 * The default implementation is based on getMillis(), backends where
+	 * the event recorder hooks into getMillis() must override it.
+	 */
+	virtual uint64 getMicros() { return (uint64)getMillis(true) * 1000; }
+
 	/** Delay/sleep for the specified amount of milliseconds. */
 	virtual void delayMillis(uint msecs) = 0;
 
@@ -1658,6 +1670,49 @@ public:
 	/** @} */
 
 
+	/**
+	 * @defgroup common_system_threads Worker threads
+	 * @ingroup common_system
+	 * @{
+	 *
+	 * Backends which can run code in parallel may provide worker threads,
+	 * which Common::ThreadPool uses to spread work over several CPU cores.
+	 * These are not meant for timers or audio, which keep going through
+	 * the timer manager and the mixer.
+	 *
+	 * Backends which do not implement these methods make Common::ThreadPool
+	 * run all of its jobs on the calling thread instead.
+	 */
+
+	/**
+	 * Create a new thread, and start it running proc(param).
+	 *
+	 * @param proc   Entry point of the thread.
+	 * @param param  Parameter passed to the entry point.
+	 * @param name   Name of the thread, used for debugging.
+	 *
+	 * @return The newly created thread, or nullptr if threads are not supported
+	 *         or an error occurred.
+	 */
+	virtual Common::ThreadInternal *createThread(void (*proc)(void *param), void *param, const char *name) { return nullptr; }
+
+	/**
+	 * Create a new counting semaphore.
+	 *
+	 * This must be implemented by every backend implementing createThread().
+	 *
+	 * @return The newly created semaphore, or nullptr if an error occurred.
+	 */
+	virtual Common::SemaphoreInternal *createSemaphore(uint initialValue) { return nullptr; }
+
+	/**
+	 * Return the number of CPU cores which can run threads in parallel.
+	 */
+	virtual uint getCPUCoreCount() const { return 1; }
+
+	/** @} */
+
+
 
 	/** @defgroup common_system_sound Sound
 	 *  @ingroup common_system
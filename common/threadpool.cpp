@@ -0,0 +1,260 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/threadpool.h"
+#include "common/system.h"
+
+namespace Common {
+
+Job::Job() : _state(kStateIdle), _finished(nullptr), _waiters(0) {
+}
+
+Job::~Job() {
+	delete _finished;
+}
+
+/**
+ * One of the jobs working through the subranges of a parallelFor() call.
+ * They all share the same cursor, and keep taking the next subrange until
+ * there are none left.
+ */
+class ThreadPool::RangeJob : public Job {
+public:
+	struct Cursor {
+		uint next;
+		uint end;
+		uint step;
+	};
+
+	RangeJob(Mutex &mutex, Cursor &cursor, const RangeBase &body) : _mutex(mutex), _cursor(cursor), _body(body) {}
+
+	void run() override {
+		for (;;) {
+			uint first, last;
+			{
+				StackLock lock(_mutex);
+				if (_cursor.next >= _cursor.end)
+					return;
+				first = _cursor.next;
+				last = MIN(_cursor.end - first, _cursor.step) + first;
+				_cursor.next = last;
+			}
+			_body(first, last);
+		}
+	}
+
+private:
+	Mutex &_mutex;
+	Cursor &_cursor;
+	const RangeBase &_body;
+};
+
+ThreadPool::ThreadPool(uint numThreads) : _jobsQueued(nullptr), _quit(false) {
+	if (numThreads == 0)
+		numThreads = g_system->getCPUCoreCount();
+
+	// The calling thread counts as one of the threads, so a single
+	// thread means running everything synchronously
+	if (numThreads <= 1)
+		return;
+
+	_jobsQueued = g_system->createSemaphore(0);
+	if (!_jobsQueued)
+		return;
+
+	for (uint i = 1; i < numThreads; ++i) {
+		ThreadInternal *thread = g_system->createThread(workerProc, this, "ThreadPool");
+		if (!thread)
+			break;
+		_workers.push_back(thread);
+	}
+
+	if (_workers.empty()) {
+		delete _jobsQueued;
+		_jobsQueued = nullptr;
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	if (_workers.empty())
+		return;
+
+	while (Job *job = takeJob())
+		runJob(job);
+
+	_mutex.lock();
+	_quit = true;
+	_mutex.unlock();
+
+	for (uint i = 0; i < _workers.size(); ++i)
+		_jobsQueued->post();
+	for (uint i = 0; i < _workers.size(); ++i) {
+		_workers[i]->join();
+		delete _workers[i];
+	}
+
+	delete _jobsQueued;
+}
+
+void ThreadPool::submit(Job *job, JobPriority priority) {
+	assert(job->_state == Job::kStateIdle || job->_state == Job::kStateFinished);
+
+	if (_workers.empty()) {
+		job->_state = Job::kStateRunning;
+		runJob(job);
+		return;
+	}
+
+	_mutex.lock();
+	job->_state = Job::kStateQueued;
+	_queues[priority].push_back(job);
+	_mutex.unlock();
+
+	_jobsQueued->post();
+}
+
+void ThreadPool::wait(Job *job) {
+	_mutex.lock();
+
+	if (job->_state == Job::kStateQueued) {
+		// No worker has got to it yet, so run it here rather than block
+		for (uint i = 0; i < kJobPriorityCount; ++i)
+			_queues[i].remove(job);
+		job->_state = Job::kStateRunning;
+		_mutex.unlock();
+
+		runJob(job);
+		return;
+	}
+
+	if (job->_state != Job::kStateRunning) {
+		_mutex.unlock();
+		return;
+	}
+
+	// Most jobs are never waited for while running, so the semaphore is only
+	// created here. runJob() posts it once for each waiter while holding the
+	// mutex, so the wakeup can't be missed, and it is kept for the next time
+	// the job is waited for.
+	if (!job->_finished)
+		job->_finished = g_system->createSemaphore(0);
+	SemaphoreInternal *finished = job->_finished;
+	if (finished)
+		job->_waiters++;
+	_mutex.unlock();
+
+	if (finished) {
+		finished->wait();
+		return;
+	}
+
+	// Should not happen, as the workers needed a semaphore as well
+	for (;;) {
+		g_system->delayMillis(1);
+		StackLock lock(_mutex);
+		if (job->_state != Job::kStateRunning)
+			return;
+	}
+}
+
+void ThreadPool::runRange(uint begin, uint end, uint minSize, const RangeBase &body) {
+	if (begin >= end)
+		return;
+
+	uint size = end - begin;
+	minSize = MAX<uint>(minSize, 1);
+	if (_workers.empty() || size <= minSize) {
+		body(begin, end);
+		return;
+	}
+
+	// Split the range into a few subranges per thread, so that threads
+	// finishing early can pick up some of the work of the slower ones
+	uint threads = _workers.size() + 1;
+	uint numRanges = MIN<uint>((size + minSize - 1) / minSize, threads * 4);
+
+	RangeJob::Cursor cursor;
+	cursor.next = begin;
+	cursor.end = end;
+	cursor.step = (size + numRanges - 1) / numRanges;
+
+	Array<RangeJob *> jobs;
+	for (uint i = 0; i < MIN(threads, numRanges) - 1; ++i) {
+		jobs.push_back(new RangeJob(_mutex, cursor, body));
+		submit(jobs.back(), kJobPriorityHigh);
+	}
+
+	RangeJob self(_mutex, cursor, body);
+	self.run();
+
+	for (uint i = 0; i < jobs.size(); ++i) {
+		wait(jobs[i]);
+		delete jobs[i];
+	}
+}
+
+void ThreadPool::workerProc(void *param) {
+	static_cast<ThreadPool *>(param)->workerLoop();
+}
+
+void ThreadPool::workerLoop() {
+	for (;;) {
+		_jobsQueued->wait();
+
+		_mutex.lock();
+		Job *job = _quit ? nullptr : takeJob();
+		bool quit = _quit;
+		_mutex.unlock();
+
+		if (quit)
+			return;
+		if (job)
+			runJob(job);
+	}
+}
+
+Job *ThreadPool::takeJob() {
+	StackLock lock(_mutex);
+
+	for (int i = kJobPriorityCount - 1; i >= 0; --i) {
+		if (!_queues[i].empty()) {
+			Job *job = _queues[i].front();
+			_queues[i].pop_front();
+			job->_state = Job::kStateRunning;
+			return job;
+		}
+	}
+
+	return nullptr;
+}
+
+void ThreadPool::runJob(Job *job) {
+	job->run();
+
+	// The waiting thread may delete the job as soon as it sees it finished,
+	// so it must not be touched anymore after unlocking
+	StackLock lock(_mutex);
+	job->_state = Job::kStateFinished;
+	for (; job->_waiters > 0; job->_waiters--)
+		job->_finished->post();
+}
+
+} // End of namespace Common
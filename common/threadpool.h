@@ -0,0 +1,165 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_THREADPOOL_H
+#define COMMON_THREADPOOL_H
+
+#include "common/array.h"
+#include "common/list.h"
+#include "common/mutex.h"
+#include "common/noncopyable.h"
+#include "common/thread.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_threadpool Thread pool
+ * @ingroup common
+ *
+ * @brief API for running work on several CPU cores.
+ * @{
+ */
+
+class ThreadPool;
+
+enum JobPriority {
+	kJobPriorityLow = 0,
+	kJobPriorityNormal = 1,
+	kJobPriorityHigh = 2,
+
+	kJobPriorityCount
+};
+
+/**
+ * A unit of work to be run by a ThreadPool.
+ *
+ * Once submitted, a job acts as the future for its own result: call
+ * ThreadPool::wait() before reading any results stored by run(), and
+ * before deleting or submitting the job again.
+ */
+class Job : NonCopyable {
+	friend class ThreadPool;
+public:
+	Job();
+	virtual ~Job();
+
+	/**
+	 * Does the actual work. This may be called from any thread.
+	 */
+	virtual void run() = 0;
+
+private:
+	enum State {
+		kStateIdle,
+		kStateQueued,
+		kStateRunning,
+		kStateFinished
+	};
+
+	State _state;
+	SemaphoreInternal *_finished;
+	uint _waiters;
+};
+
+/**
+ * Runs jobs on a set of worker threads provided by the backend.
+ *
+ * On backends without threads, and for pools created with a single thread,
+ * every job is run on the calling thread as soon as it is submitted, so
+ * code using the pool works the same everywhere.
+ */
+class ThreadPool : NonCopyable {
+public:
+	/**
+	 * Creates the pool.
+	 *
+	 * @param numThreads  Number of threads to use, including the one calling
+	 *                    parallelFor(). By default there is one per CPU core.
+	 */
+	explicit ThreadPool(uint numThreads = 0);
+
+	/**
+	 * Runs any jobs still queued, then stops the worker threads.
+	 */
+	~ThreadPool();
+
+	/**
+	 * Returns the number of worker threads, or 0 if jobs run synchronously.
+	 */
+	uint getWorkerCount() const { return _workers.size(); }
+
+	/**
+	 * Queues a job to be run by one of the workers. Jobs with a higher
+	 * priority are started before those with a lower one.
+	 */
+	void submit(Job *job, JobPriority priority = kJobPriorityNormal);
+
+	/**
+	 * Waits for a submitted job to finish. If no worker has started
+	 * the job yet, it is run on the calling thread instead.
+	 */
+	void wait(Job *job);
+
+	/**
+	 * Calls body(first, last) for consecutive subranges covering [begin, end),
+	 * spread over the workers and the calling thread, and waits for all of
+	 * them to return. Each subrange holds at least minSize elements, except
+	 * possibly the last one.
+	 */
+	template<class Body>
+	void parallelFor(uint begin, uint end, const Body &body, uint minSize = 1) {
+		RangeFunctor<Body> functor(body);
+		runRange(begin, end, minSize, functor);
+	}
+
+private:
+	struct RangeBase {
+		virtual ~RangeBase() {}
+		virtual void operator()(uint first, uint last) const = 0;
+	};
+
+	template<class Body>
+	struct RangeFunctor : public RangeBase {
+		const Body &_body;
+		RangeFunctor(const Body &body) : _body(body) {}
+		void operator()(uint first, uint last) const override { _body(first, last); }
+	};
+
+	class RangeJob;
+
+	static void workerProc(void *param);
+	void workerLoop();
+	Job *takeJob();
+	void runJob(Job *job);
+	void runRange(uint begin, uint end, uint minSize, const RangeBase &body);
+
+	Mutex _mutex;
+	SemaphoreInternal *_jobsQueued;
+	Array<ThreadInternal *> _workers;
+	List<Job *> _queues[kJobPriorityCount];
+	bool _quit;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -86,7 +86,7 @@ public:
 	SaveStateList listSaves(const char *target) const override;
 	int getMaximumSaveSlot() const override;
 	bool removeSaveState(const char *target, int slot) const override;
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 	Common::KeymapArray initKeymaps(const char *target) const override;
 };
 
@@ -159,7 +159,7 @@ bool AccessMetaEngine::removeSaveState(const char *target, int slot) const {
 	return g_system->getSavefileManager()->removeSavefile(filename);
 }
 
-SaveStateDescriptor AccessMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
+SaveStateDescriptor AccessMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
 	Common::String filename = Common::String::format("%s.%03d", target, slot);
 	Common::InSaveFile *f = g_system->getSavefileManager()->openForLoading(filename);
 
@@ -176,7 +176,7 @@ public:
 	}
 
 	bool hasFeature(MetaEngineFeature f) const override;
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 	int getAutosaveSlot() const override { return 15; }
 	int getMaximumSaveSlot() const override { return 15; }
 	SaveStateList listSaves(const char *target) const override;
@@ -201,7 +201,7 @@ bool AdlMetaEngine::hasFeature(MetaEngineFeature f) const {
 	}
 }
 
-SaveStateDescriptor AdlMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
+SaveStateDescriptor AdlMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
 	Common::String fileName = Common::String::format("%s.s%02d", target, slot);
 	Common::InSaveFile *inFile = g_system->getSavefileManager()->openForLoading(fileName);
 
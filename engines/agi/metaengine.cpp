@@ -247,7 +247,7 @@ public:
 	SaveStateList listSaves(const char *target) const override;
 	int getMaximumSaveSlot() const override;
 	bool removeSaveState(const char *target, int slot) const override;
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 
 	bool hasFeature(MetaEngineFeature f) const override;
 };
@@ -352,7 +352,7 @@ bool AgiMetaEngine::removeSaveState(const char *target, int slot) const {
 
 int AgiMetaEngine::getMaximumSaveSlot() const { return 999; }
 
-SaveStateDescriptor AgiMetaEngine::querySaveMetaInfos(const char *target, int slotNr) const {
+SaveStateDescriptor AgiMetaEngine::querySaveMetaInfos(const char *target, int slotNr, bool skipThumbnail) const {
 	const uint32 AGIflag = MKTAG('A', 'G', 'I', ':');
 	Common::String fileName = Common::String::format("%s.%03d", target, slotNr);
 
@@ -97,7 +97,7 @@ Common::String AGSMetaEngine::getSavegameFile(int saveGameIdx, const char *targe
 	}
 }
 
-SaveStateDescriptor AGSMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
+SaveStateDescriptor AGSMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
 	Common::String filename = Common::String::format("%s%s",
 	                          ::AGS3::AGS::Shared::SAVE_FOLDER_PREFIX,
 	                          getSavegameFile(slot, target).c_str());
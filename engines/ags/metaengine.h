@@ -69,7 +69,7 @@ public:
 	 * @param target  Name of a config manager target.
 	 * @param slot    Slot number of the save state.
 	 */
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 
 	/**
 	 * Remove the specified save state.
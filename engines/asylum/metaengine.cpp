@@ -52,7 +52,7 @@ public:
 
 	int getMaximumSaveSlot() const override { return 24; }
 	int getAutosaveSlot()    const override { return getMaximumSaveSlot(); }
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 	void getSavegameThumbnail(Graphics::Surface &thumb) override;
 	Common::Error createInstance(OSystem *syst, Engine **engine, const ADGameDescription *gd) const override;
 	Common::KeymapArray initKeymaps(const char *target) const override;
@@ -77,8 +77,8 @@ void AsylumMetaEngine::getSavegameThumbnail(Graphics::Surface &thumb) {
 	}
 }
 
-SaveStateDescriptor AsylumMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
-	SaveStateDescriptor desc = MetaEngine::querySaveMetaInfos(target, slot);
+SaveStateDescriptor AsylumMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
+	SaveStateDescriptor desc = MetaEngine::querySaveMetaInfos(target, slot, skipThumbnail);
 
 	if (desc.getSaveSlot() == -1) {
 		Common::InSaveFile *in(g_system->getSavefileManager()->openForLoading(getSavegameFile(slot, target)));
@@ -60,7 +60,7 @@ public:
 
 	int getMaximumSaveSlot() const override;
 	SaveStateList listSaves(const char *target) const override;
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 	bool removeSaveState(const char *target, int slot) const override;
 
 	// Disable autosave (see mirrored method in bbvs.h for detailed explanation)
@@ -183,7 +183,7 @@ SaveStateList BbvsMetaEngine::listSaves(const char *target) const {
 	return saveList;
 }
 
-SaveStateDescriptor BbvsMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
+SaveStateDescriptor BbvsMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
 	Common::String filename = Bbvs::BbvsEngine::getSavegameFilename(target, slot);
 	Common::InSaveFile *in = g_system->getSavefileManager()->openForLoading(filename.c_str());
 	if (in) {
@@ -136,7 +136,7 @@ public:
 	SaveStateList listSaves(const char *target) const override;
 	int getMaximumSaveSlot() const override;
 	bool removeSaveState(const char *target, int slot) const override;
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 	// Disable autosave (see mirrored method in bladerunner.h for detailed explanation)
 	int getAutosaveSlot() const override { return -1; }
 };
@@ -397,7 +397,7 @@ bool BladeRunnerMetaEngine::removeSaveState(const char *target, int slot) const
 	return BladeRunner::SaveFileManager::remove(target, slot);
 }
 
-SaveStateDescriptor BladeRunnerMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
+SaveStateDescriptor BladeRunnerMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
 	return BladeRunner::SaveFileManager::queryMetaInfos(this, target, slot);
 }
 
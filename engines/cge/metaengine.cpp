@@ -82,7 +82,7 @@ public:
 
 	int getMaximumSaveSlot() const override;
 	SaveStateList listSaves(const char *target) const override;
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 	bool removeSaveState(const char *target, int slot) const override;
 	Common::KeymapArray initKeymaps(const char *target) const override;
 };
@@ -151,7 +151,7 @@ SaveStateList CGEMetaEngine::listSaves(const char *target) const {
 	return saveList;
 }
 
-SaveStateDescriptor CGEMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
+SaveStateDescriptor CGEMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
 	Common::String fileName = Common::String::format("%s.%03d", target, slot);
 	Common::InSaveFile *f = g_system->getSavefileManager()->openForLoading(fileName);
 
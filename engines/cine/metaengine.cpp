@@ -108,7 +108,7 @@ public:
 	int getMaximumSaveSlot() const override;
 	bool removeSaveState(const char *target, int slot) const override;
 	Common::String getSavegameFile(int saveGameIdx, const char *target = nullptr) const override;
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 
 	Common::KeymapArray initKeymaps(const char *target) const override;
 };
@@ -207,7 +207,7 @@ Common::String CineMetaEngine::getSavegameFile(int saveGameIdx, const char *targ
 	return Common::String::format("%s.%d", target == nullptr ? getName() : target, saveGameIdx);
 }
 
-SaveStateDescriptor CineMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
+SaveStateDescriptor CineMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
 	if (slot < 0 || slot > getMaximumSaveSlot()) {
 		// HACK: Try to make SaveLoadChooserGrid::open() not use save slot
 		// numbers over the maximum save slot number for "New save".
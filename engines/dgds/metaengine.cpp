@@ -41,7 +41,7 @@ public:
 	Common::Error createInstance(OSystem *syst, Engine **engine, const ADGameDescription *desc) const override;
 
 	Common::KeymapArray initKeymaps(const char *target) const override;
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 };
 
 bool DgdsMetaEngine::hasFeature(MetaEngineFeature f) const {
@@ -111,8 +111,8 @@ static const uint32 GAME_MAGICS[] {
 	0x7ADA2628, // Adventures of Willy Beamish
 };
 
-SaveStateDescriptor DgdsMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
-	SaveStateDescriptor desc = AdvancedMetaEngine::querySaveMetaInfos(target, slot);
+SaveStateDescriptor DgdsMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
+	SaveStateDescriptor desc = AdvancedMetaEngine::querySaveMetaInfos(target, slot, skipThumbnail);
 	if (!desc.isValid() && slot > 0) {
 		const Common::String filename = getSavegameFile(slot, target);
 		Common::ScopedPtr<Common::InSaveFile> f(g_system->getSavefileManager()->openForLoading(filename));
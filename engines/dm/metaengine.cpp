@@ -92,7 +92,7 @@ public:
 		return saveList;
 	}
 
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override {
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override {
 		Common::String filename = Common::String::format("%s.%03u", target, slot);
 		Common::InSaveFile *in = g_system->getSavefileManager()->openForLoading(filename.c_str());
 
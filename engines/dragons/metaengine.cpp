@@ -39,7 +39,7 @@ public:
 	Common::Error createInstance(OSystem *syst, Engine **engine, const Dragons::DragonsGameDescription *desc) const override;
 	int getMaximumSaveSlot() const override;
 	SaveStateList listSaves(const char *target) const override;
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 	bool removeSaveState(const char *target, int slot) const override;
 	Common::KeymapArray initKeymaps(const char *target) const override;
 };
@@ -89,7 +89,7 @@ SaveStateList DragonsMetaEngine::listSaves(const char *target) const {
 	return saveList;
 }
 
-SaveStateDescriptor DragonsMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
+SaveStateDescriptor DragonsMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
 	Common::String filename = Dragons::DragonsEngine::getSavegameFilename(target, slot);
 	Common::InSaveFile *in = g_system->getSavefileManager()->openForLoading(filename.c_str());
 	if (in) {
@@ -632,6 +632,10 @@ void Engine::handleAutoSave() {
 	if (!g_eventRec.processAutosave())
 		return;
 #endif
+	// Tell about saves which failed to be written as soon as they are done
+	if (!_saveFileMan->isSaving())
+		waitForSaves();
+
 	const int diff = _system->getMillis() - _lastAutosaveTime;
 
 	if (_autosaveInterval != 0 && diff > (_autosaveInterval * 1000)) {
@@ -956,6 +960,7 @@ void Engine::flipMute() {
 Common::Error Engine::loadGameState(int slot) {
 	// In case autosaves are on, do a save first before loading the new save
 	saveAutosaveIfEnabled();
+	waitForSaves();
 
 	Common::InSaveFile *saveFile = _saveFileMan->openForLoading(getSaveStateName(slot));
 
@@ -984,7 +989,7 @@ bool Engine::canLoadGameStateCurrently(Common::U32String *msg) {
 }
 
 Common::Error Engine::saveGameState(int slot, const Common::String &desc, bool isAutosave) {
-	Common::OutSaveFile *saveFile = _saveFileMan->openForSaving(getSaveStateName(slot));
+	Common::OutSaveFile *saveFile = _saveFileMan->openForBackgroundSaving(getSaveStateName(slot));
 
 	if (!saveFile)
 		return Common::kWritingFailed;
@@ -1071,6 +1076,26 @@ bool Engine::saveGameDialog() {
 	return true;
 }
 
+bool Engine::waitForSaves() {
+	Common::StringArray failedSaves;
+	if (_saveFileMan->waitForSaves(&failedSaves))
+		return true;
+
+	Common::String files;
+	for (const auto &file : failedSaves) {
+		if (!files.empty())
+			files += ", ";
+		files += file;
+	}
+
+	Common::U32String failMessage = Common::U32String::format(_("Failed to save game (%s)! "
+		  "Please consult the README for basic information, and for "
+		  "instructions on how to obtain further assistance."), files.c_str());
+	GUI::MessageDialog dialog(failMessage);
+	runDialog(dialog);
+	return false;
+}
+
 void Engine::quitGame() {
 	Common::Event event;
 
@@ -501,6 +501,14 @@ public:
 	 */
 	bool loadGameDialog();
 
+	/**
+	 * Wait until the saves written in the background by saveGameState() are
+	 * complete, and tell the user about those which could not be written.
+	 *
+	 * @return False if writing a save failed.
+	 */
+	bool waitForSaves();
+
 protected:
 	/**
 	 * Actual implementation of pauseEngine by subclasses.
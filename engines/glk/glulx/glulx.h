@@ -27,6 +27,7 @@
 #include "common/scummsys.h"
 #include "common/random.h"
 #include "glk/glk_api.h"
+#include "glk/undo_store.h"
 #include "glk/glulx/glulx_types.h"
 
 namespace Glk {
@@ -145,6 +146,11 @@ private:
 	 */
 	const operandlist_t *fast_operandlist[0x80];
 
+	/**
+	 * Cache of decoded ROM instructions, indexed by the low bits of their address
+	 */
+	decodedinst_t *decoded_cache;
+
 	/**@}*/
 
 	/**
@@ -153,13 +159,14 @@ private:
 	 */
 
 	/**
+	 * Maximum number of states in the undo chain, and the number of bytes it may use for
+	 * states older than the most recent one.
 	 * This can be adjusted before startup by platform-specific startup code -- that is, preference code.
 	 */
 	int max_undo_level;
+	uint max_undo_size;
 
-	int undo_chain_size;
-	int undo_chain_num;
-	byte **undo_chain;
+	UndoStore undo_chain;
 
 	/**
 	 * This will contain a copy of RAM (ramstate to endmem) as it exists in the game file.
@@ -351,10 +358,10 @@ protected:
 	 * @{
 	 */
 
-	uint write_memstate(dest_t *dest);
+	uint write_memstate(dest_t *dest, int portable);
 	uint write_heapstate(dest_t *dest, int portable);
 	uint write_stackstate(dest_t *dest, int portable);
-	uint read_memstate(dest_t *dest, uint chunklen);
+	uint read_memstate(dest_t *dest, uint chunklen, int portable);
 	uint read_heapstate(dest_t *dest, uint chunklen, int portable, uint *sumlen, uint **summary);
 	uint read_stackstate(dest_t *dest, uint chunklen, int portable);
 	uint write_heapstate_sub(uint sumlen, uint *sumarray, dest_t *dest, int portable);
@@ -551,6 +558,24 @@ public:
 	*/
 	void parse_operands(oparg_t *opargs, const operandlist_t *oplist);
 
+	/**
+	 * Return the decoded form of the instruction at addr, decoding and caching it if needed.
+	 * Returns nullptr if the instruction isn't entirely in ROM or can't be decoded, in which
+	 * case it has to be executed the regular way, which also reports any errors.
+	 */
+	const decodedinst_t *lookup_decoded_inst(uint addr);
+
+	/**
+	 * Decode the instruction at addr into inst. Returns false if it can't be cached.
+	 */
+	bool decode_instruction(uint addr, decodedinst_t *inst);
+
+	/**
+	 * Fetch the operand values of a decoded instruction into args, like parse_operands() does.
+	 * The PC is not changed.
+	 */
+	void parse_decoded_operands(oparg_t *opargs, const decodedinst_t *inst);
+
 	/**
 	 * Store a result value, according to the desttype and destaddress given. This is usually used to store
 	 * the result of an opcode, but it's also used by any code that pulls a call-stub off the stack.
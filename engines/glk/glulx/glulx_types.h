@@ -351,6 +351,42 @@ typedef oparg_struct oparg_t;
 
 #define MAX_OPERANDS (8)
 
+/**
+ * How to fetch each operand of a pre-decoded instruction. The addressing mode and
+ * operand size are already resolved, so only the actual load is left to do.
+ */
+enum decodedop {
+	decodedop_Value = 0,    ///< Constant, or store operand. The oparg is used as is
+	decodedop_Pop,          ///< Pop off stack
+	decodedop_Mem4,         ///< Main memory, value is the absolute address
+	decodedop_Mem2,
+	decodedop_Mem1,
+	decodedop_Local4,       ///< Locals, value is the offset into the locals segment
+	decodedop_Local2,
+	decodedop_Local1
+};
+
+/**
+ * An instruction in ROM, with its opcode and operand modes decoded. Since ROM can't be
+ * written to, these stay valid for as long as the game runs.
+ */
+struct decodedinst_struct {
+	uint addr;                          ///< Address of the instruction, or DECODED_NONE if unused
+	uint opcode;
+	uint nextpc;                        ///< Address of the following instruction
+	int num_ops;
+	byte kinds[MAX_OPERANDS];           ///< decodedop value of each operand
+	oparg_t args[MAX_OPERANDS];
+};
+typedef decodedinst_struct decodedinst_t;
+
+#define DECODED_NONE (0xFFFFFFFF)
+
+/**
+ * Number of entries in the direct-mapped cache of decoded instructions. Must be a power of two.
+ */
+#define DECODED_CACHE_SIZE (8192)
+
 typedef uint(Glulx::*acceleration_func)(uint argc, uint *argv);
 
 struct accelentry_struct {
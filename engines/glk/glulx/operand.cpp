@@ -66,6 +66,14 @@ static const operandlist_t list_LLSS = { 4, 4, &array_LLSS[0] };
 void Glulx::init_operands() {
 	for (int ix = 0; ix < 0x80; ix++)
 		fast_operandlist[ix] = lookup_operandlist(ix);
+
+	if (!decoded_cache) {
+		decoded_cache = (decodedinst_t *)glulx_malloc(DECODED_CACHE_SIZE * sizeof(decodedinst_t));
+		if (!decoded_cache)
+			fatal_error("Unable to allocate instruction cache.");
+	}
+	for (int ix = 0; ix < DECODED_CACHE_SIZE; ix++)
+		decoded_cache[ix].addr = DECODED_NONE;
 }
 
 const operandlist_t *Glulx::lookup_operandlist(uint opcode) {
@@ -516,6 +524,186 @@ WrLocalsAddr:
 	}
 }
 
+const decodedinst_t *Glulx::lookup_decoded_inst(uint addr) {
+	decodedinst_t *inst = &decoded_cache[addr & (DECODED_CACHE_SIZE - 1)];
+	if (inst->addr == addr)
+		return inst;
+
+	if (!decode_instruction(addr, inst)) {
+		inst->addr = DECODED_NONE;
+		return nullptr;
+	}
+	inst->addr = addr;
+	return inst;
+}
+
+bool Glulx::decode_instruction(uint addr, decodedinst_t *inst) {
+	/* Fetch the opcode number, the same way execute_loop() does. */
+	uint opcode = Mem1(addr);
+	addr++;
+	if (opcode & 0x80) {
+		if (opcode & 0x40) {
+			opcode &= 0x3F;
+			opcode = (opcode << 8) | Mem1(addr);
+			opcode = (opcode << 8) | Mem1(addr + 1);
+			opcode = (opcode << 8) | Mem1(addr + 2);
+			addr += 3;
+		} else {
+			opcode &= 0x7F;
+			opcode = (opcode << 8) | Mem1(addr);
+			addr++;
+		}
+	}
+
+	const operandlist_t *oplist = (opcode < 0x80) ? fast_operandlist[opcode] : lookup_operandlist(opcode);
+	if (!oplist)
+		return false;
+
+	int numops = oplist->num_ops;
+	int argsize = oplist->arg_size;
+	uint modeaddr = addr;
+	int modeval = 0;
+	addr += (numops + 1) / 2;
+
+	inst->opcode = opcode;
+	inst->num_ops = numops;
+
+	for (int ix = 0; ix < numops; ix++) {
+		oparg_t *curarg = &inst->args[ix];
+		int mode;
+		uint value;
+
+		if ((ix & 1) == 0) {
+			modeval = Mem1(modeaddr);
+			mode = (modeval & 0x0F);
+		} else {
+			mode = ((modeval >> 4) & 0x0F);
+			modeaddr++;
+		}
+
+		/* Read the constant or address following the mode list, if any. */
+		switch (mode) {
+		case 1:
+			value = (int)(signed char)(Mem1(addr));
+			addr++;
+			break;
+		case 2:
+			value = (int)(signed char)(Mem1(addr));
+			value = (value << 8) | (uint)(Mem1(addr + 1));
+			addr += 2;
+			break;
+		case 5:
+		case 9:
+		case 13:
+			value = (uint)(Mem1(addr));
+			addr++;
+			break;
+		case 6:
+		case 10:
+		case 14:
+			value = (uint)Mem2(addr);
+			addr += 2;
+			break;
+		case 3:
+		case 7:
+		case 11:
+		case 15:
+			value = Mem4(addr);
+			addr += 4;
+			break;
+		case 0:
+		case 8:
+			value = 0;
+			break;
+		default:
+			/* Unknown mode; let parse_operands() report it. */
+			return false;
+		}
+		if (mode >= 13)
+			value += ramstart;
+
+		curarg->desttype = 0;
+		curarg->value = value;
+
+		if (oplist->formlist[ix] == modeform_Load) {
+			if (mode == 8)
+				inst->kinds[ix] = decodedop_Pop;
+			else if (mode <= 3)
+				inst->kinds[ix] = decodedop_Value;
+			else if (mode >= 9 && mode <= 11)
+				inst->kinds[ix] = (argsize == 4) ? decodedop_Local4 : (argsize == 2) ? decodedop_Local2 : decodedop_Local1;
+			else
+				inst->kinds[ix] = (argsize == 4) ? decodedop_Mem4 : (argsize == 2) ? decodedop_Mem2 : decodedop_Mem1;
+		} else {
+			/* Store operands are fully known up front. */
+			if (mode >= 1 && mode <= 3)
+				return false;
+			inst->kinds[ix] = decodedop_Value;
+			if (mode == 0)
+				curarg->desttype = 0;
+			else if (mode == 8)
+				curarg->desttype = 3;
+			else if (mode >= 9 && mode <= 11)
+				curarg->desttype = 2;
+			else
+				curarg->desttype = 1;
+		}
+	}
+
+	/* The whole instruction must be in ROM, or it could change under us. */
+	if (addr > ramstart)
+		return false;
+
+	inst->nextpc = addr;
+	return true;
+}
+
+void Glulx::parse_decoded_operands(oparg_t *args, const decodedinst_t *inst) {
+	for (int ix = 0; ix < inst->num_ops; ix++) {
+		const oparg_t &arg = inst->args[ix];
+		oparg_t *curarg = &args[ix];
+
+		curarg->desttype = arg.desttype;
+
+		switch (inst->kinds[ix]) {
+		case decodedop_Value:
+			curarg->value = arg.value;
+			break;
+
+		case decodedop_Pop:
+			if (stackptr < valstackbase + 4) {
+				fatal_error("Stack underflow in operand.");
+			}
+			stackptr -= 4;
+			curarg->value = Stk4(stackptr);
+			break;
+
+		case decodedop_Mem4:
+			curarg->value = Mem4(arg.value);
+			break;
+		case decodedop_Mem2:
+			curarg->value = Mem2(arg.value);
+			break;
+		case decodedop_Mem1:
+			curarg->value = Mem1(arg.value);
+			break;
+
+		case decodedop_Local4:
+			curarg->value = Stk4(arg.value + localsbase);
+			break;
+		case decodedop_Local2:
+			curarg->value = Stk2(arg.value + localsbase);
+			break;
+		case decodedop_Local1:
+			curarg->value = Stk1(arg.value + localsbase);
+			break;
+
+		default:
+			break;
+		}
+	}
+}
+
 void Glulx::store_operand(uint desttype, uint destaddr, uint storeval) {
 	switch (desttype) {
 
@@ -27,11 +27,8 @@ namespace Glulx {
 #define IFFID(c1, c2, c3, c4) MKTAG(c1, c2, c3, c4)
 
 bool Glulx::init_serial() {
-	undo_chain_num = 0;
-	undo_chain_size = max_undo_level;
-	undo_chain = (unsigned char **)glulx_malloc(sizeof(unsigned char *) * undo_chain_size);
-	if (!undo_chain)
-		return false;
+	undo_chain.clear();
+	undo_chain.setLimits(max_undo_size, max_undo_level);
 
 #ifdef SERIALIZE_CACHE_RAM
 	{
@@ -52,16 +49,7 @@ bool Glulx::init_serial() {
 }
 
 void Glulx::final_serial() {
-	if (undo_chain) {
-		int ix;
-		for (ix = 0; ix < undo_chain_num; ix++) {
-			glulx_free(undo_chain[ix]);
-		}
-		glulx_free(undo_chain);
-	}
-	undo_chain = nullptr;
-	undo_chain_size = 0;
-	undo_chain_num = 0;
+	undo_chain.clear();
 
 #ifdef SERIALIZE_CACHE_RAM
 	if (ramcache) {
@@ -75,18 +63,23 @@ uint Glulx::perform_saveundo() {
 	dest_t dest;
 	uint res;
 	uint memstart = 0, memlen = 0, heapstart = 0, heaplen = 0;
-	uint stackstart = 0, stacklen = 0;
+	uint stackstart = 0, stacklen = 0, totallen = 0;
 
 	/* The format for undo-saves is simpler than for saves on disk. We
 	   just have a memory chunk, a heap chunk, and a stack chunk, in
 	   that order. We skip the IFF chunk headers (although the size
 	   fields are still there.) We also don't bother with IFF's 16-bit
-	   alignment. */
+	   alignment. The memory isn't compressed either; the undo chain
+	   only keeps what changed since the previous state anyway. */
 
-	if (undo_chain_size == 0)
+	if (max_undo_level == 0)
 		return 1;
 
 	dest._isMem = true;
+	dest._size = (endmem - ramstart) + stackptr + 1024;
+	dest._ptr = (byte *)glulx_malloc(dest._size);
+	if (!dest._ptr)
+		return 1;
 
 	res = 0;
 	if (res == 0) {
@@ -94,7 +87,7 @@ uint Glulx::perform_saveundo() {
 	}
 	if (res == 0) {
 		memstart = dest._pos;
-		res = write_memstate(&dest);
+		res = write_memstate(&dest, false);
 		memlen = dest._pos - memstart;
 	}
 	if (res == 0) {
@@ -112,14 +105,9 @@ uint Glulx::perform_saveundo() {
 		stackstart = dest._pos;
 		res = write_stackstate(&dest, false);
 		stacklen = dest._pos - stackstart;
+		totallen = dest._pos;
 	}
 
-	if (res == 0) {
-		/* Trim it down to the perfect size. */
-		dest._ptr = (byte *)glulx_realloc(dest._ptr, dest._pos);
-		if (!dest._ptr)
-			res = 1;
-	}
 	if (res == 0) {
 		res = reposition_write(&dest, memstart - 4);
 	}
@@ -141,23 +129,12 @@ uint Glulx::perform_saveundo() {
 
 	if (res == 0) {
 		/* It worked. */
-		if (undo_chain_num >= undo_chain_size) {
-			glulx_free(undo_chain[undo_chain_num - 1]);
-			undo_chain[undo_chain_num - 1] = nullptr;
-		}
-		if (undo_chain_size > 1)
-			memmove(undo_chain + 1, undo_chain,
-			        (undo_chain_size - 1) * sizeof(unsigned char *));
-		undo_chain[0] = dest._ptr;
-		if (undo_chain_num < undo_chain_size)
-			undo_chain_num += 1;
+		undo_chain.push(dest._ptr, totallen);
+	}
+
+	if (dest._ptr) {
+		glulx_free(dest._ptr);
 		dest._ptr = nullptr;
-	} else {
-		/* It didn't work. */
-		if (dest._ptr) {
-			glulx_free(dest._ptr);
-			dest._ptr = nullptr;
-		}
 	}
 
 	return res;
@@ -175,18 +152,18 @@ uint Glulx::perform_restoreundo() {
 		return 1;
 #endif /* VM_PROFILING */
 
-	if (undo_chain_size == 0 || undo_chain_num == 0)
+	if (undo_chain.empty())
 		return 1;
 
 	dest._isMem = true;
-	dest._ptr = undo_chain[0];
+	dest._ptr = const_cast<byte *>(undo_chain.top().data());
 
 	res = 0;
 	if (res == 0) {
 		res = read_long(&dest, &val);
 	}
 	if (res == 0) {
-		res = read_memstate(&dest, val);
+		res = read_memstate(&dest, val, false);
 	}
 	if (res == 0) {
 		res = read_long(&dest, &val);
@@ -210,16 +187,9 @@ uint Glulx::perform_restoreundo() {
 
 	if (res == 0) {
 		/* It worked. */
-		if (undo_chain_size > 1)
-			memmove(undo_chain, undo_chain + 1,
-			        (undo_chain_size - 1) * sizeof(unsigned char *));
-		undo_chain_num -= 1;
-		glulx_free(dest._ptr);
-		dest._ptr = nullptr;
-	} else {
-		/* It didn't work. */
-		dest._ptr = nullptr;
+		undo_chain.pop();
 	}
+	dest._ptr = nullptr;
 
 	return res;
 }
@@ -267,7 +237,7 @@ Common::Error Glulx::loadGameChunks(QuetzalReader &quetzal) {
 			break;
 
 		case ID_CMem:
-			res = read_memstate(&dest, rs->size());
+			res = read_memstate(&dest, rs->size(), true);
 			break;
 
 		case MKTAG('M', 'A', 'l', 'l'):
@@ -312,7 +282,7 @@ Common::Error Glulx::saveGameChunks(QuetzalWriter &quetzal) {
 		Common::WriteStream &ws = quetzal.add(ID_CMem);
 		dest_t dest;
 		dest._dest = &ws;
-		res = write_memstate(&dest);
+		res = write_memstate(&dest, true);
 	}
 
 	// MAll
@@ -421,7 +391,7 @@ int Glulx::read_byte(dest_t *dest, byte *val) {
 	return read_buffer(dest, val, 1);
 }
 
-uint Glulx::write_memstate(dest_t *dest) {
+uint Glulx::write_memstate(dest_t *dest, int portable) {
 	uint res, pos;
 	int val;
 	int runlen;
@@ -434,6 +404,11 @@ uint Glulx::write_memstate(dest_t *dest) {
 	if (res)
 		return res;
 
+	/* If we're storing for the purpose of undo, the memory is written as
+	   it is, so that the undo chain can compare it to the previous state. */
+	if (!portable)
+		return write_buffer(dest, memmap + ramstart, endmem - ramstart);
+
 	runlen = 0;
 
 #ifdef SERIALIZE_CACHE_RAM
@@ -484,7 +459,7 @@ uint Glulx::write_memstate(dest_t *dest) {
 	return 0;
 }
 
-uint Glulx::read_memstate(dest_t *dest, uint chunklen) {
+uint Glulx::read_memstate(dest_t *dest, uint chunklen, int portable) {
 	uint chunkend = dest->_pos + chunklen;
 	uint newlen;
 	uint res, pos;
@@ -505,6 +480,30 @@ uint Glulx::read_memstate(dest_t *dest, uint chunklen) {
 	if (res)
 		return res;
 
+	if (!portable) {
+		/* An undo state holds the memory as it is, so copy it straight
+		   back, skipping over the protected range. */
+		if (chunklen != 4 + endmem - ramstart)
+			return 1;
+
+		for (pos = ramstart; pos < endmem;) {
+			uint len = endmem - pos;
+			if (pos >= protectstart && pos < protectend) {
+				len = MIN(protectend, endmem) - pos;
+				dest->_pos += len;
+			} else {
+				if (pos < protectstart && protectstart < endmem)
+					len = protectstart - pos;
+				res = read_buffer(dest, memmap + pos, len);
+				if (res)
+					return res;
+			}
+			pos += len;
+		}
+
+		return 0;
+	}
+
 	runlen = 0;
 
 #ifdef SERIALIZE_CACHE_RAM
@@ -114,6 +114,10 @@ void Glulx::finalize_vm() {
 		glulx_free(stack);
 		stack = nullptr;
 	}
+	if (decoded_cache) {
+		glulx_free(decoded_cache);
+		decoded_cache = nullptr;
+	}
 
 	final_serial();
 }
@@ -20,6 +20,7 @@ MODULE_OBJS := \
 	speech.o \
 	streams.o \
 	time.o \
+	undo_store.o \
 	unicode.o \
 	unicode_gen.o \
 	utils.o \
@@ -132,6 +132,15 @@ public:
 	 * @returns         Width of string multiplied by GLI_SUBPIX
 	 */
 	size_t stringWidthUni(int fontIdx, const Common::U32String &text, int spw = 0);
+
+	/**
+	 * Get the width in pixels a character adds to a unicode string
+	 * @param fontIdx   Which font to use
+	 * @param prevCh    Preceding character of the string for kerning, or 0 at the start
+	 * @param ch        Character to get the width of
+	 * @returns         Width of character multiplied by GLI_SUBPIX
+	 */
+	size_t charWidthUni(int fontIdx, uint32 prevCh, uint32 ch);
 };
 
 } // End of namespace Glk
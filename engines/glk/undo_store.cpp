@@ -0,0 +1,155 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "glk/undo_store.h"
+
+namespace Glk {
+
+UndoStore::UndoStore() : _hasCurrent(false), _deltaCount(0), _deltaBytes(0), _budget(0), _maxStates(0) {
+}
+
+void UndoStore::setLimits(size_t budget, uint maxStates) {
+	_budget = budget;
+	_maxStates = maxStates;
+	trim();
+}
+
+void UndoStore::clear() {
+	_current.clear();
+	_hasCurrent = false;
+	_deltas.clear();
+	_deltaCount = 0;
+	_deltaBytes = 0;
+}
+
+void UndoStore::push(const byte *data, uint32 size) {
+	if (_hasCurrent) {
+		// Size the delta first, so that it is allocated exactly once with no slack
+		uint32 deltaSize = encodeDelta(_current.data(), _current.size(), data, size, nullptr);
+
+		_deltas.push_front(Delta());
+		Delta &delta = _deltas.front();
+		delta._size = _current.size();
+		delta._data.resize(deltaSize);
+		if (deltaSize)
+			encodeDelta(_current.data(), _current.size(), data, size, delta._data.data());
+
+		_deltaCount++;
+		_deltaBytes += delta._data.size();
+	}
+
+	_current.resize(size);
+	if (size)
+		memcpy(_current.data(), data, size);
+	_hasCurrent = true;
+
+	trim();
+}
+
+void UndoStore::pop() {
+	assert(_hasCurrent);
+
+	if (_deltas.empty()) {
+		_current.clear();
+		_hasCurrent = false;
+		return;
+	}
+
+	// Rebuild the previous state in place from the one being discarded
+	const Delta &delta = _deltas.front();
+	_current.resize(delta._size);
+	applyDelta(delta._data, _current.data());
+
+	_deltaBytes -= delta._data.size();
+	_deltaCount--;
+	_deltas.pop_front();
+}
+
+void UndoStore::trim() {
+	while (_deltaCount > 0 && (_deltaBytes > _budget || (_maxStates && _deltaCount >= _maxStates))) {
+		_deltaBytes -= _deltas.back()._data.size();
+		_deltaCount--;
+		_deltas.pop_back();
+	}
+}
+
+uint32 UndoStore::encodeDelta(const byte *older, uint32 olderSize, const byte *newer, uint32 newerSize, byte *dest) {
+	// A non-zero byte is XORed into the newer state, while a zero byte is followed by the
+	// number of unchanged bytes to skip. Unchanged bytes at the end aren't stored at all.
+	uint32 size = 0;
+	uint32 run = 0;
+
+	for (uint32 pos = 0; pos < olderSize; ++pos) {
+		byte c = older[pos];
+		if (pos < newerSize)
+			c ^= newer[pos];
+
+		if (c == 0) {
+			++run;
+			continue;
+		}
+
+		if (run) {
+			if (dest)
+				dest[size] = 0;
+			size++;
+			while (run >= 0x80) {
+				if (dest)
+					dest[size] = (byte)(run | 0x80);
+				size++;
+				run >>= 7;
+			}
+			if (dest)
+				dest[size] = (byte)run;
+			size++;
+			run = 0;
+		}
+		if (dest)
+			dest[size] = c;
+		size++;
+	}
+
+	return size;
+}
+
+void UndoStore::applyDelta(const Common::Array<byte> &delta, byte *data) {
+	const byte *src = delta.data();
+	const byte *end = src + delta.size();
+
+	while (src < end) {
+		byte c = *src++;
+		if (c) {
+			*data++ ^= c;
+			continue;
+		}
+
+		uint32 run = 0;
+		for (int shift = 0; src < end; shift += 7) {
+			c = *src++;
+			run |= (uint32)(c & 0x7f) << shift;
+			if (!(c & 0x80))
+				break;
+		}
+		data += run;
+	}
+}
+
+} // End of namespace Glk
@@ -0,0 +1,113 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GLK_UNDO_STORE_H
+#define GLK_UNDO_STORE_H
+
+#include "common/array.h"
+#include "common/list.h"
+
+namespace Glk {
+
+/**
+ * Stack of saved interpreter states used to implement undo.
+ *
+ * Only the most recently saved state is kept as a complete image. Every older
+ * state is stored as a run-length encoded XOR delta against the state saved
+ * after it, so a turn which only changes a few bytes of memory only costs a few
+ * bytes to remember. Once the deltas grow beyond the byte budget, or there are
+ * more states than allowed, the oldest states are discarded.
+ */
+class UndoStore {
+	struct Delta {
+		uint32 _size;					///< Size of the state the delta restores
+		Common::Array<byte> _data;		///< Encoded difference to the newer state
+	};
+private:
+	Common::Array<byte> _current;
+	bool _hasCurrent;
+	Common::List<Delta> _deltas;		///< Newest first
+	uint _deltaCount;
+	size_t _deltaBytes;
+	size_t _budget;
+	uint _maxStates;
+private:
+	/**
+	 * Encodes the bytes needed to turn newer into older, and returns the encoded size.
+	 * When dest is null, only the size is calculated
+	 */
+	static uint32 encodeDelta(const byte *older, uint32 olderSize, const byte *newer, uint32 newerSize, byte *dest);
+
+	/**
+	 * Applies an encoded delta to data, which must already be resized to the delta's size
+	 */
+	static void applyDelta(const Common::Array<byte> &delta, byte *data);
+
+	/**
+	 * Discards the oldest states until the store fits within its limits
+	 */
+	void trim();
+public:
+	/**
+	 * Constructor
+	 */
+	UndoStore();
+
+	/**
+	 * Sets the number of bytes the older states may use, and optionally the
+	 * maximum number of states to keep. The newest state is always kept.
+	 */
+	void setLimits(size_t budget, uint maxStates = 0);
+
+	/**
+	 * Discards all saved states
+	 */
+	void clear();
+
+	/**
+	 * Returns true if there are no saved states
+	 */
+	bool empty() const { return !_hasCurrent; }
+
+	/**
+	 * Returns the number of saved states
+	 */
+	uint size() const { return _hasCurrent ? _deltaCount + 1 : 0; }
+
+	/**
+	 * Saves a new state on top of the stack
+	 */
+	void push(const byte *data, uint32 size);
+
+	/**
+	 * Returns the most recently saved state. The store must not be empty
+	 */
+	const Common::Array<byte> &top() const { return _current; }
+
+	/**
+	 * Discards the most recently saved state, making the one before it the top
+	 */
+	void pop();
+};
+
+} // End of namespace Glk
+
+#endif
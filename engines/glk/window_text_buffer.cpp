@@ -40,7 +40,7 @@ TextBufferWindow::TextBufferWindow(Windows *windows, uint rock) : TextWindow(win
 		_lastSeen(0), _scrollPos(0), _scrollMax(0), _scrollBack(SCROLLBACK), _width(-1), _height(-1),
 		_inBuf(nullptr), _lineTerminators(nullptr), _echoLineInput(true), _ladjw(0), _radjw(0),
 		_ladjn(0), _radjn(0), _numChars(0), _chars(nullptr), _attrs(nullptr), _spaced(0), _dashed(0),
-		_copyBuf(nullptr), _copyPos(0) {
+		_copyBuf(nullptr), _copyPos(0), _reflowing(false), _lineWidthsLen(0) {
 	_type = wintype_TextBuffer;
 	_history.resize(HISTORYLEN);
 
@@ -199,6 +199,8 @@ void TextBufferWindow::reflow() {
 	clear();
 
 	// and dump text back
+	_reflowing = true;
+	_lineWidthsLen = 0;
 	x = 0;
 	for (i = 0; i < p; i++) {
 		if (i == inputbyte)
@@ -212,6 +214,7 @@ void TextBufferWindow::reflow() {
 
 		putCharUni(charbuf[i]);
 	}
+	_reflowing = false;
 
 	// terribly sorry about this...
 	_lastSeen = 0;
@@ -478,6 +481,7 @@ void TextBufferWindow::putCharUni(uint32 ch) {
 		}
 	}
 
+	_lineWidthsLen = MIN(_lineWidthsLen, _numChars);
 	_chars[_numChars] = ch;
 	_attrs[_numChars] = _attr;
 	_numChars++;
@@ -489,7 +493,7 @@ void TextBufferWindow::putCharUni(uint32 ch) {
 			&& !_styles[_attrs[linelen - 1].style].reverse)
 		linelen--;
 
-	if (calcWidth(_chars, _attrs, 0, linelen, -1) >= pw) {
+	if (lineWidth(linelen) >= pw) {
 		bpoint = _numChars;
 
 		for (i = _numChars - 1; i > 0; i--) {
@@ -510,6 +514,7 @@ void TextBufferWindow::putCharUni(uint32 ch) {
 		memcpy(_chars, bchars, saved * 4);
 		memcpy(_attrs, battrs, saved * sizeof(Attributes));
 		_numChars = saved;
+		_lineWidthsLen = 0;
 	}
 
 	touch(0);
@@ -1549,11 +1554,16 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 	_lines[0]._len = _numChars;
 	_lines[0]._newLine = forced;
 
-	for (int i = _scrollBack - 1; i > 0; i--) {
-		memcpy(&_lines[i], &_lines[i - 1], sizeof(TextBufferRow));
-		if (i < _height)
-			touch(i);
-	}
+	// The oldest row is recycled as the new first row
+	bool repaint = _lines[0]._repaint;
+	_lines.rotate();
+	_lines[0]._repaint = repaint;
+	_chars = _lines[0]._chars;
+	_attrs = _lines[0]._attrs;
+	_lineWidthsLen = 0;
+
+	for (int i = MIN(_height, _scrollBack) - 1; i > 0; i--)
+		touch(i);
 
 	if (_radjn)
 		_radjn--;
@@ -1611,6 +1621,23 @@ void TextBufferWindow::scrollResize() {
 	_scrollBack += SCROLLBACK;
 }
 
+int TextBufferWindow::lineWidth(int numChars) {
+	if (!_reflowing)
+		return calcWidth(_chars, _attrs, 0, numChars, -1);
+
+	// Characters of the same attributes are measured as one string by calcWidth, so
+	// they are kerned against the previous character within that run only
+	Screen &screen = *g_vm->_screen;
+	for (int i = _lineWidthsLen; i < numChars; i++) {
+		uint32 prevCh = (i > 0 && _attrs[i] == _attrs[i - 1]) ? _chars[i - 1] : 0;
+		_lineWidths[i] = (i > 0 ? _lineWidths[i - 1] : 0) +
+			(int)screen.charWidthUni(_attrs[i].attrFont(_styles), prevCh, _chars[i]);
+	}
+	_lineWidthsLen = MAX(_lineWidthsLen, numChars);
+
+	return numChars > 0 ? _lineWidths[numChars - 1] : 0;
+}
+
 int TextBufferWindow::calcWidth(const uint32 *chars, const Attributes *attrs, int startchar, int numChars, int spw) {
 	Screen &screen = *g_vm->_screen;
 	int w = 0;
@@ -1644,6 +1671,20 @@ void TextBufferWindow::flowBreak() {
 
 /*--------------------------------------------------------------------------*/
 
+void TextBufferWindow::TextBufferRows::resize(uint newSize) {
+	if (_first) {
+		// Straighten out the ring first, so the new rows go after the oldest one
+		Common::Array<TextBufferRow> rows;
+		rows.reserve(newSize);
+		for (uint i = 0; i < _rows.size(); i++)
+			rows.push_back((*this)[i]);
+		_rows.swap(rows);
+		_first = 0;
+	}
+
+	_rows.resize(newSize);
+}
+
 TextBufferWindow::TextBufferRow::TextBufferRow() : _len(0), _newLine(0), _dirty(false),
 	_repaint(false), _lPic(nullptr), _rPic(nullptr), _lHyper(0), _rHyper(0),
 	_lm(0), _rm(0) {
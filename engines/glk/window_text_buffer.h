@@ -52,7 +52,44 @@ class TextBufferWindow : public TextWindow, Speech {
 		 */
 		TextBufferRow();
 	};
-	typedef Common::Array<TextBufferRow> TextBufferRows;
+
+	/**
+	 * The scrollback rows, newest first. They are kept in a ring, so that scrolling
+	 * in a new row doesn't have to move every other row down by one.
+	 */
+	class TextBufferRows {
+	private:
+		Common::Array<TextBufferRow> _rows;
+		uint _first;
+	public:
+		TextBufferRows() : _first(0) {}
+
+		uint size() const {
+			return _rows.size();
+		}
+
+		/**
+		 * Change the number of rows, keeping the existing rows in order
+		 */
+		void resize(uint newSize);
+
+		/**
+		 * Make the oldest row the first one, moving all the others down by one
+		 */
+		void rotate() {
+			_first = (_first ? _first : _rows.size()) - 1;
+		}
+
+		TextBufferRow &operator[](uint idx) {
+			idx += _first;
+			return _rows[idx < _rows.size() ? idx : idx - _rows.size()];
+		}
+
+		const TextBufferRow &operator[](uint idx) const {
+			idx += _first;
+			return _rows[idx < _rows.size() ? idx : idx - _rows.size()];
+		}
+	};
 private:
 	PropFontInfo &_font;
 private:
@@ -91,6 +128,16 @@ private:
 	void scrollOneLine(bool forced);
 	void scrollResize();
 	int calcWidth(const uint32 *chars, const Attributes *attrs, int startchar, int numchars, int spw);
+
+	/**
+	 * Width of the first numChars characters of the current line, like calcWidth().
+	 * During a reflow the widths of the characters added so far are remembered.
+	 */
+	int lineWidth(int numChars);
+private:
+	bool _reflowing;              ///< Set while reflow() puts the scrollback text back
+	int _lineWidthsLen;           ///< Number of valid entries in _lineWidths
+	int _lineWidths[TBLINELEN];   ///< _lineWidths[i] is the width of the first i + 1 chars
 public:
 	int _width, _height;
 	int _spaced;
@@ -29,6 +29,7 @@ namespace Glk {
 namespace ZCode {
 
 #define MAX_UNDO_SLOTS 500
+#define MAX_UNDO_SIZE (1024 * 1024)
 #define STACK_SIZE 32768
 
 #define lo(v)	(v & 0xff)
@@ -39,7 +39,7 @@ public:
 
 	int getMaximumSaveSlot() const override;
 	SaveStateList listSaves(const char *target) const override;
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 	bool removeSaveState(const char *target, int slot) const override;
 };
 
@@ -98,7 +98,7 @@ SaveStateList GnapMetaEngine::listSaves(const char *target) const {
 	return saveList;
 }
 
-SaveStateDescriptor GnapMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
+SaveStateDescriptor GnapMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
 	Common::String fileName = Common::String::format("%s.%03d", target, slot);
 	Common::InSaveFile *file = g_system->getSavefileManager()->openForLoading(fileName);
 	if (file) {
@@ -138,7 +138,7 @@ public:
 	SaveStateList listSaves(const char *target) const override;
 	int getMaximumSaveSlot() const override;
 	bool removeSaveState(const char *target, int slot) const override;
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 	int getAutosaveSlot() const override;
 
 	Common::KeymapArray initKeymaps(const char *target) const override;
@@ -181,7 +181,7 @@ bool GroovieMetaEngine::removeSaveState(const char *target, int slot) const {
 	return g_system->getSavefileManager()->removeSavefile(filename);
 }
 
-SaveStateDescriptor GroovieMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
+SaveStateDescriptor GroovieMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
 	SaveStateDescriptor desc;
 
 	Common::InSaveFile *savefile = SaveLoad::openForLoading(target, slot, &desc);
@@ -93,7 +93,7 @@ public:
 
 	bool removeSaveState(const char *target, int slot) const override;
 	SaveStateList listSaves(const char *target) const override;
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 	Common::KeymapArray initKeymaps(const char *target) const override;
 	Common::Error createInstance(OSystem *syst, Engine **engine, const ADGameDescription *desc) const override;
 };
@@ -170,7 +170,7 @@ SaveStateList HDBMetaEngine::listSaves(const char *target) const {
 	return saveList;
 }
 
-SaveStateDescriptor HDBMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
+SaveStateDescriptor HDBMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
 	Common::ScopedPtr<Common::InSaveFile> in(g_system->getSavefileManager()->openForLoading(Common::String::format("%s.%03d", target, slot)));
 
 	if (in) {
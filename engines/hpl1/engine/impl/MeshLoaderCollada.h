@@ -37,6 +37,11 @@
 
 class TiXmlElement;
 
+namespace Common {
+class SeekableReadStream;
+class WriteStream;
+} // namespace Common
+
 namespace hpl {
 
 class cMesh;
@@ -497,7 +502,7 @@ private:
 						cColladaScene *apColladaScene,
 						bool abCache);
 
-	bool SaveStructures(const tString &asFile,
+	bool SaveStructures(Common::WriteStream &aStream,
 						tColladaImageVec *apColladaImageVec,
 						tColladaTextureVec *apColladaTextureVec,
 						tColladaMaterialVec *apColladaMaterialVec,
@@ -507,7 +512,7 @@ private:
 						tColladaAnimationVec *apColladaAnimVec,
 						cColladaScene *apColladaScene);
 
-	bool LoadStructures(const tString &asFile,
+	bool LoadStructures(Common::SeekableReadStream &aStream,
 						tColladaImageVec *apColladaImageVec,
 						tColladaTextureVec *apColladaTextureVec,
 						tColladaMaterialVec *apColladaMaterialVec,
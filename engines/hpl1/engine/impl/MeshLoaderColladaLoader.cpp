@@ -46,6 +46,9 @@
 #include "hpl1/engine/impl/tinyXML/tinyxml.h"
 
 #include "hpl1/engine/math/Math.h"
+#include "hpl1/mesh_cache.h"
+
+#include "common/ptr.h"
 
 namespace hpl {
 
@@ -66,39 +69,25 @@ bool cMeshLoaderCollada::FillStructures(const tString &asFile,
 										tColladaControllerVec *apColladaControllerVec,
 										tColladaAnimationVec *apColladaAnimVec,
 										cColladaScene *apColladaScene, bool abCache) {
-	abCache = false; // FIXME: find a way to enable the use of cache files
-	bool bLoadCache = false;
-	// abCache = false;
 	// Log("Loading %s\n",asFile.c_str());
 
-	tString sCacheFile = cString::GetFileName(cString::SetFileExt(asFile, "collcach"));
-	sCacheFile = "core/cache/" + sCacheFile;
-
-	if (abCache &&
-		FileExists(cString::To16Char(sCacheFile)) &&
-		FileExists(cString::To16Char(asFile))) {
-		cDate colladaDate = FileModifiedDate(cString::To16Char(asFile));
-		cDate cacheDate = FileModifiedDate(cString::To16Char(sCacheFile));
-
-		// Check if cache is newer
-		if (cacheDate > colladaDate)
-			bLoadCache = true;
-	}
+	Hpl1::MeshCache cache(asFile, Hpl1::kMeshCacheCollada);
 
 	/////////////////////////////////////////////////
 	// LOAD CACHE
-	if (bLoadCache) {
-		return LoadStructures(sCacheFile,
-							  apColladaImageVec,
-							  apColladaTextureVec,
-							  apColladaMaterialVec,
-							  apColladaLightVec,
-							  apColladaGeometryVec,
-							  apColladaControllerVec,
-							  apColladaAnimVec,
-							  apColladaScene);
-	} else if (abCache) {
-		Log("Cache out of date! Reloading collada file '%s'\n and generating cache files", asFile.c_str());
+	if (abCache) {
+		Common::ScopedPtr<Common::SeekableReadStream> cacheStream(cache.load());
+		if (cacheStream && LoadStructures(*cacheStream,
+										  apColladaImageVec,
+										  apColladaTextureVec,
+										  apColladaMaterialVec,
+										  apColladaLightVec,
+										  apColladaGeometryVec,
+										  apColladaControllerVec,
+										  apColladaAnimVec,
+										  apColladaScene)) {
+			return true;
+		}
 	}
 
 	/////////////////////////////////////////////////
@@ -264,14 +253,17 @@ bool cMeshLoaderCollada::FillStructures(const tString &asFile,
 	}
 
 	if (abCache) {
-		SaveStructures(sCacheFile, apColladaImageVec,
-					   apColladaTextureVec,
-					   apColladaMaterialVec,
-					   apColladaLightVec,
-					   apColladaGeometryVec,
-					   apColladaControllerVec,
-					   apColladaAnimVec,
-					   apColladaScene);
+		Common::ScopedPtr<Common::WriteStream> cacheStream(cache.save());
+		if (cacheStream) {
+			SaveStructures(*cacheStream, apColladaImageVec,
+						   apColladaTextureVec,
+						   apColladaMaterialVec,
+						   apColladaLightVec,
+						   apColladaGeometryVec,
+						   apColladaControllerVec,
+						   apColladaAnimVec,
+						   apColladaScene);
+		}
 	}
 	hplDelete(pXmlDoc);
 	return true;
@@ -279,26 +271,36 @@ bool cMeshLoaderCollada::FillStructures(const tString &asFile,
 
 //--------------------------------------------------------------------------
 
+
 //////////////////////////////////////////////////////////////////////////
 // SAVE COLLADA DATA
 //////////////////////////////////////////////////////////////////////////
 
-#define CreateXMLChild(parent, name) static_cast<TiXmlElement *>(parent->InsertEndChild(TiXmlElement(name)));
-
-#define CreateXMLTextChild(parent, name) static_cast<TiXmlText *>(parent->InsertEndChild(TiXmlText(name)));
-
 //-----------------------------------------------------------------------
 
-static void SaveImageVec(TiXmlElement *apRootElem, tColladaImageVec *apColladaImageVec);
-static void SaveTextureVec(TiXmlElement *apRootElem, tColladaTextureVec *apColladaTextureVec);
-static void SaveMaterialVec(TiXmlElement *apRootElem, tColladaMaterialVec *apColladaMaterialVec);
-static void SaveLightVec(TiXmlElement *apRootElem, tColladaLightVec *apColladaLightVec);
-static void SaveAnimationVec(TiXmlElement *apRootElem, tColladaAnimationVec *apColladaAnimationVec);
-static void SaveControllerVec(TiXmlElement *apRootElem, tColladaControllerVec *apColladaControllerVec);
-static void SaveGeometryVec(TiXmlElement *apRootElem, tColladaGeometryVec *apColladaGeometryVec);
-static void SaveScene(TiXmlElement *apRootElem, cColladaScene *apColladaScene);
-
-bool cMeshLoaderCollada::SaveStructures(const tString &asFile,
+using Hpl1::MeshCache;
+
+enum eColladaCacheSection {
+	eColladaCacheSection_Images = 0x0001,
+	eColladaCacheSection_Textures = 0x0002,
+	eColladaCacheSection_Materials = 0x0004,
+	eColladaCacheSection_Lights = 0x0008,
+	eColladaCacheSection_Animations = 0x0010,
+	eColladaCacheSection_Controllers = 0x0020,
+	eColladaCacheSection_Geometries = 0x0040,
+	eColladaCacheSection_Scene = 0x0080
+};
+
+static void SaveImageVec(Common::WriteStream &aStream, tColladaImageVec *apColladaImageVec);
+static void SaveTextureVec(Common::WriteStream &aStream, tColladaTextureVec *apColladaTextureVec);
+static void SaveMaterialVec(Common::WriteStream &aStream, tColladaMaterialVec *apColladaMaterialVec);
+static void SaveLightVec(Common::WriteStream &aStream, tColladaLightVec *apColladaLightVec);
+static void SaveAnimationVec(Common::WriteStream &aStream, tColladaAnimationVec *apColladaAnimationVec);
+static void SaveControllerVec(Common::WriteStream &aStream, tColladaControllerVec *apColladaControllerVec);
+static void SaveGeometryVec(Common::WriteStream &aStream, tColladaGeometryVec *apColladaGeometryVec);
+static void SaveScene(Common::WriteStream &aStream, cColladaScene *apColladaScene);
+
+bool cMeshLoaderCollada::SaveStructures(Common::WriteStream &aStream,
 										tColladaImageVec *apColladaImageVec,
 										tColladaTextureVec *apColladaTextureVec,
 										tColladaMaterialVec *apColladaMaterialVec,
@@ -307,465 +309,297 @@ bool cMeshLoaderCollada::SaveStructures(const tString &asFile,
 										tColladaControllerVec *apColladaControllerVec,
 										tColladaAnimationVec *apColladaAnimVec,
 										cColladaScene *apColladaScene) {
-	TiXmlDocument *pXmlDoc = hplNew(TiXmlDocument, (asFile.c_str()));
-
-	TiXmlElement *pRootElem = CreateXMLChild(pXmlDoc, "ColladaCache");
+	uint32 lSections = 0;
+	if (apColladaImageVec)
+		lSections |= eColladaCacheSection_Images;
+	if (apColladaTextureVec)
+		lSections |= eColladaCacheSection_Textures;
+	if (apColladaMaterialVec)
+		lSections |= eColladaCacheSection_Materials;
+	if (apColladaLightVec)
+		lSections |= eColladaCacheSection_Lights;
+	if (apColladaAnimVec)
+		lSections |= eColladaCacheSection_Animations;
+	if (apColladaControllerVec)
+		lSections |= eColladaCacheSection_Controllers;
+	if (apColladaGeometryVec)
+		lSections |= eColladaCacheSection_Geometries;
+	if (apColladaScene)
+		lSections |= eColladaCacheSection_Scene;
+	aStream.writeUint32LE(lSections);
 
 	if (apColladaImageVec)
-		SaveImageVec(pRootElem, apColladaImageVec);
+		SaveImageVec(aStream, apColladaImageVec);
 	if (apColladaTextureVec)
-		SaveTextureVec(pRootElem, apColladaTextureVec);
+		SaveTextureVec(aStream, apColladaTextureVec);
 	if (apColladaMaterialVec)
-		SaveMaterialVec(pRootElem, apColladaMaterialVec);
+		SaveMaterialVec(aStream, apColladaMaterialVec);
 	if (apColladaLightVec)
-		SaveLightVec(pRootElem, apColladaLightVec);
+		SaveLightVec(aStream, apColladaLightVec);
 	if (apColladaAnimVec)
-		SaveAnimationVec(pRootElem, apColladaAnimVec);
+		SaveAnimationVec(aStream, apColladaAnimVec);
 	if (apColladaControllerVec)
-		SaveControllerVec(pRootElem, apColladaControllerVec);
+		SaveControllerVec(aStream, apColladaControllerVec);
 	if (apColladaGeometryVec)
-		SaveGeometryVec(pRootElem, apColladaGeometryVec);
+		SaveGeometryVec(aStream, apColladaGeometryVec);
 	if (apColladaScene)
-		SaveScene(pRootElem, apColladaScene);
+		SaveScene(aStream, apColladaScene);
 
-	if (pXmlDoc->SaveFile() == false) {
-		Error("Couldn't save XML file %s\n", asFile.c_str());
-		hplDelete(pXmlDoc);
+	aStream.finalize();
+	if (aStream.err()) {
+		Warning("Couldn't write collada cache\n");
 		return false;
 	}
-	hplDelete(pXmlDoc);
 	return true;
 }
 
 //-----------------------------------------------------------------------
 
-static void SaveImageVec(TiXmlElement *apRootElem, tColladaImageVec *apColladaImageVec) {
-	TiXmlElement *pImageRootElem = CreateXMLChild(apRootElem, "ImageRoot");
+static void SaveStringVec(Common::WriteStream &aStream, const tStringVec &avStrings) {
+	aStream.writeUint32LE(avStrings.size());
+	for (size_t i = 0; i < avStrings.size(); ++i)
+		MeshCache::writeString(aStream, avStrings[i]);
+}
 
-	pImageRootElem->SetAttribute("Size", (int)apColladaImageVec->size());
+static void SaveFloatVec(Common::WriteStream &aStream, const tFloatVec &avValues) {
+	aStream.writeUint32LE(avValues.size());
+	MeshCache::writeFloats(aStream, avValues.data(), avValues.size());
+}
 
-	for (size_t i = 0; i < apColladaImageVec->size(); ++i) {
-		cColladaImage *pImage = &(*apColladaImageVec)[i];
+static void SaveVector3fVec(Common::WriteStream &aStream, const tVector3fVec &avValues) {
+	aStream.writeUint32LE(avValues.size());
+	for (size_t i = 0; i < avValues.size(); ++i)
+		MeshCache::writeVector3f(aStream, avValues[i]);
+}
 
-		TiXmlElement *pImageElem = CreateXMLChild(pImageRootElem, "Image");
+//-----------------------------------------------------------------------
 
-		pImageElem->SetAttribute("Id", pImage->msId.c_str());
-		pImageElem->SetAttribute("Name", pImage->msName.c_str());
-		pImageElem->SetAttribute("Source", cString::GetFileName(pImage->msSource.c_str()).c_str());
+static void SaveImageVec(Common::WriteStream &aStream, tColladaImageVec *apColladaImageVec) {
+	aStream.writeUint32LE(apColladaImageVec->size());
+	for (size_t i = 0; i < apColladaImageVec->size(); ++i) {
+		cColladaImage *pImage = &(*apColladaImageVec)[i];
+		MeshCache::writeString(aStream, pImage->msId);
+		MeshCache::writeString(aStream, pImage->msName);
+		MeshCache::writeString(aStream, pImage->msSource);
 	}
 }
 
 //-----------------------------------------------------------------------
 
-static void SaveTextureVec(TiXmlElement *apRootElem, tColladaTextureVec *apColladaTextureVec) {
-	TiXmlElement *pTextureRootElem = CreateXMLChild(apRootElem, "TextureRoot");
-
-	pTextureRootElem->SetAttribute("Size", (int)apColladaTextureVec->size());
-
+static void SaveTextureVec(Common::WriteStream &aStream, tColladaTextureVec *apColladaTextureVec) {
+	aStream.writeUint32LE(apColladaTextureVec->size());
 	for (size_t i = 0; i < apColladaTextureVec->size(); ++i) {
 		cColladaTexture *pTexture = &(*apColladaTextureVec)[i];
-
-		TiXmlElement *pTextureElem = CreateXMLChild(pTextureRootElem, "Texture");
-
-		pTextureElem->SetAttribute("Id", pTexture->msId.c_str());
-		pTextureElem->SetAttribute("Name", pTexture->msName.c_str());
-		pTextureElem->SetAttribute("Image", pTexture->msImage.c_str());
+		MeshCache::writeString(aStream, pTexture->msId);
+		MeshCache::writeString(aStream, pTexture->msName);
+		MeshCache::writeString(aStream, pTexture->msImage);
 	}
 }
 
 //-----------------------------------------------------------------------
 
-static void SaveMaterialVec(TiXmlElement *apRootElem, tColladaMaterialVec *apColladaMaterialVec) {
-	TiXmlElement *pMaterialRootElem = CreateXMLChild(apRootElem, "MaterialRoot");
-
-	pMaterialRootElem->SetAttribute("Size", (int)apColladaMaterialVec->size());
-
+static void SaveMaterialVec(Common::WriteStream &aStream, tColladaMaterialVec *apColladaMaterialVec) {
+	aStream.writeUint32LE(apColladaMaterialVec->size());
 	for (size_t i = 0; i < apColladaMaterialVec->size(); ++i) {
 		cColladaMaterial *pMaterial = &(*apColladaMaterialVec)[i];
-
-		TiXmlElement *pMaterialElem = CreateXMLChild(pMaterialRootElem, "Material");
-
-		pMaterialElem->SetAttribute("Id", pMaterial->msId.c_str());
-		pMaterialElem->SetAttribute("Name", pMaterial->msName.c_str());
-		pMaterialElem->SetAttribute("Texture", pMaterial->msTexture.c_str());
-		pMaterialElem->SetAttribute("Color", pMaterial->mDiffuseColor.ToFileString().c_str());
+		MeshCache::writeString(aStream, pMaterial->msId);
+		MeshCache::writeString(aStream, pMaterial->msName);
+		MeshCache::writeString(aStream, pMaterial->msTexture);
+		MeshCache::writeColor(aStream, pMaterial->mDiffuseColor);
 	}
 }
 
 //-----------------------------------------------------------------------
 
-static void SaveLightVec(TiXmlElement *apRootElem, tColladaLightVec *apColladaLightVec) {
-	TiXmlElement *pLightRootElem = CreateXMLChild(apRootElem, "LightRoot");
-
-	pLightRootElem->SetAttribute("Size", (int)apColladaLightVec->size());
-
+static void SaveLightVec(Common::WriteStream &aStream, tColladaLightVec *apColladaLightVec) {
+	aStream.writeUint32LE(apColladaLightVec->size());
 	for (size_t i = 0; i < apColladaLightVec->size(); ++i) {
 		cColladaLight *pLight = &(*apColladaLightVec)[i];
-
-		TiXmlElement *pLightElem = CreateXMLChild(pLightRootElem, "Light");
-
-		// Log("Light %s\n",pLight->msName.c_str());
-
-		pLightElem->SetAttribute("Id", pLight->msId.c_str());
-		pLightElem->SetAttribute("Name", pLight->msName.c_str());
-		pLightElem->SetAttribute("Type", pLight->msType.c_str());
-
-		pLightElem->SetAttribute("Angle", cString::ToString(pLight->mfAngle).c_str());
-		pLightElem->SetAttribute("Color", pLight->mDiffuseColor.ToFileString().c_str());
+		MeshCache::writeString(aStream, pLight->msId);
+		MeshCache::writeString(aStream, pLight->msName);
+		MeshCache::writeString(aStream, pLight->msType);
+		MeshCache::writeColor(aStream, pLight->mDiffuseColor);
+		aStream.writeFloatLE(pLight->mfAngle);
 	}
 }
 
 //-----------------------------------------------------------------------
 
-static void SaveAnimationVec(TiXmlElement *apRootElem, tColladaAnimationVec *apColladaAnimationVec) {
-	TiXmlElement *pAnimationRootElem = CreateXMLChild(apRootElem, "AnimationRoot");
-
-	pAnimationRootElem->SetAttribute("Size", (int)apColladaAnimationVec->size());
-
+static void SaveAnimationVec(Common::WriteStream &aStream, tColladaAnimationVec *apColladaAnimationVec) {
+	aStream.writeUint32LE(apColladaAnimationVec->size());
 	for (size_t i = 0; i < apColladaAnimationVec->size(); ++i) {
 		cColladaAnimation *pAnimation = &(*apColladaAnimationVec)[i];
-
-		TiXmlElement *pAnimationElem = CreateXMLChild(pAnimationRootElem, "Animation");
-
-		pAnimationElem->SetAttribute("Id", pAnimation->msId.c_str());
-		pAnimationElem->SetAttribute("TargetNode", pAnimation->msTargetNode.c_str());
-
-		/////////////////////////////////////
-		// Channels
-		{
-			TiXmlElement *pChannelVecElem = CreateXMLChild(pAnimationElem, "ChannelVec");
-			pChannelVecElem->SetAttribute("Size", (int)pAnimation->mvChannels.size());
-
-			for (size_t idx = 0; idx < pAnimation->mvChannels.size(); ++idx) {
-				cColladaChannel *pChannel = &pAnimation->mvChannels[idx];
-				TiXmlElement *pChannelElem = CreateXMLChild(pChannelVecElem, "Channel");
-
-				pChannelElem->SetAttribute("Id", pChannel->msId.c_str());
-				pChannelElem->SetAttribute("Target", pChannel->msTarget.c_str());
-				pChannelElem->SetAttribute("Source", pChannel->msSource.c_str());
-			}
+		MeshCache::writeString(aStream, pAnimation->msId);
+		MeshCache::writeString(aStream, pAnimation->msTargetNode);
+
+		aStream.writeUint32LE(pAnimation->mvChannels.size());
+		for (size_t idx = 0; idx < pAnimation->mvChannels.size(); ++idx) {
+			cColladaChannel *pChannel = &pAnimation->mvChannels[idx];
+			MeshCache::writeString(aStream, pChannel->msId);
+			MeshCache::writeString(aStream, pChannel->msTarget);
+			MeshCache::writeString(aStream, pChannel->msSource);
 		}
-		/////////////////////////////////////
-		// Samplers
-		{
-			TiXmlElement *pSamplerVecElem = CreateXMLChild(pAnimationElem, "SamplerVec");
-			pSamplerVecElem->SetAttribute("Size", (int)pAnimation->mvSamplers.size());
-
-			for (size_t idx = 0; idx < pAnimation->mvSamplers.size(); ++idx) {
-				cColladaSampler *pSampler = &pAnimation->mvSamplers[idx];
-				TiXmlElement *pSamplerElem = CreateXMLChild(pSamplerVecElem, "Sampler");
-
-				pSamplerElem->SetAttribute("Id", pSampler->msId.c_str());
-				pSamplerElem->SetAttribute("TimeArray", pSampler->msTimeArray.c_str());
-				pSamplerElem->SetAttribute("ValueArray", pSampler->msValueArray.c_str());
-				pSamplerElem->SetAttribute("Target", pSampler->msTarget.c_str());
-			}
+
+		aStream.writeUint32LE(pAnimation->mvSamplers.size());
+		for (size_t idx = 0; idx < pAnimation->mvSamplers.size(); ++idx) {
+			cColladaSampler *pSampler = &pAnimation->mvSamplers[idx];
+			MeshCache::writeString(aStream, pSampler->msId);
+			MeshCache::writeString(aStream, pSampler->msTimeArray);
+			MeshCache::writeString(aStream, pSampler->msValueArray);
+			MeshCache::writeString(aStream, pSampler->msTarget);
 		}
-		/////////////////////////////////////
-		// Sources
-		{
-			TiXmlElement *pSourceVecElem = CreateXMLChild(pAnimationElem, "SourceVec");
-			pSourceVecElem->SetAttribute("Size", (int)pAnimation->mvSources.size());
-
-			for (size_t idx = 0; idx < pAnimation->mvSources.size(); ++idx) {
-				cColladaAnimSource *pSource = &pAnimation->mvSources[idx];
-				TiXmlElement *pSourceElem = CreateXMLChild(pSourceVecElem, "Source");
-
-				pSourceElem->SetAttribute("Id", pSource->msId.c_str());
-				tString sData = "";
-				for (size_t j = 0; j < pSource->mvValues.size(); ++j)
-					sData += cString::ToString(pSource->mvValues[j]) + " ";
-
-				pSourceElem->SetAttribute("Values", sData.c_str());
-			}
+
+		aStream.writeUint32LE(pAnimation->mvSources.size());
+		for (size_t idx = 0; idx < pAnimation->mvSources.size(); ++idx) {
+			cColladaAnimSource *pSource = &pAnimation->mvSources[idx];
+			MeshCache::writeString(aStream, pSource->msId);
+			SaveFloatVec(aStream, pSource->mvValues);
 		}
 	}
 }
 
 //-----------------------------------------------------------------------
 
-static void SaveControllerVec(TiXmlElement *apRootElem, tColladaControllerVec *apColladaControllerVec) {
-	TiXmlElement *pControllerRootElem = CreateXMLChild(apRootElem, "ControllerRoot");
-
-	pControllerRootElem->SetAttribute("Size", (int)apColladaControllerVec->size());
-
+static void SaveControllerVec(Common::WriteStream &aStream, tColladaControllerVec *apColladaControllerVec) {
+	aStream.writeUint32LE(apColladaControllerVec->size());
 	for (size_t i = 0; i < apColladaControllerVec->size(); ++i) {
 		cColladaController *pController = &(*apColladaControllerVec)[i];
-
-		TiXmlElement *pControllerElem = CreateXMLChild(pControllerRootElem, "Controller");
-
-		pControllerElem->SetAttribute("Id", pController->msId.c_str());
-		pControllerElem->SetAttribute("Target", pController->msTarget.c_str());
-
-		pControllerElem->SetAttribute("BindShapeMatrix", pController->m_mtxBindShapeMatrix.ToFileString().c_str());
-
-		pControllerElem->SetAttribute("JointPairIdx", pController->mlJointPairIdx);
-		pControllerElem->SetAttribute("WeightPairIdx", pController->mlWeightPairIdx);
-
-		///////////////////////
-		// Joints
-		{
-			TiXmlElement *pJointsElem = CreateXMLChild(pControllerElem, "Joints");
-			pJointsElem->SetAttribute("Size", (int)pController->mvJoints.size());
-
-			tString sData;
-			for (size_t idx = 0; idx < pController->mvJoints.size(); ++idx) {
-				sData += pController->mvJoints[idx] + " ";
-			}
-			CreateXMLTextChild(pJointsElem, sData.c_str());
-		}
-		///////////////////////
-		// Weights
-		{
-			TiXmlElement *pWeightsElem = CreateXMLChild(pControllerElem, "Weights");
-			pWeightsElem->SetAttribute("Size", (int)pController->mvWeights.size());
-
-			tString sData = "";
-			for (size_t idx = 0; idx < pController->mvWeights.size(); ++idx) {
-				sData += cString::ToString(pController->mvWeights[idx]) + " ";
-			}
-			CreateXMLTextChild(pWeightsElem, sData.c_str());
-		}
-		///////////////////////
-		// Matrices
-		{
-			TiXmlElement *pMatricesElem = CreateXMLChild(pControllerElem, "Matrices");
-			pMatricesElem->SetAttribute("Size", (int)pController->mvMatrices.size());
-
-			tString sData = "";
-			for (size_t idx = 0; idx < pController->mvMatrices.size(); ++idx) {
-				sData += pController->mvMatrices[idx].ToFileString() + " ";
-			}
-			CreateXMLTextChild(pMatricesElem, sData.c_str());
-		}
-		///////////////////////
-		// Pairs
-		{
-			TiXmlElement *pPairVecElem = CreateXMLChild(pControllerElem, "PairVec");
-			pPairVecElem->SetAttribute("Size", (int)pController->mvPairs.size());
-
-			tIntVec vPairNumVec;
-			Hpl1::resizeAndFill(vPairNumVec, pController->mvPairs.size(), 0);
-
-			////////////////////////////////
-			// The pair connections
-			int lCount = 0;
-			TiXmlElement *pPairsElem = CreateXMLChild(pPairVecElem, "Pairs");
-			tString sData = "";
-			for (size_t idx = 0; idx < pController->mvPairs.size(); ++idx) {
-				tColladaJointPairList *pList = &pController->mvPairs[idx];
-
-				for (tColladaJointPairListIt it = pList->begin(); it != pList->end(); ++it) {
-					cColladaJointPair &Pair = *it;
-					sData += cString::ToString(Pair.mlJoint) + " " + cString::ToString(Pair.mlWeight) + " ";
-					++lCount;
-					++vPairNumVec[idx];
-				}
+		MeshCache::writeString(aStream, pController->msTarget);
+		MeshCache::writeString(aStream, pController->msId);
+		MeshCache::writeMatrixf(aStream, pController->m_mtxBindShapeMatrix);
+		aStream.writeSint32LE(pController->mlJointPairIdx);
+		aStream.writeSint32LE(pController->mlWeightPairIdx);
+
+		SaveStringVec(aStream, pController->mvJoints);
+		SaveFloatVec(aStream, pController->mvWeights);
+
+		aStream.writeUint32LE(pController->mvMatrices.size());
+		for (size_t idx = 0; idx < pController->mvMatrices.size(); ++idx)
+			MeshCache::writeMatrixf(aStream, pController->mvMatrices[idx]);
+
+		aStream.writeUint32LE(pController->mvPairs.size());
+		for (size_t idx = 0; idx < pController->mvPairs.size(); ++idx) {
+			tColladaJointPairList *pList = &pController->mvPairs[idx];
+			aStream.writeUint32LE(pList->size());
+			for (tColladaJointPairListIt it = pList->begin(); it != pList->end(); ++it) {
+				aStream.writeSint32LE(it->mlJoint);
+				aStream.writeSint32LE(it->mlWeight);
 			}
-			CreateXMLTextChild(pPairsElem, sData.c_str());
-			pPairsElem->SetAttribute("Size", lCount);
-
-			////////////////////////////////
-			// The pair numbers
-			TiXmlElement *pPairNumElem = CreateXMLChild(pPairVecElem, "PairNum");
-			sData = "";
-			for (size_t idx = 0; idx < pController->mvPairs.size(); ++idx) {
-				sData += cString::ToString(vPairNumVec[idx]) + " ";
-			}
-			CreateXMLTextChild(pPairNumElem, sData.c_str());
 		}
 	}
 }
 
 //-----------------------------------------------------------------------
 
-static void SaveGeometryVec(TiXmlElement *apRootElem, tColladaGeometryVec *apColladaGeometryVec) {
-	TiXmlElement *pGeometryRootElem = CreateXMLChild(apRootElem, "GeometryRoot");
-
-	pGeometryRootElem->SetAttribute("Size", (int)apColladaGeometryVec->size());
-
+static void SaveGeometryVec(Common::WriteStream &aStream, tColladaGeometryVec *apColladaGeometryVec) {
+	aStream.writeUint32LE(apColladaGeometryVec->size());
 	for (size_t i = 0; i < apColladaGeometryVec->size(); ++i) {
 		cColladaGeometry *pGeometry = &(*apColladaGeometryVec)[i];
 
-		TiXmlElement *pGeometryElem = CreateXMLChild(pGeometryRootElem, "Geometry");
-
-		/////////////////////////////////7
-		// Main properties
-		pGeometryElem->SetAttribute("Id", pGeometry->msId.c_str());
-		pGeometryElem->SetAttribute("Name", pGeometry->msName.c_str());
-
-		pGeometryElem->SetAttribute("Material", pGeometry->msMaterial.c_str());
-
 		/////////////////////////////////
-		// Vertex properties
-		// Should not be needed.
-		/*pGeometryElem->SetAttribute("PosIdxNum",pGeometry->mlPosIdxNum);
-		pGeometryElem->SetAttribute("NormIdxNum",pGeometry->mlNormIdxNum);
-		pGeometryElem->SetAttribute("TexIdxNum",pGeometry->mlTexIdxNum);
-
-		pGeometryElem->SetAttribute("PosArrayIdx",pGeometry->mlPosArrayIdx);
-		pGeometryElem->SetAttribute("NormArrayIdx",pGeometry->mlNormArrayIdx);
-		pGeometryElem->SetAttribute("TexArrayIdx",pGeometry->mlTexArrayIdx); */
+		// Main properties
+		MeshCache::writeString(aStream, pGeometry->msId);
+		MeshCache::writeString(aStream, pGeometry->msName);
+		MeshCache::writeString(aStream, pGeometry->msMaterial);
 
 		/////////////////////////////////
-		// Index Vec
-		TiXmlElement *pIndexVecElem = CreateXMLChild(pGeometryElem, "IndexVec");
-
-		pIndexVecElem->SetAttribute("Size", (int)pGeometry->mvIndexVec.size());
+		// Vertices and indices, stored the way they are fed to the vertex buffers
+		aStream.writeUint32LE(pGeometry->mvVertexVec.size());
+		for (size_t j = 0; j < pGeometry->mvVertexVec.size(); ++j) {
+			const cVertex &vtx = pGeometry->mvVertexVec[j];
+			MeshCache::writeVector3f(aStream, vtx.pos);
+			MeshCache::writeVector3f(aStream, vtx.tex);
+			MeshCache::writeVector3f(aStream, vtx.tan);
+			MeshCache::writeVector3f(aStream, vtx.norm);
+			MeshCache::writeColor(aStream, vtx.col);
+		}
 
-		TiXmlElement *pIndicesDataElem = CreateXMLChild(pIndexVecElem, "Indices");
+		aStream.writeUint32LE(pGeometry->mvIndexVec.size());
+		for (size_t j = 0; j < pGeometry->mvIndexVec.size(); ++j)
+			aStream.writeUint32LE(pGeometry->mvIndexVec[j]);
 
-		tString sIndexVec = "";
-		for (size_t j = 0; j < pGeometry->mvIndexVec.size(); ++j) {
-			sIndexVec += cString::ToString((int)pGeometry->mvIndexVec[j]) + " ";
-		}
-		TiXmlText *pIndecVecText = CreateXMLTextChild(pIndicesDataElem, "Data");
-		pIndecVecText->SetValue(sIndexVec.c_str());
+		SaveFloatVec(aStream, pGeometry->mvTangents);
 
 		/////////////////////////////////
-		// Vertex vec
-		TiXmlElement *pVertexVecElem = CreateXMLChild(pGeometryElem, "VertexVec");
-		pVertexVecElem->SetAttribute("Size", (int)pGeometry->mvVertexVec.size());
-		{
-			/////////////////////////////////
-			// Positions
-			tString sData = "";
-			for (size_t j = 0; j < pGeometry->mvVertexVec.size(); ++j) {
-				sData += pGeometry->mvVertexVec[j].pos.ToFileString() + " ";
-			}
-			TiXmlElement *pDataElem = CreateXMLChild(pVertexVecElem, "Positions");
-			TiXmlText *pVecText = CreateXMLTextChild(pDataElem, "Data");
-			pVecText->SetValue(sData.c_str());
-
-			/////////////////////////////////
-			// Normals
-			sData = "";
-			for (size_t j = 0; j < pGeometry->mvVertexVec.size(); ++j) {
-				sData += pGeometry->mvVertexVec[j].norm.ToFileString() + " ";
-			}
-			pDataElem = CreateXMLChild(pVertexVecElem, "Normals");
-			pVecText = CreateXMLTextChild(pDataElem, "Data");
-			pVecText->SetValue(sData.c_str());
-
-			/////////////////////////////////
-			// UVs
-			sData = "";
-			for (size_t j = 0; j < pGeometry->mvVertexVec.size(); ++j) {
-				sData += pGeometry->mvVertexVec[j].tex.ToFileString() + " ";
-			}
-			pDataElem = CreateXMLChild(pVertexVecElem, "UV");
-			pVecText = CreateXMLTextChild(pDataElem, "Data");
-			pVecText->SetValue(sData.c_str());
-
-			/////////////////////////////////
-			// Tangents
-			sData = "";
-			char sTemp[20];
-			for (size_t j = 0; j < pGeometry->mvTangents.size(); ++j) {
-				snprintf(sTemp, 20, "%g ", pGeometry->mvTangents[j]);
-				sData += sTemp;
+		// Extra vertices
+		aStream.writeUint32LE(pGeometry->mvExtraVtxVec.size());
+		for (size_t idx = 0; idx < pGeometry->mvExtraVtxVec.size(); ++idx) {
+			tColladaExtraVtxList *pList = &pGeometry->mvExtraVtxVec[idx];
+			aStream.writeUint32LE(pList->size());
+			for (tColladaExtraVtxListIt it = pList->begin(); it != pList->end(); ++it) {
+				aStream.writeSint32LE(it->mlVtx);
+				aStream.writeSint32LE(it->mlNorm);
+				aStream.writeSint32LE(it->mlTex);
+				aStream.writeSint32LE(it->mlNewVtx);
 			}
-			pDataElem = CreateXMLChild(pVertexVecElem, "Tangents");
-			CreateXMLTextChild(pDataElem, sData.c_str());
 		}
 
 		/////////////////////////////////
-		// Extra vertex vec
-		// if(false)
-		{
-			TiXmlElement *pExtraVertexVecElem = CreateXMLChild(pGeometryElem, "ExtraVertexVec");
-			pExtraVertexVecElem->SetAttribute("Size", (int)pGeometry->mvExtraVtxVec.size());
-
-			tUIntVec vExtraNum;
-			Hpl1::resizeAndFill(vExtraNum, pGeometry->mvExtraVtxVec.size(), 0);
-
-			////////////////////////////
-			// Extra vertices
-			tString sData = "";
-			int lExtraCount = 0;
-			TiXmlElement *pExtraElem = CreateXMLChild(pExtraVertexVecElem, "ExtraVertex");
-			for (size_t idx = 0; idx < pGeometry->mvExtraVtxVec.size(); ++idx) {
-				tColladaExtraVtxList *pList = &pGeometry->mvExtraVtxVec[idx];
-
-				tColladaExtraVtxListIt it = pList->begin();
-				for (; it != pList->end(); ++it) {
-					cColladaExtraVtx &extra = *it;
-					sData += cString::ToString(extra.mlVtx) + " " +
-							 cString::ToString(extra.mlNorm) + " " +
-							 cString::ToString(extra.mlTex) + " " +
-							 cString::ToString(extra.mlNewVtx) + " ";
-					++lExtraCount;
-					++vExtraNum[idx];
-				}
-			}
-			CreateXMLTextChild(pExtraElem, sData.c_str());
-			pExtraElem->SetAttribute("Size", (int)lExtraCount);
-
-			////////////////////////////
-			// Extra num
-			sData = "";
-			TiXmlElement *pExtraNumElem = CreateXMLChild(pExtraVertexVecElem, "ExtraNum");
-			for (size_t idx = 0; idx < pGeometry->mvExtraVtxVec.size(); ++idx) {
-				sData += cString::ToString((int)vExtraNum[idx]) + " ";
-			}
-			CreateXMLTextChild(pExtraNumElem, sData.c_str());
+		// Source arrays, needed by controllers
+		aStream.writeUint32LE(pGeometry->mvArrayVec.size());
+		for (size_t idx = 0; idx < pGeometry->mvArrayVec.size(); ++idx) {
+			cColladaVtxArray *pArray = &pGeometry->mvArrayVec[idx];
+			MeshCache::writeString(aStream, pArray->msId);
+			MeshCache::writeString(aStream, pArray->msType);
+			aStream.writeByte(pArray->mbIsInVertex);
+			SaveVector3fVec(aStream, pArray->mvArray);
 		}
+
+		aStream.writeUint32LE(pGeometry->mvIndices.size());
+		for (size_t idx = 0; idx < pGeometry->mvIndices.size(); ++idx) {
+			aStream.writeSint32LE(pGeometry->mvIndices[idx].mlVtx);
+			aStream.writeSint32LE(pGeometry->mvIndices[idx].mlNorm);
+			aStream.writeSint32LE(pGeometry->mvIndices[idx].mlTex);
+		}
+
+		aStream.writeSint32LE(pGeometry->mlPosIdxNum);
+		aStream.writeSint32LE(pGeometry->mlNormIdxNum);
+		aStream.writeSint32LE(pGeometry->mlTexIdxNum);
+		aStream.writeSint32LE(pGeometry->mlPosArrayIdx);
+		aStream.writeSint32LE(pGeometry->mlNormArrayIdx);
+		aStream.writeSint32LE(pGeometry->mlTexArrayIdx);
 	}
 }
 
 //-----------------------------------------------------------------------
 
-static void SaveIterativeNode(TiXmlElement *apParentElem, cColladaNode *apParentNode) {
+static void SaveIterativeNode(Common::WriteStream &aStream, cColladaNode *apParentNode) {
+	aStream.writeUint32LE(apParentNode->mlstChildren.size());
 	tColladaNodeListIt it = apParentNode->mlstChildren.begin();
 	for (; it != apParentNode->mlstChildren.end(); ++it) {
 		cColladaNode *pNode = *it;
-		TiXmlElement *pNodeElem = CreateXMLChild(apParentElem, "Node");
-
-		pNodeElem->SetAttribute("Id", pNode->msId.c_str());
-		pNodeElem->SetAttribute("Name", pNode->msName.c_str());
-		pNodeElem->SetAttribute("Type", pNode->msType.c_str());
-
-		pNodeElem->SetAttribute("Source", pNode->msSource.c_str());
-		pNodeElem->SetAttribute("SourceIsFile", pNode->mbSourceIsFile ? "true" : "false");
 
-		pNodeElem->SetAttribute("Transform", pNode->m_mtxTransform.ToFileString().c_str());
-		pNodeElem->SetAttribute("WorldTransform", pNode->m_mtxWorldTransform.ToFileString().c_str());
+		MeshCache::writeString(aStream, pNode->msId);
+		MeshCache::writeString(aStream, pNode->msName);
+		MeshCache::writeString(aStream, pNode->msType);
 
-		pNodeElem->SetAttribute("Scale", pNode->mvScale.ToFileString().c_str());
+		MeshCache::writeString(aStream, pNode->msSource);
+		aStream.writeByte(pNode->mbSourceIsFile);
 
-		pNodeElem->SetAttribute("Count", pNode->mlCount);
+		MeshCache::writeMatrixf(aStream, pNode->m_mtxTransform);
+		MeshCache::writeMatrixf(aStream, pNode->m_mtxWorldTransform);
+		MeshCache::writeVector3f(aStream, pNode->mvScale);
+		aStream.writeSint32LE(pNode->mlCount);
 
-		TiXmlElement *pTransformRootElem = CreateXMLChild(pNodeElem, "TransformRoot");
-		// tColladaTransformList mlstTransforms;
+		aStream.writeUint32LE(pNode->mlstTransforms.size());
 		tColladaTransformListIt transIt = pNode->mlstTransforms.begin();
 		for (; transIt != pNode->mlstTransforms.end(); ++transIt) {
 			cColladaTransform &transform = *transIt;
-			TiXmlElement *pTransformElem = CreateXMLChild(pTransformRootElem, "Transform");
-
-			pTransformElem->SetAttribute("Sid", transform.msSid.c_str());
-			pTransformElem->SetAttribute("Type", transform.msType.c_str());
-
-			tString sValues = "";
-			for (size_t i = 0; i < transform.mvValues.size(); ++i)
-				sValues += cString::ToString(transform.mvValues[i]) + " ";
-
-			pTransformElem->SetAttribute("Values", sValues.c_str());
+			MeshCache::writeString(aStream, transform.msSid);
+			MeshCache::writeString(aStream, transform.msType);
+			SaveFloatVec(aStream, transform.mvValues);
 		}
 
-		SaveIterativeNode(pNodeElem, pNode);
+		SaveIterativeNode(aStream, pNode);
 	}
 }
 
-static void SaveScene(TiXmlElement *apRootElem, cColladaScene *apColladaScene) {
-	TiXmlElement *pSceneElem = CreateXMLChild(apRootElem, "Scene");
+static void SaveScene(Common::WriteStream &aStream, cColladaScene *apColladaScene) {
+	aStream.writeFloatLE(apColladaScene->mfStartTime);
+	aStream.writeFloatLE(apColladaScene->mfEndTime);
+	aStream.writeFloatLE(apColladaScene->mfDeltaTime);
 
-	pSceneElem->SetAttribute("StartTime", cString::ToString(apColladaScene->mfStartTime).c_str());
-	pSceneElem->SetAttribute("EndTime", cString::ToString(apColladaScene->mfEndTime).c_str());
-	pSceneElem->SetAttribute("DeltaTime", cString::ToString(apColladaScene->mfDeltaTime).c_str());
-
-	TiXmlElement *pSceneRootElem = CreateXMLChild(pSceneElem, "Root");
-
-	SaveIterativeNode(pSceneRootElem, &apColladaScene->mRoot);
+	SaveIterativeNode(aStream, &apColladaScene->mRoot);
 }
 
 //-----------------------------------------------------------------------
@@ -776,16 +610,53 @@ static void SaveScene(TiXmlElement *apRootElem, cColladaScene *apColladaScene) {
 
 //-----------------------------------------------------------------------
 
-static void LoadImageVec(TiXmlElement *apRootElem, tColladaImageVec *apColladaImageVec);
-static void LoadTextureVec(TiXmlElement *apRootElem, tColladaTextureVec *apColladaTextureVec);
-static void LoadMaterialVec(TiXmlElement *apRootElem, tColladaMaterialVec *apColladaMaterialVec);
-static void LoadLightVec(TiXmlElement *apRootElem, tColladaLightVec *apColladaLightVec);
-static void LoadAnimationVec(TiXmlElement *apRootElem, tColladaAnimationVec *apColladaAnimVec);
-static void LoadControllerVec(TiXmlElement *apRootElem, tColladaControllerVec *apColladaControllerVec);
-static void LoadGeometryVec(TiXmlElement *apRootElem, tColladaGeometryVec *apColladaGeometryVec);
-static void LoadScene(TiXmlElement *apRootElem, cColladaScene *apColladaScene);
+static void LoadImageVec(Common::SeekableReadStream &aStream, tColladaImageVec *apColladaImageVec);
+static void LoadTextureVec(Common::SeekableReadStream &aStream, tColladaTextureVec *apColladaTextureVec);
+static void LoadMaterialVec(Common::SeekableReadStream &aStream, tColladaMaterialVec *apColladaMaterialVec);
+static void LoadLightVec(Common::SeekableReadStream &aStream, tColladaLightVec *apColladaLightVec);
+static void LoadAnimationVec(Common::SeekableReadStream &aStream, tColladaAnimationVec *apColladaAnimVec);
+static void LoadControllerVec(Common::SeekableReadStream &aStream, tColladaControllerVec *apColladaControllerVec);
+static void LoadGeometryVec(Common::SeekableReadStream &aStream, tColladaGeometryVec *apColladaGeometryVec);
+static void LoadScene(Common::SeekableReadStream &aStream, cColladaScene *apColladaScene);
+
+// Sections are always stored in this order, the ones that were not
+// requested when the cache was written are simply missing.
+static void LoadSections(Common::SeekableReadStream &aStream, uint32 alSections,
+							   tColladaImageVec *apColladaImageVec,
+							   tColladaTextureVec *apColladaTextureVec,
+							   tColladaMaterialVec *apColladaMaterialVec,
+							   tColladaLightVec *apColladaLightVec,
+							   tColladaGeometryVec *apColladaGeometryVec,
+							   tColladaControllerVec *apColladaControllerVec,
+							   tColladaAnimationVec *apColladaAnimVec,
+							   cColladaScene *apColladaScene) {
+	tColladaImageVec vImages;
+	tColladaTextureVec vTextures;
+	tColladaMaterialVec vMaterials;
+	tColladaLightVec vLights;
+	tColladaAnimationVec vAnimations;
+	tColladaControllerVec vControllers;
+	tColladaGeometryVec vGeometries;
+
+	if (alSections & eColladaCacheSection_Images)
+		LoadImageVec(aStream, apColladaImageVec ? apColladaImageVec : &vImages);
+	if (alSections & eColladaCacheSection_Textures)
+		LoadTextureVec(aStream, apColladaTextureVec ? apColladaTextureVec : &vTextures);
+	if (alSections & eColladaCacheSection_Materials)
+		LoadMaterialVec(aStream, apColladaMaterialVec ? apColladaMaterialVec : &vMaterials);
+	if (alSections & eColladaCacheSection_Lights)
+		LoadLightVec(aStream, apColladaLightVec ? apColladaLightVec : &vLights);
+	if (alSections & eColladaCacheSection_Animations)
+		LoadAnimationVec(aStream, apColladaAnimVec ? apColladaAnimVec : &vAnimations);
+	if (alSections & eColladaCacheSection_Controllers)
+		LoadControllerVec(aStream, apColladaControllerVec ? apColladaControllerVec : &vControllers);
+	if (alSections & eColladaCacheSection_Geometries)
+		LoadGeometryVec(aStream, apColladaGeometryVec ? apColladaGeometryVec : &vGeometries);
+	if ((alSections & eColladaCacheSection_Scene) && apColladaScene)
+		LoadScene(aStream, apColladaScene);
+}
 
-bool cMeshLoaderCollada::LoadStructures(const tString &asFile,
+bool cMeshLoaderCollada::LoadStructures(Common::SeekableReadStream &aStream,
 										tColladaImageVec *apColladaImageVec,
 										tColladaTextureVec *apColladaTextureVec,
 										tColladaMaterialVec *apColladaMaterialVec,
@@ -794,326 +665,205 @@ bool cMeshLoaderCollada::LoadStructures(const tString &asFile,
 										tColladaControllerVec *apColladaControllerVec,
 										tColladaAnimationVec *apColladaAnimVec,
 										cColladaScene *apColladaScene) {
-	// unsigned long lStartTime = mpSystem->GetLowLevel()->GetTime();
-
-	TiXmlDocument *pXmlDoc = hplNew(TiXmlDocument, (asFile.c_str()));
-	if (pXmlDoc->LoadFile() == false) {
-		Warning("Couldn't open XML file %s\n", asFile.c_str());
-		hplDelete(pXmlDoc);
+	const uint32 lSections = aStream.readUint32LE();
+
+	// The cache must hold every structure that is asked for.
+	if ((apColladaImageVec && !(lSections & eColladaCacheSection_Images)) ||
+		(apColladaTextureVec && !(lSections & eColladaCacheSection_Textures)) ||
+		(apColladaMaterialVec && !(lSections & eColladaCacheSection_Materials)) ||
+		(apColladaLightVec && !(lSections & eColladaCacheSection_Lights)) ||
+		(apColladaAnimVec && !(lSections & eColladaCacheSection_Animations)) ||
+		(apColladaControllerVec && !(lSections & eColladaCacheSection_Controllers)) ||
+		(apColladaGeometryVec && !(lSections & eColladaCacheSection_Geometries)) ||
+		(apColladaScene && !(lSections & eColladaCacheSection_Scene))) {
 		return false;
 	}
 
-	// unsigned long lTime = mpSystem->GetLowLevel()->GetTime() - lStartTime;
-	// Log("Loading cached collada XML file '%s' took: %d ms\n",asFile.c_str(),lTime);
-
-	TiXmlElement *pRootElem = pXmlDoc->RootElement();
+	LoadSections(aStream, lSections,
+					   apColladaImageVec,
+					   apColladaTextureVec,
+					   apColladaMaterialVec,
+					   apColladaLightVec,
+					   apColladaGeometryVec,
+					   apColladaControllerVec,
+					   apColladaAnimVec,
+					   apColladaScene);
 
-	if (apColladaImageVec)
-		LoadImageVec(pRootElem, apColladaImageVec);
-	if (apColladaTextureVec)
-		LoadTextureVec(pRootElem, apColladaTextureVec);
-	if (apColladaMaterialVec)
-		LoadMaterialVec(pRootElem, apColladaMaterialVec);
-	if (apColladaLightVec)
-		LoadLightVec(pRootElem, apColladaLightVec);
-	if (apColladaAnimVec)
-		LoadAnimationVec(pRootElem, apColladaAnimVec);
-	if (apColladaControllerVec)
-		LoadControllerVec(pRootElem, apColladaControllerVec);
-	if (apColladaGeometryVec)
-		LoadGeometryVec(pRootElem, apColladaGeometryVec);
-	if (apColladaScene)
-		LoadScene(pRootElem, apColladaScene);
+	if (aStream.err() || aStream.eos()) {
+		Warning("Corrupt collada cache, reloading from source\n");
+		// Leave the structures the way the parser expects to find them.
+		if (apColladaImageVec)
+			apColladaImageVec->clear();
+		if (apColladaTextureVec)
+			apColladaTextureVec->clear();
+		if (apColladaMaterialVec)
+			apColladaMaterialVec->clear();
+		if (apColladaLightVec)
+			apColladaLightVec->clear();
+		if (apColladaAnimVec)
+			apColladaAnimVec->clear();
+		if (apColladaControllerVec)
+			apColladaControllerVec->clear();
+		if (apColladaGeometryVec)
+			apColladaGeometryVec->clear();
+		if (apColladaScene)
+			apColladaScene->ResetNodes();
+		return false;
+	}
 
-	hplDelete(pXmlDoc);
 	return true;
 }
 
 //-----------------------------------------------------------------------
 
-static void LoadImageVec(TiXmlElement *apRootElem, tColladaImageVec *apColladaImageVec) {
-	TiXmlElement *pImageRootElem = apRootElem->FirstChildElement("ImageRoot");
-
-	int lSize = cString::ToInt(pImageRootElem->Attribute("Size"), 0);
-
-	apColladaImageVec->clear();
-	apColladaImageVec->resize(lSize);
-
-	int lCount = 0;
-	TiXmlElement *pImageElem = pImageRootElem->FirstChildElement();
-	for (; pImageElem != NULL; pImageElem = pImageElem->NextSiblingElement(), ++lCount) {
-		cColladaImage *pImage = &(*apColladaImageVec)[lCount];
+static void LoadStringVec(Common::SeekableReadStream &aStream, tStringVec &avStrings) {
+	avStrings.resize(aStream.readUint32LE());
+	for (size_t i = 0; i < avStrings.size() && !aStream.eos(); ++i)
+		avStrings[i] = MeshCache::readString(aStream);
+}
 
-		pImage->msId = pImageElem->Attribute("Id");
-		pImage->msName = pImageElem->Attribute("Name");
-		pImage->msSource = pImageElem->Attribute("Source");
+static void LoadFloatVec(Common::SeekableReadStream &aStream, tFloatVec &avValues) {
+	const uint32 lSize = aStream.readUint32LE();
+	if (aStream.eos() || lSize > aStream.size() / sizeof(float)) {
+		avValues.clear();
+		return;
 	}
+	avValues.resize(lSize);
+	MeshCache::readFloats(aStream, avValues.data(), lSize);
 }
 
-//-----------------------------------------------------------------------
-
-static void LoadTextureVec(TiXmlElement *apRootElem, tColladaTextureVec *apColladaTextureVec) {
-	TiXmlElement *pTextureRootElem = apRootElem->FirstChildElement("TextureRoot");
-
-	int lSize = cString::ToInt(pTextureRootElem->Attribute("Size"), 0);
-
-	apColladaTextureVec->clear();
-	apColladaTextureVec->resize(lSize);
-
-	int lCount = 0;
-	TiXmlElement *pTextureElem = pTextureRootElem->FirstChildElement();
-	for (; pTextureElem != NULL; pTextureElem = pTextureElem->NextSiblingElement(), ++lCount) {
-		cColladaTexture *pTexture = &(*apColladaTextureVec)[lCount];
-
-		pTexture->msId = pTextureElem->Attribute("Id");
-		pTexture->msName = pTextureElem->Attribute("Name");
-		pTexture->msImage = pTextureElem->Attribute("Image");
+static void LoadVector3fVec(Common::SeekableReadStream &aStream, tVector3fVec &avValues) {
+	const uint32 lSize = aStream.readUint32LE();
+	if (aStream.eos() || lSize > aStream.size() / (sizeof(float) * 3)) {
+		avValues.clear();
+		return;
 	}
+	avValues.resize(lSize);
+	for (size_t i = 0; i < lSize; ++i)
+		avValues[i] = MeshCache::readVector3f(aStream);
 }
 
-//-----------------------------------------------------------------------
-
-static void LoadMaterialVec(TiXmlElement *apRootElem, tColladaMaterialVec *apColladaMaterialVec) {
-	TiXmlElement *pMaterialRootElem = apRootElem->FirstChildElement("MaterialRoot");
-
-	int lSize = cString::ToInt(pMaterialRootElem->Attribute("Size"), 0);
-
-	apColladaMaterialVec->clear();
-	apColladaMaterialVec->resize(lSize);
-
-	int lCount = 0;
-	TiXmlElement *pMaterialElem = pMaterialRootElem->FirstChildElement();
-	for (; pMaterialElem != NULL; pMaterialElem = pMaterialElem->NextSiblingElement(), ++lCount) {
-		cColladaMaterial *pMaterial = &(*apColladaMaterialVec)[lCount];
-
-		pMaterial->msId = pMaterialElem->Attribute("Id");
-		pMaterial->msName = pMaterialElem->Attribute("Name");
-		pMaterial->msTexture = pMaterialElem->Attribute("Texture");
-		pMaterial->mDiffuseColor = cString::ToColor(pMaterialElem->Attribute("Color"), cColor(0, 0));
-	}
+// Guards against allocating huge arrays from a corrupt size field.
+static uint32 ReadCount(Common::SeekableReadStream &aStream) {
+	const uint32 lCount = aStream.readUint32LE();
+	if (aStream.eos() || lCount > aStream.size() - aStream.pos())
+		return 0;
+	return lCount;
 }
 
 //-----------------------------------------------------------------------
 
-static void LoadControllerVec(TiXmlElement *apRootElem, tColladaControllerVec *apColladaControllerVec) {
-	TiXmlElement *pControllerRootElem = apRootElem->FirstChildElement("ControllerRoot");
-	if (pControllerRootElem == NULL) {
-		Warning("Could not find root element 'ControllerRoot' for controller!\n");
-		return;
+static void LoadImageVec(Common::SeekableReadStream &aStream, tColladaImageVec *apColladaImageVec) {
+	apColladaImageVec->resize(ReadCount(aStream));
+	for (size_t i = 0; i < apColladaImageVec->size(); ++i) {
+		cColladaImage *pImage = &(*apColladaImageVec)[i];
+		pImage->msId = MeshCache::readString(aStream);
+		pImage->msName = MeshCache::readString(aStream);
+		pImage->msSource = MeshCache::readString(aStream);
 	}
+}
 
-	int lSize1 = cString::ToInt(pControllerRootElem->Attribute("Size"), 0);
-
-	apColladaControllerVec->clear();
-	apColladaControllerVec->resize(lSize1);
-
-	int lCount = 0;
-	TiXmlElement *pControllerElem = pControllerRootElem->FirstChildElement();
-	for (; pControllerElem != NULL; pControllerElem = pControllerElem->NextSiblingElement(), ++lCount) {
-		cColladaController *pController = &(*apColladaControllerVec)[lCount];
-
-		pController->msId = pControllerElem->Attribute("Id");
-		pController->msTarget = pControllerElem->Attribute("Target");
-
-		pController->m_mtxBindShapeMatrix = cString::ToMatrixf(pControllerElem->Attribute("BindShapeMatrix"), cMatrixf::Identity);
-
-		pController->mlJointPairIdx = cString::ToInt(pControllerElem->Attribute("JointPairIdx"), 0);
-		pController->mlWeightPairIdx = cString::ToInt(pControllerElem->Attribute("WeightPairIdx"), 0);
-
-		////////////////////////////
-		// Joints
-		{
-			TiXmlElement *pJointsElem = pControllerElem->FirstChildElement("Joints");
-			int lSize = cString::ToInt(pJointsElem->Attribute("Size"), 0);
-			TiXmlText *pJointsText = pJointsElem->FirstChild()->ToText();
+//-----------------------------------------------------------------------
 
-			tString sData = pJointsText->Value();
-			tString sSepp = " ";
-			pController->mvJoints.reserve(lSize);
-			cString::GetStringVec(sData, pController->mvJoints, &sSepp);
-		}
-		////////////////////////////
-		// Weights
-		{
-			TiXmlElement *pWeightsElem = pControllerElem->FirstChildElement("Weights");
-			int lSize = cString::ToInt(pWeightsElem->Attribute("Size"), 0);
-			TiXmlText *pWeightsText = pWeightsElem->FirstChild()->ToText();
-
-			// tString sData = pWeightsText->Value();
-			// tString sSepp = " "; pController->mvWeights.reserve(lSize);
-			// cString::GetFloatVec(sData,pController->mvWeights,&sSepp);
-
-			pController->mvWeights.resize(lSize);
-			cString::FloatStringToArray(&pController->mvWeights[0], pWeightsText->Value(), lSize);
-		}
-		////////////////////////////
-		// Matrices
-		{
-			TiXmlElement *pMatricesElem = pControllerElem->FirstChildElement("Matrices");
-			int lSize = cString::ToInt(pMatricesElem->Attribute("Size"), 0);
-			TiXmlText *pMatricesText = pMatricesElem->FirstChild()->ToText();
-
-			// tString sData = pMatricesText->Value();
-			// tString sSepp = " ";
-			// cString::GetFloatVec(sData,vRawData,&sSepp);
-			tFloatVec vRawData;
-			vRawData.resize(lSize * 16);
-			cString::FloatStringToArray(&vRawData[0], pMatricesText->Value(), lSize * 16);
-
-			float *pData = &vRawData[0];
-			pController->mvMatrices.reserve(lSize);
-			for (int i = 0; i < lSize; ++i) {
-				pController->mvMatrices.push_back(
-					cMatrixf(pData[0], pData[1], pData[2], pData[3],
-							 pData[4], pData[5], pData[6], pData[7],
-							 pData[8], pData[9], pData[10], pData[11],
-							 pData[12], pData[13], pData[14], pData[15]));
-				pData += 16;
-			}
-		}
-		////////////////////////////
-		// Pairs
-		{
-			TiXmlElement *pPairVecElem = pControllerElem->FirstChildElement("PairVec");
-			int lSize = cString::ToInt(pPairVecElem->Attribute("Size"), 0);
-
-			/////////////////////////////////////////
-			// Get number of connections per pair
-			TiXmlElement *pPairNumElem = pPairVecElem->FirstChildElement("PairNum");
-			TiXmlText *pPairNumText = pPairNumElem->FirstChild()->ToText();
-
-			tUIntVec vPairNum;
-			vPairNum.resize(lSize);
-			// tString sData = pPairNumText->Value();
-			// tString sSepp = " ";
-			// cString::GetIntVec(sData,vPairNum,&sSepp);
-			cString::UIntStringToArray(&vPairNum[0], pPairNumText->Value(), lSize);
-
-			/////////////////////////////////////////
-			// Get pairs
-			TiXmlElement *pPairsElem = pPairVecElem->FirstChildElement("Pairs");
-			int lPairSize = cString::ToInt(pPairsElem->Attribute("Size"), 0);
-			TiXmlText *pPairsText = pPairsElem->FirstChild()->ToText();
-
-			tUIntVec vPairs;
-			vPairs.resize(lPairSize * 2);
-			// sData = pPairsText->Value();
-			// cString::GetIntVec(sData,vPairs,&sSepp);
-			cString::UIntStringToArray(&vPairs[0], pPairsText->Value(), lPairSize * 2);
-
-			pController->mvPairs.resize(lSize);
-
-			int lPairCount = 0;
-			for (int i = 0; i < lSize; ++i) {
-				for (unsigned int j = 0; j < vPairNum[i]; ++j) {
-					pController->mvPairs[i].push_back(
-						cColladaJointPair(vPairs[lPairCount], vPairs[lPairCount + 1]));
-					lPairCount += 2;
-				}
-			}
-		}
+static void LoadTextureVec(Common::SeekableReadStream &aStream, tColladaTextureVec *apColladaTextureVec) {
+	apColladaTextureVec->resize(ReadCount(aStream));
+	for (size_t i = 0; i < apColladaTextureVec->size(); ++i) {
+		cColladaTexture *pTexture = &(*apColladaTextureVec)[i];
+		pTexture->msId = MeshCache::readString(aStream);
+		pTexture->msName = MeshCache::readString(aStream);
+		pTexture->msImage = MeshCache::readString(aStream);
 	}
 }
-//-----------------------------------------------------------------------
-
-static void LoadLightVec(TiXmlElement *apRootElem, tColladaLightVec *apColladaLightVec) {
-	TiXmlElement *pLightRootElem = apRootElem->FirstChildElement("LightRoot");
-
-	int lSize = cString::ToInt(pLightRootElem->Attribute("Size"), 0);
-
-	apColladaLightVec->clear();
-	apColladaLightVec->resize(lSize);
 
-	int lCount = 0;
-	TiXmlElement *pLightElem = pLightRootElem->FirstChildElement();
-	for (; pLightElem != NULL; pLightElem = pLightElem->NextSiblingElement(), ++lCount) {
-		cColladaLight *pLight = &(*apColladaLightVec)[lCount];
+//-----------------------------------------------------------------------
 
-		pLight->msId = pLightElem->Attribute("Id");
-		pLight->msName = pLightElem->Attribute("Name");
-		pLight->msType = pLightElem->Attribute("Type");
-		pLight->mfAngle = cString::ToFloat(pLightElem->Attribute("Angle"), 0);
-		pLight->mDiffuseColor = cString::ToColor(pLightElem->Attribute("Color"), cColor(0, 0));
+static void LoadMaterialVec(Common::SeekableReadStream &aStream, tColladaMaterialVec *apColladaMaterialVec) {
+	apColladaMaterialVec->resize(ReadCount(aStream));
+	for (size_t i = 0; i < apColladaMaterialVec->size(); ++i) {
+		cColladaMaterial *pMaterial = &(*apColladaMaterialVec)[i];
+		pMaterial->msId = MeshCache::readString(aStream);
+		pMaterial->msName = MeshCache::readString(aStream);
+		pMaterial->msTexture = MeshCache::readString(aStream);
+		pMaterial->mDiffuseColor = MeshCache::readColor(aStream);
 	}
 }
 
 //-----------------------------------------------------------------------
 
-static void LoadAnimationVec(TiXmlElement *apRootElem, tColladaAnimationVec *apColladaAnimationVec) {
-	TiXmlElement *pAnimationRootElem = apRootElem->FirstChildElement("AnimationRoot");
-	if (pAnimationRootElem == NULL) {
-		Warning("Could not find root element 'AnimationRoot' for animation!\n");
-		return;
+static void LoadLightVec(Common::SeekableReadStream &aStream, tColladaLightVec *apColladaLightVec) {
+	apColladaLightVec->resize(ReadCount(aStream));
+	for (size_t i = 0; i < apColladaLightVec->size(); ++i) {
+		cColladaLight *pLight = &(*apColladaLightVec)[i];
+		pLight->msId = MeshCache::readString(aStream);
+		pLight->msName = MeshCache::readString(aStream);
+		pLight->msType = MeshCache::readString(aStream);
+		pLight->mDiffuseColor = MeshCache::readColor(aStream);
+		pLight->mfAngle = aStream.readFloatLE();
 	}
+}
 
-	int lSize1 = cString::ToInt(pAnimationRootElem->Attribute("Size"), 0);
-
-	apColladaAnimationVec->clear();
-	apColladaAnimationVec->resize(lSize1);
-
-	int lCount = 0;
-	TiXmlElement *pAnimationElem = pAnimationRootElem->FirstChildElement();
-	for (; pAnimationElem != NULL; pAnimationElem = pAnimationElem->NextSiblingElement(), ++lCount) {
-		cColladaAnimation *pAnimation = &(*apColladaAnimationVec)[lCount];
-
-		pAnimation->msId = pAnimationElem->Attribute("Id");
-		pAnimation->msTargetNode = pAnimationElem->Attribute("TargetNode");
-
-		/////////////////////////////////////
-		// Channels
-		{
-			TiXmlElement *pChannelVecElem = pAnimationElem->FirstChildElement("ChannelVec");
-			int lSize = cString::ToInt(pChannelVecElem->Attribute("Size"), 0);
-			pAnimation->mvChannels.resize(lSize);
-
-			int idx = 0;
-			TiXmlElement *pChannelElem = pChannelVecElem->FirstChildElement("Channel");
-			for (; pChannelElem != NULL; pChannelElem = pChannelElem->NextSiblingElement("Channel"), ++idx) {
-				cColladaChannel *pChannel = &pAnimation->mvChannels[idx];
+//-----------------------------------------------------------------------
 
-				pChannel->msId = pChannelElem->Attribute("Id");
-				pChannel->msTarget = pChannelElem->Attribute("Target");
-				pChannel->msSource = pChannelElem->Attribute("Source");
-			}
+static void LoadAnimationVec(Common::SeekableReadStream &aStream, tColladaAnimationVec *apColladaAnimVec) {
+	apColladaAnimVec->resize(ReadCount(aStream));
+	for (size_t i = 0; i < apColladaAnimVec->size(); ++i) {
+		cColladaAnimation *pAnimation = &(*apColladaAnimVec)[i];
+		pAnimation->msId = MeshCache::readString(aStream);
+		pAnimation->msTargetNode = MeshCache::readString(aStream);
+
+		pAnimation->mvChannels.resize(ReadCount(aStream));
+		for (size_t idx = 0; idx < pAnimation->mvChannels.size(); ++idx) {
+			cColladaChannel *pChannel = &pAnimation->mvChannels[idx];
+			pChannel->msId = MeshCache::readString(aStream);
+			pChannel->msTarget = MeshCache::readString(aStream);
+			pChannel->msSource = MeshCache::readString(aStream);
 		}
 
-		/////////////////////////////////////
-		// Samplers
-		{
-			TiXmlElement *pSamplerVecElem = pAnimationElem->FirstChildElement("SamplerVec");
-			int lSize = cString::ToInt(pSamplerVecElem->Attribute("Size"), 0);
-			pAnimation->mvSamplers.resize(lSize);
-
-			int idx = 0;
-			TiXmlElement *pSamplerElem = pSamplerVecElem->FirstChildElement("Sampler");
-			for (; pSamplerElem != NULL; pSamplerElem = pSamplerElem->NextSiblingElement("Sampler"), ++idx) {
-				cColladaSampler *pSampler = &pAnimation->mvSamplers[idx];
-
-				pSampler->msId = pSamplerElem->Attribute("Id");
-				pSampler->msTarget = pSamplerElem->Attribute("Target");
-				pSampler->msTimeArray = pSamplerElem->Attribute("TimeArray");
-				pSampler->msValueArray = pSamplerElem->Attribute("ValueArray");
-			}
+		pAnimation->mvSamplers.resize(ReadCount(aStream));
+		for (size_t idx = 0; idx < pAnimation->mvSamplers.size(); ++idx) {
+			cColladaSampler *pSampler = &pAnimation->mvSamplers[idx];
+			pSampler->msId = MeshCache::readString(aStream);
+			pSampler->msTimeArray = MeshCache::readString(aStream);
+			pSampler->msValueArray = MeshCache::readString(aStream);
+			pSampler->msTarget = MeshCache::readString(aStream);
 		}
 
-		/////////////////////////////////////
-		// Sources
-		{
-			TiXmlElement *pSourceVecElem = pAnimationElem->FirstChildElement("SourceVec");
-			int lSize = cString::ToInt(pSourceVecElem->Attribute("Size"), 0);
-			pAnimation->mvSources.resize(lSize);
-
-			int idx = 0;
-			TiXmlElement *pSourceElem = pSourceVecElem->FirstChildElement("Source");
-			for (; pSourceElem != NULL; pSourceElem = pSourceElem->NextSiblingElement("Source"), ++idx) {
-				cColladaAnimSource *pSource = &pAnimation->mvSources[idx];
+		pAnimation->mvSources.resize(ReadCount(aStream));
+		for (size_t idx = 0; idx < pAnimation->mvSources.size(); ++idx) {
+			cColladaAnimSource *pSource = &pAnimation->mvSources[idx];
+			pSource->msId = MeshCache::readString(aStream);
+			LoadFloatVec(aStream, pSource->mvValues);
+		}
+	}
+}
 
-				pSource->msId = pSourceElem->Attribute("Id");
-				tString sData = pSourceElem->Attribute("Values");
-				tString sSepp = " ";
-				pSource->mvValues.reserve(3);
+//-----------------------------------------------------------------------
 
-				cString::GetFloatVec(sData, pSource->mvValues, &sSepp);
+static void LoadControllerVec(Common::SeekableReadStream &aStream, tColladaControllerVec *apColladaControllerVec) {
+	apColladaControllerVec->resize(ReadCount(aStream));
+	for (size_t i = 0; i < apColladaControllerVec->size(); ++i) {
+		cColladaController *pController = &(*apColladaControllerVec)[i];
+		pController->msTarget = MeshCache::readString(aStream);
+		pController->msId = MeshCache::readString(aStream);
+		pController->m_mtxBindShapeMatrix = MeshCache::readMatrixf(aStream);
+		pController->mlJointPairIdx = aStream.readSint32LE();
+		pController->mlWeightPairIdx = aStream.readSint32LE();
+
+		LoadStringVec(aStream, pController->mvJoints);
+		LoadFloatVec(aStream, pController->mvWeights);
+
+		pController->mvMatrices.resize(ReadCount(aStream));
+		for (size_t idx = 0; idx < pController->mvMatrices.size(); ++idx)
+			pController->mvMatrices[idx] = MeshCache::readMatrixf(aStream);
+
+		pController->mvPairs.resize(ReadCount(aStream));
+		for (size_t idx = 0; idx < pController->mvPairs.size(); ++idx) {
+			tColladaJointPairList *pList = &pController->mvPairs[idx];
+			const uint32 lPairs = ReadCount(aStream);
+			for (uint32 j = 0; j < lPairs; ++j) {
+				const int lJoint = aStream.readSint32LE();
+				const int lWeight = aStream.readSint32LE();
+				pList->push_back(cColladaJointPair(lJoint, lWeight));
 			}
 		}
 	}
@@ -1121,243 +871,122 @@ static void LoadAnimationVec(TiXmlElement *apRootElem, tColladaAnimationVec *apC
 
 //-----------------------------------------------------------------------
 
-static void LoadGeometryVec(TiXmlElement *apRootElem, tColladaGeometryVec *apColladaGeometryVec) {
-	TiXmlElement *pGeometryRootElem = apRootElem->FirstChildElement("GeometryRoot");
-
-	int lSize1 = cString::ToInt(pGeometryRootElem->Attribute("Size"), 0);
-
-	apColladaGeometryVec->clear();
-	apColladaGeometryVec->resize(lSize1);
-
-	int lCount = 0;
-	TiXmlElement *pGeometryElem = pGeometryRootElem->FirstChildElement();
-	for (; pGeometryElem != NULL; pGeometryElem = pGeometryElem->NextSiblingElement(), ++lCount) {
-		cColladaGeometry *pGeometry = &(*apColladaGeometryVec)[lCount];
-
-		pGeometry->msId = pGeometryElem->Attribute("Id");
-		pGeometry->msName = pGeometryElem->Attribute("Name");
-		pGeometry->msMaterial = pGeometryElem->Attribute("Material");
+static void LoadGeometryVec(Common::SeekableReadStream &aStream, tColladaGeometryVec *apColladaGeometryVec) {
+	apColladaGeometryVec->resize(ReadCount(aStream));
+	for (size_t i = 0; i < apColladaGeometryVec->size(); ++i) {
+		cColladaGeometry *pGeometry = &(*apColladaGeometryVec)[i];
 
 		/////////////////////////////////
-		// Index Vec
-		{
-			TiXmlElement *pIndexVecElem = pGeometryElem->FirstChildElement("IndexVec");
-			int lSize = cString::ToInt(pIndexVecElem->Attribute("Size"), 0);
-
-			if (lSize > 0) {
-				TiXmlElement *pIndicesDataElem = pIndexVecElem->FirstChildElement("Indices");
-				TiXmlText *pVecText = pIndicesDataElem->FirstChild()->ToText();
-
-				pGeometry->mvIndexVec.resize(lSize);
-
-				cString::UIntStringToArray(&pGeometry->mvIndexVec[0], pVecText->Value(), lSize);
-
-				// tString sData = pVecText->Value();
-				// tString sSepp = " ";
-				// cString::GetUIntVec(sData,pGeometry->mvIndexVec,&sSepp);
-			}
-		}
+		// Main properties
+		pGeometry->msId = MeshCache::readString(aStream);
+		pGeometry->msName = MeshCache::readString(aStream);
+		pGeometry->msMaterial = MeshCache::readString(aStream);
 
 		/////////////////////////////////
-		// Vertex vec
-		{
-			TiXmlElement *pVertexVecElem = pGeometryElem->FirstChildElement("VertexVec");
-			int lSize = cString::ToInt(pVertexVecElem->Attribute("Size"), 0);
-
-			if (lSize > 0) {
-				pGeometry->mvVertexVec.resize(lSize);
-
-				tFloatVec vRawData;
-				vRawData.resize(lSize * 3);
-
-				/////////////////////////////////
-				// Positions
-				{
-					TiXmlElement *pDataElem = pVertexVecElem->FirstChildElement("Positions");
-					TiXmlText *pVecText = pDataElem->FirstChild()->ToText();
-
-					// tString sData = pVecText->Value();
-					// tString sSepp = " ";
-					// tFloatVec vRawData; vRawData.reserve(lSize * 3);
-					// cString::GetFloatVec(sData,vRawData,&sSepp);
-
-					cString::FloatStringToArray(&vRawData[0], pVecText->Value(), lSize * 3);
-
-					float *pData = &vRawData[0];
-					for (int i = 0; i < lSize; ++i) {
-						cVector3f &vPos = pGeometry->mvVertexVec[i].pos;
-						vPos.x = pData[0];
-						vPos.y = pData[1];
-						vPos.z = pData[2];
-						pData += 3;
-					}
-				}
-
-				/////////////////////////////////
-				// Normals
-				{
-					TiXmlElement *pDataElem = pVertexVecElem->FirstChildElement("Normals");
-					TiXmlText *pVecText = pDataElem->FirstChild()->ToText();
-
-					// tString sData = pVecText->Value();
-					// tString sSepp = " ";
-					// tFloatVec vRawData; vRawData.reserve(lSize * 3);
-					// cString::GetFloatVec(sData,vRawData,&sSepp);
-
-					cString::FloatStringToArray(&vRawData[0], pVecText->Value(), lSize * 3);
-
-					float *pData = &vRawData[0];
-					for (int i = 0; i < lSize; ++i) {
-						cVector3f &vPos = pGeometry->mvVertexVec[i].norm;
-						vPos.x = pData[0];
-						vPos.y = pData[1];
-						vPos.z = pData[2];
-						pData += 3;
-					}
-				}
-
-				/////////////////////////////////
-				// UVs
-				{
-					TiXmlElement *pDataElem = pVertexVecElem->FirstChildElement("UV");
-					TiXmlText *pVecText = pDataElem->FirstChild()->ToText();
-
-					// tString sData = pVecText->Value();
-					// tString sSepp = " ";
-					// tFloatVec vRawData; vRawData.reserve(lSize * 3);
-					// cString::GetFloatVec(sData,vRawData,&sSepp);
-
-					cString::FloatStringToArray(&vRawData[0], pVecText->Value(), lSize * 3);
-
-					float *pData = &vRawData[0];
-					for (int i = 0; i < lSize; ++i) {
-						cVector3f &vPos = pGeometry->mvVertexVec[i].tex;
-						vPos.x = pData[0];
-						vPos.y = pData[1];
-						vPos.z = pData[2];
-						pData += 3;
-					}
-				}
+		// Vertices and indices
+		pGeometry->mvVertexVec.resize(ReadCount(aStream));
+		for (size_t j = 0; j < pGeometry->mvVertexVec.size(); ++j) {
+			cVertex &vtx = pGeometry->mvVertexVec[j];
+			vtx.pos = MeshCache::readVector3f(aStream);
+			vtx.tex = MeshCache::readVector3f(aStream);
+			vtx.tan = MeshCache::readVector3f(aStream);
+			vtx.norm = MeshCache::readVector3f(aStream);
+			vtx.col = MeshCache::readColor(aStream);
+		}
 
-				/////////////////////////////////
-				// Tangents
-				{
-					TiXmlElement *pDataElem = pVertexVecElem->FirstChildElement("Tangents");
-					TiXmlText *pVecText = pDataElem->FirstChild()->ToText();
+		pGeometry->mvIndexVec.resize(ReadCount(aStream));
+		for (size_t j = 0; j < pGeometry->mvIndexVec.size(); ++j)
+			pGeometry->mvIndexVec[j] = aStream.readUint32LE();
 
-					// tString sData = pVecText->Value();
-					// tString sSepp = " ";
-					// tFloatVec vRawData; vRawData.reserve(lSize * 3);
-					// cString::GetFloatVec(sData,vRawData,&sSepp);
+		LoadFloatVec(aStream, pGeometry->mvTangents);
 
-					pGeometry->mvTangents.resize(lSize * 4);
-					cString::FloatStringToArray(&pGeometry->mvTangents[0], pVecText->Value(), lSize * 4);
-				}
+		/////////////////////////////////
+		// Extra vertices
+		pGeometry->mvExtraVtxVec.resize(ReadCount(aStream));
+		for (size_t idx = 0; idx < pGeometry->mvExtraVtxVec.size(); ++idx) {
+			tColladaExtraVtxList *pList = &pGeometry->mvExtraVtxVec[idx];
+			const uint32 lExtra = ReadCount(aStream);
+			for (uint32 j = 0; j < lExtra; ++j) {
+				const int lVtx = aStream.readSint32LE();
+				const int lNorm = aStream.readSint32LE();
+				const int lTex = aStream.readSint32LE();
+				const int lNewVtx = aStream.readSint32LE();
+				pList->push_back(cColladaExtraVtx(lVtx, lNorm, lTex, lNewVtx));
 			}
 		}
 
 		/////////////////////////////////
-		// Extra vertex vec
-		{
-			TiXmlElement *pVertexVecElem = pGeometryElem->FirstChildElement("ExtraVertexVec");
-			int lSize = cString::ToInt(pVertexVecElem->Attribute("Size"), 0);
-
-			if (lSize > 0) {
-				pGeometry->mvExtraVtxVec.resize(lSize);
-				tUIntVec mvExtraNum;
-				mvExtraNum.resize(lSize);
-				tUIntVec mvExtraVtx;
-
-				//////////////////////////////////////////////
-				// Extra num
-				{
-					TiXmlElement *pExtraNumElem = pVertexVecElem->FirstChildElement("ExtraNum");
-					TiXmlText *pExtraNumText = pExtraNumElem->FirstChild()->ToText();
-
-					cString::UIntStringToArray(&mvExtraNum[0], pExtraNumText->Value(), lSize);
-				}
-
-				//////////////////////////////////////////////
-				// Extra vertex
-				{
-					TiXmlElement *pExtraVertexElem = pVertexVecElem->FirstChildElement("ExtraVertex");
-					TiXmlText *pExtraVertexText = pExtraVertexElem->FirstChild()->ToText();
-					int lExtraVtxSize = cString::ToInt(pExtraVertexElem->Attribute("Size"), 0);
-					mvExtraVtx.resize(lExtraVtxSize * 4);
-
-					cString::UIntStringToArray(&mvExtraVtx[0], pExtraVertexText->Value(), lExtraVtxSize * 4);
-				}
-
-				unsigned int *pData = &mvExtraVtx[0];
-				for (int idx = 0; idx < lSize; ++idx) {
-					tColladaExtraVtxList *pList = &pGeometry->mvExtraVtxVec[idx];
+		// Source arrays
+		pGeometry->mvArrayVec.resize(ReadCount(aStream));
+		for (size_t idx = 0; idx < pGeometry->mvArrayVec.size(); ++idx) {
+			cColladaVtxArray *pArray = &pGeometry->mvArrayVec[idx];
+			pArray->msId = MeshCache::readString(aStream);
+			pArray->msType = MeshCache::readString(aStream);
+			pArray->mbIsInVertex = aStream.readByte() != 0;
+			LoadVector3fVec(aStream, pArray->mvArray);
+		}
 
-					for (unsigned int j = 0; j < mvExtraNum[idx]; ++j) {
-						pList->push_back(cColladaExtraVtx(pData[0], pData[1], pData[2], pData[3]));
-						pData += 4;
-					}
-				}
-			}
+		pGeometry->mvIndices.resize(ReadCount(aStream));
+		for (size_t idx = 0; idx < pGeometry->mvIndices.size(); ++idx) {
+			pGeometry->mvIndices[idx].mlVtx = aStream.readSint32LE();
+			pGeometry->mvIndices[idx].mlNorm = aStream.readSint32LE();
+			pGeometry->mvIndices[idx].mlTex = aStream.readSint32LE();
 		}
+
+		pGeometry->mlPosIdxNum = aStream.readSint32LE();
+		pGeometry->mlNormIdxNum = aStream.readSint32LE();
+		pGeometry->mlTexIdxNum = aStream.readSint32LE();
+		pGeometry->mlPosArrayIdx = aStream.readSint32LE();
+		pGeometry->mlNormArrayIdx = aStream.readSint32LE();
+		pGeometry->mlTexArrayIdx = aStream.readSint32LE();
 	}
 }
 
 //-----------------------------------------------------------------------
 
-static void LoadIterativeNode(TiXmlElement *apNodeElem, cColladaNode *apParentNode, cColladaScene *apColladaScene) {
-	cColladaNode *pNode = apParentNode->CreateChild();
-	apColladaScene->mlstNodes.push_back(pNode);
-
-	pNode->msId = apNodeElem->Attribute("Id");
-	pNode->msName = apNodeElem->Attribute("Name");
-	pNode->msType = apNodeElem->Attribute("Type");
+static void LoadIterativeNode(Common::SeekableReadStream &aStream, cColladaNode *apParentNode, cColladaScene *apColladaScene) {
+	const uint32 lChildren = ReadCount(aStream);
+	for (uint32 i = 0; i < lChildren; ++i) {
+		cColladaNode *pNode = apParentNode->CreateChild();
+		apColladaScene->mlstNodes.push_back(pNode);
 
-	pNode->msSource = apNodeElem->Attribute("Source");
-	pNode->mbSourceIsFile = cString::ToBool(apNodeElem->Attribute("SourceIsFile"), false);
+		pNode->msId = MeshCache::readString(aStream);
+		pNode->msName = MeshCache::readString(aStream);
+		pNode->msType = MeshCache::readString(aStream);
 
-	pNode->m_mtxTransform = cString::ToMatrixf(apNodeElem->Attribute("Transform"), cMatrixf::Identity);
-	pNode->m_mtxWorldTransform = cString::ToMatrixf(apNodeElem->Attribute("WorldTransform"), cMatrixf::Identity);
+		pNode->msSource = MeshCache::readString(aStream);
+		pNode->mbSourceIsFile = aStream.readByte() != 0;
 
-	pNode->mvScale = cString::ToVector3f(apNodeElem->Attribute("Scale"), 1);
-	pNode->mlCount = cString::ToInt(apNodeElem->Attribute("Count"), 1);
+		pNode->m_mtxTransform = MeshCache::readMatrixf(aStream);
+		pNode->m_mtxWorldTransform = MeshCache::readMatrixf(aStream);
+		pNode->mvScale = MeshCache::readVector3f(aStream);
+		pNode->mlCount = aStream.readSint32LE();
 
-	TiXmlElement *pTransformRootElem = apNodeElem->FirstChildElement("TransformRoot");
-	TiXmlElement *pTransformElem = pTransformRootElem->FirstChildElement("Transform");
-	for (; pTransformElem != NULL; pTransformElem = pTransformElem->NextSiblingElement("Transform")) {
-		pNode->mlstTransforms.push_back(cColladaTransform());
-		cColladaTransform &transform = pNode->mlstTransforms.back();
+		const uint32 lTransforms = ReadCount(aStream);
+		for (uint32 j = 0; j < lTransforms; ++j) {
+			pNode->mlstTransforms.push_back(cColladaTransform());
+			cColladaTransform &transform = pNode->mlstTransforms.back();
 
-		transform.msSid = pTransformElem->Attribute("Sid");
-		transform.msType = pTransformElem->Attribute("Type");
-
-		tString sData = pTransformElem->Attribute("Values");
-		tString sSepp = " ";
-		cString::GetFloatVec(sData, transform.mvValues, &sSepp);
-	}
+			transform.msSid = MeshCache::readString(aStream);
+			transform.msType = MeshCache::readString(aStream);
+			LoadFloatVec(aStream, transform.mvValues);
+		}
 
-	TiXmlElement *pChildElem = apNodeElem->FirstChildElement("Node");
-	for (; pChildElem != NULL; pChildElem = pChildElem->NextSiblingElement("Node")) {
-		LoadIterativeNode(pChildElem, pNode, apColladaScene);
+		LoadIterativeNode(aStream, pNode, apColladaScene);
 	}
 }
 
 //-----------------------------------------------------------------------
 
-static void LoadScene(TiXmlElement *apRootElem, cColladaScene *apColladaScene) {
-	TiXmlElement *pSceneElem = apRootElem->FirstChildElement("Scene");
-
+static void LoadScene(Common::SeekableReadStream &aStream, cColladaScene *apColladaScene) {
 	// Delete all nodes.
 	apColladaScene->ResetNodes();
 
-	apColladaScene->mfStartTime = cString::ToFloat(pSceneElem->Attribute("StartTime"), 0);
-	apColladaScene->mfEndTime = cString::ToFloat(pSceneElem->Attribute("EndTime"), 0);
-	apColladaScene->mfDeltaTime = cString::ToFloat(pSceneElem->Attribute("DeltaTime"), 0);
+	apColladaScene->mfStartTime = aStream.readFloatLE();
+	apColladaScene->mfEndTime = aStream.readFloatLE();
+	apColladaScene->mfDeltaTime = aStream.readFloatLE();
 
-	TiXmlElement *pSceneRootElem = pSceneElem->FirstChildElement("Root");
-	TiXmlElement *pNodeElem = pSceneRootElem->FirstChildElement("Node");
-	for (; pNodeElem != NULL; pNodeElem = pNodeElem->NextSiblingElement("Node")) {
-		LoadIterativeNode(pNodeElem, &apColladaScene->mRoot, apColladaScene);
-	}
+	LoadIterativeNode(aStream, &apColladaScene->mRoot, apColladaScene);
 }
 
 //-----------------------------------------------------------------------
@@ -40,6 +40,10 @@
 #include "hpl1/engine/impl/tinyXML/tinyxml.h"
 
 #include "hpl1/engine/math/Math.h"
+#include "hpl1/mesh_cache.h"
+
+#include "common/memstream.h"
+#include "common/ptr.h"
 
 namespace hpl {
 
@@ -77,7 +81,29 @@ cWorld3D *cMeshLoaderMSH::LoadWorld(const tString &asFile, cScene *apScene, tWor
 
 //-----------------------------------------------------------------------
 
+static int GetElementsPerVertex(tVertexFlag aFlag) {
+	if (aFlag & eVertexFlag_Texture1 || aFlag & eVertexFlag_Color0)
+		return 4;
+	return 3;
+}
+
+//-----------------------------------------------------------------------
+
 cMesh *cMeshLoaderMSH::LoadMesh(const tString &asFile, tMeshLoadFlag aFlags) {
+	/////////////////////////////////////////////////
+	// TRY THE CACHE
+	Hpl1::MeshCache cache(asFile, Hpl1::kMeshCacheMSH);
+	{
+		Common::ScopedPtr<Common::SeekableReadStream> cacheStream(cache.load());
+		if (cacheStream) {
+			cMesh *pCachedMesh = LoadCachedMesh(*cacheStream, asFile);
+			if (pCachedMesh)
+				return pCachedMesh;
+		}
+	}
+	// The cache is only written once the whole mesh has been loaded.
+	Common::MemoryWriteStreamDynamic cacheData(DisposeAfterUse::YES);
+
 	cMesh *pMesh = hplNew(cMesh, (cString::GetFileName(asFile), mpMaterialManager, mpAnimationManager));
 	// If the mesh is animated there are some property differences, the vertex buffer
 	// Must be Stream instead of static for example.
@@ -154,10 +180,7 @@ cMesh *cMeshLoaderMSH::LoadMesh(const tString &asFile, tMeshLoadFlag aFlags) {
 		// Fill the arrays
 		for (int i = 0; i < klNumOfVertexFlags; i++) {
 			if (kvVertexFlags[i] & vtxFlags) {
-				int lElemPerVtx = 3;
-				if (kvVertexFlags[i] & eVertexFlag_Texture1 || kvVertexFlags[i] & eVertexFlag_Color0) {
-					lElemPerVtx = 4;
-				}
+				int lElemPerVtx = GetElementsPerVertex(kvVertexFlags[i]);
 
 				TiXmlElement *pElem = pVtxElem->FirstChildElement(GetVertexName(kvVertexFlags[i]));
 
@@ -179,6 +202,8 @@ cMesh *cMeshLoaderMSH::LoadMesh(const tString &asFile, tMeshLoadFlag aFlags) {
 		pVtxBuff->ResizeIndices(lIdxSize);
 		FillIdxArray(pVtxBuff->GetIndices(), pIdxElem->Attribute("data"), lIdxSize);
 
+		WriteCachedSubMesh(cacheData, pSubMesh->GetName(), pMatName, bTangents, lVtxSize, pVtxBuff);
+
 		///////////////////
 		// Compile vertex buffer
 		pVtxBuff->Compile(0);
@@ -195,11 +220,105 @@ cMesh *cMeshLoaderMSH::LoadMesh(const tString &asFile, tMeshLoadFlag aFlags) {
 
 	hplDelete(pXmlDoc);
 
+	/////////////////////////////////////////////////
+	// WRITE CACHE
+	cacheData.writeByte(0);
+	Common::ScopedPtr<Common::WriteStream> cacheStream(cache.save());
+	if (cacheStream) {
+		cacheStream->write(cacheData.getData(), cacheData.size());
+		cacheStream->finalize();
+	}
+
+	return pMesh;
+}
+
+//-----------------------------------------------------------------------
+
+cMesh *cMeshLoaderMSH::LoadCachedMesh(Common::SeekableReadStream &aStream, const tString &asFile) {
+	cMesh *pMesh = hplNew(cMesh, (cString::GetFileName(asFile), mpMaterialManager, mpAnimationManager));
+
+	// Every sub mesh is preceded by a non zero byte.
+	while (aStream.readByte() && !aStream.eos()) {
+		cSubMesh *pSubMesh = pMesh->CreateSubMesh(Hpl1::MeshCache::readString(aStream));
+		pSubMesh->SetMaterial(mpMaterialManager->CreateMaterial(Hpl1::MeshCache::readString(aStream)));
+
+		const tVertexFlag vtxFlags = aStream.readUint32LE();
+		const bool bTangents = aStream.readByte() != 0;
+		const int lVtxSize = aStream.readUint32LE();
+
+		iVertexBuffer *pVtxBuff = mpLowLevelGraphics->CreateVertexBuffer(vtxFlags,
+																		 eVertexBufferDrawType_Tri,
+																		 eVertexBufferUsageType_Static,
+																		 0, 0);
+		pVtxBuff->SetTangents(bTangents);
+		pSubMesh->SetVertexBuffer(pVtxBuff);
+
+		for (int i = 0; i < klNumOfVertexFlags; i++) {
+			if (kvVertexFlags[i] & vtxFlags) {
+				const int lArraySize = lVtxSize * GetElementsPerVertex(kvVertexFlags[i]);
+				if (aStream.eos() || lArraySize < 0 || lArraySize > aStream.size()) {
+					hplDelete(pMesh);
+					return NULL;
+				}
+				pVtxBuff->ResizeArray(kvVertexFlags[i], lArraySize);
+				Hpl1::MeshCache::readFloats(aStream, pVtxBuff->GetArray(kvVertexFlags[i]), lArraySize);
+			}
+		}
+
+		const int lIdxSize = aStream.readUint32LE();
+		if (aStream.eos() || lIdxSize < 0 || lIdxSize > aStream.size()) {
+			hplDelete(pMesh);
+			return NULL;
+		}
+		pVtxBuff->ResizeIndices(lIdxSize);
+		unsigned int *pIndices = pVtxBuff->GetIndices();
+		for (int i = 0; i < lIdxSize; i++)
+			pIndices[i] = aStream.readUint32LE();
+
+		if (aStream.eos() || aStream.err()) {
+			hplDelete(pMesh);
+			return NULL;
+		}
+
+		pVtxBuff->Compile(0);
+	}
+
+	if (aStream.eos() || aStream.err()) {
+		hplDelete(pMesh);
+		return NULL;
+	}
+
 	return pMesh;
 }
 
 //-----------------------------------------------------------------------
 
+void cMeshLoaderMSH::WriteCachedSubMesh(Common::WriteStream &aStream, const tString &asName, const tString &asMaterial,
+										bool abTangents, int alVtxSize, iVertexBuffer *apVtxBuff) {
+	const tVertexFlag vtxFlags = apVtxBuff->GetVertexFlags();
+
+	aStream.writeByte(1);
+	Hpl1::MeshCache::writeString(aStream, asName);
+	Hpl1::MeshCache::writeString(aStream, asMaterial);
+	aStream.writeUint32LE(vtxFlags);
+	aStream.writeByte(abTangents);
+	aStream.writeUint32LE(alVtxSize);
+
+	for (int i = 0; i < klNumOfVertexFlags; i++) {
+		if (kvVertexFlags[i] & vtxFlags) {
+			Hpl1::MeshCache::writeFloats(aStream, apVtxBuff->GetArray(kvVertexFlags[i]),
+										 alVtxSize * GetElementsPerVertex(kvVertexFlags[i]));
+		}
+	}
+
+	aStream.writeUint32LE(apVtxBuff->GetIndexNum());
+	const unsigned int *pIndices = apVtxBuff->GetIndices();
+	for (int i = 0; i < apVtxBuff->GetIndexNum(); i++)
+		aStream.writeUint32LE(pIndices[i]);
+}
+
+//-----------------------------------------------------------------------
+
 bool cMeshLoaderMSH::SaveMesh(cMesh *apMesh, const tString &asFile) {
 	TiXmlDocument *pXmlDoc = hplNew(TiXmlDocument, (asFile.c_str()));
 
@@ -34,6 +34,11 @@
 
 class TiXmlElement;
 
+namespace Common {
+class SeekableReadStream;
+class WriteStream;
+} // namespace Common
+
 namespace hpl {
 
 class cMesh;
@@ -62,6 +67,9 @@ private:
 	void SaveIntData(TiXmlElement *apRoot, int alSize, unsigned int *apData);
 
 	// Loading
+	cMesh *LoadCachedMesh(Common::SeekableReadStream &aStream, const tString &asFile);
+	void WriteCachedSubMesh(Common::WriteStream &aStream, const tString &asName, const tString &asMaterial,
+							bool abTangents, int alVtxSize, iVertexBuffer *apVtxBuff);
 	void FillVtxArray(float *apArray, const char *apString, int alSize);
 	void FillIdxArray(unsigned int *apArray, const char *apString, int alSize);
 
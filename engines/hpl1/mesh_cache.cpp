@@ -0,0 +1,179 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "hpl1/mesh_cache.h"
+#include "common/config-manager.h"
+#include "common/crc.h"
+#include "common/file.h"
+#include "common/savefile.h"
+#include "common/system.h"
+#include "hpl1/debug.h"
+
+namespace Hpl1 {
+
+static const uint32 kMeshCacheTag = MKTAG('H', 'P', 'L', 'M');
+// Bump this whenever the layout of any cached structure changes.
+static const uint32 kMeshCacheVersion = 2;
+
+MeshCache::MeshCache(const Common::String &sourceFile, MeshCacheType type)
+	: _sourceFile(sourceFile), _type(type), _hasStamp(false), _hasCrc(false), _sourceSize(0), _sourceTime(0), _sourceCrc(0) {
+	// Meshes in different directories may have the same name, so the name
+	// is followed by a checksum of the whole path
+	Common::String path = Common::Path(sourceFile).normalize().toString();
+	path.toLowercase();
+	Common::CRC32 crc;
+	_cacheFile = Common::String::format("%s-%s-%08x.mcache", ConfMan.getActiveDomainName().c_str(),
+										Common::Path(sourceFile).baseName().c_str(), crc.crcFast((const byte *)path.c_str(), path.size()));
+}
+
+bool MeshCache::readSourceStamp() {
+	if (_hasStamp)
+		return true;
+	Common::File file;
+	if (!file.open(Common::Path(_sourceFile)))
+		return false;
+	_sourceSize = file.size();
+	// Files inside of archives don't have a modification time
+	Common::ArchiveMemberPtr member = SearchMan.getMember(Common::Path(_sourceFile));
+	_sourceTime = member ? member->getModificationTime() : 0;
+	_hasStamp = true;
+	return true;
+}
+
+bool MeshCache::computeSourceCrc() {
+	if (_hasCrc)
+		return true;
+	Common::File file;
+	if (!readSourceStamp() || !file.open(Common::Path(_sourceFile)))
+		return false;
+	Common::Array<byte> data(_sourceSize);
+	if (_sourceSize && file.read(data.data(), _sourceSize) != _sourceSize)
+		return false;
+	Common::CRC32 crc;
+	_sourceCrc = crc.crcFast(data.data(), _sourceSize);
+	_hasCrc = true;
+	return true;
+}
+
+Common::SeekableReadStream *MeshCache::load() {
+	Common::ScopedPtr<Common::InSaveFile> cacheFile(g_system->getSavefileManager()->openForLoading(_cacheFile));
+	if (!cacheFile)
+		return nullptr;
+	if (cacheFile->readUint32BE() != kMeshCacheTag || cacheFile->readUint32LE() != kMeshCacheVersion ||
+		cacheFile->readUint32LE() != (uint32)_type) {
+		logWarning(kDebugResourceLoading, "discarding outdated mesh cache %s\n", _cacheFile.c_str());
+		return nullptr;
+	}
+	const uint32 sourceSize = cacheFile->readUint32LE();
+	const uint32 sourceTime = cacheFile->readUint32LE();
+	const uint32 sourceCrc = cacheFile->readUint32LE();
+	// The source is only read for its checksum if its modification time can't tell
+	if (cacheFile->err() || !readSourceStamp() || sourceSize != _sourceSize ||
+		((!_sourceTime || sourceTime != _sourceTime) && (!computeSourceCrc() || sourceCrc != _sourceCrc))) {
+		logInfo(kDebugResourceLoading, "mesh cache %s is out of date\n", _cacheFile.c_str());
+		return nullptr;
+	}
+	Common::SeekableReadStream *data = cacheFile->readStream(cacheFile->size() - cacheFile->pos());
+	if (!data || cacheFile->err()) {
+		delete data;
+		return nullptr;
+	}
+	return data;
+}
+
+Common::WriteStream *MeshCache::save() {
+	if (!computeSourceCrc())
+		return nullptr;
+	Common::OutSaveFile *cacheFile = g_system->getSavefileManager()->openForSaving(_cacheFile, false);
+	if (!cacheFile) {
+		logWarning(kDebugResourceLoading, "couldn't create mesh cache %s\n", _cacheFile.c_str());
+		return nullptr;
+	}
+	cacheFile->writeUint32BE(kMeshCacheTag);
+	cacheFile->writeUint32LE(kMeshCacheVersion);
+	cacheFile->writeUint32LE(_type);
+	cacheFile->writeUint32LE(_sourceSize);
+	cacheFile->writeUint32LE(_sourceTime);
+	cacheFile->writeUint32LE(_sourceCrc);
+	return cacheFile;
+}
+
+void MeshCache::writeString(Common::WriteStream &stream, const Common::String &str) {
+	stream.writeUint32LE(str.size());
+	stream.writeString(str);
+}
+
+Common::String MeshCache::readString(Common::ReadStream &stream) {
+	const uint32 size = stream.readUint32LE();
+	return stream.readString(0, size);
+}
+
+void MeshCache::writeVector3f(Common::WriteStream &stream, const hpl::cVector3f &vec) {
+	stream.writeFloatLE(vec.x);
+	stream.writeFloatLE(vec.y);
+	stream.writeFloatLE(vec.z);
+}
+
+hpl::cVector3f MeshCache::readVector3f(Common::ReadStream &stream) {
+	hpl::cVector3f vec;
+	vec.x = stream.readFloatLE();
+	vec.y = stream.readFloatLE();
+	vec.z = stream.readFloatLE();
+	return vec;
+}
+
+void MeshCache::writeMatrixf(Common::WriteStream &stream, const hpl::cMatrixf &mtx) {
+	writeFloats(stream, mtx.v, 16);
+}
+
+hpl::cMatrixf MeshCache::readMatrixf(Common::ReadStream &stream) {
+	hpl::cMatrixf mtx;
+	readFloats(stream, mtx.v, 16);
+	return mtx;
+}
+
+void MeshCache::writeColor(Common::WriteStream &stream, const hpl::cColor &col) {
+	stream.writeFloatLE(col.r);
+	stream.writeFloatLE(col.g);
+	stream.writeFloatLE(col.b);
+	stream.writeFloatLE(col.a);
+}
+
+hpl::cColor MeshCache::readColor(Common::ReadStream &stream) {
+	hpl::cColor col;
+	col.r = stream.readFloatLE();
+	col.g = stream.readFloatLE();
+	col.b = stream.readFloatLE();
+	col.a = stream.readFloatLE();
+	return col;
+}
+
+void MeshCache::writeFloats(Common::WriteStream &stream, const float *data, uint32 size) {
+	for (uint32 i = 0; i < size; ++i)
+		stream.writeFloatLE(data[i]);
+}
+
+void MeshCache::readFloats(Common::ReadStream &stream, float *data, uint32 size) {
+	for (uint32 i = 0; i < size; ++i)
+		data[i] = stream.readFloatLE();
+}
+
+} // namespace Hpl1
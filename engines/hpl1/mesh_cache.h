@@ -0,0 +1,97 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef HPL1_MESH_CACHE_H
+#define HPL1_MESH_CACHE_H
+
+#include "common/array.h"
+#include "common/stream.h"
+#include "common/str.h"
+#include "hpl1/engine/graphics/Color.h"
+#include "hpl1/engine/math/MathTypes.h"
+
+namespace Hpl1 {
+
+enum MeshCacheType {
+	kMeshCacheCollada = 1,
+	kMeshCacheMSH = 2
+};
+
+/**
+ * Binary cache of processed mesh data, stored next to the save files.
+ *
+ * Each cache file starts with a header holding the cache format version,
+ * the kind of data it contains and the size, modification time and CRC32
+ * of the source file it was built from. A cache is only used if the source
+ * still has the same size and either the same modification time or, where
+ * that isn't known or differs, the same CRC32. Otherwise the caller is
+ * expected to parse the source and write a new one.
+ */
+class MeshCache {
+public:
+	MeshCache(const Common::String &sourceFile, MeshCacheType type);
+
+	/**
+	 * Opens the cache for the source file and validates its header.
+	 * The whole cache is read into memory in one go, the returned stream
+	 * is positioned right after the header. Returns nullptr on a miss.
+	 */
+	Common::SeekableReadStream *load();
+
+	/**
+	 * Creates a new cache for the source file and writes its header.
+	 * The caller is responsible for finalizing and deleting the stream.
+	 */
+	Common::WriteStream *save();
+
+	static void writeString(Common::WriteStream &stream, const Common::String &str);
+	static Common::String readString(Common::ReadStream &stream);
+
+	static void writeVector3f(Common::WriteStream &stream, const hpl::cVector3f &vec);
+	static hpl::cVector3f readVector3f(Common::ReadStream &stream);
+
+	static void writeMatrixf(Common::WriteStream &stream, const hpl::cMatrixf &mtx);
+	static hpl::cMatrixf readMatrixf(Common::ReadStream &stream);
+
+	static void writeColor(Common::WriteStream &stream, const hpl::cColor &col);
+	static hpl::cColor readColor(Common::ReadStream &stream);
+
+	static void writeFloats(Common::WriteStream &stream, const float *data, uint32 size);
+	static void readFloats(Common::ReadStream &stream, float *data, uint32 size);
+
+private:
+	bool readSourceStamp();
+	bool computeSourceCrc();
+
+	Common::String _sourceFile;
+	Common::String _cacheFile;
+	MeshCacheType _type;
+
+	bool _hasStamp;
+	bool _hasCrc;
+	uint32 _sourceSize;
+	uint32 _sourceTime;
+	uint32 _sourceCrc;
+};
+
+} // namespace Hpl1
+
+#endif // HPL1_MESH_CACHE_H
@@ -4,6 +4,7 @@ MODULE_OBJS := \
 	string.o \
 	opengl.o \
 	graphics.o \
+	mesh_cache.o \
 	serialize.o \
 	engine/ai/AI.o \
 	engine/ai/AINodeContainer.o \
@@ -94,7 +94,7 @@ public:
 
 	int getMaximumSaveSlot() const override;
 	SaveStateList listSaves(const char *target) const override;
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 	bool removeSaveState(const char *target, int slot) const override;
 	Common::String getSavegameFile(int saveGameIdx, const char *target) const override {
 		if (!target)
@@ -313,7 +313,7 @@ SaveStateList HugoMetaEngine::listSaves(const char *target) const {
 	return saveList;
 }
 
-SaveStateDescriptor HugoMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
+SaveStateDescriptor HugoMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
 	Common::InSaveFile *file = g_system->getSavefileManager()->openForLoading(getSavegameFile(slot, target));
 
 	if (file) {
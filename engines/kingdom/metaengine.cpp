@@ -49,7 +49,7 @@ public:
 	int getMaximumSaveSlot() const override;
 	SaveStateList listSaves(const char *target) const override;
 	bool removeSaveState(const char *target, int slot) const override;
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 };
 
 bool KingdomMetaEngine::hasFeature(MetaEngineFeature f) const {
@@ -111,7 +111,7 @@ bool KingdomMetaEngine::removeSaveState(const char *target, int slot) const {
 	return g_system->getSavefileManager()->removeSavefile(filename);
 }
 
-SaveStateDescriptor KingdomMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
+SaveStateDescriptor KingdomMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
 	Common::String filename = Common::String::format("%s.%03d", target, slot);
 	Common::InSaveFile *f = g_system->getSavefileManager()->openForLoading(filename);
 
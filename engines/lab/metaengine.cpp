@@ -63,7 +63,7 @@ public:
 	SaveStateList listSaves(const char *target) const override;
 	int getMaximumSaveSlot() const override;
 	bool removeSaveState(const char *target, int slot) const override;
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 	Common::KeymapArray initKeymaps(const char *target) const override;
 };
 
@@ -123,7 +123,7 @@ bool LabMetaEngine::removeSaveState(const char *target, int slot) const {
 	return saveFileMan->removeSavefile(Common::String::format("%s.%03u", target, slot));
 }
 
-SaveStateDescriptor LabMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
+SaveStateDescriptor LabMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
 	Common::String filename = Common::String::format("%s.%03u", target, slot);
 	Common::InSaveFile *in = g_system->getSavefileManager()->openForLoading(filename.c_str());
 
@@ -75,7 +75,7 @@ bool M4MetaEngine::hasFeature(MetaEngineFeature f) const {
 		(f == kSupportsLoadingDuringStartup);
 }
 
-SaveStateDescriptor M4MetaEngine::querySaveMetaInfos(const char *target, int slot) const {
+SaveStateDescriptor M4MetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
 	Common::String saveName = Common::String::format("%s.%03u", target, slot);
 	Common::InSaveFile *save = getOriginalSave(saveName);
 
@@ -89,7 +89,7 @@ SaveStateDescriptor M4MetaEngine::querySaveMetaInfos(const char *target, int slo
 		SaveStateDescriptor desc(this, slot, saveDesc);
 		return desc;
 	} else {
-		return AdvancedMetaEngine::querySaveMetaInfos(target, slot);
+		return AdvancedMetaEngine::querySaveMetaInfos(target, slot, skipThumbnail);
 	}
 }
 
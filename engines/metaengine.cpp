@@ -26,6 +26,7 @@
 #include "backends/keymapper/keymap.h"
 #include "backends/keymapper/standard-actions.h"
 
+#include "common/memstream.h"
 #include "common/savefile.h"
 #include "common/system.h"
 #include "common/translation.h"
@@ -360,6 +361,77 @@ WARN_UNUSED_RESULT bool MetaEngine::readSavegameHeader(Common::InSaveFile *in, E
 }
 
 
+// Bump this whenever the layout of the stored metadata changes
+static const byte kSavegameMetadataVersion = 1;
+
+WARN_UNUSED_RESULT bool MetaEngine::readSavegameMetadata(const Common::String &filename, ExtendedSavegameHeader *header, bool skipThumbnail) {
+	Common::SaveFileManager *saveFileMan = g_system->getSavefileManager();
+
+	Common::ScopedPtr<Common::SeekableReadStream> meta(saveFileMan->openMetadata(filename));
+	if (meta && meta->readByte() == kSavegameMetadataVersion) {
+		Common::strcpy_s(header->id, "SVMCR");
+		header->version = meta->readByte();
+		header->date = meta->readUint32LE();
+		header->time = meta->readUint16LE();
+		header->playtime = meta->readUint32LE();
+		header->isAutosave = meta->readByte();
+		header->saveName = meta->readPascalString();
+		header->description = meta->readString(0, meta->readUint16LE());
+
+		// The thumbnail is only decoded when asked for
+		header->thumbnail = nullptr;
+		if (!meta->err() && !meta->eos() &&
+			(!meta->readByte() || Graphics::loadThumbnail(*meta, header->thumbnail, skipThumbnail)))
+			return true;
+
+		delete header->thumbnail;
+		header->thumbnail = nullptr;
+	}
+
+	Common::ScopedPtr<Common::InSaveFile> in(saveFileMan->openForLoading(filename));
+	if (!in || !readSavegameHeader(in.get(), header, false))
+		return false;
+
+	if (header->thumbnail && (header->thumbnail->w > kThumbnailWidth || header->thumbnail->h > kThumbnailHeight2)) {
+		int w = kThumbnailWidth;
+		int h = header->thumbnail->h * kThumbnailWidth / header->thumbnail->w;
+		if (h > kThumbnailHeight2) {
+			h = kThumbnailHeight2;
+			w = header->thumbnail->w * kThumbnailHeight2 / header->thumbnail->h;
+		}
+
+		Graphics::Surface *scaled = Graphics::scale(*header->thumbnail, MAX(w, 1), MAX(h, 1));
+		header->thumbnail->free();
+		delete header->thumbnail;
+		header->thumbnail = scaled;
+	}
+
+	Common::MemoryWriteStreamDynamic out(DisposeAfterUse::YES);
+	out.writeByte(kSavegameMetadataVersion);
+	out.writeByte(header->version);
+	out.writeUint32LE(header->date);
+	out.writeUint16LE(header->time);
+	out.writeUint32LE(header->playtime);
+	out.writeByte(header->isAutosave);
+	out.writeByte(MIN<uint>(header->saveName.size(), 0xFF));
+	out.writeString(header->saveName.substr(0, 0xFF));
+	out.writeUint16LE(MIN<uint>(header->description.size(), 0xFFFF));
+	out.writeString(header->description.substr(0, 0xFFFF));
+	out.writeByte(header->thumbnail != nullptr);
+	if (header->thumbnail)
+		Graphics::saveThumbnail(out, *header->thumbnail);
+	saveFileMan->setMetadata(filename, out.getData(), out.size());
+
+	if (skipThumbnail && header->thumbnail) {
+		header->thumbnail->free();
+		delete header->thumbnail;
+		header->thumbnail = nullptr;
+	}
+
+	return true;
+}
+
+
 //////////////////////////////////////////////
 // MetaEngine default implementations
 //////////////////////////////////////////////
@@ -402,13 +474,18 @@ SaveStateList MetaEngine::listSaves(const char *target) const {
 		int slotNum = atoi(slotStr);
 
 		if (slotNum >= 0 && slotNum <= getMaximumSaveSlot()) {
-			SaveStateDescriptor desc = querySaveMetaInfos(target, slotNum);
+			SaveStateDescriptor desc = querySaveMetaInfos(target, slotNum, true);
 			if (desc.getSaveSlot() != -1) {
+				// Thumbnails are queried again for the saves actually shown
+				desc.setThumbnail(Common::SharedPtr<Graphics::Surface>());
 				saveList.push_back(desc);
 			}
 		}
 	}
 
+	// Keep the metadata read from save files for the next time
+	saveFileMan->flushMetadata();
+
 	// Sort saves based on slot number.
 	Common::sort(saveList.begin(), saveList.end(), SaveStateDescriptorSlotComparator());
 	return saveList;
@@ -469,26 +546,18 @@ bool MetaEngine::removeSaveState(const char *target, int slot) const {
 	return g_system->getSavefileManager()->removeSavefile(getSavegameFile(slot, target));
 }
 
-SaveStateDescriptor MetaEngine::querySaveMetaInfos(const char *target, int slot) const {
+SaveStateDescriptor MetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
 	if (!hasFeature(kSavesUseExtendedFormat))
 		return SaveStateDescriptor();
 
-	Common::ScopedPtr<Common::InSaveFile> f(g_system->getSavefileManager()->openForLoading(
-		getSavegameFile(slot, target)));
-
-	if (f) {
-		ExtendedSavegameHeader header;
-		if (!readSavegameHeader(f.get(), &header, false)) {
-			return SaveStateDescriptor();
-		}
-
-		// Create the return descriptor
-		SaveStateDescriptor desc(this, slot, Common::U32String());
-		parseSavegameHeader(&header, &desc);
-		desc.setThumbnail(header.thumbnail);
-		desc.setAutosave(header.isAutosave);
-		return desc;
-	}
+	ExtendedSavegameHeader header;
+	if (!readSavegameMetadata(getSavegameFile(slot, target), &header, skipThumbnail))
+		return SaveStateDescriptor();
 
-	return SaveStateDescriptor();
+	// Create the return descriptor
+	SaveStateDescriptor desc(this, slot, Common::U32String());
+	parseSavegameHeader(&header, &desc);
+	desc.setThumbnail(header.thumbnail);
+	desc.setAutosave(header.isAutosave);
+	return desc;
 }
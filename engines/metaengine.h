@@ -359,10 +359,12 @@ public:
 	 * Depending on the MetaEngineFeatures set, this can include
 	 * thumbnails, save date and time, play time.
 	 *
-	 * @param target  Name of a config manager target.
-	 * @param slot    Slot number of the save state.
+	 * @param target         Name of a config manager target.
+	 * @param slot           Slot number of the save state.
+	 * @param skipThumbnail  The thumbnail is not needed, e.g. because the save
+	 *                       state is only listed. Engines may still return one.
 	 */
-	virtual SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const;
+	virtual SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const;
 
 	/**
 	 * Return the name of the save file for the given slot and optional target,
@@ -592,6 +594,16 @@ public:
 	 * Read the extended savegame header from the given savegame file.
 	 */
 	WARN_UNUSED_RESULT static bool readSavegameHeader(Common::InSaveFile *in, ExtendedSavegameHeader *header, bool skipThumbnail = true);
+
+	/**
+	 * Read the extended savegame header of the given savegame file.
+	 *
+	 * The header is taken from the metadata the save file manager keeps for
+	 * the file if possible. Otherwise it is read from the file and added to
+	 * that metadata, with the thumbnail scaled down to the standard thumbnail
+	 * size if it is any bigger.
+	 */
+	WARN_UNUSED_RESULT static bool readSavegameMetadata(const Common::String &filename, ExtendedSavegameHeader *header, bool skipThumbnail = true);
 };
 
 /**
@@ -119,7 +119,7 @@ public:
 	bool hasFeature(MetaEngineFeature f) const override;
 	Common::Error createInstance(OSystem *syst, Engine **engine, const MM::MightAndMagicGameDescription *desc) const override;
 	SaveStateList listSaves(const char *target) const override;
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 	Common::KeymapArray initKeymaps(const char *target) const override;
 
 	const ADExtraGuiOptionsMap *getAdvancedExtraGuiOptions() const override {
@@ -165,14 +165,14 @@ SaveStateList MMMetaEngine::listSaves(const char *target) const {
 	return AdvancedMetaEngine::listSaves(target);
 }
 
-SaveStateDescriptor MMMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
+SaveStateDescriptor MMMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
 #ifdef ENABLE_XEEN
 	if (isXeenGame(target))
 		// Fallback original code for Xeen
 		return MM::Xeen::XeenMetaEngine::querySaveMetaInfos(this, target, slot);
 #endif
 
-	return AdvancedMetaEngine::querySaveMetaInfos(target, slot);
+	return AdvancedMetaEngine::querySaveMetaInfos(target, slot, skipThumbnail);
 }
 
 Common::KeymapArray MMMetaEngine::initKeymaps(const char *target) const {
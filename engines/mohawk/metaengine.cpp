@@ -134,7 +134,7 @@ public:
 	SaveStateList listSavesForPrefix(const char *prefix, const char *extension) const;
 	int getMaximumSaveSlot() const override { return 999; }
 	bool removeSaveState(const char *target, int slot) const override;
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 
 	Common::KeymapArray initKeymaps(const char *target) const override;
 
@@ -246,7 +246,7 @@ bool MohawkMetaEngine::removeSaveState(const char *target, int slot) const {
 	return false;
 }
 
-SaveStateDescriptor MohawkMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
+SaveStateDescriptor MohawkMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
 	Common::String gameId = ConfMan.get("gameid", target);
 
 #ifdef ENABLE_MYST
@@ -27,6 +27,7 @@
 #include "mohawk/riven_sound.h"
 #include "mohawk/riven.h"
 #include "mohawk/riven_card.h"
+#include "mohawk/riven_stack.h"
 #include "mohawk/resource.h"
 #include "mohawk/sound.h"
 
@@ -47,7 +48,15 @@ RivenSoundManager::~RivenSoundManager() {
 }
 
 Audio::RewindableAudioStream *RivenSoundManager::makeAudioStream(uint16 id) {
-	return makeMohawkWaveStream(_vm->getResource(ID_TWAV, id));
+	// Sound ids are only unique within a stack
+	const Common::String key = Audio::PCMCache::makeKey(Common::String::format("%d", _vm->getStack()->getId()),
+	                                                    Common::String::format("%d", id), "tWAV");
+
+	Audio::SeekableAudioStream *stream = _soundCache.find(key);
+	if (stream)
+		return stream;
+
+	return _soundCache.makeCachingStream(key, makeMohawkWaveStream(_vm->getResource(ID_TWAV, id)));
 }
 
 void RivenSoundManager::playSound(uint16 id, uint16 volume, bool playOnDraw) {
@@ -26,6 +26,7 @@
 #include "common/str.h"
 
 #include "audio/mixer.h"
+#include "audio/pcmcache.h"
 
 namespace Audio {
 class RewindableAudioStream;
@@ -129,6 +130,9 @@ private:
 	RivenSound *_effect;
 	bool _effectPlayOnDraw;
 
+	/** Decoded sounds, as effects like button clicks are played over and over */
+	Audio::PCMCache _soundCache;
+
 	Audio::RewindableAudioStream *makeAudioStream(uint16 id);
 
 	// Ambient sound management
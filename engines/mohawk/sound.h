@@ -34,6 +34,7 @@ class MidiParser;
 
 namespace Audio {
 class RewindableAudioStream;
+class SeekableAudioStream;
 }
 
 namespace Mohawk {
@@ -95,7 +96,7 @@ struct DataChunk {
 	Common::SeekableReadStream *audioData;
 };
 
-Audio::RewindableAudioStream *makeMohawkWaveStream(Common::SeekableReadStream *stream, CueList *cueList = nullptr);
+Audio::SeekableAudioStream *makeMohawkWaveStream(Common::SeekableReadStream *stream, CueList *cueList = nullptr);
 
 class MohawkEngine;
 
@@ -74,7 +74,7 @@ public:
 
 	int getMaximumSaveSlot() const override;
 	SaveStateList listSaves(const char *target) const override;
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 	Common::String getSavegameFile(int saveGameIdx, const char *target) const override {
 		if (!target)
 			target = getName();
@@ -111,7 +111,7 @@ SaveStateList MortevielleMetaEngine::listSaves(const char *target) const {
 	return Mortevielle::SavegameManager::listSaves(this, target);
 }
 
-SaveStateDescriptor MortevielleMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
+SaveStateDescriptor MortevielleMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
 	Common::String filename = Mortevielle::MortevielleEngine::generateSaveFilename(target, slot);
 	return Mortevielle::SavegameManager::querySaveMetaInfos(this, filename);
 }
@@ -95,7 +95,7 @@ public:
 		return description;
 	}
 
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override {
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override {
 		SaveStateDescriptor saveInfos = getSaveDescription(target, slot);
 
 		if (saveInfos.getDescription().empty()) {
@@ -122,7 +122,7 @@ public:
 	Common::Error createInstance(OSystem *syst, Engine **engine, const Nancy::NancyGameDescription *gd) const override;
 
 	int getMaximumSaveSlot() const override;
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 
 	Common::KeymapArray initKeymaps(const char *target) const override;
 
@@ -159,8 +159,8 @@ Common::Error NancyMetaEngine::createInstance(OSystem *syst, Engine **engine, co
 
 int NancyMetaEngine::getMaximumSaveSlot() const { int r = ConfMan.getInt("nancy_max_saves"); return r ? r : AdvancedMetaEngine::getMaximumSaveSlot(); }
 
-SaveStateDescriptor NancyMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
-	SaveStateDescriptor ret = AdvancedMetaEngine::querySaveMetaInfos(target, slot);
+SaveStateDescriptor NancyMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
+	SaveStateDescriptor ret = AdvancedMetaEngine::querySaveMetaInfos(target, slot, skipThumbnail);
 	if (slot == getMaximumSaveSlot()) {
 		// We do not allow the second chance slot to be overwritten
 		ret.setWriteProtectedFlag(true);
@@ -41,7 +41,7 @@ public:
 	int getMaximumSaveSlot() const override { return 17; }
 	SaveStateList listSaves(const char *target) const override;
 	bool removeSaveState(const char *target, int slot) const override;
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 	Common::Error createInstance(OSystem *syst, Engine **engine, const ADGameDescription *desc) const override;
 	Common::KeymapArray initKeymaps(const char *target) const override;
 };
@@ -86,7 +86,7 @@ bool PetkaMetaEngine::removeSaveState(const char *target, int slot) const {
 	return g_system->getSavefileManager()->removeSavefile(Petka::generateSaveName(slot, target));
 }
 
-SaveStateDescriptor PetkaMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
+SaveStateDescriptor PetkaMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
 	Common::ScopedPtr<Common::InSaveFile> f(g_system->getSavefileManager()->openForLoading(Petka::generateSaveName(slot, target)));
 
 	if (f) {
@@ -137,7 +137,7 @@ SaveStateList PhoenixVRMetaEngine::listSaves(const char *target) const {
 	return saveList;
 }
 
-SaveStateDescriptor PhoenixVRMetaEngine::querySaveMetaInfos(const char *target, int slotIdx) const {
+SaveStateDescriptor PhoenixVRMetaEngine::querySaveMetaInfos(const char *target, int slotIdx, bool skipThumbnail) const {
 	Common::SaveFileManager *saveFileMan = g_system->getSavefileManager();
 
 	auto fname = getSavegameFile(slotIdx, target);
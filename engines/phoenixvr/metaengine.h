@@ -43,7 +43,7 @@ public:
 
 	SaveStateList listSaves(const char *target) const override;
 
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 
 	const ADExtraGuiOptionsMap *getAdvancedExtraGuiOptions() const override;
 	Common::KeymapArray initKeymaps(const char *target) const override;
@@ -50,7 +50,7 @@ public:
 	int getMaximumSaveSlot() const override { return 99; }
 	SaveStateList listSaves(const char *target) const override;
 	bool removeSaveState(const char *target, int slot) const override;
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 
 	Common::Error createInstance(OSystem *syst, Engine **engine, const ADGameDescription *desc) const override;
 	Common::KeymapArray initKeymaps(const char *target) const override;
@@ -96,7 +96,7 @@ bool PinkMetaEngine::removeSaveState(const char *target, int slot) const {
 	return g_system->getSavefileManager()->removeSavefile(Pink::generateSaveName(slot, target));
 }
 
-SaveStateDescriptor PinkMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
+SaveStateDescriptor PinkMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
 	Common::ScopedPtr<Common::InSaveFile> f(g_system->getSavefileManager()->openForLoading(Pink::generateSaveName(slot, target)));
 
 	if (f) {
@@ -70,7 +70,7 @@ public:
 
 	Common::Error createInstance(OSystem *syst, Engine **engine, const ADGameDescription *desc) const override;
 	void getSavegameThumbnail(Graphics::Surface &thumb) override;
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 	Common::KeymapArray initKeymaps(const char *target) const override;
 };
 
@@ -99,10 +99,10 @@ void PrivateMetaEngine::getSavegameThumbnail(Graphics::Surface &thumb) {
  * Save files now contain a version number in their header so that we can detect
  * that a save is compatible, and not present incompatible saves to users.
  */
-SaveStateDescriptor PrivateMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
+SaveStateDescriptor PrivateMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
 	using namespace Private;
 	
-	SaveStateDescriptor desc = MetaEngine::querySaveMetaInfos(target, slot);
+	SaveStateDescriptor desc = MetaEngine::querySaveMetaInfos(target, slot, skipThumbnail);
 	if (desc.getSaveSlot() == -1) {
 		return desc;
 	}
@@ -112,7 +112,7 @@ SaveStateDescriptor PrivateMetaEngine::querySaveMetaInfos(const char *target, in
 		getSavegameFile(slot, target)));
 	if (f) {
 		SavegameMetadata meta;
-		if (!readSavegameMetadata(f.get(), meta)) {
+		if (!Private::readSavegameMetadata(f.get(), meta)) {
 			return SaveStateDescriptor();
 		}
 	}
@@ -107,7 +107,7 @@ public:
 	SaveStateList listSaves(const char *target) const override;
 	int getMaximumSaveSlot() const override;
 	bool removeSaveState(const char *target, int slot) const override;
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 
 	Common::KeymapArray initKeymaps(const char *target) const override;
 };
@@ -186,7 +186,7 @@ bool SagaMetaEngine::removeSaveState(const char *target, int slot) const {
 	return g_system->getSavefileManager()->removeSavefile(filename);
 }
 
-SaveStateDescriptor SagaMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
+SaveStateDescriptor SagaMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
 	static char fileName[MAX_FILE_NAME];
 	Common::sprintf_s(fileName, "%s.s%02d", target, slot);
 	char title[TITLESIZE];
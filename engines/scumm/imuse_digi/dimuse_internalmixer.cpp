@@ -22,6 +22,7 @@
 #include "common/scummsys.h"
 #include "common/mutex.h"
 #include "common/serializer.h"
+#include "common/system.h"
 #include "common/textconsole.h"
 #include "common/util.h"
 
@@ -49,6 +50,10 @@ IMuseDigiInternalMixer::IMuseDigiInternalMixer(Audio::Mixer *mixer, int sampleRa
 
 	_radioChatter = 0;
 	_amp8Table = nullptr;
+
+#ifdef SCUMMVM_SSE2
+	_useSIMD = g_system->hasFeature(OSystem::kFeatureCpuSSE2);
+#endif
 }
 
 IMuseDigiInternalMixer::~IMuseDigiInternalMixer() {
@@ -180,6 +185,10 @@ int IMuseDigiInternalMixer::init(int bytesPerSample, int numChannels, uint8 *mix
 	}
 }
 
+void IMuseDigiInternalMixer::setUseSIMD(bool useSIMD) {
+	_useSIMD = useSIMD;
+}
+
 void IMuseDigiInternalMixer::setRadioChatter() {
 	_radioChatter = 1;
 }
@@ -221,6 +230,12 @@ void IMuseDigiInternalMixer::mix(uint8 *srcBuf, int32 inFrameCount, int wordSize
 					// Linear volume quantization from the lookup table
 					rightChannelVolume = _stereoVolumeTable[17 * channelVolume + channelPan];
 					leftChannelVolume = _stereoVolumeTable[17 * channelVolume - channelPan];
+
+#ifdef SCUMMVM_SSE2
+					if (_useSIMD && mixSSE2(srcBuf, inFrameCount, wordSize, channelCount, feedSize, mixBufStartIndex, leftChannelVolume, rightChannelVolume, ftIs11025Hz))
+						return;
+#endif
+
 					if (wordSize == 8) {
 						mixBits8ConvertToStereo(
 							srcBuf,
@@ -254,6 +269,11 @@ void IMuseDigiInternalMixer::mix(uint8 *srcBuf, int32 inFrameCount, int wordSize
 					if (channelVolume >= 17)
 						channelVolume = 16;
 
+#ifdef SCUMMVM_SSE2
+					if (_useSIMD && mixSSE2(srcBuf, inFrameCount, wordSize, channelCount, feedSize, mixBufStartIndex, channelVolume, channelVolume, ftIs11025Hz))
+						return;
+#endif
+
 					if (wordSize == 8)
 						ampTable = &_amp8Table[channelVolume * 128];
 					else
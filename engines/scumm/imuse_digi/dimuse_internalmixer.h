@@ -62,6 +62,7 @@ private:
 	int _stereoReverseFlag = 0;
 	bool _isEarlyDiMUSE = false;
 	bool _lowLatencyMode = false;
+	bool _useSIMD = false;
 
 	void mixBits8Mono(uint8 *srcBuf, int32 inFrameCount, int feedSize, int32 mixBufStartIndex, int32 *ampTable, bool ftIs11025Hz);
 	void mixBits12Mono(uint8 *srcBuf, int32 inFrameCount, int feedSize, int32 mixBufStartIndex, int32 *ampTable);
@@ -79,10 +80,19 @@ private:
 	void mixBits12Stereo(uint8 *srcBuf, int32 inFrameCount, int feedSize, int32 mixBufStartIndex, int32 *ampTable);
 	void mixBits16Stereo(uint8 *srcBuf, int32 inFrameCount, int feedSize, int32 mixBufStartIndex, int32 *ampTable);
 
+#ifdef SCUMMVM_SSE2
+	// Mixes the formats which don't need resampling, returns false for anything else
+	bool mixSSE2(uint8 *srcBuf, int32 inFrameCount, int wordSize, int channelCount, int feedSize, int32 mixBufStartIndex, int leftVolume, int rightVolume, bool ftIs11025Hz);
+#endif
+
 public:
 	IMuseDigiInternalMixer(Audio::Mixer *mixer, int sampleRate, bool isEarlyDiMUSE, bool lowLatencyMode = false);
 	~IMuseDigiInternalMixer();
 	int  init(int bytesPerSample, int numChannels, uint8 *mixBuf, int mixBufSize, int sizeSampleKB, int mixChannelsNum);
+	// Switches between the SIMD mixing loops, which are used by default when the
+	// CPU supports them, and the C++ loops, which they must match exactly.
+	// Only enable them if the CPU supports them.
+	void setUseSIMD(bool useSIMD);
 	void setRadioChatter();
 	void clearRadioChatter();
 	int  clearMixerBuffer();
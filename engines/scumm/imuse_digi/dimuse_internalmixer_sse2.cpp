@@ -0,0 +1,233 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "scumm/imuse_digi/dimuse_engine.h"
+#include "scumm/imuse_digi/dimuse_internalmixer.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Scumm {
+
+namespace {
+
+// The amplitude tables built by IMuseDigiInternalMixer::init() hold
+// volume * sample / 127, rounded towards zero, for 12-bit samples and volumes
+// from 0 to 127. Instead of looking up every sample in the table, this computes
+// the same values for eight samples at a time. The product is exact in single
+// precision, and since the rounding error is far smaller than the distance
+// between two quotients, adding half the sign before dividing gives exactly the
+// truncated quotient.
+class Amplitude {
+public:
+	Amplitude(int volume) : _volume(_mm_set1_ps(volume ? volume * 8 - 1 : 0)) {}
+
+	FORCEINLINE __m128i operator()(__m128i samples) const {
+		const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+		const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+		return _mm_packs_epi32(amplitude(lo), amplitude(hi));
+	}
+
+private:
+	FORCEINLINE __m128i amplitude(__m128i samples) const {
+		const __m128 product = _mm_mul_ps(_mm_cvtepi32_ps(samples), _volume);
+		const __m128 half = _mm_or_ps(_mm_set1_ps(0.5f), _mm_and_ps(product, _mm_set1_ps(-0.0f)));
+		return _mm_cvttps_epi32(_mm_mul_ps(_mm_add_ps(product, half), _mm_set1_ps(1.0f / 127.0f)));
+	}
+
+	__m128 _volume;
+};
+
+// Every source format provides its samples scaled to 12 bits, eight at a time,
+// as well as the table lookup of the C++ loops for the remaining samples.
+
+struct Source8 {
+	const uint8 *_src;
+
+	FORCEINLINE __m128i load(int32 i) const {
+		const __m128i samples = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(_src + i)), _mm_setzero_si128());
+		return _mm_slli_epi16(_mm_sub_epi16(samples, _mm_set1_epi16(128)), 4);
+	}
+
+	FORCEINLINE uint16 lookup(const int32 *ampTable, int32 i) const {
+		return *((const uint16 *)ampTable + _src[i]);
+	}
+};
+
+struct Source12 {
+	const uint8 *_src;
+
+	FORCEINLINE __m128i load(int32 i) const {
+		// Two samples are packed in three bytes
+		int16 samples[8];
+		const uint8 *src = _src + i / 2 * 3;
+		for (int j = 0; j < 8; j += 2, src += 3) {
+			samples[j] = (src[0] | ((src[1] & 0xF) << 8)) - 2048;
+			samples[j + 1] = (src[2] | ((src[1] & 0xF0) << 4)) - 2048;
+		}
+		return _mm_loadu_si128((const __m128i *)samples);
+	}
+
+	FORCEINLINE uint16 lookup(const int32 *ampTable, int32 i) const {
+		const uint8 *src = _src + i / 2 * 3;
+		if (i & 1)
+			return *((const uint16 *)ampTable + (src[2] | ((src[1] & 0xF0) << 4)));
+		return *((const uint16 *)ampTable + (src[0] | ((src[1] & 0xF) << 8)));
+	}
+};
+
+struct Source16 {
+	const int16 *_src;
+
+	FORCEINLINE __m128i load(int32 i) const {
+		return _mm_srai_epi16(_mm_loadu_si128((const __m128i *)(_src + i)), 4);
+	}
+
+	FORCEINLINE uint16 lookup(const int32 *ampTable, int32 i) const {
+		return *((const uint16 *)ampTable + (_src[i] >> 4) + 2048);
+	}
+};
+
+template<class Source>
+void mixSamples(uint16 *dst, const Source &src, int32 count, const int32 *ampTable, const Amplitude &amp) {
+	int32 i = 0;
+
+	for (; i + 8 <= count; i += 8) {
+		__m128i *out = (__m128i *)(dst + i);
+		_mm_storeu_si128(out, _mm_add_epi16(_mm_loadu_si128(out), amp(src.load(i))));
+	}
+
+	for (; i < count; i++)
+		dst[i] += src.lookup(ampTable, i);
+}
+
+template<class Source>
+void mixSamplesToStereo(uint16 *dst, const Source &src, int32 count, const int32 *leftAmpTable, const int32 *rightAmpTable,
+						const Amplitude &leftAmp, const Amplitude &rightAmp) {
+	int32 i = 0;
+
+	for (; i + 8 <= count; i += 8) {
+		const __m128i samples = src.load(i);
+		const __m128i left = leftAmp(samples);
+		const __m128i right = rightAmp(samples);
+
+		__m128i *out = (__m128i *)(dst + 2 * i);
+		_mm_storeu_si128(out, _mm_add_epi16(_mm_loadu_si128(out), _mm_unpacklo_epi16(left, right)));
+		_mm_storeu_si128(out + 1, _mm_add_epi16(_mm_loadu_si128(out + 1), _mm_unpackhi_epi16(left, right)));
+	}
+
+	for (; i < count; i++) {
+		dst[2 * i] += src.lookup(leftAmpTable, i);
+		dst[2 * i + 1] += src.lookup(rightAmpTable, i);
+	}
+}
+
+} // End of anonymous namespace
+
+bool IMuseDigiInternalMixer::mixSSE2(uint8 *srcBuf, int32 inFrameCount, int wordSize, int channelCount, int feedSize, int32 mixBufStartIndex, int leftVolume, int rightVolume, bool ftIs11025Hz) {
+	const bool toStereo = channelCount == 1 && _outChannelCount == 2;
+
+	// Downmixing to mono is left to the C++ loops
+	if (channelCount != _outChannelCount && !toStereo)
+		return false;
+
+	// Only the loops which don't resample are vectorized
+	int32 frames;
+	if (_isEarlyDiMUSE && wordSize == 8 && channelCount == 1) {
+		if (ftIs11025Hz)
+			return false;
+		frames = inFrameCount;
+	} else {
+		if (feedSize != inFrameCount)
+			return false;
+		if (wordSize == 8 && channelCount == 1 && _radioChatter)
+			return false;
+		frames = feedSize;
+	}
+
+	int32 count = frames * channelCount;
+	uint16 *dst = (uint16 *)&_mixBuf[(_outChannelCount == 2 ? 4 : 2) * mixBufStartIndex];
+	const int32 *leftAmpTable;
+	const int32 *rightAmpTable;
+
+	if (wordSize == 8) {
+		leftAmpTable = &_amp8Table[leftVolume * 128];
+		rightAmpTable = &_amp8Table[rightVolume * 128];
+	} else {
+		leftAmpTable = &_amp12Table[leftVolume * 2048];
+		rightAmpTable = &_amp12Table[rightVolume * 2048];
+	}
+
+	if (wordSize == 12 && channelCount == 1) {
+		// Leave the warning about odd frame counts to the C++ loop
+		if (!toStereo && (count & 1))
+			return false;
+		count &= ~1;
+	}
+
+	if (!toStereo) {
+		const Amplitude amp(leftVolume);
+		if (wordSize == 8)
+			mixSamples(dst, Source8{srcBuf}, count, leftAmpTable, amp);
+		else if (wordSize == 12)
+			mixSamples(dst, Source12{srcBuf}, count, leftAmpTable, amp);
+		else
+			mixSamples(dst, Source16{(const int16 *)srcBuf}, count, leftAmpTable, amp);
+		return true;
+	}
+
+	const Amplitude leftAmp(leftVolume);
+	const Amplitude rightAmp(rightVolume);
+	if (wordSize == 8) {
+		mixSamplesToStereo(dst, Source8{srcBuf}, count, leftAmpTable, rightAmpTable, leftAmp, rightAmp);
+	} else if (wordSize == 12) {
+		mixSamplesToStereo(dst, Source12{srcBuf}, count, leftAmpTable, rightAmpTable, leftAmp, rightAmp);
+	} else {
+		// Like mixBits16ConvertToStereo(), start at the mono position
+		dst = (uint16 *)&_mixBuf[2 * mixBufStartIndex];
+		mixSamplesToStereo(dst, Source16{(const int16 *)srcBuf}, count, leftAmpTable, rightAmpTable, leftAmp, rightAmp);
+	}
+	return true;
+}
+
+} // End of namespace Scumm
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
@@ -591,7 +591,7 @@ bool ScummMetaEngine::removeSaveState(const char *target, int slot) const {
 	return g_system->getSavefileManager()->removeSavefile(filename);
 }
 
-SaveStateDescriptor ScummMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
+SaveStateDescriptor ScummMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
 	Common::String saveDesc;
 	Graphics::Surface *thumbnail = nullptr;
 	SaveStateMetaInfos infos;
@@ -35,7 +35,7 @@ class ScummMetaEngine : public MetaEngine {
 	SaveStateList listSaves(const char *target) const override;
 	int getMaximumSaveSlot() const override;
 	bool removeSaveState(const char *target, int slot) const override;
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 
 	const ExtraGuiOptions getExtraGuiOptions(const Common::String &target) const override;
 	void registerDefaultSettings(const Common::String &) const override;
@@ -146,6 +146,11 @@ MODULE_OBJS += \
 	smush/codec47ARM.o
 endif
 
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	imuse_digi/dimuse_internalmixer_sse2.o
+endif
+
 endif
 
 ifdef USE_ARM_GFX_ASM
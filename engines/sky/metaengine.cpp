@@ -52,7 +52,7 @@ class SkyMetaEngine : public MetaEngine {
 	SaveStateList listSaves(const char *target) const override;
 	int getMaximumSaveSlot() const override;
 	bool removeSaveState(const char *target, int slot) const override;
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 
 	Common::KeymapArray initKeymaps(const char *target) const override;
 	Common::String getSavegameFile(int saveGameIdx, const char *target) const override {
@@ -282,7 +282,7 @@ bool SkyMetaEngine::removeSaveState(const char *target, int slot) const {
 	return !ioFailed;
 }
 
-SaveStateDescriptor SkyMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
+SaveStateDescriptor SkyMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
 	Common::SaveFileManager *saveFileMan = g_system->getSavefileManager();
 
 	if (slot > 0) {
@@ -121,7 +121,7 @@ public:
 		return saveList;
 	}
 
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override {
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override {
 		Common::String filename = StarkEngine::formatSaveName(target, slot);
 		Common::InSaveFile *save = g_system->getSavefileManager()->openForLoading(filename);
 		if (!save) {
@@ -80,7 +80,7 @@ public:
 	int getMaximumSaveSlot() const override {
 		return 99;
 	}
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 	Common::String getSavegameFile(int saveGameIdx, const char *target) const override {
 		const char *prefix = target;
 		if (!strncmp(target, "msn1", 4))
@@ -154,7 +154,7 @@ bool SupernovaMetaEngine::removeSaveState(const char *target, int slot) const {
 	return g_system->getSavefileManager()->removeSavefile(getSavegameFile(slot, target));
 }
 
-SaveStateDescriptor SupernovaMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
+SaveStateDescriptor SupernovaMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
 	Common::InSaveFile *savefile = g_system->getSavefileManager()->openForLoading(getSavegameFile(slot, target));
 
 	if (savefile) {
@@ -145,7 +145,7 @@ public:
 		return g_system->getSavefileManager()->removeSavefile(getSavegameFile(slot, target));
 	}
 
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override {
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override {
 		Common::String filename = getSavegameFile(slot, target);
 		Common::ScopedPtr<Common::InSaveFile> in(g_system->getSavefileManager()->openForLoading(filename));
 		if (!in)
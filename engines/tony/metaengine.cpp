@@ -62,7 +62,7 @@ public:
 	SaveStateList listSaves(const char *target) const override;
 	int getMaximumSaveSlot() const override;
 	bool removeSaveState(const char *target, int slot) const override;
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 };
 
 bool TonyMetaEngine::hasFeature(MetaEngineFeature f) const {
@@ -127,7 +127,7 @@ bool TonyMetaEngine::removeSaveState(const char *target, int slot) const {
 	return g_system->getSavefileManager()->removeSavefile(filename);
 }
 
-SaveStateDescriptor TonyMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
+SaveStateDescriptor TonyMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
 	Common::String saveName;
 	byte difficulty;
 
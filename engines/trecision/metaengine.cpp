@@ -60,7 +60,7 @@ class TrecisionMetaEngine : public AdvancedMetaEngine<ADGameDescription> {
 
 	Common::Error createInstance(OSystem *syst, Engine **engine, const ADGameDescription *desc) const override;
 	void getSavegameThumbnail(Graphics::Surface &thumb) override;
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 
 	Common::KeymapArray initKeymaps(const char *target) const override;
 };
@@ -83,7 +83,7 @@ void TrecisionMetaEngine::getSavegameThumbnail(Graphics::Surface &thumb) {
 		MetaEngine::getSavegameThumbnail(thumb);
 }
 
-SaveStateDescriptor TrecisionMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
+SaveStateDescriptor TrecisionMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
 	Common::ScopedPtr<Common::InSaveFile> saveFile(g_system->getSavefileManager()->openForLoading(
 		getSavegameFile(slot, target)));
 
@@ -106,7 +106,7 @@ SaveStateDescriptor TrecisionMetaEngine::querySaveMetaInfos(const char *target,
 			return desc;
 		} else if (version >= SAVE_VERSION_SCUMMVM_MIN) {
 			saveFile->seek(0);
-			return MetaEngine::querySaveMetaInfos(target, slot);
+			return MetaEngine::querySaveMetaInfos(target, slot, skipThumbnail);
 		}
 	}
 
@@ -99,7 +99,7 @@ public:
 		return g_system->getSavefileManager()->removeSavefile(filename);
 	}
 
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override {
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override {
 		Common::String fileName = Common::String::format("%s.%d", target, slot);
 		Common::InSaveFile *file = g_system->getSavefileManager()->openForLoading(fileName);
 
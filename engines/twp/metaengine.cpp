@@ -89,8 +89,8 @@ static Common::String getDesc(const Twp::SaveGame &savegame) {
 	return desc;
 }
 
-SaveStateDescriptor TwpMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
-	SaveStateDescriptor desc = MetaEngine::querySaveMetaInfos(target, slot);
+SaveStateDescriptor TwpMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
+	SaveStateDescriptor desc = MetaEngine::querySaveMetaInfos(target, slot, skipThumbnail);
 	if (desc.isValid())
 		return desc;
 
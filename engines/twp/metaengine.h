@@ -39,7 +39,7 @@ public:
 
 	int getMaximumSaveSlot() const override;
 
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 	void registerDefaultSettings(const Common::String &) const override;
 
 	Common::AchievementsPlatform getAchievementsPlatform(const Common::String &target) const override;
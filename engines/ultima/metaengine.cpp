@@ -237,8 +237,8 @@ SaveStateList UltimaMetaEngine::listSaves(const char *target) const {
 	return saveList;
 }
 
-SaveStateDescriptor UltimaMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
-	SaveStateDescriptor desc = AdvancedMetaEngine::querySaveMetaInfos(target, slot);
+SaveStateDescriptor UltimaMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
+	SaveStateDescriptor desc = AdvancedMetaEngine::querySaveMetaInfos(target, slot, skipThumbnail);
 	if (!desc.isValid() && slot > 0) {
 #ifdef ENABLE_ULTIMA8
 		Common::String gameId = getGameId(target);
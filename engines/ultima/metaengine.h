@@ -48,7 +48,7 @@ public:
 	/**
 	 * Return meta information from the specified save state.
 	 */
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 
 	/**
 	 * Initialize keymaps
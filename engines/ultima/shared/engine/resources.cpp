@@ -52,6 +52,9 @@ void Resources::addResource(const Common::Path &name, const byte *data, size_t s
 	lr._name = name;
 	lr._data.resize(size);
 	Common::copy(data, data + size, &lr._data[0]);
+
+	// Search sets may remember that the file wasn't there
+	Common::SearchSet::invalidateLookupCaches();
 }
 
 bool Resources::hasFile(const Common::Path &path) const {
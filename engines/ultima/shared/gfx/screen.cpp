@@ -35,6 +35,7 @@ void Screen::update() {
 
 	if (_cursor) {
 		// Check whether the area the cursor occupies will be being updated
+		mergeDirtyRects();
 		Common::Rect cursorBounds = _cursor->getBounds();
 		for (const auto &r : _dirtyRects) {
 			if (r.intersects(cursorBounds)) {
@@ -57,6 +57,7 @@ CurrentMap::CurrentMap() : _currentMap(0), _eggHatcher(0),
 	for (unsigned int i = 0; i < MAP_NUM_CHUNKS; i++) {
 		memset(_fast[i], false, sizeof(uint32)*MAP_NUM_CHUNKS / 32);
 	}
+	memset(_chunkFootpad, 0, sizeof(_chunkFootpad));
 
 	if (GAME_IS_U8) {
 		_mapChunkSize = 512;
@@ -85,6 +86,7 @@ void CurrentMap::clear() {
 		}
 		memset(_fast[i], false, sizeof(uint32)*MAP_NUM_CHUNKS / 32);
 	}
+	memset(_chunkFootpad, 0, sizeof(_chunkFootpad));
 
 	_fastXMin =  _fastYMin = _fastXMax = _fastYMax = -1;
 	_currentMap = nullptr;
@@ -149,6 +151,7 @@ void CurrentMap::writeback() {
 			_items[i][j].clear();
 		}
 	}
+	memset(_chunkFootpad, 0, sizeof(_chunkFootpad));
 
 	// delete _eggHatcher
 	Process *ehp = Kernel::get_instance()->getProcess(_eggHatcher);
@@ -250,6 +253,7 @@ void CurrentMap::addItem(Item *item) {
 
 	_items[cx][cy].push_front(item);
 	item->setExtFlag(Item::EXT_INCURMAP);
+	updateItemFootpad(item);
 
 	Egg *egg = dynamic_cast<Egg *>(item);
 	if (egg) {
@@ -285,6 +289,7 @@ void CurrentMap::addItemToEnd(Item *item) {
 
 	_items[cx][cy].push_back(item);
 	item->setExtFlag(Item::EXT_INCURMAP);
+	updateItemFootpad(item);
 
 	Egg *egg = dynamic_cast<Egg *>(item);
 	if (egg) {
@@ -396,6 +401,25 @@ void CurrentMap::removeItemFromList(Item *item, int32 oldx, int32 oldy) {
 
 	_items[cx][cy].remove(item);
 	item->clearExtFlag(Item::EXT_INCURMAP);
+
+	if (_items[cx][cy].empty())
+		_chunkFootpad[cx][cy] = 0;
+}
+
+void CurrentMap::updateItemFootpad(const Item *item) {
+	Point3 pt = item->getLocation();
+
+	if (pt.x < 0 || pt.x >= _mapChunkSize * MAP_NUM_CHUNKS ||
+	        pt.y < 0 || pt.y >= _mapChunkSize * MAP_NUM_CHUNKS)
+		return;
+
+	int32 cx = pt.x / _mapChunkSize;
+	int32 cy = pt.y / _mapChunkSize;
+
+	// Use the larger of x and y so flipping the item doesn't matter
+	int32 xd, yd, zd;
+	item->getFootpadWorld(xd, yd, zd);
+	_chunkFootpad[cx][cy] = MAX(_chunkFootpad[cx][cy], MAX(xd, yd));
 }
 
 // Check to see if the chunk is on the screen
@@ -537,6 +561,19 @@ inline void CurrentMap::clipMapChunks(int &minx, int &maxx, int &miny, int &maxy
 	maxy = CLIP(maxy, 0, MAP_NUM_CHUNKS - 1);
 }
 
+inline bool CurrentMap::chunkMayTouch(int cx, int cy, int32 x1, int32 y1, int32 x2, int32 y2) const {
+	if (_items[cx][cy].empty())
+		return false;
+
+	// Items in the chunk have their x/y origin inside it and extend
+	// by at most the chunk footpad size towards negative x/y
+	int32 fp = _chunkFootpad[cx][cy];
+	int32 chunkx = cx * _mapChunkSize;
+	int32 chunky = cy * _mapChunkSize;
+	return chunkx + _mapChunkSize - 1 >= x1 && chunkx - fp <= x2 &&
+	       chunky + _mapChunkSize - 1 >= y1 && chunky - fp <= y2;
+}
+
 void CurrentMap::areaSearch(UCList *itemlist, const uint8 *loopscript,
 							uint32 scriptsize, const Item *check, uint16 range,
 							bool recurse, int32 x, int32 y) const {
@@ -621,6 +658,9 @@ void CurrentMap::surfaceSearch(UCList *itemlist, const uint8 *loopscript,
 
 	for (int cy = miny; cy <= maxy; cy++) {
 		for (int cx = minx; cx <= maxx; cx++) {
+			if (!chunkMayTouch(cx, cy, pt.x - xd - 1, pt.y - yd - 1, pt.x + 1, pt.y + 1))
+				continue;
+
 			for (const auto *item : _items[cx][cy]) {
 				if (item->getObjId() == check->getObjId())
 					continue;
@@ -713,6 +753,10 @@ PositionInfo CurrentMap::getPositionInfo(const Box &target, const Box &start, ui
 
 	for (int cx = minx; cx <= maxx; cx++) {
 		for (int cy = miny; cy <= maxy; cy++) {
+			if (!chunkMayTouch(cx, cy, target._x - target._xd - 1, target._y - target._yd - 1,
+							   target._x + 1, target._y + 1))
+				continue;
+
 			for (const auto *item : _items[cx][cy]) {
 				if (item->getObjId() == id)
 					continue;
@@ -1001,12 +1045,21 @@ bool CurrentMap::sweepTest(const Point3 &start, const Point3 &end,
 		   vel[0] - ext[0], vel[1] - ext[1], vel[2] - ext[2],
 		   vel[0] + ext[0], vel[1] + ext[1], vel[2] + ext[2]);
 
+	// The area covered by the whole sweep, for skipping chunks
+	const int32 sweepx1 = MIN(start.x, end.x) - dims[0] - 1;
+	const int32 sweepy1 = MIN(start.y, end.y) - dims[1] - 1;
+	const int32 sweepx2 = MAX(start.x, end.x) + 1;
+	const int32 sweepy2 = MAX(start.y, end.y) + 1;
+
 	Common::List<SweepItem>::iterator sw_it;
 	if (hit)
 		sw_it = hit->end();
 
 	for (int cx = minx; cx <= maxx; cx++) {
 		for (int cy = miny; cy <= maxy; cy++) {
+			if (!chunkMayTouch(cx, cy, sweepx1, sweepy1, sweepx2, sweepy2))
+				continue;
+
 			for (const auto *other_item : _items[cx][cy]) {
 				if (other_item->getObjId() == item)
 					continue;
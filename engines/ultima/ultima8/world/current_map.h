@@ -74,6 +74,9 @@ public:
 	void removeItemFromList(Item *item, int32 oldx, int32 oldy);
 	void removeItem(Item *item);
 
+	//! Update the collision bounds after an item in the map changed shape
+	void updateItemFootpad(const Item *item);
+
 	//! Add an item to the list of possible targets (in Crusader)
 	void addTargetItem(const Item *item);
 	//! Remove an item from the list of possible targets (in Crusader)
@@ -200,12 +203,21 @@ private:
 	//! clip the given map chunk numbers to iterate over them safely
 	static void clipMapChunks(int &minx, int &maxx, int &miny, int &maxy);
 
+	//! check if any item in the given chunk might overlap or touch the
+	//! (inclusive) world x/y range, based on the chunk footpad bounds
+	bool chunkMayTouch(int cx, int cy, int32 x1, int32 y1, int32 x2, int32 y2) const;
+
 	Map *_currentMap;
 
 	// item lists. Lots of them :-)
 	// items[x][y]
 	Common::List<Item *> _items[MAP_NUM_CHUNKS][MAP_NUM_CHUNKS];
 
+	// Largest footpad x/y size of the items in each chunk. Only grows while
+	// the chunk has items, so it is a conservative bound which allows the
+	// collision checks to skip chunks whose items can't reach the area tested.
+	int32 _chunkFootpad[MAP_NUM_CHUNKS][MAP_NUM_CHUNKS];
+
 	ProcId _eggHatcher;
 
 	// Fast area bit masks -> fast[ry][rx/32]&(1<<(rx&31));
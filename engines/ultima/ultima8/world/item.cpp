@@ -503,6 +503,10 @@ void Item::setShape(uint32 shape) {
 		_shape = shape;
 		_cachedShapeInfo = nullptr;
 	}
+
+	// The new shape may have a larger footpad
+	if (_extendedFlags & EXT_INCURMAP)
+		World::get_instance()->getCurrentMap()->updateItemFootpad(this);
 }
 
 bool Item::overlaps(const Item &item2) const {
@@ -49,7 +49,7 @@ struct SortItem {
 			_occl(false), _solid(false), _draw(false), _roof(false),
 			_noisy(false), _anim(false), _trans(false), _fixed(false),
 			_land(false), _occluded(false), _sprite(false),
-			_invitem(false) { }
+			_invitem(false), _listOrder(0), _binStamp(0) { }
 
 	SortItem                *_next;
 	SortItem                *_prev;
@@ -119,6 +119,9 @@ struct SortItem {
 
 	int32   _order;      // Rendering _order. -1 is not yet drawn
 
+	uint64  _listOrder;  // Increases along the display list, only meaningful for comparisons
+	uint32  _binStamp;   // Last candidate search this item was collected by
+
 	// Note that PriorityQueue could be used here, BUT there is no guarantee that it's implementation
 	// will be friendly to insertions
 	// Alternatively i could use Common::List, BUT there is no guarantee that it will keep won't delete
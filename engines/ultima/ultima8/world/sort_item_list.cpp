@@ -0,0 +1,242 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/algorithm.h"
+#include "ultima/ultima8/world/sort_item.h"
+#include "ultima/ultima8/world/sort_item_list.h"
+
+namespace Ultima {
+namespace Ultima8 {
+
+// Screenspace bins are 64x64 pixels
+static const int32 BIN_SHIFT = 6;
+
+// Spacing of list order values, leaving room for insertions in between
+static const uint64 LIST_ORDER_GAP = 1ULL << 32;
+
+SortItemList::SortItemList() :
+	_clipWindow(0, 0, 0, 0), _items(nullptr), _itemsTail(nullptr),
+	_binCols(0), _binRows(0), _binStamp(0) {
+}
+
+void SortItemList::reset(const Common::Rect32 &clipWindow) {
+	_clipWindow = clipWindow;
+	_items = nullptr;
+	_itemsTail = nullptr;
+	_keyFirsts.resize(0);
+
+	// Reset the bins, keeping their storage around for the next frame
+	int32 binCols = MAX<int32>(1, (clipWindow.width() + (1 << BIN_SHIFT) - 1) >> BIN_SHIFT);
+	int32 binRows = MAX<int32>(1, (clipWindow.height() + (1 << BIN_SHIFT) - 1) >> BIN_SHIFT);
+	if (binCols != _binCols || binRows != _binRows) {
+		_binCols = binCols;
+		_binRows = binRows;
+		_bins.resize(_binCols * _binRows);
+	}
+	for (auto &bin : _bins)
+		bin.resize(0);
+}
+
+void SortItemList::add(SortItem *si) {
+	si->_occluded = false;
+	si->_order = -1;
+
+	// We will clear all the vector memory
+	// Stictly speaking the vector will sort of leak memory, since they
+	// are never deleted
+	si->_depends.clear();
+
+	// Compare against the items which may overlap, in display list order
+	collectCandidates(si);
+
+	// Get the insert point... which is before the first item that has higher z than us
+	SortItem *addpoint = findInsertPoint(si);
+	for (auto *si2 : _candidates) {
+#ifdef SORTITEM_OCCLUSION_EXPERIMENTAL
+		// Find adjoining rects for better occlusion
+		if (si->_occl && si2->_occl && si->_z == si2->_z) {
+			// Does this share an edge?
+			if (si->_y == si2->_y && si->_yFar == si2->_yFar) {
+				if (si->_xLeft == si2->_x) {
+					si->_xAdjoin = si2;
+				} else if (si->_x == si2->_xLeft) {
+					si2->_xAdjoin = si;
+				}
+			}
+			else if (si->_x == si2->_x && si->_xLeft == si2->_xLeft) {
+				if (si->_yFar == si2->_y) {
+					si->_yAdjoin = si2;
+				} else if (si->_y == si2->_yFar) {
+					si2->_yAdjoin = si;
+				}
+			}
+		}
+#endif // SORTITEM_OCCLUSION_EXPERIMENTAL
+
+		// Attempt to find paint dependency order
+		if (si->overlap(*si2)) {
+			if (si->below(*si2)) {
+				if (si2->_occl && si2->occludes(*si)) {
+					// No need to do any more checks, this isn't visible
+					si->_occluded = true;
+
+					// A full list walk would have stopped here too, so only use
+					// the insert point if it would have been reached by now
+					if (addpoint && addpoint->_listOrder > si2->_listOrder)
+						addpoint = nullptr;
+					break;
+				} else {
+					// si1 is behind si2, so add it to si2's dependency list
+					si2->_depends.insert_sorted(si);
+				}
+			} else {
+				if (si->_occl && si->occludes(*si2)) {
+					// Occluded, but we can't remove it from the list
+					si2->_occluded = true;
+				} else {
+					// si2 is behind si1, so add it to si1's dependency list
+					si->_depends.insert_sorted(si2);
+				}
+			}
+		}
+	}
+
+	// Add it to the list
+	insertItem(si, addpoint);
+
+	// Occluded items are skipped by all later overlap checks
+	if (!si->_occluded)
+		addToBins(si);
+}
+
+void SortItemList::getBinRange(const Common::Rect32 &r, int32 &x1, int32 &y1, int32 &x2, int32 &y2) const {
+	// Rects outside the clip window are clamped to the border bins, which
+	// keeps intersecting rects in at least one common bin
+	x1 = CLIP<int32>((r.left - _clipWindow.left) >> BIN_SHIFT, 0, _binCols - 1);
+	y1 = CLIP<int32>((r.top - _clipWindow.top) >> BIN_SHIFT, 0, _binRows - 1);
+	x2 = CLIP<int32>((MAX(r.left, r.right - 1) - _clipWindow.left) >> BIN_SHIFT, x1, _binCols - 1);
+	y2 = CLIP<int32>((MAX(r.top, r.bottom - 1) - _clipWindow.top) >> BIN_SHIFT, y1, _binRows - 1);
+}
+
+void SortItemList::collectCandidates(const SortItem *si) {
+	_candidates.resize(0);
+
+#ifdef SORTITEM_OCCLUSION_EXPERIMENTAL
+	// Adjoining rects do not necessarily overlap, so check everything
+	for (SortItem *si2 = _items; si2 != nullptr; si2 = si2->_next) {
+		if (!si2->_occluded)
+			_candidates.push_back(si2);
+	}
+#else
+	int32 x1, y1, x2, y2;
+	getBinRange(si->_sr, x1, y1, x2, y2);
+
+	_binStamp++;
+	for (int32 y = y1; y <= y2; y++) {
+		for (int32 x = x1; x <= x2; x++) {
+			for (auto *si2 : _bins[y * _binCols + x]) {
+				if (si2->_binStamp == _binStamp || si2->_occluded)
+					continue;
+				si2->_binStamp = _binStamp;
+				_candidates.push_back(si2);
+			}
+		}
+	}
+
+	Common::sort(_candidates.begin(), _candidates.end(), [](const SortItem *a, const SortItem *b) {
+		return a->_listOrder < b->_listOrder;
+	});
+#endif // SORTITEM_OCCLUSION_EXPERIMENTAL
+}
+
+void SortItemList::addToBins(SortItem *si) {
+	int32 x1, y1, x2, y2;
+	getBinRange(si->_sr, x1, y1, x2, y2);
+	for (int32 y = y1; y <= y2; y++) {
+		for (int32 x = x1; x <= x2; x++)
+			_bins[y * _binCols + x].push_back(si);
+	}
+}
+
+SortItem *SortItemList::findInsertPoint(const SortItem *si) const {
+	// The first item in the list with a higher sort key than us. Occluded
+	// items may sit out of order at the end of the list, so check the
+	// first item of every higher key rather than assuming a sorted list.
+	SortItem *addpoint = nullptr;
+	for (auto *first : _keyFirsts) {
+		if (si->listLessThan(*first) && (!addpoint || first->_listOrder < addpoint->_listOrder))
+			addpoint = first;
+	}
+	return addpoint;
+}
+
+void SortItemList::insertItem(SortItem *si, SortItem *addpoint) {
+	// have a position
+	if (addpoint) {
+		uint64 lower = addpoint->_prev ? addpoint->_prev->_listOrder : 0;
+		if (addpoint->_listOrder - lower < 2) {
+			renumberList();
+			lower = addpoint->_prev ? addpoint->_prev->_listOrder : 0;
+		}
+		si->_listOrder = lower + (addpoint->_listOrder - lower) / 2;
+
+		si->_next = addpoint;
+		si->_prev = addpoint->_prev;
+		addpoint->_prev = si;
+		if (si->_prev)
+			si->_prev->_next = si;
+		else
+			_items = si;
+	}
+	// Add it to the end of the list
+	else {
+		si->_listOrder = (_itemsTail ? _itemsTail->_listOrder : 0) + LIST_ORDER_GAP;
+
+		if (_itemsTail)
+			_itemsTail->_next = si;
+		if (!_items)
+			_items = si;
+		si->_next = nullptr;
+		si->_prev = _itemsTail;
+		_itemsTail = si;
+	}
+
+	// Track the first item of each sort key for finding insert points
+	for (auto &first : _keyFirsts) {
+		if (!si->listLessThan(*first) && !first->listLessThan(*si)) {
+			if (si->_listOrder < first->_listOrder)
+				first = si;
+			return;
+		}
+	}
+	_keyFirsts.push_back(si);
+}
+
+void SortItemList::renumberList() {
+	uint64 order = 0;
+	for (SortItem *si = _items; si != nullptr; si = si->_next) {
+		order += LIST_ORDER_GAP;
+		si->_listOrder = order;
+	}
+}
+
+} // End of namespace Ultima8
+} // End of namespace Ultima
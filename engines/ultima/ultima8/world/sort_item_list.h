@@ -0,0 +1,81 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ULTIMA8_WORLD_SORTITEMLIST_H
+#define ULTIMA8_WORLD_SORTITEMLIST_H
+
+#include "common/array.h"
+#include "common/rect.h"
+
+namespace Ultima {
+namespace Ultima8 {
+
+struct SortItem;
+
+/**
+ * The display list of ItemSorter, which sorts items into paint order and
+ * works out which items occlude and depend on each other.
+ *
+ * This class is basically private to ItemSorter, but is separate from it
+ * to enable unit testing.
+ */
+class SortItemList {
+	Common::Rect32 _clipWindow;
+
+	SortItem    *_items;
+	SortItem    *_itemsTail;
+
+	// Screenspace grid over the clip window. Each bin holds the items whose
+	// shape frame rect touches it, so overlap tests only consider neighbours.
+	Common::Array<Common::Array<SortItem *> > _bins;
+	int32       _binCols, _binRows;
+	uint32      _binStamp;
+	Common::Array<SortItem *> _candidates;
+
+	// First item in the display list for each distinct list sort key
+	Common::Array<SortItem *> _keyFirsts;
+
+	void getBinRange(const Common::Rect32 &r, int32 &x1, int32 &y1, int32 &x2, int32 &y2) const;
+	void collectCandidates(const SortItem *si);
+	void addToBins(SortItem *si);
+
+	SortItem *findInsertPoint(const SortItem *si) const;
+	void insertItem(SortItem *si, SortItem *addpoint);
+	void renumberList();
+
+public:
+	SortItemList();
+
+	// Empty the list for items within the given clip window. The items
+	// are not owned by the list.
+	void reset(const Common::Rect32 &clipWindow);
+
+	// Sort an item into the list, its bounds and flags must be set up
+	void add(SortItem *si);
+
+	SortItem *front() const { return _items; }
+	SortItem *back() const { return _itemsTail; }
+};
+
+} // End of namespace Ultima8
+} // End of namespace Ultima
+
+#endif
@@ -49,7 +49,7 @@ RenderManager::RenderManager(ZVision *engine, const ScreenLayout layout, const G
 	  _backgroundWidth(0),
 	  _backgroundHeight(0),
 	  _backgroundOffset(0),
-	  _renderTable(engine, layout.workingArea.width(), layout.workingArea.height(), pixelFormat),
+	  _renderTable(engine->_system, layout.workingArea.width(), layout.workingArea.height(), pixelFormat),
 	  _doubleFPS(doubleFPS),
 	  _widescreen(widescreen),
 	  _frameLimiter(engine->_system, doubleFPS ? 60 : 30) {
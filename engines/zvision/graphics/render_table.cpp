@@ -28,16 +28,32 @@
 
 namespace ZVision {
 
-RenderTable::RenderTable(ZVision *engine, uint16 numColumns, uint16 numRows, const Graphics::PixelFormat &pixelFormat)
-	: _engine(engine),
-	  _system(engine->_system),
+// Fractional bits of the warp offsets. Five bits keep all four bilinear weights within
+// 10 bits, so red & blue can be filtered together in one 32 bit value (see splitColor)
+static const int WARP_FRAC_BITS = 5;
+static const int WARP_FRAC_MASK = (1 << WARP_FRAC_BITS) - 1;
+
+static inline int16 toWarpOffset(float offset) {
+	// Round symmetrically, so that mirrored offsets are exact negations of each other
+	const float scaled = offset * (1 << WARP_FRAC_BITS);
+	return (int16)(scaled >= 0 ? (int32)(scaled + 0.5f) : -(int32)(0.5f - scaled));
+}
+
+RenderTable::RenderTable(OSystem *system, uint16 numColumns, uint16 numRows, const Graphics::PixelFormat &pixelFormat)
+	: _system(system),
 	  _numRows(numRows),
 	  _numColumns(numColumns),
 	  _renderState(FLAT),
-	  _pixelFormat(pixelFormat) {
+	  _pixelFormat(pixelFormat),
+	  _tableState(FLAT),
+	  _tableFoV(0.0f),
+	  _tableScale(0.0f) {
 	assert(numRows != 0 && numColumns != 0);
+	// Offsets may span the whole working area and must fit in 16 bits
+	assert((MAX(numRows, numColumns) << WARP_FRAC_BITS) <= 0x7fff);
 
-	_internalBuffer = new FilterPixel[numRows * numColumns];
+	_offsetsX.resize(numRows * numColumns);
+	_offsetsY.resize(numRows * numColumns);
 
 	memset(&_panoramaOptions, 0, sizeof(_panoramaOptions));
 	memset(&_tiltOptions, 0, sizeof(_tiltOptions));
@@ -48,7 +64,6 @@ RenderTable::RenderTable(ZVision *engine, uint16 numColumns, uint16 numRows, con
 }
 
 RenderTable::~RenderTable() {
-	delete[] _internalBuffer;
 }
 
 void RenderTable::setRenderState(RenderState newState) {
@@ -84,11 +99,10 @@ const Common::Point RenderTable::convertWarpedCoordToFlatCoord(const Common::Poi
 	
 	uint32 index = point.y * _numColumns + point.x;
 
-	Common::Point newPoint(point);
-	newPoint.x += (_internalBuffer[index]._xDir ? _internalBuffer[index]._src.right : _internalBuffer[index]._src.left);
-	newPoint.y += (_internalBuffer[index]._yDir ? _internalBuffer[index]._src.bottom : _internalBuffer[index]._src.top);
-
-	return newPoint;
+	// Same nearest neighbour rounding as mutateImage()
+	const int32 srcX = (point.x << WARP_FRAC_BITS) + _offsetsX[index];
+	const int32 srcY = (point.y << WARP_FRAC_BITS) + _offsetsY[index];
+	return Common::Point((srcX + (WARP_FRAC_MASK >> 1)) >> WARP_FRAC_BITS, (srcY + (WARP_FRAC_MASK >> 1)) >> WARP_FRAC_BITS);
 }
 
 // Disused at present; potentially useful for future rendering efficient improvements.
@@ -130,55 +144,57 @@ void RenderTable::mutateImage(uint16 *sourceBuffer, uint16 *destBuffer, uint32 d
 // */
 
 void RenderTable::mutateImage(Graphics::Surface *dstBuf, Graphics::Surface *srcBuf, bool highQuality) {
-	uint32 destOffset = 0;
-	uint32 sourceOffset = 0;
-	uint16 *sourceBuffer = (uint16 *)srcBuf->getPixels();
+	const uint16 *sourceBuffer = (const uint16 *)srcBuf->getPixels();
 	uint16 *destBuffer = (uint16 *)dstBuf->getPixels();
-	if (highQuality != _highQuality) {
-		_highQuality = highQuality;
-		generateRenderTable();
-	}
+	const int16 *offsetsX = _offsetsX.data();
+	const int16 *offsetsY = _offsetsY.data();
+	uint32 destOffset = 0;
 	uint32 mutationTime = _system->getMillis();
-	if (_highQuality) {
+	if (highQuality) {
 		// Apply bilinear interpolation
 		for (int16 y = 0; y < srcBuf->h; ++y) {
-			sourceOffset = y * _numColumns;
+			const uint32 rowOffset = y * _numColumns;
+			const int32 fixedY = y << WARP_FRAC_BITS;
 			for (int16 x = 0; x < srcBuf->w; ++x) {
-				const FilterPixel &curP = _internalBuffer[sourceOffset + x];
-				const uint32 srcIndexYT = y + curP._src.top;
-				const uint32 srcIndexYB = y + curP._src.bottom;
-				const uint32 srcIndexXL = x + curP._src.left;
-				const uint32 srcIndexXR = x + curP._src.right;
-				uint32 rTL, rTR, rBL, rBR;
-				uint32 gTL, gTR, gBL, gBR;
-				uint32 bTL, bTR, bBL, bBR;
-				splitColor(sourceBuffer[srcIndexYT * _numColumns + srcIndexXL], rTL, gTL, bTL);
-				splitColor(sourceBuffer[srcIndexYT * _numColumns + srcIndexXR], rTR, gTR, bTR);
-				splitColor(sourceBuffer[srcIndexYB * _numColumns + srcIndexXL], rBL, gBL, bBL);
-				splitColor(sourceBuffer[srcIndexYB * _numColumns + srcIndexXR], rBR, gBR, bBR);
-				const uint32 rF = curP._fTL * rTL + curP._fTR * rTR + curP._fBL * rBL + curP._fBR * rBR;
-				const uint32 gF = curP._fTL * gTL + curP._fTR * gTR + curP._fBL * gBL + curP._fBR * gBR;
-				const uint32 bF = curP._fTL * bTL + curP._fTR * bTR + curP._fBL * bBL + curP._fBR * bBR;
-				destBuffer[destOffset] = mergeColor(rF, gF, bF);
-				destOffset++;
+				const uint32 index = rowOffset + x;
+				// RenderTable only stores offsets from the original coordinates
+				const int32 srcX = (x << WARP_FRAC_BITS) + offsetsX[index];
+				const int32 srcY = fixedY + offsetsY[index];
+				const uint32 fX = srcX & WARP_FRAC_MASK;
+				const uint32 fY = srcY & WARP_FRAC_MASK;
+				// Only step to the next pixel when it contributes, so exact edge coordinates stay in bounds
+				const uint16 *srcTL = sourceBuffer + (srcY >> WARP_FRAC_BITS) * _numColumns + (srcX >> WARP_FRAC_BITS);
+				const uint32 stepX = fX ? 1 : 0;
+				const uint32 stepY = fY ? _numColumns : 0;
+				const uint16 pTL = srcTL[0];
+				const uint16 pTR = srcTL[stepX];
+				const uint16 pBL = srcTL[stepY];
+				const uint16 pBR = srcTL[stepY + stepX];
+				// Weights sum to 1 << (2 * WARP_FRAC_BITS)
+				const uint32 wTL = ((1 << WARP_FRAC_BITS) - fX) * ((1 << WARP_FRAC_BITS) - fY);
+				const uint32 wTR = fX * ((1 << WARP_FRAC_BITS) - fY);
+				const uint32 wBL = ((1 << WARP_FRAC_BITS) - fX) * fY;
+				const uint32 wBR = fX * fY;
+				const uint32 rb = splitColor(pTL) * wTL + splitColor(pTR) * wTR + splitColor(pBL) * wBL + splitColor(pBR) * wBR;
+				const uint32 g = (pTL & 0x03e0) * wTL + (pTR & 0x03e0) * wTR + (pBL & 0x03e0) * wBL + (pBR & 0x03e0) * wBR;
+				destBuffer[destOffset++] = mergeColor(rb >> (2 * WARP_FRAC_BITS), g >> (2 * WARP_FRAC_BITS));
 			}
 		}
 	} else {
-		// Apply nearest-neighbour interpolation
+		// Apply nearest-neighbour interpolation, rounding exact midpoints down
 		for (int16 y = 0; y < srcBuf->h; ++y) {
-			sourceOffset = y * _numColumns;
+			const uint32 rowOffset = y * _numColumns;
+			const int32 fixedY = (y << WARP_FRAC_BITS) + (WARP_FRAC_MASK >> 1);
 			for (int16 x = 0; x < srcBuf->w; ++x) {
-				const uint32 index = sourceOffset + x;
-				// RenderTable only stores offsets from the original coordinates
-				const uint32 srcIndexX = x + (_internalBuffer[index]._xDir ? _internalBuffer[index]._src.right : _internalBuffer[index]._src.left);
-				const uint32 srcIndexY = y + (_internalBuffer[index]._yDir ? _internalBuffer[index]._src.bottom : _internalBuffer[index]._src.top);
-				destBuffer[destOffset] = sourceBuffer[srcIndexY * _numColumns + srcIndexX];
-				destOffset++;
+				const uint32 index = rowOffset + x;
+				const int32 srcX = ((x << WARP_FRAC_BITS) + (WARP_FRAC_MASK >> 1) + offsetsX[index]) >> WARP_FRAC_BITS;
+				const int32 srcY = (fixedY + offsetsY[index]) >> WARP_FRAC_BITS;
+				destBuffer[destOffset++] = sourceBuffer[srcY * _numColumns + srcX];
 			}
 		}
 	}
 	mutationTime = _system->getMillis() - mutationTime;
-	debugC(5, kDebugGraphics, "\tPanorama mutation time %dms, %s quality", mutationTime, _highQuality ? "high" : "low");
+	debugC(5, kDebugGraphics, "\tPanorama mutation time %dms, %s quality", mutationTime, highQuality ? "high" : "low");
 }
 
 void RenderTable::generateRenderTable() {
@@ -199,76 +215,73 @@ void RenderTable::generateRenderTable() {
 }
 
 void RenderTable::generateLookupTable(bool tilt) {
+	// The polar axis is the direction of camera rotation, the linear axis is perpendicular to it.
+	// The polar offsets only depend on the polar coordinate, while the linear offsets do not
+	// depend on the linear scale, so a change of scale alone only regenerates the polar table.
+	const float fov = tilt ? _tiltOptions.verticalFOV : _panoramaOptions.verticalFOV;
+	const float scale = tilt ? _tiltOptions.linearScale : _panoramaOptions.linearScale;
+	const uint halfPolar = tilt ? _halfRows : _halfColumns;
+	const uint halfLinear = tilt ? _halfColumns : _halfRows;
+	const float halfPolarSize = tilt ? _halfHeight : _halfWidth;
+	const float halfLinearSize = tilt ? _halfWidth : _halfHeight;
+	const uint polarCount = tilt ? _numRows : _numColumns;
+	const uint linearCount = tilt ? _numColumns : _numRows;
+	const uint32 polarStride = tilt ? _numColumns : 1;
+	const uint32 linearStride = tilt ? 1 : _numColumns;
+	int16 *polarTable = tilt ? _offsetsY.data() : _offsetsX.data();
+	int16 *linearTable = tilt ? _offsetsX.data() : _offsetsY.data();
+
+	const float cylinderRadius = (halfLinearSize + 0.5f) / tan(fov);
+	if (tilt)
+		_tiltOptions.gap = cylinderRadius * atan2((float)(_halfHeight / cylinderRadius), 1.0f) * _tiltOptions.linearScale;
+
+	const RenderState state = tilt ? TILT : PANORAMA;
+	const bool regenerateLinear = _tableState != state || _tableFoV != fov;
+	if (!regenerateLinear && _tableScale == scale)
+		return;
+
 	debugC(1, kDebugGraphics, "Generating %s lookup table.", tilt ? "tilt" : "panorama");
 	debugC(5, kDebugGraphics, "_halfWidth %f, _halfHeight %f", _halfWidth, _halfHeight);
 	debugC(5, kDebugGraphics, "_halfRows %d, _halfColumns %d", _halfRows, _halfColumns);
 	uint32 generationTime = _system->getMillis();
-	float cosAlpha, polarCoordInCylinderCoords, cylinderRadius, xOffset, yOffset;
-	uint32 indexTL, indexBL, indexTR, indexBR;
-	auto outerLoop = [&](uint & polarCoord, float & halfPolarSize, float & scale) {
-		// polarCoord is the coordinate of the working window pixel parallel to the direction of camera rotation
-		// halfPolarSize is the distance from the central axis to the outermost working window pixel in the direction of camera rotation
+	for (uint polarCoord = 0; polarCoord <= halfPolar; ++polarCoord) {
 		// alpha represents the angle in the direction of camera rotation between the view axis and the centre of a pixel at the given polar coordinate
 		const float alpha = atan(((float)polarCoord - halfPolarSize) / cylinderRadius);
 		// To map the polar coordinate to the cylinder surface coordinates, we just need to calculate the arc length
 		// We also scale it by linearScale
-		polarCoordInCylinderCoords = (cylinderRadius * scale * alpha) + halfPolarSize;
-		cosAlpha = cos(alpha);
-	};
-	auto innerLoop = [&](uint & polarCoord, uint & linearCoord, float & halfLinearSize,  float & polarOffset, float & linearOffset) {
-		// To calculate linear coordinate in cylinder coordinates, we can do similar triangles comparison,
-		// comparing the triangle from the center to the screen and from the center to the edge of the cylinder
-		const float linearCoordInCylinderCoords = halfLinearSize + ((float)linearCoord - halfLinearSize) * cosAlpha;
-		linearOffset = linearCoordInCylinderCoords - linearCoord;
-		polarOffset = polarCoordInCylinderCoords - polarCoord;
-		_internalBuffer[indexTL] = FilterPixel(xOffset, yOffset, _highQuality);
+		const float polarCoordInCylinderCoords = (cylinderRadius * scale * alpha) + halfPolarSize;
+		const int16 polarOffset = toWarpOffset(polarCoordInCylinderCoords - polarCoord);
+
 		// Transformation is both horizontally and vertically symmetrical about the camera axis,
-		// We can thus save on trigonometric calculations by computing one quarter of the transformation matrix and then mirroring it in both X & Y:
-		_internalBuffer[indexBL] = _internalBuffer[indexTL];
-		_internalBuffer[indexBL].flipV();
-		_internalBuffer[indexTR] = _internalBuffer[indexTL];
-		_internalBuffer[indexTR].flipH();
-		_internalBuffer[indexBR] = _internalBuffer[indexBL];
-		_internalBuffer[indexBR].flipH();
-	};
-	if (tilt) {
-		cylinderRadius = (_halfWidth + 0.5f) / tan(_tiltOptions.verticalFOV);
-		_tiltOptions.gap = cylinderRadius * atan2((float)(_halfHeight / cylinderRadius), 1.0f) * _tiltOptions.linearScale;
-		for (uint y = 0; y <= _halfRows; ++y) {
-			outerLoop(y, _halfHeight, _tiltOptions.linearScale);
-			const uint32 columnIndexTL = y * _numColumns;
-			const uint32 columnIndexBL = (_numRows - (y + 1)) * _numColumns;
-			const uint32 columnIndexTR = columnIndexTL + (_numColumns - 1);
-			const uint32 columnIndexBR = columnIndexBL + (_numColumns - 1);
-			for (uint x = 0; x <= _halfColumns; ++x) {
-				indexTL = columnIndexTL + x;
-				indexBL = columnIndexBL + x;
-				indexTR = columnIndexTR - x;
-				indexBR = columnIndexBR - x;
-				innerLoop(y, x, _halfWidth, yOffset, xOffset);
-			}
+		// We can thus save on trigonometric calculations by computing one quarter of the transformation matrix and then mirroring it in both X & Y
+		const uint32 nearIndex = polarCoord * polarStride;
+		const uint32 farIndex = (polarCount - 1 - polarCoord) * polarStride;
+		for (uint32 linearIndex = 0; linearIndex < linearCount * linearStride; linearIndex += linearStride) {
+			polarTable[nearIndex + linearIndex] = polarOffset;
+			polarTable[farIndex + linearIndex] = -polarOffset;
 		}
-	} else {
-		cylinderRadius = (_halfHeight + 0.5f) / tan(_panoramaOptions.verticalFOV);
-		for (uint x = 0; x <= _halfColumns; ++x) {
-			const uint32 columnIndexL = x;
-			const uint32 columnIndexR = (_numColumns - 1) - x;
-			uint32 rowIndexT = 0;
-			uint32 rowIndexB = _numColumns * (_numRows - 1);
-			outerLoop(x, _halfWidth, _panoramaOptions.linearScale);
-			for (uint y = 0; y <= _halfRows; ++y) {
-				indexTL = rowIndexT + columnIndexL;
-				indexBL = rowIndexB + columnIndexL;
-				indexTR = rowIndexT + columnIndexR;
-				indexBR = rowIndexB + columnIndexR;
-				innerLoop(x, y, _halfHeight, xOffset, yOffset);
-				rowIndexT += _numColumns;
-				rowIndexB -= _numColumns;
+
+		if (regenerateLinear) {
+			const float cosAlpha = cos(alpha);
+			for (uint linearCoord = 0; linearCoord <= halfLinear; ++linearCoord) {
+				// To calculate linear coordinate in cylinder coordinates, we can do similar triangles comparison,
+				// comparing the triangle from the center to the screen and from the center to the edge of the cylinder
+				const float linearCoordInCylinderCoords = halfLinearSize + ((float)linearCoord - halfLinearSize) * cosAlpha;
+				const int16 linearOffset = toWarpOffset(linearCoordInCylinderCoords - linearCoord);
+				const uint32 nearLinear = linearCoord * linearStride;
+				const uint32 farLinear = (linearCount - 1 - linearCoord) * linearStride;
+				linearTable[nearIndex + nearLinear] = linearOffset;
+				linearTable[nearIndex + farLinear] = -linearOffset;
+				linearTable[farIndex + nearLinear] = linearOffset;
+				linearTable[farIndex + farLinear] = -linearOffset;
 			}
 		}
 	}
+	_tableState = state;
+	_tableFoV = fov;
+	_tableScale = scale;
 	generationTime = _system->getMillis() - generationTime;
-	debugC(1, kDebugGraphics, "Render table generated, %s quality", _highQuality ? "high" : "low");
+	debugC(1, kDebugGraphics, "Render table generated, %s", regenerateLinear ? "full" : "polar offsets only");
 	debugC(1, kDebugGraphics, "\tRender table generation time %dms", generationTime);
 }
 
@@ -22,6 +22,7 @@
 #ifndef ZVISION_RENDER_TABLE_H
 #define ZVISION_RENDER_TABLE_H
 
+#include "common/array.h"
 #include "common/rect.h"
 #include "graphics/surface.h"
 #include "zvision/zvision.h"
@@ -29,48 +30,9 @@
 class OSystem;
 namespace ZVision {
 
-class FilterPixel {
-public:
-	// Bitfields representing sequential direction of contraction
-	bool _xDir = false; // false left, true right
-	bool _yDir = false; // false up, true down
-	Common::Rect _src = Common::Rect(0, 0); // Coordinates of four panorama image pixels around actual working window pixel
-
-	float _fX, _fY, _fTL, _fTR, _fBL, _fBR;
-	
-	FilterPixel() {}
-	FilterPixel(float x, float y, bool highQuality = false) {
-		_src.left = int16(floor(x));
-		_src.right = int16(ceil(x));
-		_src.top = int16(floor(y));
-		_src.bottom = int16(ceil(y));
-		if (highQuality) {
-			_fX = x - (float)_src.left;
-			_fY = y - (float)_src.top;
-			_fTL = (1 - _fX) * (1 - _fY);
-			_fTR = _fX * (1 - _fY);
-			_fBL = (1 - _fX) * _fY;
-			_fBR = _fX * _fY;
-		} else {
-			// Nearest neighbour
-			_xDir = (x - _src.left) > 0.5f;
-			_yDir = (y - _src.top) > 0.5f;
-		}
-	}
-	~FilterPixel() {}
-	inline void flipH() {
-		_src.left = -_src.left;
-		_src.right = -_src.right;
-	}
-	inline void flipV() {
-		_src.top = -_src.top;
-		_src.bottom = -_src.bottom;
-	}
-};
-
 class RenderTable {
 public:
-	RenderTable(ZVision *engine, uint16 numRows, uint16 numColumns, const Graphics::PixelFormat &pixelFormat);
+	RenderTable(OSystem *system, uint16 numRows, uint16 numColumns, const Graphics::PixelFormat &pixelFormat);
 	~RenderTable();
 
 // Common::Point testPixel = Common::Point(255,0);
@@ -82,24 +44,26 @@ public:
 	};
 
 private:
-	ZVision *_engine;
 	OSystem *_system;
 	uint16 _numRows, _numColumns, _halfRows, _halfColumns; // Working area width, height; half width, half height, in whole pixels
 	float _halfWidth, _halfHeight;  // Centre axis to midpoint of outermost pixel
-	FilterPixel *_internalBuffer;
 	RenderState _renderState;
-	bool _highQuality = false;
 	const Graphics::PixelFormat _pixelFormat;
 
-	inline void splitColor(uint16 &color, uint32 &r, uint32 &g, uint32 &b) const {
-		// NB Left & right shifting unnecessary for interpolating & recombining, so not bothering in order to save cycles
-		r = color & 0x001f;
-		g = color & 0x03e0;
-		b = color & 0x7c00;
+	// Offsets from each working window pixel to the panorama image coordinates it samples,
+	// in fixed point with WARP_FRAC_BITS fractional bits. Kept as separate x & y tables.
+	Common::Array<int16> _offsetsX, _offsetsY;
+
+	// Parameters the offset tables were last generated with
+	RenderState _tableState;
+	float _tableFoV, _tableScale;
+
+	inline uint32 splitColor(uint16 color) const {
+		// Spread red & blue of an RGB555 pixel 16 bits apart, leaving room to multiply both by the filter weights at once
+		return (color | (color << 6)) & 0x001f001f;
 	}
-	inline uint16 mergeColor(const uint32 &r, const uint32 &g, const uint32 &b) const {
-		// NB Red uses the lowest bits in RGB555 and so doesn't need its fractional bits masked away after averaging
-		return r | (g & 0x03e0) | (b & 0x7c00);
+	inline uint16 mergeColor(uint32 rb, uint32 g) const {
+		return (rb & 0x001f) | ((rb >> 6) & 0x7c00) | (g & 0x03e0);
 	}
 
 
@@ -152,7 +152,7 @@ public:
 	SaveStateList listSaves(const char *target) const override;
 	int getMaximumSaveSlot() const override;
 	bool removeSaveState(const char *target, int slot) const override;
-	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot) const override;
+	SaveStateDescriptor querySaveMetaInfos(const char *target, int slot, bool skipThumbnail = false) const override;
 };
 
 bool ZVisionMetaEngine::hasFeature(MetaEngineFeature f) const {
@@ -369,7 +369,7 @@ bool ZVisionMetaEngine::removeSaveState(const char *target, int slot) const {
 	return saveFileMan->removeSavefile(Common::String::format("%s.%03u", target, slot));
 }
 
-SaveStateDescriptor ZVisionMetaEngine::querySaveMetaInfos(const char *target, int slot) const {
+SaveStateDescriptor ZVisionMetaEngine::querySaveMetaInfos(const char *target, int slot, bool skipThumbnail) const {
 	Common::String filename = Common::String::format("%s.%03u", target, slot);
 	Common::InSaveFile *in = g_system->getSavefileManager()->openForLoading(filename.c_str());
 
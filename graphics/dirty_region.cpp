@@ -0,0 +1,159 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/dirty_region.h"
+
+namespace Graphics {
+
+DirtyRegion::DirtyRegion(int tileWidth, int tileHeight) : _tileWidth(tileWidth), _tileHeight(tileHeight),
+		_width(0), _height(0), _cols(0), _rows(0), _empty(true) {
+	assert(tileWidth > 0 && tileHeight > 0);
+}
+
+void DirtyRegion::setSize(int width, int height) {
+	if (width == _width && height == _height)
+		return;
+
+	Common::List<Common::Rect> rects;
+	getRects(rects);
+
+	_width = MAX(width, 0);
+	_height = MAX(height, 0);
+	_cols = (_width + _tileWidth - 1) / _tileWidth;
+	_rows = (_height + _tileHeight - 1) / _tileHeight;
+
+	_tiles.clear();
+	_tiles.resize(_cols * _rows, 0);
+	_rowBounds.resize(_rows);
+	for (int y = 0; y < _rows; y++) {
+		_rowBounds[y].first = _cols;
+		_rowBounds[y].last = 0;
+	}
+	_empty = true;
+
+	for (Common::List<Common::Rect>::const_iterator i = rects.begin(); i != rects.end(); ++i)
+		addRect(*i);
+}
+
+void DirtyRegion::clear() {
+	if (_empty)
+		return;
+
+	for (int y = 0; y < _rows; y++) {
+		RowBounds &bounds = _rowBounds[y];
+		if (bounds.first < bounds.last)
+			memset(&_tiles[y * _cols + bounds.first], 0, bounds.last - bounds.first);
+		bounds.first = _cols;
+		bounds.last = 0;
+	}
+
+	_empty = true;
+}
+
+void DirtyRegion::addRect(const Common::Rect &r) {
+	int left = MAX<int>(r.left, 0);
+	int top = MAX<int>(r.top, 0);
+	int right = MIN<int>(r.right, _width);
+	int bottom = MIN<int>(r.bottom, _height);
+
+	if (left >= right || top >= bottom)
+		return;
+
+	int firstCol = left / _tileWidth;
+	int lastCol = (right + _tileWidth - 1) / _tileWidth;
+	int firstRow = top / _tileHeight;
+	int lastRow = (bottom + _tileHeight - 1) / _tileHeight;
+
+	for (int y = firstRow; y < lastRow; y++) {
+		memset(&_tiles[y * _cols + firstCol], 1, lastCol - firstCol);
+
+		RowBounds &bounds = _rowBounds[y];
+		bounds.first = MIN<int>(bounds.first, firstCol);
+		bounds.last = MAX<int>(bounds.last, lastCol);
+	}
+
+	_empty = false;
+}
+
+void DirtyRegion::markAll() {
+	addRect(Common::Rect(0, 0, _width, _height));
+}
+
+void DirtyRegion::getRects(Common::List<Common::Rect> &rects) const {
+	if (_empty)
+		return;
+
+	// Rectangles still being extended downwards, ordered by column
+	struct OpenRect {
+		int16 left, right, top;
+	};
+	Common::Array<OpenRect> open, next;
+
+	// The extra row ends all of the rectangles still open
+	for (int y = 0; y <= _rows; y++) {
+		uint openPos = 0;
+		next.resize(0);
+
+		int x = 0, end = 0;
+		if (y < _rows) {
+			x = _rowBounds[y].first;
+			end = _rowBounds[y].last;
+		}
+
+		const byte *row = y < _rows ? &_tiles[y * _cols] : nullptr;
+
+		while (true) {
+			// Find the next run of dirty tiles
+			while (x < end && !row[x])
+				x++;
+			int runStart = x;
+			while (x < end && row[x])
+				x++;
+			bool haveRun = runStart < x;
+
+			// Close the rectangles which aren't continued by the run
+			while (openPos < open.size() && (!haveRun || open[openPos].left < runStart ||
+					(open[openPos].left == runStart && open[openPos].right != x))) {
+				const OpenRect &o = open[openPos++];
+				Common::Rect rect(o.left * _tileWidth, o.top * _tileHeight, o.right * _tileWidth, y * _tileHeight);
+				rect.clip(Common::Rect(_width, _height));
+				rects.push_back(rect);
+			}
+
+			if (!haveRun)
+				break;
+
+			OpenRect o;
+			o.left = runStart;
+			o.right = x;
+			o.top = y;
+
+			if (openPos < open.size() && open[openPos].left == runStart && open[openPos].right == x)
+				o.top = open[openPos++].top;
+
+			next.push_back(o);
+		}
+
+		open.swap(next);
+	}
+}
+
+} // End of namespace Graphics
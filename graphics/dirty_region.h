@@ -0,0 +1,105 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_DIRTY_REGION_H
+#define GRAPHICS_DIRTY_REGION_H
+
+#include "common/array.h"
+#include "common/list.h"
+#include "common/rect.h"
+
+namespace Graphics {
+
+/**
+ * @defgroup graphics_dirty_region Dirty region
+ * @ingroup graphics
+ *
+ * @brief Class for tracking the modified areas of a surface.
+ *
+ * @{
+ */
+
+/**
+ * Keeps track of the modified areas of a surface on a grid of tiles.
+ *
+ * Adding a rectangle just marks the tiles it covers, so it costs the same
+ * however many rectangles were added before. When the dirty areas are needed,
+ * each row of tiles is split into runs of dirty tiles, and runs which are the
+ * same on consecutive rows are joined into a single rectangle. The rectangles
+ * returned never overlap, and are aligned to tiles, clipped to the size.
+ */
+class DirtyRegion {
+public:
+	DirtyRegion(int tileWidth = 8, int tileHeight = 8);
+
+	/**
+	 * Sets the size of the tracked area. Dirty areas which are still
+	 * inside it are kept.
+	 */
+	void setSize(int width, int height);
+
+	int getWidth() const { return _width; }
+	int getHeight() const { return _height; }
+
+	/**
+	 * Returns true if nothing has been marked dirty since the last clear
+	 */
+	bool empty() const { return _empty; }
+
+	/**
+	 * Marks everything as clean
+	 */
+	void clear();
+
+	/**
+	 * Marks the area of a rectangle as dirty. Parts outside the tracked
+	 * area are ignored.
+	 */
+	void addRect(const Common::Rect &r);
+
+	/**
+	 * Marks the whole tracked area as dirty
+	 */
+	void markAll();
+
+	/**
+	 * Appends rectangles covering all of the dirty areas to a list
+	 */
+	void getRects(Common::List<Common::Rect> &rects) const;
+
+private:
+	struct RowBounds {
+		int16 first, last;	///< Range of columns which may be dirty
+	};
+
+	int _tileWidth, _tileHeight;
+	int _width, _height;
+	int _cols, _rows;
+	Common::Array<byte> _tiles;
+	Common::Array<RowBounds> _rowBounds;
+	bool _empty;
+};
+
+/** @} */
+
+} // End of namespace Graphics
+
+#endif
@@ -779,12 +779,17 @@ void MacTextCanvas::render(int from, int to) {
 	from = MAX<int>(0, from);
 	to = MIN<int>(to, _text.size() - 1);
 
-	// Clear the screen
-	_surface->fillRect(Common::Rect(0, _text[from].y, _surface->w, _text[to].y + getLineHeight(to)), _tbgcolor);
+	// Clear the screen, and the masks so only the rows being rendered get redrawn
+	Common::Rect rows(0, _text[from].y, _surface->w, _text[to].y + getLineHeight(to));
+	_surface->fillRect(rows, _tbgcolor);
+	_glyphMask->fillRect(rows, 0);
+	_charBoxMask->fillRect(rows, 0);
 
 	// render the shadow surface;
-	if (_textShadow)
+	if (_textShadow) {
+		_shadowSurface->fillRect(rows, _tbgcolor);
 		render(from, to, _shadowSurface, _wm->_colorBlack);
+	}
 
 	render(from, to, _glyphMask, 0xff);
 	render(from, to, _charBoxMask, 0xff, true);
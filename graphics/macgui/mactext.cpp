@@ -199,6 +199,7 @@ MacText::MacText(const Common::U32String &s, MacWindowManager *wm, const Font *f
 
 void MacText::init(uint32 fgcolor, uint32 bgcolor, int maxWidth, TextAlign textAlignment, int interlinear, uint16 textShadow, bool macFontMode) {
 	_fullRefresh = true;
+	_dirtyFrom = _dirtyTo = -1;
 
 	_canvas._maxWidth = maxWidth - _border * 2 - _gutter * 2 - _shadow;
 	_canvas._textAlignment = textAlignment;
@@ -414,37 +415,63 @@ void MacText::setMaxWidth(int maxWidth) {
 }
 
 void MacText::setColors(uint32 fg, uint32 bg) {
+	bool bgChanged = (bg != _canvas._tbgcolor);
+
+	if (fg != _canvas._tfgcolor) {
+		_canvas._tfgcolor = fg;
+		// also set the cursor color
+		_cursorSurface->clear(_canvas._tfgcolor);
+		_contentIsDirty = true;
+	}
 	_canvas._tbgcolor = bg;
-	_canvas._tfgcolor = fg;
-	// also set the cursor color
-	_cursorSurface->clear(_canvas._tfgcolor);
+
+	// Lines which change color are marked dirty by setTextColor()
 	for (uint i = 0; i < _canvas._text.size(); i++)
 		setTextColor(fg, i);
 
-	_fullRefresh = true;
+	if (bgChanged) {
+		_fullRefresh = true;
+		_contentIsDirty = true;
+	}
+
 	render();
-	_contentIsDirty = true;
 }
 
 void MacText::enforceTextFont(uint16 fontId) {
+	bool changed = false;
+
 	for (uint i = 0; i < _canvas._text.size(); i++) {
 		for (uint j = 0; j < _canvas._text[i].chunks.size(); j++) {
-			_canvas._text[i].chunks[j].fontId = fontId;
+			if (_canvas._text[i].chunks[j].fontId != fontId) {
+				_canvas._text[i].chunks[j].fontId = fontId;
+				changed = true;
+			}
 		}
 	}
 
+	if (!changed)
+		return;
+
 	_fullRefresh = true;
 	render();
 	_contentIsDirty = true;
 }
 
 void MacText::setTextSize(int textSize) {
+	bool changed = false;
+
 	for (uint i = 0; i < _canvas._text.size(); i++) {
 		for (uint j = 0; j < _canvas._text[i].chunks.size(); j++) {
-			_canvas._text[i].chunks[j].fontSize = textSize;
+			if (_canvas._text[i].chunks[j].fontSize != textSize) {
+				_canvas._text[i].chunks[j].fontSize = textSize;
+				changed = true;
+			}
 		}
 	}
 
+	if (!changed)
+		return;
+
 	_fullRefresh = true;
 	render();
 	_contentIsDirty = true;
@@ -458,10 +485,13 @@ void MacText::setTextColor(uint32 color, uint32 line) {
 
 	uint32 fgcol = _wm->findBestColor(color);
 	for (uint j = 0; j < _canvas._text[line].chunks.size(); j++) {
-		_canvas._text[line].chunks[j].fgcolor = fgcol;
+		if (_canvas._text[line].chunks[j].fgcolor != fgcol) {
+			_canvas._text[line].chunks[j].fgcolor = fgcol;
+			invalidateRows(line, line);
+		}
 	}
 
-	// if we are calling this func separately, then here need a refresh
+	// if we are calling this func separately, the line gets repainted on the next render()
 }
 
 void MacText::getChunkPosFromIndex(int index, uint &lineNum, uint &chunkNum, uint &offset) {
@@ -532,6 +562,9 @@ void MacText::setTextChunks(int start, int end, int param, void (*callback)(MacF
 		endCol++;
 	}
 
+	bool recolored = false, refonted = false;
+	int firstRow = -1, lastRow = -1;
+
 	for (uint i = startRow; i <= endRow; i++) {
 		uint from, to;
 		if (i == startRow && i == endRow) {
@@ -548,13 +581,39 @@ void MacText::setTextChunks(int start, int end, int param, void (*callback)(MacF
 			to = _canvas._text[i].chunks.size();
 		}
 		for (uint j = from; j < to; j++) {
-			callback(_canvas._text[i].chunks[j], param);
+			MacFontRun &chunk = _canvas._text[i].chunks[j];
+			uint16 fontId = chunk.fontId, fontSize = chunk.fontSize;
+			byte textSlant = chunk.textSlant;
+			uint32 fgcolor = chunk.fgcolor;
+
+			callback(chunk, param);
+
+			if (chunk.fontId != fontId || chunk.fontSize != fontSize || chunk.textSlant != textSlant)
+				refonted = true;
+			else if (chunk.fgcolor != fgcolor)
+				recolored = true;
+			else
+				continue;
+
+			// The range may end at the start of a row, which is then left alone
+			if (firstRow == -1)
+				firstRow = i;
+			lastRow = i;
 		}
 	}
 
-	_fullRefresh = true;
+	// A new font repaints everything, like the other font setters do, while
+	// a new color just needs the rows repainted
+	if (refonted) {
+		_fullRefresh = true;
+		_contentIsDirty = true;
+	} else if (recolored) {
+		invalidateRows(firstRow, lastRow);
+	} else {
+		return;
+	}
+
 	render();
-	_contentIsDirty = true;
 }
 
 void setTextFontCallback(MacFontRun &macFontRun, int fontId) {
@@ -574,12 +633,20 @@ void MacText::setTextSlant(int textSlant, int start, int end) {
 }
 
 void MacText::enforceTextSlant(int textSlant) {
+	bool changed = false;
+
 	for (uint i = 0; i < _canvas._text.size(); i++) {
 		for (uint j = 0; j < _canvas._text[i].chunks.size(); j++) {
-			_canvas._text[i].chunks[j].textSlant = textSlant;
+			if (_canvas._text[i].chunks[j].textSlant != textSlant) {
+				_canvas._text[i].chunks[j].textSlant = textSlant;
+				changed = true;
+			}
 		}
 	}
 
+	if (!changed)
+		return;
+
 	_fullRefresh = true;
 	render();
 	_contentIsDirty = true;
@@ -643,6 +710,7 @@ void MacText::render() {
 		_canvas.render(0, _canvas._text.size());
 
 		_fullRefresh = false;
+		_dirtyFrom = _dirtyTo = -1;
 
 #if 0
 		byte pal[256 * 3];
@@ -678,7 +746,26 @@ void MacText::render() {
 			out.close();
 		}
 #endif
+	} else if (_dirtyFrom != -1) {
+		_canvas.render(_dirtyFrom, _dirtyTo);
+
+		_dirtyFrom = _dirtyTo = -1;
+	}
+}
+
+void MacText::invalidateRows(int from, int to) {
+	if (from > to)
+		return;
+
+	if (_dirtyFrom == -1) {
+		_dirtyFrom = from;
+		_dirtyTo = to;
+	} else {
+		_dirtyFrom = MIN(_dirtyFrom, from);
+		_dirtyTo = MAX(_dirtyTo, to);
 	}
+
+	_contentIsDirty = true;
 }
 
 int MacText::getLastLineWidth() {
@@ -693,6 +780,9 @@ int MacText::getLineHeight(int line) {
 }
 
 void MacText::setInterLinear(int interLinear) {
+	if (interLinear == _canvas._interLinear)
+		return;
+
 	_canvas._interLinear = interLinear;
 
 	recalcDims();
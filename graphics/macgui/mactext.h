@@ -202,6 +202,12 @@ private:
 
 	void recalcDims();
 
+	/**
+	 * Marks rows whose runs changed without affecting the layout, so the next
+	 * render() repaints only them instead of the whole text.
+	 */
+	void invalidateRows(int from, int to);
+
 	void drawSelection(int xoff, int yoff);
 	void updateCursorPos();
 
@@ -226,6 +232,7 @@ public:
 	int _scrollPos;
 
 	bool _fullRefresh;
+	int _dirtyFrom, _dirtyTo;
 
 protected:
 	Common::U32String _str;
@@ -67,34 +67,31 @@ void Screen::addDirtyRect(const Common::Rect &r) {
 	bounds.translate(getOffsetFromOwner().x, getOffsetFromOwner().y);
 
 	if (bounds.width() > 0 && bounds.height() > 0)
-		_dirtyRects.push_back(bounds);
+		addToDirtyRegion(bounds);
+}
+
+void Screen::addToDirtyRegion(const Common::Rect &r) {
+	// The screen may have been recreated at a different size. Anything
+	// outside of it can't be copied to the physical screen anyway.
+	_dirtyRegion.setSize(this->w, this->h);
+
+	_dirtyRegion.addRect(r);
 }
 
 void Screen::makeAllDirty() {
-	_dirtyRects.clear();
+	clearDirtyRects();
 	addDirtyRect(Common::Rect(0, 0, this->w, this->h));
 }
 
 void Screen::mergeDirtyRects() {
-	Common::List<Common::Rect>::iterator rOuter, rInner;
-
-	// Process the dirty rect list to find any rects to merge
-	for (rOuter = _dirtyRects.begin(); rOuter != _dirtyRects.end(); ++rOuter) {
-		rInner = rOuter;
-		while (++rInner != _dirtyRects.end()) {
-
-			if ((*rOuter).intersects(*rInner)) {
-				// These two rectangles overlap, so merge them
-				unionRectangle(*rOuter, *rOuter, *rInner);
-
-				// remove the inner rect from the list
-				_dirtyRects.erase(rInner);
+	// Include any rects from a previous merge, or added to the list directly
+	Common::List<Common::Rect>::iterator i;
+	for (i = _dirtyRects.begin(); i != _dirtyRects.end(); ++i)
+		addToDirtyRegion(*i);
 
-				// move back to beginning of list
-				rInner = rOuter;
-			}
-		}
-	}
+	_dirtyRects.clear();
+	_dirtyRegion.getRects(_dirtyRects);
+	_dirtyRegion.clear();
 }
 
 bool Screen::unionRectangle(Common::Rect &destRect, const Common::Rect &src1, const Common::Rect &src2) {
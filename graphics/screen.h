@@ -22,6 +22,7 @@
 #ifndef GRAPHICS_SCREEN_H
 #define GRAPHICS_SCREEN_H
 
+#include "graphics/dirty_region.h"
 #include "graphics/managed_surface.h"
 #include "graphics/palette.h"
 #include "graphics/pixelformat.h"
@@ -48,15 +49,26 @@ namespace Graphics {
 class Screen : public ManagedSurface {
 protected:
 	/**
-	 * List of affected areas of the screen
+	 * Affected areas of the screen added since the last merge
+	 */
+	DirtyRegion _dirtyRegion;
+
+	/**
+	 * List of affected areas of the screen, filled in by mergeDirtyRects()
 	 */
 	Common::List<Common::Rect> _dirtyRects;
 protected:
 	/**
-	 * Merges together overlapping dirty areas of the screen
+	 * Replaces the dirty rects list with non-overlapping rects covering
+	 * all of the dirty areas of the screen
 	 */
 	void mergeDirtyRects();
 
+	/**
+	 * Marks an area as dirty. Parts outside of the screen are dropped
+	 */
+	void addToDirtyRegion(const Common::Rect &r);
+
 	/**
 	 * Returns the union of two dirty area rectangles
 	 */
@@ -69,7 +81,7 @@ public:
 	/**
 	 * Returns true if there are any pending screen updates (dirty areas)
 	 */
-	bool isDirty() const { return !_dirtyRects.empty(); }
+	bool isDirty() const { return !_dirtyRects.empty() || !_dirtyRegion.empty(); }
 
 	/**
 	 * Marks the whole screen as dirty. This forces the next call to update
@@ -80,7 +92,7 @@ public:
 	/**
 	 * Clear the current dirty rects list
 	 */
-	virtual void clearDirtyRects() { _dirtyRects.clear(); }
+	virtual void clearDirtyRects() { _dirtyRects.clear(); _dirtyRegion.clear(); }
 
 	/**
 	 * Adds a rectangle to the list of modified areas of the screen during the
@@ -32,6 +32,7 @@ DECLARE_SINGLETON(GUI::EventRecorder);
 #include "backends/timer/sdl/sdl-timer.h"
 #include "backends/mixer/mixer.h"
 #include "common/config-manager.h"
+#include "common/file.h"
 #include "common/md5.h"
 #include "gui/gui-manager.h"
 #include "gui/widget.h"
@@ -78,6 +79,8 @@ EventRecorder::EventRecorder() {
 	_screenshotPeriod = 0;
 	_playbackFile = nullptr;
 	_recordFile = nullptr;
+	_benchmark = false;
+	_displayDisabled = false;
 }
 
 EventRecorder::~EventRecorder() {
@@ -88,6 +91,7 @@ void EventRecorder::deinit() {
 	if (!_initialized) {
 		return;
 	}
+	writeBenchmarkReport();
 	setFileHeader();
 	_needRedraw = false;
 	_initialized = false;
@@ -161,7 +165,7 @@ void EventRecorder::processTimeAndDate(TimeDate &td, bool skipRecord) {
 			_recordFile->writeEvent(timeDateEvent);
 		}
 
-		_nextEvent = _playbackFile->getNextEvent();
+		readNextEvent();
 	}
 	if (_recordMode == kRecorderPlaybackPause)
 		td = _lastTimeDate;
@@ -218,7 +222,7 @@ void EventRecorder::processMillis(uint32 &millis, bool skipRecord) {
 			_recordFile->writeEvent(timerEvent);
 		}
 		updateSubsystems();
-		_nextEvent = _playbackFile->getNextEvent();
+		readNextEvent();
 		_timerManager->handler();
 		_controlPanel->setReplayedTime(_fakeTimer);
 		_processingMillis = false;
@@ -260,7 +264,7 @@ void EventRecorder::processScreenUpdate() {
 		if (_nextEvent.recordedtype != Common::kRecorderEventTypeScreenUpdate) {
 			int numSkipped = 0;
 			while (true) {
-				_nextEvent = _playbackFile->getNextEvent();
+				readNextEvent();
 				numSkipped += 1;
 				if (_nextEvent.recordedtype == Common::kRecorderEventTypeScreenUpdate) {
 					warning("Skipped %d events to get to the next screen update at %d", numSkipped, _nextEvent.time);
@@ -271,7 +275,7 @@ void EventRecorder::processScreenUpdate() {
 		_processingMillis = true;
 		_fakeTimer = _nextEvent.time;
 		updateSubsystems();
-		_nextEvent = _playbackFile->getNextEvent();
+		readNextEvent();
 		if (_recordMode == kRecorderUpdate) {
 			// write event to the updated file and update screenshot if necessary
 			screenUpdateEvent.recordedtype = Common::kRecorderEventTypeScreenUpdate;
@@ -308,7 +312,7 @@ bool EventRecorder::pollEvent(Common::Event &ev) {
 	}
 
 	ev = _nextEvent;
-	_nextEvent = _playbackFile->getNextEvent();
+	readNextEvent();
 	switch (ev.type) {
 	case Common::EVENT_MOUSEMOVE:
 	case Common::EVENT_LBUTTONDOWN:
@@ -383,6 +387,38 @@ void EventRecorder::setFastPlayback(bool fastPlayback) {
 	_fastPlayback = fastPlayback;
 }
 
+void EventRecorder::setBenchmark(const Common::String &reportFileName) {
+	_benchmark = true;
+	_benchmarkFileName = reportFileName;
+	_benchmarkTimings.start(g_system->getMicros());
+}
+
+void EventRecorder::writeBenchmarkReport() {
+	if (!_benchmark)
+		return;
+	_benchmark = false;
+
+	const uint64 now = g_system->getMicros();
+	debug("benchmark: %s", _benchmarkTimings.getSummary(now).c_str());
+
+	Common::DumpFile file;
+	if (!file.open(Common::Path(_benchmarkFileName, Common::Path::kNativeSeparator))) {
+		warning("Could not write benchmark report to %s", _benchmarkFileName.c_str());
+		return;
+	}
+	_benchmarkTimings.writeReport(file, ConfMan.getActiveDomainName(), ConfMan.get("record_file_name"), now);
+	file.finalize();
+	file.close();
+}
+
+void EventRecorder::readNextEvent() {
+	// The playback file quits as soon as it runs out of events, without
+	// going through deinit()
+	if (!_playbackFile->hasNextEvent())
+		writeBenchmarkReport();
+	_nextEvent = _playbackFile->getNextEvent();
+}
+
 void EventRecorder::init(const Common::String &recordFileName, RecordMode mode) {
 	_fakeMixerManager = new NullMixerManager();
 	_fakeMixerManager->init();
@@ -393,6 +429,7 @@ void EventRecorder::init(const Common::String &recordFileName, RecordMode mode)
 	_recordMode = mode;
 	_needcontinueGame = false;
 	_fastPlayback = false;
+	_displayDisabled = ConfMan.getBool("disable_display");
 	if (ConfMan.hasKey("disable_display")) {
 		DebugMan.enableDebugChannel("EventRec");
 		gDebugLevel = 1;
@@ -419,7 +456,7 @@ void EventRecorder::init(const Common::String &recordFileName, RecordMode mode)
 	}
 	if ((_recordMode == kRecorderPlayback) || (_recordMode == kRecorderUpdate)) {
 		applyPlaybackSettings();
-		_nextEvent = _playbackFile->getNextEvent();
+		readNextEvent();
 	}
 	if ((_recordMode == kRecorderRecord) || (_recordMode == kRecorderUpdate)) {
 		getConfig();
@@ -703,6 +740,11 @@ Common::SaveFileManager *EventRecorder::getSaveManager(Common::SaveFileManager *
 }
 
 void EventRecorder::preDrawOverlayGui() {
+	if (_benchmark) {
+		// The playback controls are left out, they would only add to the render time
+		_benchmarkTimings.beginRender(g_system->getMicros());
+		return;
+	}
 	if ((_initialized) || (_needRedraw)) {
 		RecordMode oldMode = _recordMode;
 		_recordMode = kPassthrough;
@@ -720,6 +762,11 @@ void EventRecorder::preDrawOverlayGui() {
 }
 
 void EventRecorder::postDrawOverlayGui() {
+	if (_benchmark) {
+		if (_initialized)
+			_benchmarkTimings.endFrame(_fakeTimer, g_system->getMicros());
+		return;
+	}
 	if ((_initialized) || (_needRedraw)) {
 		RecordMode oldMode = _recordMode;
 		_recordMode = kPassthrough;
@@ -44,6 +44,7 @@
 #include "backends/saves/recorder/recorder-saves.h"
 #include "backends/mixer/null/null-mixer.h"
 #include "backends/saves/default/default-saves.h"
+#include "gui/recorderbenchmark.h"
 
 
 #define g_eventRec (GUI::EventRecorder::instance())
@@ -81,6 +82,12 @@ public:
 	void deinit();
 	bool processDelayMillis();
 	void setFastPlayback(bool fastPlayback);
+
+	/**
+	 * Measure how long each frame takes to run and render during playback, and
+	 * write the results as JSON to the given file once the playback ends.
+	 */
+	void setBenchmark(const Common::String &reportFileName);
 	uint32 getRandomSeed(const Common::String &name);
 	void processTimeAndDate(TimeDate &td, bool skipRecord);
 	void processMillis(uint32 &millis, bool skipRecord);
@@ -174,6 +181,11 @@ public:
 		return _recordMode;
 	}
 
+	/** Whether the backend should skip drawing to the screen, as asked by --disable-display */
+	bool isDisplayDisabled() const {
+		return _initialized && _displayDisabled;
+	}
+
 	Common::StringArray listSaveFiles(const Common::String &pattern);
 	Common::String generateRecordFileName(const Common::String &target);
 
@@ -241,6 +253,13 @@ private:
 	Common::PlaybackFile *_playbackFile;
 	Common::PlaybackFile *_recordFile;
 
+	bool _benchmark;
+	Common::String _benchmarkFileName;
+	RecorderBenchmark _benchmarkTimings;
+
+	void writeBenchmarkReport();
+	void readNextEvent();
+
 	void saveScreenShot();
 	void checkRecordedMD5();
 	void deleteTemporarySave();
@@ -248,6 +267,7 @@ private:
 	volatile RecordMode _recordMode;
 	Common::String _recordFileName;
 	bool _fastPlayback;
+	bool _displayDisabled;
 	bool _needRedraw;
 	bool _processingMillis;
 };
@@ -19,7 +19,11 @@
  *
  */
 
+#include "base/version.h"
+
 #include "common/events.h"
+#include "common/fs.h"
+#include "common/hash-str.h"
 #include "common/translation.h"
 #include "common/zip-set.h"
 #include "gui/EventRecorder.h"
@@ -67,6 +71,7 @@ GuiManager::GuiManager() : CommandSender(nullptr), _redrawStatus(kRedrawDisabled
 
 	_useRTL = false;
 
+	_iconsSetVersion = 0;
 	_iconsSetChanged = false;
 
 	_displayTopDialogOnly = false;
@@ -117,6 +122,20 @@ void GuiManager::initIconsSet() {
 #else
 	_iconsSetChanged = Common::generateZipSet(_iconsSet, "gui-icons.dat", "gui-icons*.dat");
 #endif
+
+	// Downloaded packs have the date in their name, while the default pack
+	// comes with the release
+	Common::String version(gScummVMFullVersion);
+	Common::Path packsPath = ConfMan.getPath("iconspath");
+	if (!packsPath.empty()) {
+		Common::FSDirectory iconDir(packsPath);
+		Common::ArchiveMemberList iconFiles;
+		iconDir.listMatchingMembers(iconFiles, "gui-icons*.dat");
+		Common::sort(iconFiles.begin(), iconFiles.end(), Common::ArchiveMemberListComparator());
+		for (auto &ic : iconFiles)
+			version += ":" + ic->getName();
+	}
+	_iconsSetVersion = Common::hashit(version.c_str());
 }
 
 void GuiManager::computeScaleFactor() {
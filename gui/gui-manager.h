@@ -111,6 +111,8 @@ public:
 	void lockIconsSet() { _iconsMutex.lock(); }
 	void unlockIconsSet()  { _iconsMutex.unlock(); }
 	Common::SearchSet &getIconsSet() { return _iconsSet; }
+	/** Identifies the loaded icon packs, changes whenever a different set of packs is loaded */
+	uint32 getIconsSetVersion() { Common::StackLock lock(_iconsMutex); return _iconsSetVersion; }
 
 	int16 getGUIWidth() const { return _baseWidth; }
 	int16 getGUIHeight() const { return _baseHeight; }
@@ -188,6 +190,7 @@ protected:
 
 	Common::Mutex _iconsMutex;
 	Common::SearchSet _iconsSet;
+	uint32 _iconsSetVersion;
 	bool _iconsSetChanged;
 
 	Graphics::MacWindowManager *_wm = nullptr;
@@ -1794,6 +1794,8 @@ void LauncherGrid::build() {
 	// Add list with game titles
 	_grid = new GridWidget(this, "LauncherGrid.IconArea");
 	_grid->setMultiSelectEnabled(true);
+	// The grid collects the thumbnails loaded in the background on tickle
+	setTickleWidget(_grid);
 	// Populate the list
 	updateListing();
 
@@ -72,6 +72,7 @@ ifdef ENABLE_EVENTRECORDER
 MODULE_OBJS += \
 	editrecorddialog.o \
 	onscreendialog.o \
+	recorderbenchmark.o \
 	recorderdialog.o
 endif
 
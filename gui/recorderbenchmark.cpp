@@ -0,0 +1,122 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "gui/recorderbenchmark.h"
+
+#include "common/algorithm.h"
+#include "common/stream.h"
+
+namespace GUI {
+
+RecorderBenchmark::RecorderBenchmark() : _start(0), _frameStart(0), _renderStart(0) {
+}
+
+void RecorderBenchmark::start(uint64 now) {
+	_frames.clear();
+	_start = now;
+	_frameStart = now;
+	_renderStart = now;
+}
+
+void RecorderBenchmark::beginRender(uint64 now) {
+	_renderStart = now;
+}
+
+void RecorderBenchmark::endFrame(uint32 gameTime, uint64 now) {
+	Frame frame;
+	frame.time = gameTime;
+	frame.engineMicros = _renderStart - _frameStart;
+	frame.renderMicros = now - _renderStart;
+	_frames.push_back(frame);
+	_frameStart = now;
+}
+
+void RecorderBenchmark::getTotals(uint64 &engineMicros, uint64 &renderMicros) const {
+	engineMicros = renderMicros = 0;
+	for (uint i = 0; i < _frames.size(); ++i) {
+		engineMicros += _frames[i].engineMicros;
+		renderMicros += _frames[i].renderMicros;
+	}
+}
+
+double RecorderBenchmark::getFps(uint64 now) const {
+	const uint64 wallMicros = now - _start;
+	return wallMicros ? _frames.size() * 1000000.0 / wallMicros : 0.0;
+}
+
+Common::String RecorderBenchmark::getSummary(uint64 now) const {
+	uint64 engineMicros, renderMicros;
+	getTotals(engineMicros, renderMicros);
+	const uint32 gameMillis = _frames.empty() ? 0 : _frames.back().time;
+	return Common::String::format("frames=%u gametime=%ums walltime=%ums engine=%ums render=%ums fps=%.1f",
+		_frames.size(), gameMillis, (uint)((now - _start) / 1000), (uint)(engineMicros / 1000),
+		(uint)(renderMicros / 1000), getFps(now));
+}
+
+static Common::String jsonString(const Common::String &str) {
+	Common::String result("\"");
+	for (uint i = 0; i < str.size(); ++i) {
+		if (str[i] == '"' || str[i] == '\\')
+			result += '\\';
+		result += str[i];
+	}
+	result += '"';
+	return result;
+}
+
+void RecorderBenchmark::writeReport(Common::WriteStream &out, const Common::String &target, const Common::String &record, uint64 now) const {
+	const uint numFrames = _frames.size();
+	uint64 engineMicros, renderMicros;
+	getTotals(engineMicros, renderMicros);
+
+	Common::Array<uint32> frameMicros;
+	frameMicros.reserve(numFrames);
+	for (uint i = 0; i < numFrames; ++i)
+		frameMicros.push_back(_frames[i].engineMicros + _frames[i].renderMicros);
+	Common::sort(frameMicros.begin(), frameMicros.end());
+
+	out.writeString("{\n");
+	out.writeString(Common::String::format("\t\"target\": %s,\n", jsonString(target).c_str()));
+	out.writeString(Common::String::format("\t\"record\": %s,\n", jsonString(record).c_str()));
+	out.writeString(Common::String::format("\t\"frames\": %u,\n", numFrames));
+	out.writeString(Common::String::format("\t\"gameTimeMs\": %u,\n", numFrames ? _frames.back().time : 0));
+	out.writeString(Common::String::format("\t\"wallTimeUs\": %llu,\n", (unsigned long long)(now - _start)));
+	out.writeString(Common::String::format("\t\"engineTimeUs\": %llu,\n", (unsigned long long)engineMicros));
+	out.writeString(Common::String::format("\t\"renderTimeUs\": %llu,\n", (unsigned long long)renderMicros));
+	out.writeString(Common::String::format("\t\"fps\": %.2f,\n", getFps(now)));
+	if (numFrames) {
+		out.writeString(Common::String::format(
+			"\t\"frameTimeUs\": { \"min\": %u, \"median\": %u, \"p95\": %u, \"p99\": %u, \"max\": %u },\n",
+			frameMicros[0], frameMicros[numFrames / 2], frameMicros[numFrames * 95 / 100],
+			frameMicros[numFrames * 99 / 100], frameMicros[numFrames - 1]));
+	}
+
+	// One entry per frame: game time in ms, then engine and render time in us
+	out.writeString("\t\"perFrame\": [");
+	for (uint i = 0; i < numFrames; ++i) {
+		const Frame &frame = _frames[i];
+		out.writeString(Common::String::format("%s\n\t\t[%u, %u, %u]", i ? "," : "",
+			frame.time, frame.engineMicros, frame.renderMicros));
+	}
+	out.writeString("\n\t]\n}\n");
+}
+
+} // End of namespace GUI
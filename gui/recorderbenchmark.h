@@ -0,0 +1,79 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GUI_RECORDERBENCHMARK_H
+#define GUI_RECORDERBENCHMARK_H
+
+#include "common/array.h"
+#include "common/str.h"
+
+namespace Common {
+class WriteStream;
+}
+
+namespace GUI {
+
+/**
+ * Frame timings collected by the event recorder in benchmark mode.
+ *
+ * All times are passed in by the caller, in microseconds, so that this
+ * class does not depend on a particular clock.
+ */
+class RecorderBenchmark {
+public:
+	RecorderBenchmark();
+
+	/** Forget all frames, and start measuring at the given time. */
+	void start(uint64 now);
+
+	/** The engine has finished the current frame, and the backend starts rendering it. */
+	void beginRender(uint64 now);
+
+	/** The backend has finished rendering the frame shown at the given game time. */
+	void endFrame(uint32 gameTime, uint64 now);
+
+	uint getFrameCount() const { return _frames.size(); }
+
+	/** A one line summary of the timings up to the given time, for the log. */
+	Common::String getSummary(uint64 now) const;
+
+	/** Write the per-frame timings and a summary as JSON. */
+	void writeReport(Common::WriteStream &out, const Common::String &target, const Common::String &record, uint64 now) const;
+
+private:
+	struct Frame {
+		uint32 time;			///< Game time of the frame, in milliseconds
+		uint32 engineMicros;	///< Time spent in the engine since the previous frame
+		uint32 renderMicros;	///< Time spent by the backend to present the frame
+	};
+
+	Common::Array<Frame> _frames;
+	uint64 _start;
+	uint64 _frameStart;
+	uint64 _renderStart;
+
+	void getTotals(uint64 &engineMicros, uint64 &renderMicros) const;
+	double getFps(uint64 now) const;
+};
+
+} // End of namespace GUI
+
+#endif
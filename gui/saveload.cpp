@@ -79,6 +79,9 @@ int SaveLoadChooser::runModalWithCurrentTarget() {
 	if (!g_engine)
 		error("No engine is currently active");
 
+	// List the saves made in the background once they are complete
+	g_engine->waitForSaves();
+
 	return runModalWithMetaEngineAndTarget(g_engine->getMetaEngine(), ConfMan.getActiveDomainName());
 }
 
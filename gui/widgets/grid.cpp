@@ -20,9 +20,14 @@
  */
 
 #include "common/system.h"
+#include "common/algorithm.h"
+#include "common/config-manager.h"
 #include "common/file.h"
+#include "common/fs.h"
 #include "common/language.h"
 #include "common/platform.h"
+#include "common/ptr.h"
+#include "common/threadpool.h"
 #include "common/tokenizer.h"
 #include "common/translation.h"
 
@@ -46,14 +51,15 @@ void GridItemWidget::setActiveEntry(GridItemInfo &entry) {
 	_activeEntry = &entry;
 }
 
-void GridItemWidget::updateThumb() {
-	const Graphics::ManagedSurface *gfx = _grid->filenameToSurface(_activeEntry->thumbPath);
-	_thumbGfx.free();
-	if (gfx) {
-		// TODO: Use a reference instead of copying the surface
-		_thumbGfx.copyFrom(*gfx);
-		_thumbAlpha = _thumbGfx.detectAlpha();
-	}
+bool GridItemWidget::updateThumb() {
+	Graphics::AlphaType alphaType = Graphics::ALPHA_OPAQUE;
+	Common::SharedPtr<const Graphics::ManagedSurface> gfx = _grid->filenameToSurface(_activeEntry->thumbPath, alphaType);
+	if (gfx == _thumbGfx)
+		return false;
+
+	_thumbGfx = gfx;
+	_thumbAlpha = alphaType;
+	return true;
 }
 
 void GridItemWidget::update() {
@@ -113,8 +119,8 @@ void GridItemWidget::drawWidget() {
 										ThemeEngine::kThumbnailBackground);
 
 	// Draw Thumbnail
-	if (_thumbGfx.empty()) {
-		// Draw Title when thumbnail is missing
+	if (!_thumbGfx) {
+		// Draw Title when thumbnail is missing or still loading
 		int linesInThumb = MIN(thumbHeight / kLineHeight, (int)titleLines.size());
 		Common::Rect r(_x, _y + (thumbHeight - linesInThumb * kLineHeight) / 2,
 					   _x + thumbWidth, _y + (thumbHeight - linesInThumb * kLineHeight) / 2 + kLineHeight);
@@ -126,7 +132,7 @@ void GridItemWidget::drawWidget() {
 			r.translate(0, kLineHeight);
 		}
 	} else {
-		g_gui.theme()->drawManagedSurface(Common::Point(_x + _grid->_thumbnailMargin, _y + _grid->_thumbnailMargin), _thumbGfx, _thumbAlpha);
+		g_gui.theme()->drawManagedSurface(Common::Point(_x + _grid->_thumbnailMargin, _y + _grid->_thumbnailMargin), *_thumbGfx, _thumbAlpha);
 	}
 
 	Graphics::AlphaType alphaType;
@@ -396,53 +402,219 @@ void GridItemTray::handleMouseMoved(int x, int y, int button) {
 
 #pragma mark -
 
+// Read an icon into memory. Only accessing the icons set needs its lock, so that
+// decoding the icon doesn't hold up the GUI thread or the other thumbnail workers.
+static Common::SeekableReadStream *readIconFile(const Common::String &name) {
+	Common::Path path(name);
+	Common::SeekableReadStream *stream = nullptr;
+	g_gui.lockIconsSet();
+	if (g_gui.getIconsSet().hasFile(path)) {
+		Common::ScopedPtr<Common::SeekableReadStream> file(g_gui.getIconsSet().createReadStreamForMember(path));
+		if (file)
+			stream = file->readStream(file->size());
+	}
+	g_gui.unlockIconsSet();
+
+	if (!stream)
+		debug(5, "GridWidget: Cannot read file '%s'", name.c_str());
+	return stream;
+}
+
 // Load an image file by String name, provide additional render dimensions for SVG images.
 // TODO: Add BMP support, and add scaling of non-vector images.
 Graphics::ManagedSurface *loadSurfaceFromFile(const Common::String &name, int renderWidth = 0, int renderHeight = 0) {
-	Common::Path path(name);
 	Graphics::ManagedSurface *surf = nullptr;
 	if (name.hasSuffix(".png")) {
 #ifdef USE_PNG
-		const Graphics::Surface *srcSurface = nullptr;
-		Image::PNGDecoder decoder;
-		g_gui.lockIconsSet();
-		if (g_gui.getIconsSet().hasFile(path)) {
-			Common::SeekableReadStream *stream = g_gui.getIconsSet().createReadStreamForMember(path);
+		Common::ScopedPtr<Common::SeekableReadStream> stream(readIconFile(name));
+		if (stream) {
+			Image::PNGDecoder decoder;
 			if (!decoder.loadStream(*stream)) {
-				g_gui.unlockIconsSet();
 				warning("Error decoding PNG");
 				return surf;
 			}
 
-			srcSurface = decoder.getSurface();
-			delete stream;
+			const Graphics::Surface *srcSurface = decoder.getSurface();
 			if (!srcSurface) {
 				warning("Failed to load surface : %s", name.c_str());
 			} else if (srcSurface->format.bytesPerPixel != 1) {
 				surf = new Graphics::ManagedSurface();
 				surf->copyFrom(*srcSurface);
 			}
-		} else {
-			debug(5, "GridWidget: Cannot read file '%s'", name.c_str());
 		}
-		g_gui.unlockIconsSet();
 #else
 		error("No PNG support compiled");
 #endif
 	} else if (name.hasSuffix(".svg")) {
-		g_gui.lockIconsSet();
-		if (g_gui.getIconsSet().hasFile(path)) {
-			Common::SeekableReadStream *stream = g_gui.getIconsSet().createReadStreamForMember(path);
-			surf = new Graphics::SVGBitmap(stream, renderWidth, renderHeight);
-			delete stream;
-		} else {
-			debug(5, "GridWidget: Cannot read file '%s'", name.c_str());
+		Common::ScopedPtr<Common::SeekableReadStream> stream(readIconFile(name));
+		if (stream)
+			surf = new Graphics::SVGBitmap(stream.get(), renderWidth, renderHeight);
+	}
+	return surf;
+}
+
+#pragma mark -
+
+/**
+ * Loads the icon used as thumbnail by one or more grid entries, and scales
+ * it to the thumbnail size. The scaled icons are kept in a cache on disk,
+ * so that they only need to be decoded and scaled once per icon pack.
+ *
+ * This runs on the threads of the grid's thumbnail pool, so apart from the
+ * icons set it must not touch anything belonging to the GUI.
+ */
+class GridThumbnailJob : public Common::Job {
+public:
+	GridThumbnailJob(Common::Mutex &mutex, const Common::String &source, const Common::String &fallback,
+					 int width, int height, uint32 packVersion, const Common::Path &cachePath);
+	~GridThumbnailJob() override;
+
+	void run() override;
+
+	const Common::String _source;
+	const Common::String _fallback;			///< Icon to use when the source can't be decoded
+	Common::StringArray _targets;				///< Entries waiting for the icon, only used by the GUI thread
+
+	// Guarded by the mutex
+	const Graphics::ManagedSurface *_result;
+	Graphics::AlphaType _alphaType;
+	bool _cancelled;
+	bool _done;
+
+private:
+	Graphics::ManagedSurface *loadCached();
+	void saveCached(const Graphics::ManagedSurface &surf);
+
+	Common::Mutex &_mutex;
+	const int _width;
+	const int _height;
+	const uint32 _packVersion;
+	Common::Path _cacheFile;
+};
+
+static const uint32 kThumbnailCacheTag = MKTAG('G', 'T', 'H', 'C');
+// Bump this whenever the layout of the cache files changes
+static const uint32 kThumbnailCacheVersion = 1;
+
+GridThumbnailJob::GridThumbnailJob(Common::Mutex &mutex, const Common::String &source, const Common::String &fallback,
+								   int width, int height, uint32 packVersion, const Common::Path &cachePath)
+	: _source(source), _fallback(fallback), _result(nullptr), _alphaType(Graphics::ALPHA_OPAQUE), _cancelled(false), _done(false),
+	  _mutex(mutex), _width(width), _height(height), _packVersion(packVersion) {
+	if (!cachePath.empty()) {
+		Common::String name = Common::Path(source).baseName();
+		if (name.hasSuffix(".png"))
+			name.erase(name.size() - 4);
+		_cacheFile = cachePath.join(Common::String::format("%s-%dx%d.thumb", name.c_str(), width, height));
+	}
+}
+
+GridThumbnailJob::~GridThumbnailJob() {
+	delete _result;
+}
+
+void GridThumbnailJob::run() {
+	{
+		Common::StackLock lock(_mutex);
+		if (_cancelled) {
+			_done = true;
+			return;
+		}
+	}
+
+	const Graphics::ManagedSurface *scSurf = loadCached();
+	if (!scSurf) {
+		Graphics::ManagedSurface *surf = loadSurfaceFromFile(_source);
+		if (!surf && !_fallback.empty())
+			surf = loadSurfaceFromFile(_fallback);
+		if (surf) {
+			scSurf = scaleGfx(surf, _width, _height, true);
+			if (surf != scSurf) {
+				surf->free();
+				delete surf;
+			}
+			saveCached(*scSurf);
 		}
-		g_gui.unlockIconsSet();
+	}
+
+	Graphics::AlphaType alphaType = scSurf ? scSurf->detectAlpha() : Graphics::ALPHA_OPAQUE;
+
+	Common::StackLock lock(_mutex);
+	_result = scSurf;
+	_alphaType = alphaType;
+	_done = true;
+}
+
+Graphics::ManagedSurface *GridThumbnailJob::loadCached() {
+	if (_cacheFile.empty())
+		return nullptr;
+
+	Common::File file;
+	if (!file.open(Common::FSNode(_cacheFile)))
+		return nullptr;
+
+	if (file.readUint32BE() != kThumbnailCacheTag || file.readUint32LE() != kThumbnailCacheVersion ||
+		file.readUint32LE() != _packVersion) {
+		debug(5, "GridWidget: Discarding outdated thumbnail '%s'", _cacheFile.toString(Common::Path::kNativeSeparator).c_str());
+		return nullptr;
+	}
+
+	const uint16 w = file.readUint16LE();
+	const uint16 h = file.readUint16LE();
+	Graphics::PixelFormat format;
+	format.bytesPerPixel = file.readByte();
+	format.rLoss = file.readByte();
+	format.gLoss = file.readByte();
+	format.bLoss = file.readByte();
+	format.aLoss = file.readByte();
+	format.rShift = file.readByte();
+	format.gShift = file.readByte();
+	format.bShift = file.readByte();
+	format.aShift = file.readByte();
+	if (file.err() || w == 0 || h == 0 || w > _width || h > _height || format.bytesPerPixel < 2 || format.bytesPerPixel > 4)
+		return nullptr;
+
+	Graphics::ManagedSurface *surf = new Graphics::ManagedSurface(w, h, format);
+	for (int y = 0; y < h; ++y)
+		file.read(surf->getBasePtr(0, y), w * format.bytesPerPixel);
+
+	if (file.err() || file.eos()) {
+		delete surf;
+		return nullptr;
 	}
 	return surf;
 }
 
+void GridThumbnailJob::saveCached(const Graphics::ManagedSurface &surf) {
+	if (_cacheFile.empty())
+		return;
+
+	Common::DumpFile file;
+	if (!file.open(_cacheFile)) {
+		debug(5, "GridWidget: Cannot write thumbnail '%s'", _cacheFile.toString(Common::Path::kNativeSeparator).c_str());
+		return;
+	}
+
+	file.writeUint32BE(kThumbnailCacheTag);
+	file.writeUint32LE(kThumbnailCacheVersion);
+	file.writeUint32LE(_packVersion);
+	file.writeUint16LE(surf.w);
+	file.writeUint16LE(surf.h);
+	file.writeByte(surf.format.bytesPerPixel);
+	file.writeByte(surf.format.rLoss);
+	file.writeByte(surf.format.gLoss);
+	file.writeByte(surf.format.bLoss);
+	file.writeByte(surf.format.aLoss);
+	file.writeByte(surf.format.rShift);
+	file.writeByte(surf.format.gShift);
+	file.writeByte(surf.format.bShift);
+	file.writeByte(surf.format.aShift);
+	for (int y = 0; y < surf.h; ++y)
+		file.write(surf.getBasePtr(0, y), surf.w * surf.format.bytesPerPixel);
+
+	file.finalize();
+	file.close();
+}
+
 #pragma mark -
 
 GridWidget::GridWidget(GuiObject *boss, const Common::String &name)
@@ -457,6 +629,8 @@ GridWidget::GridWidget(GuiObject *boss, const Common::String &name)
 	_extraIconHeight = 0;
 	_extraIconWidth = 0;
 	_disabledIconOverlay = nullptr;
+	_thumbnailPool = nullptr;
+	setFlags(WIDGET_WANT_TICKLE);
 
 	_minGridXSpacing = 0;
 	_minGridYSpacing = 0;
@@ -496,10 +670,17 @@ GridWidget::GridWidget(GuiObject *boss, const Common::String &name)
 }
 
 GridWidget::~GridWidget() {
+	// Deleting the pool waits for the jobs still running
+	cancelThumbnails();
+	delete _thumbnailPool;
+	for (uint i = 0; i < _thumbnailJobs.size(); ++i)
+		delete _thumbnailJobs[i];
+	_thumbnailJobs.clear();
+
 	unloadSurfaces(_platformIcons);
 	unloadSurfaces(_languageIcons);
 	unloadSurfaces(_extraIcons);
-	unloadSurfaces(_loadedSurfaces);
+	_loadedSurfaces.clear();
 	delete _disabledIconOverlay;
 	_gridItems.clear();
 	_dataEntryList.clear();
@@ -519,10 +700,12 @@ void GridWidget::unloadSurfaces(Common::HashMap<T, const Graphics::ManagedSurfac
 	surfaces.clear();
 }
 
-const Graphics::ManagedSurface *GridWidget::filenameToSurface(const Common::String &name) {
-	if (name.empty())
+Common::SharedPtr<const Graphics::ManagedSurface> GridWidget::filenameToSurface(const Common::String &name, Graphics::AlphaType &alphaType) {
+	GridThumbnail thumb;
+	if (!_loadedSurfaces.tryGetVal(name, thumb))
 		return nullptr;
-	return _loadedSurfaces[name];
+	alphaType = thumb.alphaType;
+	return thumb.surface;
 }
 
 const Graphics::ManagedSurface *GridWidget::languageToSurface(Common::Language languageCode, Graphics::AlphaType &alphaType) {
@@ -752,44 +935,97 @@ void GridWidget::reloadThumbnails() {
 	const int thumbnailHeight = MAX(_thumbnailHeight - 2 * _thumbnailMargin, 0);
 	for (Common::Array<GridItemInfo *>::iterator iter = _visibleEntryList.begin(); iter != _visibleEntryList.end(); ++iter) {
 		GridItemInfo *entry = *iter;
-		if (entry->thumbPath.empty())
+		if (entry->thumbPath.empty() || _loadedSurfaces.contains(entry->thumbPath))
 			continue;
 
-		if (!_loadedSurfaces.contains(entry->thumbPath)) {
-			_loadedSurfaces[entry->thumbPath] = nullptr;
-			Common::String path = Common::String::format("icons/%s-%s.png", entry->engineid.c_str(), entry->gameid.c_str());
-			Graphics::ManagedSurface *surf = loadSurfaceFromFile(path);
-			if (!surf) {
-				path = Common::String::format("icons/%s.png", entry->engineid.c_str());
-				if (!_loadedSurfaces.contains(path)) {
-					surf = loadSurfaceFromFile(path);
-				} else {
-					const Graphics::ManagedSurface *scSurf = _loadedSurfaces[path];
-					// TODO: Use SharedPtr instead of duplicating the surface
-					Graphics::ManagedSurface *thSurf = new Graphics::ManagedSurface();
-					thSurf->copyFrom(*scSurf);
-					_loadedSurfaces[entry->thumbPath] = thSurf;
-				}
-			}
+		// Entries without an icon of their own use the icon of their engine,
+		// as do those whose icon can't be decoded
+		Common::String path = entry->thumbPath;
+		Common::String fallback = Common::String::format("icons/%s.png", entry->engineid.c_str());
+		g_gui.lockIconsSet();
+		if (!g_gui.getIconsSet().hasFile(Common::Path(path)))
+			path = fallback;
+		g_gui.unlockIconsSet();
+		if (path == fallback)
+			fallback.clear();
 
-			if (surf) {
-				const Graphics::ManagedSurface *scSurf(scaleGfx(surf, thumbnailWidth, thumbnailHeight, true));
-				_loadedSurfaces[entry->thumbPath] = scSurf;
+		GridThumbnail thumb;
+		if (_loadedSurfaces.tryGetVal(path, thumb)) {
+			_loadedSurfaces[entry->thumbPath] = thumb;
+			continue;
+		}
 
-				if (path != entry->thumbPath) {
-					// TODO: Use SharedPtr instead of duplicating the surface
-					Graphics::ManagedSurface *thSurf = new Graphics::ManagedSurface();
-					thSurf->copyFrom(*scSurf);
-					_loadedSurfaces[path] = thSurf;
-				}
+		GridThumbnailJob *job = nullptr;
+		if (!_pendingThumbnails.tryGetVal(path, job)) {
+			if (!_thumbnailPool) {
+				_thumbnailPool = new Common::ThreadPool();
 
-				if (surf != scSurf) {
-					surf->free();
-					delete surf;
+				Common::Path iconsPath = ConfMan.getPath("iconspath");
+				if (!iconsPath.empty()) {
+					Common::FSNode cacheDir(iconsPath.join("gui-icons-cache"));
+					if (cacheDir.exists() || cacheDir.createDirectory())
+						_thumbnailCachePath = cacheDir.getPath();
 				}
 			}
+
+			job = new GridThumbnailJob(_thumbnailMutex, path, fallback, thumbnailWidth, thumbnailHeight,
+									   g_gui.getIconsSetVersion(), _thumbnailCachePath);
+			_pendingThumbnails[path] = job;
+			_thumbnailJobs.push_back(job);
+			_thumbnailPool->submit(job);
 		}
+
+		if (path != entry->thumbPath && Common::find(job->_targets.begin(), job->_targets.end(), entry->thumbPath) == job->_targets.end())
+			job->_targets.push_back(entry->thumbPath);
 	}
+
+	// Without worker threads, the thumbnails are loaded right away
+	collectThumbnails();
+}
+
+bool GridWidget::collectThumbnails() {
+	bool loaded = false;
+
+	for (uint i = 0; i < _thumbnailJobs.size();) {
+		GridThumbnailJob *job = _thumbnailJobs[i];
+		bool done, cancelled;
+		{
+			Common::StackLock lock(_thumbnailMutex);
+			done = job->_done;
+			cancelled = job->_cancelled;
+		}
+		if (!done) {
+			++i;
+			continue;
+		}
+
+		_thumbnailPool->wait(job);
+		_thumbnailJobs.remove_at(i);
+
+		if (!cancelled) {
+			GridThumbnail thumb;
+			thumb.surface = Common::SharedPtr<const Graphics::ManagedSurface>(job->_result);
+			thumb.alphaType = job->_alphaType;
+			job->_result = nullptr;
+
+			_pendingThumbnails.erase(job->_source);
+			_loadedSurfaces[job->_source] = thumb;
+			for (uint j = 0; j < job->_targets.size(); ++j)
+				_loadedSurfaces[job->_targets[j]] = thumb;
+			loaded = true;
+		}
+		delete job;
+	}
+
+	return loaded;
+}
+
+void GridWidget::cancelThumbnails() {
+	// The jobs are only deleted once they are done, since they may be running already
+	Common::StackLock lock(_thumbnailMutex);
+	for (uint i = 0; i < _thumbnailJobs.size(); ++i)
+		_thumbnailJobs[i]->_cancelled = true;
+	_pendingThumbnails.clear();
 }
 
 void GridWidget::loadFlagIcons() {
@@ -1018,6 +1254,16 @@ bool GridWidget::handleKeyUp(Common::KeyState state) {
 	return false;
 }
 
+void GridWidget::handleTickle() {
+	if (!collectThumbnails())
+		return;
+
+	for (uint k = 0; k < _visibleEntryList.size() && k < _gridItems.size(); ++k) {
+		if (_gridItems[k]->updateThumb())
+			_gridItems[k]->markAsDirty();
+	}
+}
+
 void GridWidget::handleCommand(CommandSender *sender, uint32 cmd, uint32 data) {
 	// Work in progress
 	switch (cmd) {
@@ -1162,7 +1408,8 @@ void GridWidget::reflowLayout() {
 		unloadSurfaces(_extraIcons);
 		unloadSurfaces(_platformIcons);
 		unloadSurfaces(_languageIcons);
-		unloadSurfaces(_loadedSurfaces);
+		cancelThumbnails();
+		_loadedSurfaces.clear();
 		_platformIconsAlpha.clear();
 		_languageIconsAlpha.clear();
 		_extraIconsAlpha.clear();
@@ -24,17 +24,24 @@
 
 #include "gui/dialog.h"
 #include "gui/widgets/scrollbar.h"
+#include "common/mutex.h"
+#include "common/ptr.h"
 #include "common/str.h"
 
 #include "image/bmp.h"
 #include "image/png.h"
 #include "graphics/svg.h"
 
+namespace Common {
+class ThreadPool;
+}
+
 namespace GUI {
 
 class ScrollBarWidget;
 class GridItemWidget;
 class GridWidget;
+class GridThumbnailJob;
 
 enum {
 	kPlayButtonCmd = 'PLAY',
@@ -75,6 +82,14 @@ struct GridItemInfo {
 	}
 };
 
+/* GridThumbnail */
+struct GridThumbnail {
+	Common::SharedPtr<const Graphics::ManagedSurface>	surface;
+	Graphics::AlphaType									alphaType;
+
+	GridThumbnail() : alphaType(Graphics::ALPHA_OPAQUE) {}
+};
+
 /* GridItemTray */
 class GridItemTray: public Dialog, public CommandSender {
 	int				_entryID;
@@ -106,8 +121,14 @@ protected:
 	Common::HashMap<int, Graphics::AlphaType> _languageIconsAlpha;
 	Common::HashMap<int, Graphics::AlphaType> _extraIconsAlpha;
 	Graphics::ManagedSurface *_disabledIconOverlay;
-	// Images are mapped by filename -> surface.
-	Common::HashMap<Common::String, const Graphics::ManagedSurface *> _loadedSurfaces;
+	// Images are mapped by filename -> surface. Entries using the same icon share its surface.
+	Common::HashMap<Common::String, GridThumbnail> _loadedSurfaces;
+	// Icons being decoded in the background, mapped by icon filename
+	Common::HashMap<Common::String, GridThumbnailJob *> _pendingThumbnails;
+	Common::Array<GridThumbnailJob *>	_thumbnailJobs;
+	Common::ThreadPool					*_thumbnailPool;
+	Common::Mutex						_thumbnailMutex;
+	Common::Path						_thumbnailCachePath;
 
 	Common::Array<GridItemInfo>			_dataEntryList;
 	Common::Array<GridItemInfo>			_headerEntryList;
@@ -177,7 +198,7 @@ public:
 	template<typename T>
 	void unloadSurfaces(Common::HashMap<T, const Graphics::ManagedSurface *> &surfaces);
 
-	const Graphics::ManagedSurface *filenameToSurface(const Common::String &name);
+	Common::SharedPtr<const Graphics::ManagedSurface> filenameToSurface(const Common::String &name, Graphics::AlphaType &alphaType);
 	const Graphics::ManagedSurface *languageToSurface(Common::Language languageCode, Graphics::AlphaType &alphaType);
 	const Graphics::ManagedSurface *platformToSurface(Common::Platform platformCode, Graphics::AlphaType &alphaType);
 	const Graphics::ManagedSurface *demoToSurface(const Common::String &extraString, Graphics::AlphaType &alphaType);
@@ -200,6 +221,9 @@ public:
 	void saveClosedGroups(const Common::U32String &groupName);
 
 	void reloadThumbnails();
+	/// Stores the thumbnails loaded in the background and returns true if there were any.
+	bool collectThumbnails();
+	void cancelThumbnails();
 	void loadFlagIcons();
 	void loadPlatformIcons();
 	void loadExtraIcons();
@@ -223,6 +247,7 @@ public:
 
 	void handleMouseWheel(int x, int y, int direction) override;
 	void handleCommand(CommandSender *sender, uint32 cmd, uint32 data) override;
+	void handleTickle() override;
 	void reflowLayout() override;
 
 	bool wantsFocus() override { return true; }
@@ -249,7 +274,7 @@ public:
 /* GridItemWidget */
 class GridItemWidget : public ContainerWidget, public CommandSender {
 protected:
-	Graphics::ManagedSurface _thumbGfx;
+	Common::SharedPtr<const Graphics::ManagedSurface> _thumbGfx;
 	Graphics::AlphaType _thumbAlpha;
 
 	GridItemInfo	*_activeEntry;
@@ -261,7 +286,7 @@ public:
 
 	void move(int x, int y);
 	void update();
-	void updateThumb();
+	bool updateThumb();
 	void setActiveEntry(GridItemInfo &entry);
 
 	void drawWidget() override;
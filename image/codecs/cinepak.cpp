@@ -677,7 +677,7 @@ void CinepakDecoder::setDither(DitherType type, const byte *palette) {
 	} else {
 		// Generate QuickTime dither table
 		// 4 blocks of 0x4000 bytes (RGB554 lookup)
-		_colorMap = DitherCodec::createQuickTimeDitherTable(palette, 256);
+		_colorMap = QuickTimeDitherTableCache::instance().createQuickTimeDitherTable(palette, 256);
 	}
 }
 
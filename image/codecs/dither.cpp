@@ -21,7 +21,11 @@
 
 #include "image/codecs/dither.h"
 
-#include "common/list.h"
+#include "common/array.h"
+
+namespace Common {
+DECLARE_SINGLETON(Image::QuickTimeDitherTableCache);
+}
 
 namespace Image {
 
@@ -30,11 +34,11 @@ namespace {
 /**
  * Add a color to the QuickTime dither table check queue if it hasn't already been found.
  */
-inline void addColorToQueue(uint16 color, uint16 index, byte *checkBuffer, Common::List<uint16> &checkQueue) {
-	if ((READ_UINT16(checkBuffer + color * 2) & 0xFF) == 0) {
+inline void addColorToQueue(uint16 color, uint16 index, uint16 *checkBuffer, uint16 *checkQueue, uint &queueEnd) {
+	if ((checkBuffer[color] & 0xFF) == 0) {
 		// Previously unfound color
-		WRITE_UINT16(checkBuffer + color * 2, index);
-		checkQueue.push_back(color);
+		checkBuffer[color] = index;
+		checkQueue[queueEnd++] = color;
 	}
 }
 
@@ -47,6 +51,18 @@ inline uint16 makeQuickTimeDitherColor(byte r, byte g, byte b) {
 	return ((r & 0xF8) << 6) | ((g & 0xF8) << 1) | (b >> 4);
 }
 
+enum {
+	kDitherTableSize = 0x10000
+};
+
+uint32 hashDitherPalette(const byte *palette, uint colorCount) {
+	// FNV-1a
+	uint32 hash = 2166136261u;
+	for (uint i = 0; i < colorCount * 3; i++)
+		hash = (hash ^ palette[i]) * 16777619u;
+	return hash;
+}
+
 } // End of anonymous namespace
 
 DitherCodec::DitherCodec(Codec *codec, DisposeAfterUse::Flag disposeAfterUse)
@@ -68,42 +84,72 @@ DitherCodec::~DitherCodec() {
 
 namespace {
 
-// Default template to convert a dither color
-inline uint16 readQT_RGB(uint32 srcColor, const Graphics::PixelFormat& format, const byte *palette) {
-	byte r, g, b;
-	format.colorToRGB(srcColor, r, g, b);
-	return makeQuickTimeDitherColor(r, g, b);
-}
+// Default reader to convert a dither color
+struct ReadQT_RGB {
+	const Graphics::PixelFormat &_format;
 
-// Specialized version for 8bpp
-inline uint16 readQT_Palette(uint8 srcColor, const Graphics::PixelFormat& format, const byte *palette) {
-	return makeQuickTimeDitherColor(palette[srcColor * 3], palette[srcColor * 3 + 1], palette[srcColor * 3 + 2]);
-}
+	ReadQT_RGB(const Graphics::PixelFormat &format) : _format(format) {}
+
+	inline uint16 operator()(uint32 srcColor) const {
+		byte r, g, b;
+		_format.colorToRGB(srcColor, r, g, b);
+		return makeQuickTimeDitherColor(r, g, b);
+	}
+};
+
+// Specialized version for 8bpp, converting the palette once per frame
+struct ReadQT_Palette {
+	uint16 _colors[256];
+
+	ReadQT_Palette(const byte *palette) {
+		for (int i = 0; i < 256; i++)
+			_colors[i] = makeQuickTimeDitherColor(palette[i * 3], palette[i * 3 + 1], palette[i * 3 + 2]);
+	}
+
+	inline uint16 operator()(uint8 srcColor) const {
+		return _colors[srcColor];
+	}
+};
 
 // Specialized version for RGB554
-inline uint16 readQT_RGB554(uint16 srcColor, const Graphics::PixelFormat& format, const byte *palette) {
-	return srcColor;
-}
+struct ReadQT_RGB554 {
+	inline uint16 operator()(uint16 srcColor) const {
+		return srcColor;
+	}
+};
 
 // Specialized version for RGB555 and ARGB1555
-inline uint16 readQT_RGB555(uint16 srcColor, const Graphics::PixelFormat& format, const byte *palette) {
-	return (srcColor >> 1) & 0x3FFF;
-}
+struct ReadQT_RGB555 {
+	inline uint16 operator()(uint16 srcColor) const {
+		return (srcColor >> 1) & 0x3FFF;
+	}
+};
 
-template<typename PixelInt, class Fn>
-void ditherQuickTimeFrame(const Graphics::Surface &src, Graphics::Surface &dst, const byte *ditherTable, Fn fn, const byte *palette = 0) {
+template<typename PixelInt, class Reader>
+void ditherQuickTimeFrame(const Graphics::Surface &src, Graphics::Surface &dst, const byte *ditherTable, const Reader &reader) {
 	static const uint16 colorTableOffsets[] = { 0x0000, 0xC000, 0x4000, 0x8000 };
 
 	for (int y = 0; y < dst.h; y++) {
 		const PixelInt *srcPtr = (const PixelInt *)src.getBasePtr(0, y);
 		byte *dstPtr = (byte *)dst.getBasePtr(0, y);
-		uint16 colorTableOffset = colorTableOffsets[y & 3];
 
-		for (int x = 0; x < dst.w; x++) {
-			uint16 color = fn(*srcPtr++, src.format, palette);
-			*dstPtr++ = ditherTable[colorTableOffset + color];
-			colorTableOffset += 0x4000;
+		// The table used moves on by one for every pixel, and wraps around every four
+		const byte *tables[4];
+		for (int i = 0; i < 4; i++)
+			tables[i] = ditherTable + (uint16)(colorTableOffsets[y & 3] + i * 0x4000);
+
+		int x = 0;
+		for (; x + 4 <= dst.w; x += 4) {
+			dstPtr[0] = tables[0][reader(srcPtr[0])];
+			dstPtr[1] = tables[1][reader(srcPtr[1])];
+			dstPtr[2] = tables[2][reader(srcPtr[2])];
+			dstPtr[3] = tables[3][reader(srcPtr[3])];
+			srcPtr += 4;
+			dstPtr += 4;
 		}
+
+		for (int i = 0; x < dst.w; x++, i++)
+			*dstPtr++ = tables[i][reader(*srcPtr++)];
 	}
 }
 
@@ -133,16 +179,16 @@ const Graphics::Surface *DitherCodec::decodeFrame(Common::SeekableReadStream &st
 	}
 
 	if (frame->format.isCLUT8() && curPalette)
-		ditherQuickTimeFrame<byte>(*frame, *_ditherFrame, _ditherTable, readQT_Palette, curPalette);
+		ditherQuickTimeFrame<byte>(*frame, *_ditherFrame, _ditherTable, ReadQT_Palette(curPalette));
 	else if (frame->format == Graphics::PixelFormat(2, 5, 5, 4, 0, 9, 4, 0, 0))
-		ditherQuickTimeFrame<uint16>(*frame, *_ditherFrame, _ditherTable, readQT_RGB554);
+		ditherQuickTimeFrame<uint16>(*frame, *_ditherFrame, _ditherTable, ReadQT_RGB554());
 	else if (frame->format == Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0) ||
 	         frame->format == Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15))
-		ditherQuickTimeFrame<uint16>(*frame, *_ditherFrame, _ditherTable, readQT_RGB555);
+		ditherQuickTimeFrame<uint16>(*frame, *_ditherFrame, _ditherTable, ReadQT_RGB555());
 	else if (frame->format.bytesPerPixel == 2)
-		ditherQuickTimeFrame<uint16>(*frame, *_ditherFrame, _ditherTable, readQT_RGB);
+		ditherQuickTimeFrame<uint16>(*frame, *_ditherFrame, _ditherTable, ReadQT_RGB(frame->format));
 	else if (frame->format.bytesPerPixel == 4)
-		ditherQuickTimeFrame<uint32>(*frame, *_ditherFrame, _ditherTable, readQT_RGB);
+		ditherQuickTimeFrame<uint32>(*frame, *_ditherFrame, _ditherTable, ReadQT_RGB(frame->format));
 
 	return _ditherFrame;
 }
@@ -207,9 +253,17 @@ void DitherCodec::setCodecAccuracy(CodecAccuracy accuracy) {
 }
 
 byte *DitherCodec::createQuickTimeDitherTable(const byte *palette, uint colorCount) {
-	byte *buf = new byte[0x10000]();
+	byte *buf = new byte[kDitherTableSize];
 
-	Common::List<uint16> checkQueue;
+	// The palette index found for each color in the upper byte, with the lower
+	// byte set once the color has been found
+	Common::Array<uint16> found(0x4000, 0);
+	uint16 *checkBuffer = found.data();
+
+	// Every color is only queued once, after black and white
+	Common::Array<uint16> queue(0x4000 + 2);
+	uint16 *checkQueue = queue.data();
+	uint queueStart = 2, queueEnd = 2;
 
 	bool foundBlack = false;
 	bool foundWhite = false;
@@ -228,57 +282,54 @@ byte *DitherCodec::createQuickTimeDitherTable(const byte *palette, uint colorCou
 			// Special case for close-to-black
 			// The original did more here, but it effectively discarded the value
 			// due to a poor if-check (whole 16-bit value instead of lower 8-bits).
-			WRITE_UINT16(buf, n);
+			checkBuffer[0] = n;
 			foundBlack = true;
 		} else if (col == 0x3FFF) {
 			// Special case for close-to-white
 			// The original did more here, but it effectively discarded the value
 			// due to a poor if-check (whole 16-bit value instead of lower 8-bits).
-			WRITE_UINT16(buf + 0x7FFE, n);
+			checkBuffer[0x3FFF] = n;
 			foundWhite = true;
 		} else {
 			// Previously unfound color
-			addColorToQueue(col, n, buf, checkQueue);
+			addColorToQueue(col, n, checkBuffer, checkQueue, queueEnd);
 		}
 	}
 
 	// More special handling for white
 	if (foundWhite)
-		checkQueue.push_front(0x3FFF);
+		checkQueue[--queueStart] = 0x3FFF;
 
 	// More special handling for black
 	if (foundBlack)
-		checkQueue.push_front(0);
+		checkQueue[--queueStart] = 0;
 
 	// Go through the list of colors we have and match up similar colors
 	// to fill in the table as best as we can.
-	while (!checkQueue.empty()) {
-		uint16 col = checkQueue.front();
-		checkQueue.pop_front();
-		uint16 index = READ_UINT16(buf + col * 2);
-
-		uint32 x = col << 4;
-		if ((x & 0xFF) < 0xF0)
-			addColorToQueue((x + 0x10) >> 4, index, buf, checkQueue);
-		if ((x & 0xFF) >= 0x10)
-			addColorToQueue((x - 0x10) >> 4, index, buf, checkQueue);
-
-		uint32 y = col << 7;
-		if ((y & 0xFF00) < 0xF800)
-			addColorToQueue((y + 0x800) >> 7, index, buf, checkQueue);
-		if ((y & 0xFF00) >= 0x800)
-			addColorToQueue((y - 0x800) >> 7, index, buf, checkQueue);
-
-		uint32 z = col << 2;
-		if ((z & 0xFF00) < 0xF800)
-			addColorToQueue((z + 0x800) >> 2, index, buf, checkQueue);
-		if ((z & 0xFF00) >= 0x800)
-			addColorToQueue((z - 0x800) >> 2, index, buf, checkQueue);
+	while (queueStart != queueEnd) {
+		uint16 col = checkQueue[queueStart++];
+		uint16 index = checkBuffer[col];
+
+		// Step each of the blue, green and red components by one
+		if ((col & 0x000F) < 0x000F)
+			addColorToQueue(col + 0x0001, index, checkBuffer, checkQueue, queueEnd);
+		if ((col & 0x000F) >= 0x0001)
+			addColorToQueue(col - 0x0001, index, checkBuffer, checkQueue, queueEnd);
+
+		if ((col & 0x01F0) < 0x01F0)
+			addColorToQueue(col + 0x0010, index, checkBuffer, checkQueue, queueEnd);
+		if ((col & 0x01F0) >= 0x0010)
+			addColorToQueue(col - 0x0010, index, checkBuffer, checkQueue, queueEnd);
+
+		if ((col & 0x3E00) < 0x3E00)
+			addColorToQueue(col + 0x0200, index, checkBuffer, checkQueue, queueEnd);
+		if ((col & 0x3E00) >= 0x0200)
+			addColorToQueue(col - 0x0200, index, checkBuffer, checkQueue, queueEnd);
 	}
 
 	// Contract the table back to just palette entries
 	for (int i = 0; i < 0x4000; i++)
-		buf[i] = READ_UINT16(buf + i * 2) >> 8;
+		buf[i] = checkBuffer[i] >> 8;
 
 	// Now go through and distribute the error to three more pixels
 	byte *bufPtr = buf;
@@ -328,5 +379,82 @@ byte *DitherCodec::createQuickTimeDitherTable(const byte *palette, uint colorCou
 	return buf;
 }
 
+QuickTimeDitherTableCache::QuickTimeDitherTableCache() : _clock(0) {
+	for (int i = 0; i < kCacheSize; i++)
+		_entries[i].table = nullptr;
+}
+
+QuickTimeDitherTableCache::~QuickTimeDitherTableCache() {
+	clear();
+}
+
+QuickTimeDitherTableCache::Entry *QuickTimeDitherTableCache::findEntry(uint32 hash, const byte *palette, uint colorCount) {
+	for (int i = 0; i < kCacheSize; i++) {
+		Entry &cached = _entries[i];
+
+		if (cached.table && cached.hash == hash && cached.colorCount == colorCount &&
+				memcmp(cached.palette, palette, colorCount * 3) == 0)
+			return &cached;
+	}
+
+	return nullptr;
+}
+
+byte *QuickTimeDitherTableCache::createQuickTimeDitherTable(const byte *palette, uint colorCount) {
+	uint32 hash = hashDitherPalette(palette, colorCount);
+
+	{
+		Common::StackLock lock(_mutex);
+
+		Entry *cached = findEntry(hash, palette, colorCount);
+		if (cached) {
+			cached->lastUse = ++_clock;
+
+			byte *buf = new byte[kDitherTableSize];
+			memcpy(buf, cached->table, kDitherTableSize);
+			return buf;
+		}
+	}
+
+	// Build the table without holding the lock, other codecs may be
+	// looking up theirs in the meantime
+	byte *buf = DitherCodec::createQuickTimeDitherTable(palette, colorCount);
+
+	if (colorCount > 256)
+		return buf;
+
+	Common::StackLock lock(_mutex);
+
+	// Another codec may have added the same palette in the meantime
+	if (findEntry(hash, palette, colorCount))
+		return buf;
+
+	// Replace an unused entry, or else the least recently used one
+	Entry *entry = &_entries[0];
+	for (int i = 1; i < kCacheSize && entry->table; i++) {
+		if (!_entries[i].table || _entries[i].lastUse < entry->lastUse)
+			entry = &_entries[i];
+	}
+
+	if (!entry->table)
+		entry->table = new byte[kDitherTableSize];
+	memcpy(entry->table, buf, kDitherTableSize);
+	memcpy(entry->palette, palette, colorCount * 3);
+	entry->hash = hash;
+	entry->colorCount = colorCount;
+	entry->lastUse = ++_clock;
+
+	return buf;
+}
+
+void QuickTimeDitherTableCache::clear() {
+	Common::StackLock lock(_mutex);
+
+	for (int i = 0; i < kCacheSize; i++) {
+		delete[] _entries[i].table;
+		_entries[i].table = nullptr;
+	}
+}
+
 } // End of namespace Image
 
@@ -24,6 +24,8 @@
 
 #include "image/codecs/codec.h"
 
+#include "common/mutex.h"
+#include "common/singleton.h"
 #include "common/types.h"
 #include "graphics/palette.h"
 
@@ -66,6 +68,51 @@ private:
 	bool _dirtyPalette;
 };
 
+/**
+ * The QuickTime dither tables created recently, keyed by palette.
+ *
+ * The Cinepak, RPZA and QT RLE codecs share one instance, so that videos
+ * using the same palette, or switching back and forth between palettes,
+ * don't rebuild the tables every time. Only a few tables are kept, and
+ * codecs on different threads may use it at once.
+ */
+class QuickTimeDitherTableCache : public Common::Singleton<QuickTimeDitherTableCache> {
+public:
+	QuickTimeDitherTableCache();
+	~QuickTimeDitherTableCache();
+
+	/**
+	 * Create a dither table, as DitherCodec::createQuickTimeDitherTable()
+	 * does. The returned copy is cheap to get again for a palette that was
+	 * seen recently.
+	 */
+	byte *createQuickTimeDitherTable(const byte *palette, uint colorCount);
+
+	/**
+	 * Free the cached dither tables.
+	 */
+	void clear();
+
+private:
+	enum {
+		kCacheSize = 8
+	};
+
+	struct Entry {
+		uint32 hash;
+		uint colorCount;
+		uint32 lastUse;
+		byte palette[256 * 3];
+		byte *table;
+	};
+
+	Common::Mutex _mutex;
+	Entry _entries[kCacheSize];
+	uint32 _clock;
+
+	Entry *findEntry(uint32 hash, const byte *palette, uint colorCount);
+};
+
 } // End of namespace Image
 
 #endif
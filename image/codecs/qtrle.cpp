@@ -662,7 +662,7 @@ void QTRLEDecoder::setDither(DitherType type, const byte *palette) {
 	_dirtyPalette = true;
 
 	delete[] _colorMap;
-	_colorMap = DitherCodec::createQuickTimeDitherTable(palette, 256);
+	_colorMap = QuickTimeDitherTableCache::instance().createQuickTimeDitherTable(palette, 256);
 }
 
 void QTRLEDecoder::createSurface() {
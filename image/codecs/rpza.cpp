@@ -359,7 +359,7 @@ void RPZADecoder::setDither(DitherType type, const byte *palette) {
 	_format = Graphics::PixelFormat::createFormatCLUT8();
 
 	delete[] _colorMap;
-	_colorMap = DitherCodec::createQuickTimeDitherTable(palette, 256);
+	_colorMap = QuickTimeDitherTableCache::instance().createQuickTimeDitherTable(palette, 256);
 }
 
 } // End of namespace Image
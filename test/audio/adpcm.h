@@ -0,0 +1,94 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/decoders/adpcm.h"
+#include "audio/audiostream.h"
+#include "common/memstream.h"
+
+// The checksums were taken from the sample by sample decoders, to make sure
+// decoding whole blocks at a time still gives exactly the same output.
+class ADPCMStreamTestSuite : public CxxTest::TestSuite
+{
+private:
+	static byte *createData(uint32 size) {
+		byte *data = new byte[size];
+		uint32 seed = 12345;
+		for (uint32 i = 0; i < size; ++i) {
+			seed = seed * 1103515245 + 12345;
+			data[i] = seed >> 16;
+		}
+		return data;
+	}
+
+	void testDecode(Audio::ADPCMType type, const byte *data, uint32 size, int channels, uint32 blockAlign,
+			int chunkSize, uint32 expectedSamples, uint32 expectedChecksum) {
+		Common::MemoryReadStream *stream = new Common::MemoryReadStream(data, size);
+		Audio::SeekableAudioStream *s = Audio::makeADPCMStream(stream, DisposeAfterUse::YES, size, type, 22050, channels, blockAlign);
+
+		int16 *buffer = new int16[chunkSize];
+		uint32 numSamples = 0;
+		uint32 checksum = 2166136261u;
+		for (;;) {
+			const int samples = s->readBuffer(buffer, chunkSize);
+			if (samples <= 0)
+				break;
+			for (int i = 0; i < samples; ++i)
+				checksum = (checksum ^ (uint16)buffer[i]) * 16777619u;
+			numSamples += samples;
+		}
+
+		TS_ASSERT(s->endOfData());
+		TS_ASSERT_EQUALS(numSamples, expectedSamples);
+		TS_ASSERT_EQUALS(checksum, expectedChecksum);
+
+		delete[] buffer;
+		delete s;
+	}
+
+public:
+	void test_oki() {
+		byte *data = createData(3001);
+		testDecode(Audio::kADPCMOki, data, 3001, 1, 0, 1024, 6002, 1893167917u);
+		testDecode(Audio::kADPCMOki, data, 3001, 1, 0, 7, 6002, 1893167917u);
+		delete[] data;
+	}
+
+	void test_dvi() {
+		byte *data = createData(3001);
+		testDecode(Audio::kADPCMDVI, data, 3001, 1, 0, 1024, 6002, 1871238504u);
+		testDecode(Audio::kADPCMDVI, data, 3001, 2, 0, 1024, 6002, 3250759199u);
+		testDecode(Audio::kADPCMDVI, data, 3001, 2, 0, 7, 6002, 3250759199u);
+		delete[] data;
+	}
+
+	void test_ms_ima() {
+		byte *data = createData(4000);
+		// Use valid step indices in the block headers
+		for (uint32 i = 0; i < 4000; i += 512) {
+			data[i + 2] = data[i + 6] = 40;
+			data[i + 3] = data[i + 7] = 0;
+		}
+		testDecode(Audio::kADPCMMSIma, data, 4000, 1, 512, 1024, 7936, 430030102u);
+		testDecode(Audio::kADPCMMSIma, data, 4000, 2, 512, 1024, 7872, 2663033878u);
+		testDecode(Audio::kADPCMMSIma, data, 4000, 2, 512, 16, 7872, 2663033878u);
+		// Reading less than a group of samples at a time works as well
+		testDecode(Audio::kADPCMMSIma, data, 4000, 2, 512, 6, 7872, 2663033878u);
+		delete[] data;
+	}
+
+	void test_ms() {
+		byte *data = createData(4000);
+		testDecode(Audio::kADPCMMS, data, 4000, 1, 512, 1024, 7904, 587848562u);
+		testDecode(Audio::kADPCMMS, data, 4000, 2, 512, 1024, 7808, 1645597570u);
+		testDecode(Audio::kADPCMMS, data, 4000, 2, 512, 13, 7808, 1645597570u);
+		delete[] data;
+	}
+
+	void test_apple() {
+		byte *data = createData(34 * 40 + 20);
+		testDecode(Audio::kADPCMApple, data, 34 * 40 + 20, 1, 34, 1024, 2596, 2210536871u);
+		// Both channels need the same number of blocks
+		testDecode(Audio::kADPCMApple, data, 34 * 40, 2, 34, 1024, 2560, 2964289222u);
+		testDecode(Audio::kADPCMApple, data, 34 * 40, 2, 34, 6, 2560, 2964289222u);
+		delete[] data;
+	}
+};
@@ -0,0 +1,134 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/softsynth/opl/nuked.h"
+#include "common/array.h"
+#include "common/func.h"
+#include "../system/null_osystem.h"
+
+#ifndef DISABLE_NUKED_OPL
+
+/**
+ * Drives the Nuked OPL emulator either with register writes deferred over a
+ * whole buffer, or made between short runs of samples.
+ */
+class TestNukedOPL : public ::OPL::NUKED::OPL {
+public:
+	TestNukedOPL(bool deferWrites) : ::OPL::NUKED::OPL(::OPL::Config::kOpl3) {
+		_deferWrites = deferWrites;
+	}
+
+	// Runs the callback from readBuffer(), without playing the chip in the mixer
+	void setTimer(TimerCallback *callback, int timerFrequency) {
+		_callback.reset(callback);
+		setCallbackFrequency(timerFrequency);
+	}
+};
+
+/**
+ * Replays a fixed sequence of register writes from the timer callback.
+ */
+class OPLSequence {
+public:
+	OPLSequence(TestNukedOPL *opl) : _opl(opl), _tick(0) {}
+
+	void setUp() {
+		_opl->writeReg(0x01, 0x20);
+		for (int channel = 0; channel < 3; ++channel) {
+			static const int kOperators[3][2] = { { 0x00, 0x03 }, { 0x01, 0x04 }, { 0x02, 0x05 } };
+			for (int op = 0; op < 2; ++op) {
+				const int offset = kOperators[channel][op];
+				_opl->writeReg(0x20 + offset, 0x21 + op);
+				_opl->writeReg(0x40 + offset, 0x10);
+				_opl->writeReg(0x60 + offset, 0xF4 - channel);
+				_opl->writeReg(0x80 + offset, 0x55);
+				_opl->writeReg(0xE0 + offset, (channel + op) & 3);
+			}
+			_opl->writeReg(0xC0 + channel, 0x30 | (channel << 1));
+		}
+	}
+
+	void onTimer() {
+		const int channel = _tick % 3;
+		const int fnum = 0x150 + (_tick * 37) % 0x200;
+		const int block = 3 + (_tick / 3) % 3;
+
+		_opl->writeReg(0xA0 + channel, fnum & 0xFF);
+		_opl->writeReg(0xB0 + channel, (_tick & 4 ? 0x00 : 0x20) | (block << 2) | (fnum >> 8));
+		_opl->writeReg(0x43 + channel, (_tick * 5) & 0x3F);
+
+		// Tick lengths change from within the callback too
+		if (_tick == 40)
+			_opl->setCallbackFrequency(173);
+		else if (_tick == 120)
+			_opl->setCallbackFrequency(1000);
+
+		++_tick;
+	}
+
+private:
+	TestNukedOPL *_opl;
+	int _tick;
+};
+
+#endif
+
+class NukedOPLTestSuite : public CxxTest::TestSuite {
+#ifndef DISABLE_NUKED_OPL
+	// Only one OPL may exist at a time, so the runs are made one after the other
+	static Common::Array<int16> render(bool deferWrites) {
+		static const int kBufferSizes[] = { 2048, 34, 1000, 4410, 2, 8192, 512, 730 };
+		static const int kTotalSamples = 2 * 40000;
+
+		TestNukedOPL opl(deferWrites);
+		opl.init();
+		OPLSequence sequence(&opl);
+		sequence.setUp();
+		opl.setTimer(new Common::Functor0Mem<void, OPLSequence>(&sequence, &OPLSequence::onTimer), 250);
+
+		Common::Array<int16> samples(kTotalSamples, 0);
+		int pos = 0;
+		for (int i = 0; pos < kTotalSamples; ++i) {
+			const int count = MIN(kBufferSizes[i % ARRAYSIZE(kBufferSizes)], kTotalSamples - pos);
+			TS_ASSERT_EQUALS(opl.readBuffer(&samples[pos], count), count);
+			pos += count;
+		}
+		return samples;
+	}
+#endif
+
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+#endif
+	}
+
+	void tearDown() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::uninstall_null_g_system();
+#endif
+	}
+
+	void test_deferred_writes() {
+#if NULL_OSYSTEM_IS_AVAILABLE && !defined(DISABLE_NUKED_OPL)
+		const Common::Array<int16> direct = render(false);
+		const Common::Array<int16> deferred = render(true);
+
+		TS_ASSERT_EQUALS(direct.size(), deferred.size());
+		uint firstDifference = direct.size();
+		for (uint i = 0; i < direct.size(); ++i) {
+			if (direct[i] != deferred[i]) {
+				firstDifference = i;
+				break;
+			}
+		}
+		TS_ASSERT_EQUALS(firstDifference, direct.size());
+
+		// Make sure the sequence actually produced sound
+		bool silent = true;
+		for (uint i = 0; i < direct.size() && silent; ++i)
+			silent = direct[i] == 0;
+		TS_ASSERT(!silent);
+#endif
+	}
+};
@@ -0,0 +1,139 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/audiostream.h"
+#include "audio/decoders/mp3.h"
+#include "common/array.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
+
+class MP3StreamTestSuite : public CxxTest::TestSuite {
+#ifdef USE_MAD
+	// MPEG-1 Layer I frames at 448 kbps and 32 kHz, mono: 384 samples in 672 bytes
+	static const uint32 kFrameSize = 672;
+	static const int kFrameSamples = 384;
+	static const int kFrameMsecs = 12;
+	static const int kFrames = 100;
+
+	// The synthesis filter remembers 512 samples, so after a seek the output
+	// matches linear decoding once that many samples have been decoded
+	static const int kSettleSamples = 2 * kFrameSamples;
+
+	struct BitWriter {
+		byte *_data;
+		uint32 _bit;
+
+		BitWriter(byte *data) : _data(data), _bit(0) {}
+
+		void put(uint32 value, int bits) {
+			for (int i = bits - 1; i >= 0; --i, ++_bit) {
+				if ((value >> i) & 1)
+					_data[_bit >> 3] |= 0x80 >> (_bit & 7);
+			}
+		}
+	};
+
+	// Layer I frames don't depend on each other, so random but valid
+	// allocations, scale factors and samples make for a stream whose every
+	// frame sounds different
+	static Common::Array<byte> createFrames() {
+		Common::Array<byte> data(kFrames * kFrameSize, 0);
+		uint32 seed = 12345;
+		for (int frame = 0; frame < kFrames; ++frame) {
+			BitWriter bits(&data[frame * kFrameSize]);
+			bits.put(0xFFFF, 16);	// Sync, MPEG-1, Layer I, no CRC
+			bits.put(0xE8, 8);		// 448 kbps, 32 kHz, no padding
+			bits.put(0xC0, 8);		// Mono
+
+			int allocation[32];
+			for (int sb = 0; sb < 32; ++sb) {
+				seed = seed * 1103515245 + 12345;
+				allocation[sb] = (seed >> 16) % 8;
+				bits.put(allocation[sb], 4);
+			}
+			for (int sb = 0; sb < 32; ++sb) {
+				seed = seed * 1103515245 + 12345;
+				if (allocation[sb])
+					bits.put((seed >> 16) % 63, 6);
+			}
+			for (int s = 0; s < 12; ++s) {
+				for (int sb = 0; sb < 32; ++sb) {
+					seed = seed * 1103515245 + 12345;
+					if (allocation[sb])
+						bits.put(seed >> 16, allocation[sb] + 1);
+				}
+			}
+		}
+		return data;
+	}
+
+	static Audio::SeekableAudioStream *makeStream(const Common::Array<byte> &data) {
+		return Audio::makeMP3Stream(new Common::MemoryReadStream(data.data(), data.size()), DisposeAfterUse::YES);
+	}
+
+	static Common::Array<int16> decodeAll(const Common::Array<byte> &data) {
+		Common::ScopedPtr<Audio::SeekableAudioStream> stream(makeStream(data));
+		Common::Array<int16> samples;
+		int16 buffer[1000];
+		int count;
+		while ((count = stream->readBuffer(buffer, ARRAYSIZE(buffer))) > 0)
+			for (int i = 0; i < count; ++i)
+				samples.push_back(buffer[i]);
+		return samples;
+	}
+
+	// Seeks to the start of the given frame, and compares the output with
+	// the output of linear decoding from there
+	static void checkSeek(Audio::SeekableAudioStream *stream, const Common::Array<int16> &linear, int frame) {
+		TS_ASSERT(stream->seek(Audio::Timestamp(frame * kFrameMsecs, 1000)));
+
+		const int start = frame * kFrameSamples;
+		int16 buffer[4 * kFrameSamples];
+		const int count = MIN<int>(ARRAYSIZE(buffer), linear.size() - start);
+		TS_ASSERT_EQUALS(stream->readBuffer(buffer, count), count);
+
+		int firstDifference = count;
+		for (int i = kSettleSamples; i < count; ++i) {
+			if (buffer[i] != linear[start + i]) {
+				firstDifference = i;
+				break;
+			}
+		}
+		TS_ASSERT_EQUALS(firstDifference, count);
+	}
+#endif
+
+public:
+	void test_seek() {
+#ifdef USE_MAD
+		const Common::Array<byte> data = createFrames();
+		const Common::Array<int16> linear = decodeAll(data);
+		TS_ASSERT_LESS_THAN_EQUALS((uint)(kFrames - 1) * kFrameSamples, linear.size());
+
+		Common::ScopedPtr<Audio::SeekableAudioStream> stream(makeStream(data));
+		TS_ASSERT_LESS_THAN_EQUALS((kFrames - 1) * kFrameMsecs, stream->getLength().msecs());
+
+		// Forward seeks on a fresh stream, then backward ones through the index
+		static const int kFrameOrder[] = { 20, 50, 51, 96, 10, 80, 0, 33, 1, 64, 48 };
+		for (int i = 0; i < ARRAYSIZE(kFrameOrder); ++i)
+			checkSeek(stream.get(), linear, kFrameOrder[i]);
+
+		// Seeking after playing to the end
+		int16 buffer[1000];
+		while (stream->readBuffer(buffer, ARRAYSIZE(buffer)) > 0)
+			;
+		TS_ASSERT(stream->endOfData());
+		checkSeek(stream.get(), linear, 17);
+#endif
+	}
+
+	void test_seek_to_end() {
+#ifdef USE_MAD
+		const Common::Array<byte> data = createFrames();
+		Common::ScopedPtr<Audio::SeekableAudioStream> stream(makeStream(data));
+
+		TS_ASSERT(stream->seek(stream->getLength()));
+		TS_ASSERT(stream->endOfData());
+		TS_ASSERT(!stream->seek(stream->getLength().addMsecs(1)));
+#endif
+	}
+};
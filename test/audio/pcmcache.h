@@ -0,0 +1,207 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/pcmcache.h"
+#include "audio/audiostream.h"
+
+#include "helper.h"
+#include "../system/null_osystem.h"
+
+namespace {
+
+// Reports a length which isn't the one of the stream it plays
+class WrongLengthStream : public Audio::SeekableAudioStream {
+public:
+	WrongLengthStream(Audio::SeekableAudioStream *stream, int frames) : _stream(stream), _frames(frames) {}
+	~WrongLengthStream() override { delete _stream; }
+
+	int readBuffer(int16 *buffer, const int numSamples) override { return _stream->readBuffer(buffer, numSamples); }
+	bool isStereo() const override { return _stream->isStereo(); }
+	int getRate() const override { return _stream->getRate(); }
+	bool endOfData() const override { return _stream->endOfData(); }
+	bool seek(const Audio::Timestamp &where) override { return _stream->seek(where); }
+	Audio::Timestamp getLength() const override { return Audio::Timestamp(0, _frames, getRate()); }
+
+private:
+	Audio::SeekableAudioStream *_stream;
+	int _frames;
+};
+
+} // End of anonymous namespace
+
+class PCMCacheTestSuite : public CxxTest::TestSuite {
+#if NULL_OSYSTEM_IS_AVAILABLE
+	// Reads the whole stream in pieces, and checks it plays the samples
+	static bool readAll(Audio::AudioStream *s, const int16 *samples, int numSamples) {
+		int16 buffer[1000];
+		int pos = 0;
+		bool same = true;
+		while (!s->endOfData()) {
+			const int count = s->readBuffer(buffer, ARRAYSIZE(buffer));
+			if (count <= 0 || pos + count > numSamples)
+				return false;
+			same = same && !memcmp(samples + pos, buffer, count * sizeof(int16));
+			pos += count;
+		}
+		return same && pos == numSamples;
+	}
+#endif
+
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+#endif
+	}
+
+	void tearDown() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::uninstall_null_g_system();
+#endif
+	}
+
+	void test_find_and_insert() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Audio::PCMCache cache(1024 * 1024);
+		const Common::String key = Audio::PCMCache::makeKey("sounds.dat", "click", "raw");
+
+		TS_ASSERT(!cache.find(key));
+		TS_ASSERT_EQUALS(cache.getMisses(), 1u);
+
+		int16 *sine;
+		Audio::SeekableAudioStream *s = createSineStream<int16>(11025, 2, &sine, true, true);
+		const int totalSamples = 11025 * 2 * 2;
+
+		s = cache.insert(key, s);
+		TS_ASSERT(s);
+		TS_ASSERT_EQUALS(cache.getSize(), totalSamples * sizeof(int16));
+		TS_ASSERT_EQUALS(s->isStereo(), true);
+		TS_ASSERT_EQUALS(s->getRate(), 11025);
+		TS_ASSERT_EQUALS(s->getLength().msecs(), 2000);
+
+		Audio::SeekableAudioStream *s2 = cache.find(key);
+		TS_ASSERT(s2);
+		TS_ASSERT_EQUALS(cache.getHits(), 1u);
+
+		int16 *buffer = new int16[totalSamples];
+		TS_ASSERT_EQUALS(s->readBuffer(buffer, totalSamples), totalSamples);
+		TS_ASSERT_EQUALS(memcmp(sine, buffer, sizeof(int16) * totalSamples), 0);
+		TS_ASSERT(s->endOfData());
+
+		// Streams don't share their position
+		TS_ASSERT(!s2->endOfData());
+		TS_ASSERT(s2->seek(Audio::Timestamp(1000, 11025)));
+		TS_ASSERT_EQUALS(s2->readBuffer(buffer, totalSamples), totalSamples / 2);
+		TS_ASSERT_EQUALS(memcmp(sine + totalSamples / 2, buffer, sizeof(int16) * totalSamples / 2), 0);
+
+		// Streams keep playing once the sound is dropped
+		cache.clear();
+		TS_ASSERT_EQUALS(cache.getSize(), 0u);
+		TS_ASSERT(!cache.find(key));
+		TS_ASSERT(s2->rewind());
+		TS_ASSERT_EQUALS(s2->readBuffer(buffer, totalSamples), totalSamples);
+		TS_ASSERT_EQUALS(memcmp(sine, buffer, sizeof(int16) * totalSamples), 0);
+
+		delete[] buffer;
+		delete[] sine;
+		delete s;
+		delete s2;
+#endif
+	}
+
+	void test_eviction() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		// Each one second sound takes 2000 bytes, so eight of them fit
+		Audio::PCMCache cache(16000);
+
+		for (int i = 0; i < 8; ++i)
+			delete cache.insert(Common::String::format("%d", i), createSineStream<int16>(1000, 1, nullptr, true, false));
+		TS_ASSERT_EQUALS(cache.getSize(), 16000u);
+
+		// Using the first sound makes the second one the least recently used
+		delete cache.find("0");
+		delete cache.insert("8", createSineStream<int16>(1000, 1, nullptr, true, false));
+		TS_ASSERT_EQUALS(cache.getSize(), 16000u);
+
+		Audio::SeekableAudioStream *s = cache.find("1");
+		TS_ASSERT(!s);
+		s = cache.find("0");
+		TS_ASSERT(s);
+		delete s;
+		s = cache.find("8");
+		TS_ASSERT(s);
+		delete s;
+
+		// Sounds too long to cache are returned as they are
+		Audio::SeekableAudioStream *orig = createSineStream<int16>(1000, 2, nullptr, true, false);
+		s = cache.insert("9", orig);
+		TS_ASSERT_EQUALS(s, orig);
+		delete s;
+		TS_ASSERT_EQUALS(cache.getSize(), 16000u);
+#endif
+	}
+
+	void test_wrong_length() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Audio::PCMCache cache(1024 * 1024);
+
+		// The whole sound is cached, whatever length the stream reports
+		const int lengths[] = { 0, 1000, 11025 * 4 };
+		for (int i = 0; i < ARRAYSIZE(lengths); ++i) {
+			int16 *sine;
+			Audio::SeekableAudioStream *s = createSineStream<int16>(11025, 2, &sine, true, true);
+			s = cache.insert(Common::String::format("%d", i), new WrongLengthStream(s, lengths[i]));
+			TS_ASSERT(s);
+			TS_ASSERT_EQUALS(s->getLength().msecs(), 2000);
+			TS_ASSERT(readAll(s, sine, 11025 * 2 * 2));
+			delete s;
+			delete[] sine;
+		}
+		TS_ASSERT_EQUALS(cache.getSize(), 3 * 11025 * 2 * 2 * sizeof(int16));
+
+		// Streams longer than they say are given back when they turn out too long
+		Audio::PCMCache small(16000);
+		Audio::SeekableAudioStream *orig = new WrongLengthStream(createSineStream<int16>(1000, 2, nullptr, true, false), 10);
+		TS_ASSERT_EQUALS(small.insert("long", orig), orig);
+		TS_ASSERT_EQUALS(orig->getLength().totalNumberOfFrames(), 10);
+		TS_ASSERT(!orig->endOfData());
+		delete orig;
+		TS_ASSERT_EQUALS(small.getSize(), 0u);
+#endif
+	}
+
+	void test_caching_stream() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Audio::PCMCache cache(1024 * 1024);
+		int16 *sine;
+		Audio::SeekableAudioStream *s = cache.makeCachingStream("sine", createSineStream<int16>(11025, 1, &sine, true, false));
+
+		// Nothing is decoded up front, the sound is cached once played through
+		TS_ASSERT(s->rewind());
+		TS_ASSERT_EQUALS(cache.getSize(), 0u);
+		TS_ASSERT(readAll(s, sine, 11025));
+		TS_ASSERT_EQUALS(cache.getSize(), 11025 * sizeof(int16));
+		delete s;
+
+		s = cache.find("sine");
+		TS_ASSERT(s);
+		TS_ASSERT(readAll(s, sine, 11025));
+		delete s;
+
+		// Sounds which were seeked in aren't cached
+		s = cache.makeCachingStream("seeked", createSineStream<int16>(11025, 1, nullptr, true, false));
+		int16 buffer[100];
+		TS_ASSERT_EQUALS(s->readBuffer(buffer, ARRAYSIZE(buffer)), 100);
+		TS_ASSERT(s->rewind());
+		TS_ASSERT(readAll(s, sine, 11025));
+		delete s;
+		TS_ASSERT(!cache.find("seeked"));
+
+		// Nor are the ones which weren't played to the end
+		delete cache.makeCachingStream("stopped", createSineStream<int16>(11025, 1, nullptr, true, false));
+		TS_ASSERT(!cache.find("stopped"));
+		TS_ASSERT_EQUALS(cache.getSize(), 11025 * sizeof(int16));
+
+		delete[] sine;
+#endif
+	}
+};
@@ -0,0 +1,105 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/softsynth/renderahead.h"
+#include "common/system.h"
+
+#include "../system/null_osystem.h"
+
+namespace {
+
+// Generates a ramp, and counts the samples generated
+struct RampGenerator {
+	RampGenerator(bool stereo) : _stereoFactor(stereo ? 2 : 1), _next(0) {}
+
+	static int16 valueAt(uint pos) {
+		return (int16)(pos & 0x7FFF);
+	}
+
+	static void generate(void *param, int16 *buf, int len) {
+		RampGenerator *ramp = (RampGenerator *)param;
+		Common::StackLock lock(ramp->_mutex);
+		for (int i = 0; i < len * ramp->_stereoFactor; ++i)
+			buf[i] = valueAt(ramp->_next++);
+	}
+
+	uint getGenerated() {
+		Common::StackLock lock(_mutex);
+		return _next;
+	}
+
+	const int _stereoFactor;
+	Common::Mutex _mutex;
+	uint _next;
+};
+
+} // End of anonymous namespace
+
+class RenderAheadTestSuite : public CxxTest::TestSuite {
+#if NULL_OSYSTEM_IS_AVAILABLE
+	static bool waitGenerated(RampGenerator &ramp, uint count) {
+		for (uint i = 0; i < 5000 && ramp.getGenerated() < count; ++i)
+			g_system->delayMillis(1);
+		return ramp.getGenerated() >= count;
+	}
+
+	// Reads the ramp in uneven pieces of whole frames
+	static void checkRamp(Audio::RenderAheadBuffer &buffer, int stereoFactor, uint total) {
+		int16 samples[2000];
+		uint pos = 0;
+		bool same = true;
+		for (uint size = 1; pos < total; size = size * 7 % 997 + 1) {
+			const int count = MIN<uint>(size * stereoFactor, total - pos);
+			buffer.read(samples, count);
+			for (int i = 0; i < count; ++i)
+				same = same && samples[i] == RampGenerator::valueAt(pos + i);
+			pos += count;
+		}
+		TS_ASSERT(same);
+	}
+
+	void checkRenderAhead(bool stereo) {
+		RampGenerator ramp(stereo);
+		Audio::RenderAheadBuffer buffer(RampGenerator::generate, &ramp);
+		TS_ASSERT(buffer.start(4096, stereo));
+		TS_ASSERT(buffer.isRunning());
+
+		// The buffer is filled without anything being read, and no further
+		TS_ASSERT(waitGenerated(ramp, 4096));
+		g_system->delayMillis(10);
+		TS_ASSERT_EQUALS(ramp.getGenerated(), 4096u);
+
+		// Reading more than the buffer holds waits for the render thread,
+		// or generates the samples right away
+		checkRamp(buffer, ramp._stereoFactor, 100000);
+		TS_ASSERT(ramp.getGenerated() >= 100000u);
+
+		buffer.stop();
+		TS_ASSERT(!buffer.isRunning());
+	}
+#endif
+
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+#endif
+	}
+
+	void tearDown() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::uninstall_null_g_system();
+#endif
+	}
+
+	void test_mono() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		checkRenderAhead(false);
+#endif
+	}
+
+	void test_stereo() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		checkRenderAhead(true);
+#endif
+	}
+};
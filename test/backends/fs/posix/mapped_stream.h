@@ -0,0 +1,117 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/ptr.h"
+#include "backends/fs/posix/posix-fs.h"
+#include "backends/fs/posix/posix-iostream.h"
+
+class PosixMappedStreamTestSuite : public CxxTest::TestSuite {
+	// Written to the build directory, and removed by 'make clean-test'
+	static const char *const kLargeFile;
+	static const char *const kSmallFile;
+	static const uint32 kLargeSize = 200 * 1024;
+
+	static byte valueAt(uint32 pos) {
+		return (byte)((pos * 31) ^ (pos >> 9));
+	}
+
+	static bool writeFile(const char *path, uint32 size) {
+		Common::ScopedPtr<StdioStream> out(PosixIoStream::makeFromPath(path, StdioStream::WriteMode_Write));
+		if (!out)
+			return false;
+		for (uint32 i = 0; i < size; ++i)
+			out->writeByte(valueAt(i));
+		out->finalize();
+		return !out->err();
+	}
+
+public:
+	void test_mapping() {
+		TS_ASSERT(writeFile(kLargeFile, kLargeSize));
+		Common::ScopedPtr<PosixMappedStream> stream(PosixMappedStream::makeFromPath(kLargeFile));
+		TS_ASSERT(stream);
+		if (!stream)
+			return;
+
+		TS_ASSERT_EQUALS(stream->size(), (int64)kLargeSize);
+		TS_ASSERT_EQUALS(stream->pos(), 0);
+
+		// The whole file is available in memory
+		const byte *data = stream->getData();
+		bool same = true;
+		for (uint32 i = 0; i < kLargeSize; ++i)
+			same = same && data[i] == valueAt(i);
+		TS_ASSERT(same);
+
+		byte buffer[16];
+		TS_ASSERT_EQUALS(stream->read(buffer, sizeof(buffer)), sizeof(buffer));
+		TS_ASSERT_EQUALS(buffer[15], valueAt(15));
+		TS_ASSERT_EQUALS(stream->pos(), 16);
+
+		TS_ASSERT(stream->seek(100000));
+		TS_ASSERT_EQUALS(stream->readByte(), valueAt(100000));
+		TS_ASSERT(stream->seek(-1001, SEEK_CUR));
+		TS_ASSERT_EQUALS(stream->readByte(), valueAt(99000));
+		TS_ASSERT(stream->seek(-2, SEEK_END));
+		TS_ASSERT_EQUALS(stream->readByte(), valueAt(kLargeSize - 2));
+		TS_ASSERT_EQUALS(stream->readByte(), valueAt(kLargeSize - 1));
+		TS_ASSERT(!stream->eos());
+		stream->readByte();
+		TS_ASSERT(stream->eos());
+	}
+
+	void test_substream() {
+		TS_ASSERT(writeFile(kLargeFile, kLargeSize));
+		Common::ScopedPtr<PosixMappedStream> stream(PosixMappedStream::makeFromPath(kLargeFile));
+		TS_ASSERT(stream);
+		if (!stream)
+			return;
+
+		// Substreams share the mapping, which outlives the stream they come from
+		stream->seek(70000);
+		Common::ScopedPtr<Common::SeekableReadStream> sub(stream->readStream(5000));
+		TS_ASSERT_EQUALS(stream->pos(), 75000);
+		stream.reset();
+
+		TS_ASSERT_EQUALS(sub->size(), 5000);
+		TS_ASSERT_EQUALS(sub->readByte(), valueAt(70000));
+		TS_ASSERT(sub->seek(4999));
+		TS_ASSERT_EQUALS(sub->readByte(), valueAt(74999));
+		sub->readByte();
+		TS_ASSERT(sub->eos());
+	}
+
+	void test_small_file() {
+		// Small files are left to stdio
+		TS_ASSERT(writeFile(kSmallFile, 1000));
+		Common::ScopedPtr<PosixMappedStream> stream(PosixMappedStream::makeFromPath(kSmallFile));
+		TS_ASSERT(!stream);
+
+		TS_ASSERT(!PosixMappedStream::makeFromPath("test/does-not-exist.dat"));
+	}
+
+	void test_unmapped_stream() {
+		TS_ASSERT(writeFile(kLargeFile, kLargeSize));
+		POSIXFilesystemNode node(kLargeFile);
+
+		Common::ScopedPtr<Common::SeekableReadStream> mapped(node.createReadStream());
+		TS_ASSERT(dynamic_cast<PosixMappedStream *>(mapped.get()));
+		mapped.reset();
+
+		Common::ScopedPtr<Common::SeekableReadStream> stream(node.createUnmappedReadStream());
+		TS_ASSERT(stream);
+		if (!stream)
+			return;
+		TS_ASSERT(!dynamic_cast<PosixMappedStream *>(stream.get()));
+		TS_ASSERT_EQUALS(stream->readByte(), valueAt(0));
+
+		// Truncating the file while it is open makes reads come up short
+		TS_ASSERT(writeFile(kLargeFile, 1000));
+		TS_ASSERT(stream->seek(100000));
+		byte buffer[16];
+		TS_ASSERT_EQUALS(stream->read(buffer, sizeof(buffer)), 0u);
+		TS_ASSERT(stream->eos());
+	}
+};
+
+const char *const PosixMappedStreamTestSuite::kLargeFile = "test/mapped-large.dat";
+const char *const PosixMappedStreamTestSuite::kSmallFile = "test/mapped-small.dat";
@@ -0,0 +1,214 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/algorithm.h"
+#include "common/fs.h"
+#include "common/ptr.h"
+#include "common/stream.h"
+#include "../system/null_osystem.h"
+
+/**
+ * Checks that FSDirectory finds the same members when it lists only the
+ * directories it is asked about as when it caches the whole tree.
+ */
+class FSDirectoryTestSuite : public CxxTest::TestSuite {
+#if NULL_OSYSTEM_IS_AVAILABLE
+	// Written to the build directory, and removed by 'make clean-test'
+	static const char *const kRoot;
+
+	// Whether the file system keeps 'Sub' and 'sub' apart
+	bool _caseClash;
+
+	static bool makeDirectory(const Common::FSNode &node) {
+		if (node.exists())
+			return node.isDirectory();
+		return node.createDirectory();
+	}
+
+	static bool makeFile(const Common::FSNode &node) {
+		if (node.exists())
+			return true;
+		Common::ScopedPtr<Common::SeekableWriteStream> out(node.createWriteStream(false));
+		if (!out)
+			return false;
+		out->writeString(node.getName());
+		out->finalize();
+		return !out->err();
+	}
+
+	static Common::StringArray memberNames(const Common::FSDirectory &dir) {
+		Common::ArchiveMemberList list;
+		dir.listMembers(list);
+
+		Common::StringArray names;
+		for (const auto &member : list)
+			names.push_back(member->getPathInArchive().toString());
+		Common::sort(names.begin(), names.end());
+		return names;
+	}
+
+	static Common::StringArray children(const Common::FSDirectory &dir, const char *path, Common::Archive::ListMode mode) {
+		Common::StringArray list;
+		dir.getChildren(Common::Path(path), list, mode);
+		return list;
+	}
+
+	// Looks a few members up and lists a subdirectory, then checks that
+	// listing all members gives the same as a directory which didn't
+	void checkPartialListing(int depth, bool includeDirectories) {
+		Common::FSDirectory partial(Common::Path(kRoot), depth, false, false, includeDirectories);
+		Common::FSDirectory eager(Common::Path(kRoot), depth, false, false, includeDirectories);
+
+		partial.hasFile(Common::Path("a/deep/d.txt"));
+		partial.hasFile(Common::Path("missing/file.txt"));
+		children(partial, "sub", Common::Archive::kListFilesOnly);
+
+		const Common::StringArray expected = memberNames(eager);
+		TS_ASSERT_EQUALS(memberNames(partial), expected);
+
+		// Lookups after the full listing agree with the listing
+		if (!includeDirectories) {
+			for (const auto &name : expected)
+				TS_ASSERT(partial.hasFile(Common::Path(name)));
+		}
+	}
+#endif
+
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		// top.txt, a/a1.txt, a/deep/d.txt, a/deep/deeper/e.txt, Sub/s1.txt and sub/s2.txt
+		// Children can only be taken from directories which exist
+		const Common::FSNode root(kRoot);
+		TS_ASSERT(makeDirectory(root));
+		TS_ASSERT(makeFile(root.getChild("top.txt")));
+		const Common::FSNode a = root.getChild("a");
+		TS_ASSERT(makeDirectory(a));
+		TS_ASSERT(makeFile(a.getChild("a1.txt")));
+		const Common::FSNode deep = a.getChild("deep");
+		TS_ASSERT(makeDirectory(deep));
+		TS_ASSERT(makeFile(deep.getChild("d.txt")));
+		const Common::FSNode deeper = deep.getChild("deeper");
+		TS_ASSERT(makeDirectory(deeper));
+		TS_ASSERT(makeFile(deeper.getChild("e.txt")));
+		TS_ASSERT(makeDirectory(root.getChild("Sub")));
+		TS_ASSERT(makeFile(root.getChild("Sub").getChild("s1.txt")));
+		TS_ASSERT(makeDirectory(root.getChild("sub")));
+		TS_ASSERT(makeFile(root.getChild("sub").getChild("s2.txt")));
+
+		Common::FSList dirs;
+		root.getChildren(dirs, Common::FSNode::kListDirectoriesOnly);
+		_caseClash = dirs.size() == 3;
+#endif
+	}
+
+	void tearDown() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::uninstall_null_g_system();
+#endif
+	}
+
+	void test_depth_limits() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::FSDirectory top(Common::Path(kRoot), 1);
+		TS_ASSERT(top.hasFile(Common::Path("top.txt")));
+		TS_ASSERT(!top.hasFile(Common::Path("a/a1.txt")));
+
+		Common::FSDirectory two(Common::Path(kRoot), 2);
+		TS_ASSERT(two.hasFile(Common::Path("a/a1.txt")));
+		TS_ASSERT(!two.hasFile(Common::Path("a/deep/d.txt")));
+
+		// Directories at the last level are known, their contents aren't
+		Common::StringArray dirs = children(two, "a", Common::Archive::kListDirectoriesOnly);
+		TS_ASSERT_EQUALS(dirs.size(), 1u);
+		TS_ASSERT(dirs.size() == 1 && dirs[0] == "deep");
+		TS_ASSERT(children(two, "a/deep", Common::Archive::kListAll).empty());
+
+		Common::FSDirectory three(Common::Path(kRoot), 3);
+		TS_ASSERT(three.hasFile(Common::Path("a/deep/d.txt")));
+		TS_ASSERT(!three.hasFile(Common::Path("a/deep/deeper/e.txt")));
+
+		Common::FSDirectory four(Common::Path(kRoot), 4);
+		TS_ASSERT(four.hasFile(Common::Path("A/Deep/Deeper/E.TXT")));
+#endif
+	}
+
+	void test_unvisited_subdirectory() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		// Nothing has been looked up before, so neither 'a' nor 'a/deep' have been listed
+		Common::FSDirectory dir(Common::Path(kRoot), 4);
+		Common::StringArray list = children(dir, "A/Deep", Common::Archive::kListAll);
+		TS_ASSERT_EQUALS(list.size(), 2u);
+		TS_ASSERT(list.size() == 2 && list[0] == "deeper" && list[1] == "d.txt");
+
+		TS_ASSERT(children(dir, "a/deep/deeper", Common::Archive::kListDirectoriesOnly).empty());
+		list = children(dir, "a/deep/deeper", Common::Archive::kListFilesOnly);
+		TS_ASSERT(list.size() == 1 && list[0] == "e.txt");
+
+		// Directories on the way were listed as well
+		list = children(dir, "a", Common::Archive::kListFilesOnly);
+		TS_ASSERT(list.size() == 1 && list[0] == "a1.txt");
+		TS_ASSERT(dir.hasFile(Common::Path("top.txt")));
+		TS_ASSERT(children(dir, "missing/deep", Common::Archive::kListAll).empty());
+#endif
+	}
+
+	void test_case_clash() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::FSDirectory lazy(Common::Path(kRoot), 2);
+		Common::FSDirectory eager(Common::Path(kRoot), 2);
+		memberNames(eager);
+
+		const bool hasS1 = lazy.hasFile(Common::Path("sub/s1.txt"));
+		const bool hasS2 = lazy.hasFile(Common::Path("SUB/S2.TXT"));
+		TS_ASSERT_EQUALS(eager.hasFile(Common::Path("sub/s1.txt")), hasS1);
+		TS_ASSERT_EQUALS(eager.hasFile(Common::Path("SUB/S2.TXT")), hasS2);
+
+		// Only one of the clashing directories is used, and none of the other one's files
+		const Common::StringArray files = children(lazy, "sub", Common::Archive::kListFilesOnly);
+		if (_caseClash) {
+			TS_ASSERT(hasS1 != hasS2);
+			TS_ASSERT_EQUALS(files.size(), 1u);
+		} else {
+			TS_ASSERT(hasS1 && hasS2);
+			TS_ASSERT_EQUALS(files.size(), 2u);
+		}
+		TS_ASSERT_EQUALS(children(lazy, "", Common::Archive::kListDirectoriesOnly).size(), 2u);
+#endif
+	}
+
+	void test_partial_listing() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		for (int depth = 1; depth <= 4; depth++) {
+			checkPartialListing(depth, false);
+			checkPartialListing(depth, true);
+		}
+
+		Common::FSDirectory dir(Common::Path(kRoot), 3);
+		const Common::StringArray names = memberNames(dir);
+		TS_ASSERT_EQUALS(names.size(), _caseClash ? 4u : 5u);
+		TS_ASSERT(Common::find(names.begin(), names.end(), "top.txt") != names.end());
+		TS_ASSERT(Common::find(names.begin(), names.end(), "a/a1.txt") != names.end());
+		TS_ASSERT(Common::find(names.begin(), names.end(), "a/deep/d.txt") != names.end());
+#endif
+	}
+
+	void test_file_stamp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		// Each file holds its own name
+		const Common::FSNode root(kRoot);
+		const Common::FSNode file = root.getChild("top.txt");
+		TS_ASSERT_EQUALS(file.getFileSize(), 7);
+		TS_ASSERT_DIFFERS(file.getModificationTime(), 0u);
+
+		TS_ASSERT_EQUALS(root.getFileSize(), -1);
+		TS_ASSERT_EQUALS(root.getChild("missing.txt").getFileSize(), -1);
+		TS_ASSERT_EQUALS(root.getChild("missing.txt").getModificationTime(), 0u);
+#endif
+	}
+};
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+const char *const FSDirectoryTestSuite::kRoot = "test/fs-tree";
+#endif
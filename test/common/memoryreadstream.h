@@ -104,4 +104,14 @@ class MemoryReadStreamTestSuite : public CxxTest::TestSuite {
 		ms.seek(0, SEEK_SET);
 		TS_ASSERT(!ms.eos());
 	}
+
+	void test_get_data() {
+		byte contents[] = { 1, 2, 3, 4, 5, 6, 7 };
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+
+		// The data pointer doesn't move with the stream
+		ms.seek(3, SEEK_SET);
+		TS_ASSERT_EQUALS(ms.getData(), contents);
+		TS_ASSERT_EQUALS(ms.getData()[ms.pos()], 4);
+	}
 };
@@ -472,6 +472,30 @@ class PathTestSuite : public CxxTest::TestSuite
 		TS_ASSERT_EQUALS(map.size(), 3u);
 	}
 
+	void test_ignoreCaseAndMac() {
+		Common::Path::IgnoreCaseAndMac_Hash hash;
+		Common::Path::IgnoreCaseAndMac_EqualTo equal;
+
+		// Plain paths and their escaped and punycode encoded forms must
+		// still hash and compare the same
+		Common::Path p1("Parent/Sound Manager 3.1 : SoundLib/Sound");
+		Common::Path p2("parent:sound manager 3.1 / soundlib:SOUND", ':');
+		Common::Path p3("PARENT/xn--Sound Manager 3.1  SoundLib-lba84k/sound");
+		Common::Path p4("parent/sound manager 3.1 : soundlib/sound/");
+
+		TS_ASSERT_EQUALS(hash(p1), hash(p2));
+		TS_ASSERT_EQUALS(hash(p1), hash(p3));
+		TS_ASSERT(equal(p1, p2));
+		TS_ASSERT(equal(p1, p3));
+		TS_ASSERT(equal(p3, p2));
+		TS_ASSERT(!equal(p1, p4));
+		TS_ASSERT(equal(p4, Common::Path("Parent/Sound Manager 3.1 : SoundLib/Sound/")));
+
+		TS_ASSERT_EQUALS(hash(Common::Path()), hash(Common::Path("", ':')));
+		TS_ASSERT(equal(Common::Path(), Common::Path()));
+		TS_ASSERT(!equal(Common::Path(), Common::Path("/")));
+	}
+
 	void test_casesensitive() {
 		Common::Path p2("parent:dir:Sound Manager 3.1 / SoundLib:Sound", ':');
 		Common::Path p3("parent:dir:sound manager 3.1 / soundlib:sound", ':');
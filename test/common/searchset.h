@@ -0,0 +1,128 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/memstream.h"
+
+namespace {
+
+class CountingArchive : public Common::Archive {
+public:
+	CountingArchive() : _hasFileCalls(0), _streamCalls(0) {}
+
+	void addFile(const char *name) { _files[Common::Path(name)] = true; }
+
+	bool hasFile(const Common::Path &path) const override {
+		_hasFileCalls++;
+		return _files.contains(path);
+	}
+
+	int listMembers(Common::ArchiveMemberList &list) const override { return 0; }
+
+	const Common::ArchiveMemberPtr getMember(const Common::Path &path) const override {
+		return Common::ArchiveMemberPtr();
+	}
+
+	Common::SeekableReadStream *createReadStreamForMember(const Common::Path &path) const override {
+		_streamCalls++;
+		if (!_files.contains(path))
+			return nullptr;
+		return new Common::MemoryReadStream((const byte *)this, 1);
+	}
+
+	Common::HashMap<Common::Path, bool, Common::Path::IgnoreCase_Hash, Common::Path::IgnoreCase_EqualTo> _files;
+	mutable int _hasFileCalls, _streamCalls;
+};
+
+} // End of anonymous namespace
+
+class SearchSetTestSuite : public CxxTest::TestSuite {
+public:
+	void test_lookup_cache() {
+		Common::SearchSet set;
+		CountingArchive *first = new CountingArchive();
+		CountingArchive *second = new CountingArchive();
+		first->addFile("a.dat");
+		second->addFile("a.dat");
+		second->addFile("b.dat");
+		set.add("first", first, 1);
+		set.add("second", second, 0);
+
+		TS_ASSERT(set.hasFile("A.DAT"));
+		TS_ASSERT(set.hasFile("b.dat"));
+		TS_ASSERT(!set.hasFile("c.dat"));
+		int hasFileCalls = first->_hasFileCalls + second->_hasFileCalls;
+
+		// Found or missing, the archives aren't asked again
+		TS_ASSERT(set.hasFile("a.dat"));
+		TS_ASSERT(set.hasFile("B.dat"));
+		TS_ASSERT(!set.hasFile("C.dat"));
+		TS_ASSERT_EQUALS(first->_hasFileCalls + second->_hasFileCalls, hasFileCalls);
+
+		// Streams come from the first archive which has the file
+		Common::SeekableReadStream *stream = set.createReadStreamForMember("a.dat");
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(first->_streamCalls, 1);
+		TS_ASSERT_EQUALS(second->_streamCalls, 0);
+		delete stream;
+
+		TS_ASSERT(!set.createReadStreamForMember("c.dat"));
+		TS_ASSERT(!set.createReadStreamForMember("c.dat"));
+		TS_ASSERT_EQUALS(first->_streamCalls, 2);
+		TS_ASSERT_EQUALS(second->_streamCalls, 1);
+
+		stream = set.createReadStreamForMember("b.dat");
+		delete stream;
+		stream = set.createReadStreamForMember("b.dat");
+		TS_ASSERT(stream);
+		delete stream;
+		TS_ASSERT_EQUALS(first->_streamCalls, 3);
+		TS_ASSERT_EQUALS(second->_streamCalls, 3);
+	}
+
+	void test_lookup_invalidation() {
+		Common::SearchSet set;
+		CountingArchive *first = new CountingArchive();
+		set.add("first", first);
+		TS_ASSERT(!set.hasFile("c.dat"));
+
+		// Adding an archive makes missing files be looked up again
+		CountingArchive *second = new CountingArchive();
+		second->addFile("c.dat");
+		set.add("second", second);
+		TS_ASSERT(set.hasFile("c.dat"));
+
+		// So does changing the priorities
+		CountingArchive *third = new CountingArchive();
+		third->addFile("c.dat");
+		set.add("third", third, -1);
+		Common::Archive *container = nullptr;
+		set.getMember("c.dat", &container);
+		TS_ASSERT_EQUALS(container, second);
+		set.setPriority("third", 1);
+		set.getMember("c.dat", &container);
+		TS_ASSERT_EQUALS(container, third);
+
+		set.remove("third");
+		set.getMember("c.dat", &container);
+		TS_ASSERT_EQUALS(container, second);
+
+		// Changes to the contents of an archive need to be announced
+		TS_ASSERT(!set.hasFile("d.dat"));
+		first->addFile("d.dat");
+		TS_ASSERT(!set.hasFile("d.dat"));
+		Common::SearchSet::invalidateLookupCaches();
+		TS_ASSERT(set.hasFile("d.dat"));
+
+		// Search sets inside other search sets are invalidated too
+		Common::SearchSet *inner = new Common::SearchSet();
+		set.add("inner", inner, 2);
+		TS_ASSERT(!set.hasFile("e.dat"));
+		CountingArchive *fourth = new CountingArchive();
+		fourth->addFile("e.dat");
+		inner->add("fourth", fourth);
+		TS_ASSERT(set.hasFile("e.dat"));
+
+		set.clear();
+		TS_ASSERT(!set.hasFile("e.dat"));
+	}
+};
@@ -0,0 +1,341 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/algorithm.h"
+#include "common/threadpool.h"
+#include "../system/null_osystem.h"
+
+namespace {
+
+class SumJob : public Common::Job {
+public:
+	SumJob(uint first, uint last) : _first(first), _last(last), _sum(0) {}
+
+	void run() override {
+		for (uint i = _first; i < _last; ++i)
+			_sum += i;
+	}
+
+	uint _first, _last;
+	uint64 _sum;
+};
+
+class OrderJob : public Common::Job {
+public:
+	OrderJob(Common::Array<int> &order, int id) : _order(order), _id(id) {}
+
+	void run() override {
+		_order.push_back(_id);
+	}
+
+	Common::Array<int> &_order;
+	int _id;
+};
+
+struct CountRange {
+	Common::Array<byte> &_hits;
+	CountRange(Common::Array<byte> &hits) : _hits(hits) {}
+
+	void operator()(uint first, uint last) const {
+		for (uint i = first; i < last; ++i)
+			_hits[i]++;
+	}
+};
+
+// Blocks the worker running it until released
+class GateJob : public Common::Job {
+public:
+	GateJob() : _started(false), _open(false) {}
+
+	void run() override {
+		setFlag(_started);
+		while (!getFlag(_open))
+			g_system->delayMillis(1);
+	}
+
+	bool getFlag(const bool &flag) {
+		Common::StackLock lock(_mutex);
+		return flag;
+	}
+
+	void setFlag(bool &flag) {
+		Common::StackLock lock(_mutex);
+		flag = true;
+	}
+
+	bool waitStarted() {
+		for (uint i = 0; i < 5000 && !getFlag(_started); ++i)
+			g_system->delayMillis(1);
+		return getFlag(_started);
+	}
+
+	Common::Mutex _mutex;
+	bool _started, _open;
+};
+
+// Takes a while to run, and tells when it started and finished
+class SlowJob : public GateJob {
+public:
+	SlowJob() : _done(false) {}
+
+	void run() override {
+		setFlag(_started);
+		g_system->delayMillis(50);
+		setFlag(_done);
+	}
+
+	void reset() {
+		Common::StackLock lock(_mutex);
+		_started = _done = false;
+	}
+
+	bool _done;
+};
+
+// Records the order jobs ran in, from any thread
+class LockedOrderJob : public Common::Job {
+public:
+	LockedOrderJob(Common::Mutex &mutex, Common::Array<int> &order, int id) : _mutex(mutex), _order(order), _id(id) {}
+
+	void run() override {
+		Common::StackLock lock(_mutex);
+		_order.push_back(_id);
+	}
+
+	Common::Mutex &_mutex;
+	Common::Array<int> &_order;
+	int _id;
+};
+
+// Only finishes once the given number of these jobs run at the same time
+class RendezvousJob : public Common::Job {
+public:
+	RendezvousJob(Common::Mutex &mutex, uint &arrived, uint count) : _mutex(mutex), _arrived(arrived), _count(count), _met(false) {}
+
+	void run() override {
+		{
+			Common::StackLock lock(_mutex);
+			_arrived++;
+		}
+		for (uint i = 0; i < 5000; ++i) {
+			{
+				Common::StackLock lock(_mutex);
+				if (_arrived >= _count) {
+					_met = true;
+					return;
+				}
+			}
+			g_system->delayMillis(1);
+		}
+	}
+
+	Common::Mutex &_mutex;
+	uint &_arrived;
+	uint _count;
+	bool _met;
+};
+
+} // End of anonymous namespace
+
+class ThreadPoolTestSuite : public CxxTest::TestSuite {
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+#endif
+	}
+
+	void tearDown() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::uninstall_null_g_system();
+#endif
+	}
+
+	void test_jobs() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::ThreadPool pool;
+		SumJob a(0, 1000), b(1000, 2000);
+
+		pool.submit(&a);
+		pool.submit(&b, Common::kJobPriorityHigh);
+		pool.wait(&b);
+		pool.wait(&a);
+
+		TS_ASSERT_EQUALS(a._sum, 499500u);
+		TS_ASSERT_EQUALS(b._sum, 1499500u);
+
+		// Jobs can be submitted again once finished
+		a._first = 10;
+		a._last = 20;
+		a._sum = 0;
+		pool.submit(&a, Common::kJobPriorityLow);
+		pool.wait(&a);
+		TS_ASSERT_EQUALS(a._sum, 145u);
+#endif
+	}
+
+	void test_resubmit() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::ThreadPool pool(2);
+		if (!pool.getWorkerCount())
+			return;
+
+		// Waiting while the job runs sets up its semaphore
+		SlowJob job;
+		pool.submit(&job);
+		TS_ASSERT(job.waitStarted());
+		pool.wait(&job);
+		TS_ASSERT(job.getFlag(job._done));
+
+		// Nobody waits for it this time
+		job.reset();
+		pool.submit(&job);
+		for (uint i = 0; i < 5000 && !job.getFlag(job._done); ++i)
+			g_system->delayMillis(1);
+		TS_ASSERT(job.getFlag(job._done));
+		g_system->delayMillis(20);
+
+		// So nothing may be left over for this wait to take
+		job.reset();
+		pool.submit(&job);
+		TS_ASSERT(job.waitStarted());
+		pool.wait(&job);
+		TS_ASSERT(job.getFlag(job._done));
+#endif
+	}
+
+	void test_synchronous() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		// A single thread always runs jobs as they are submitted
+		Common::ThreadPool pool(1);
+		TS_ASSERT_EQUALS(pool.getWorkerCount(), 0u);
+
+		Common::Array<int> order;
+		OrderJob low(order, 1), high(order, 2);
+		pool.submit(&low, Common::kJobPriorityLow);
+		pool.submit(&high, Common::kJobPriorityHigh);
+
+		TS_ASSERT_EQUALS(order.size(), 2u);
+		TS_ASSERT_EQUALS(order[0], 1);
+		TS_ASSERT_EQUALS(order[1], 2);
+
+		pool.wait(&low);
+		pool.wait(&high);
+		TS_ASSERT_EQUALS(order.size(), 2u);
+#endif
+	}
+
+	void test_concurrent() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::ThreadPool pool(4);
+		if (!pool.getWorkerCount())
+			return;
+		TS_ASSERT_EQUALS(pool.getWorkerCount(), 3u);
+
+		// Every job waits for all the others, so they can only finish
+		// if each one runs on its own worker
+		Common::Mutex mutex;
+		uint arrived = 0;
+		RendezvousJob a(mutex, arrived, 3), b(mutex, arrived, 3), c(mutex, arrived, 3);
+		pool.submit(&a);
+		pool.submit(&b);
+		pool.submit(&c);
+		// Give the workers time to start them, so that wait() blocks on running jobs
+		g_system->delayMillis(10);
+		pool.wait(&a);
+		pool.wait(&b);
+		pool.wait(&c);
+		TS_ASSERT(a._met);
+		TS_ASSERT(b._met);
+		TS_ASSERT(c._met);
+#endif
+	}
+
+	void test_priority_order() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::ThreadPool pool(2);
+		if (!pool.getWorkerCount())
+			return;
+
+		// Keep the only worker busy while the other jobs are queued
+		GateJob gate;
+		pool.submit(&gate);
+		TS_ASSERT(gate.waitStarted());
+
+		Common::Mutex mutex;
+		Common::Array<int> order;
+		LockedOrderJob low(mutex, order, 1), normal(mutex, order, 2), high(mutex, order, 3), high2(mutex, order, 4);
+		pool.submit(&low, Common::kJobPriorityLow);
+		pool.submit(&normal, Common::kJobPriorityNormal);
+		pool.submit(&high, Common::kJobPriorityHigh);
+		pool.submit(&high2, Common::kJobPriorityHigh);
+
+		gate.setFlag(gate._open);
+		pool.wait(&gate);
+		// Waiting for the lowest priority job last lets the worker take them all
+		for (uint i = 0; i < 5000; ++i) {
+			{
+				Common::StackLock lock(mutex);
+				if (order.size() == 4)
+					break;
+			}
+			g_system->delayMillis(1);
+		}
+		pool.wait(&low);
+		pool.wait(&normal);
+		pool.wait(&high);
+		pool.wait(&high2);
+
+		TS_ASSERT_EQUALS(order.size(), 4u);
+		if (order.size() == 4) {
+			TS_ASSERT_EQUALS(order[0], 3);
+			TS_ASSERT_EQUALS(order[1], 4);
+			TS_ASSERT_EQUALS(order[2], 2);
+			TS_ASSERT_EQUALS(order[3], 1);
+		}
+#endif
+	}
+
+	void test_shutdown() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		// The jobs must outlive the pool
+		GateJob gate;
+		Common::Mutex mutex;
+		Common::Array<int> order;
+		LockedOrderJob first(mutex, order, 1), second(mutex, order, 2), third(mutex, order, 3);
+
+		{
+			Common::ThreadPool pool(2);
+			if (!pool.getWorkerCount())
+				return;
+
+			pool.submit(&gate);
+			TS_ASSERT(gate.waitStarted());
+			pool.submit(&first);
+			pool.submit(&second);
+			pool.submit(&third, Common::kJobPriorityLow);
+			gate.setFlag(gate._open);
+			// Destroying the pool runs the jobs still queued
+		}
+
+		// The worker and the destructor may both be running jobs, in any order
+		TS_ASSERT_EQUALS(order.size(), 3u);
+		TS_ASSERT(Common::find(order.begin(), order.end(), 1) != order.end());
+		TS_ASSERT(Common::find(order.begin(), order.end(), 2) != order.end());
+		TS_ASSERT(Common::find(order.begin(), order.end(), 3) != order.end());
+#endif
+	}
+
+	void test_parallel_for() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::ThreadPool pool;
+		Common::Array<byte> hits(1000, 0);
+
+		pool.parallelFor(0, hits.size(), CountRange(hits));
+		pool.parallelFor(100, 900, CountRange(hits), 64);
+		pool.parallelFor(500, 500, CountRange(hits));
+
+		for (uint i = 0; i < hits.size(); ++i)
+			TS_ASSERT_EQUALS(hits[i], (i >= 100 && i < 900) ? 2 : 1);
+#endif
+	}
+};
@@ -0,0 +1,102 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "glk/undo_store.h"
+
+class GlkUndoStoreTestSuite : public CxxTest::TestSuite {
+	// Builds a state from the previous one, changing a few scattered bytes
+	// and sometimes the size, so deltas contain both short and long skips
+	static Common::Array<byte> nextState(const Common::Array<byte> &prev, uint seed) {
+		uint32 size = prev.size();
+		if (seed % 3 == 1)
+			size += 37 * seed;
+		else if (seed % 3 == 2 && size > 1000)
+			size -= 29 * seed;
+
+		Common::Array<byte> state(size, 0);
+		for (uint32 i = 0; i < size; ++i)
+			state[i] = i < prev.size() ? prev[i] : (byte)(i * 7);
+		for (uint32 i = seed; i < size; i += 97 + seed * 131)
+			state[i] ^= (byte)(seed | 1);
+		// A change far past the previous one makes for a skip longer than 16K
+		if (size > 40000)
+			state[size - 1] ^= 0x5a;
+		return state;
+	}
+
+	static bool sameState(const Common::Array<byte> &a, const Common::Array<byte> &b) {
+		return a.size() == b.size() && (a.empty() || !memcmp(a.data(), b.data(), a.size()));
+	}
+
+public:
+	void test_round_trip() {
+		Glk::UndoStore store;
+		store.setLimits(1024 * 1024);
+		TS_ASSERT(store.empty());
+
+		Common::Array<Common::Array<byte> > states;
+		Common::Array<byte> state(50000, 0);
+		for (uint i = 0; i < 50000; ++i)
+			state[i] = (byte)(i ^ (i >> 8));
+
+		for (uint i = 0; i < 12; ++i) {
+			states.push_back(state);
+			store.push(state.data(), state.size());
+			TS_ASSERT_EQUALS(store.size(), i + 1);
+			state = nextState(state, i + 1);
+		}
+
+		// Identical states only cost an empty delta
+		store.push(states.back().data(), states.back().size());
+		states.push_back(states.back());
+
+		while (!states.empty()) {
+			TS_ASSERT(!store.empty());
+			TS_ASSERT(sameState(store.top(), states.back()));
+			store.pop();
+			states.pop_back();
+		}
+		TS_ASSERT(store.empty());
+	}
+
+	void test_trim() {
+		Glk::UndoStore store;
+		Common::Array<byte> state(4096, 0);
+
+		// Every delta changes 64 bytes, so is at least 64 bytes long
+		store.setLimits(300);
+		for (uint i = 0; i < 10; ++i) {
+			for (uint j = 0; j < 64; ++j)
+				state[j * 64 + i] ^= 0xff;
+			store.push(state.data(), state.size());
+		}
+		TS_ASSERT_LESS_THAN_EQUALS(store.size(), 5u);
+		TS_ASSERT_LESS_THAN_EQUALS(2u, store.size());
+		TS_ASSERT(sameState(store.top(), state));
+
+		// The oldest states are the ones dropped
+		const uint count = store.size();
+		for (uint i = 1; i < count; ++i) {
+			store.pop();
+			for (uint j = 0; j < 64; ++j)
+				state[j * 64 + 10 - i] ^= 0xff;
+			TS_ASSERT(sameState(store.top(), state));
+		}
+
+		// A state limit applies on top of the budget
+		store.clear();
+		store.setLimits(1024 * 1024, 3);
+		for (uint i = 0; i < 10; ++i) {
+			state[i] ^= 1;
+			store.push(state.data(), state.size());
+		}
+		TS_ASSERT_EQUALS(store.size(), 3u);
+
+		// The newest state is always kept
+		store.setLimits(0);
+		TS_ASSERT_EQUALS(store.size(), 1u);
+		TS_ASSERT(sameState(store.top(), state));
+		store.pop();
+		TS_ASSERT(store.empty());
+	}
+};
@@ -0,0 +1,88 @@
+#include <cxxtest/TestSuite.h>
+
+#include "scumm/imuse_digi/dimuse_engine.h"
+#include "scumm/imuse_digi/dimuse_internalmixer.h"
+#include "../../system/null_osystem.h"
+
+// The SIMD mixing loops must give exactly the same output as the C++ ones.
+class IMuseDigiInternalMixerTestSuite : public CxxTest::TestSuite {
+private:
+	void compareMix(int outChannels, int wordSize, int channelCount, int32 frames) {
+		// Every 8-bit and 16-bit value is mixed, random data for 12-bit
+		const int32 srcSize = frames * channelCount * 2;
+		uint8 *src = new uint8[srcSize];
+		uint32 seed = 1;
+		for (int32 i = 0; i < srcSize; i++) {
+			if (wordSize == 8)
+				src[i] = i;
+			else if (wordSize == 16)
+				src[i] = (i & 1) ? i >> 9 : i >> 1;
+			else
+				src[i] = (seed = seed * 1103515245 + 12345) >> 16;
+		}
+
+		const int mixBufSize = frames * 4 + 64;
+		uint8 *refBuf = new uint8[mixBufSize];
+		uint8 *simdBuf = new uint8[mixBufSize];
+
+		Scumm::IMuseDigiInternalMixer ref(nullptr, 22050, false, true);
+		Scumm::IMuseDigiInternalMixer simd(nullptr, 22050, false, true);
+		ref.init(16, outChannels, refBuf, mixBufSize, 0, 8);
+		simd.init(16, outChannels, simdBuf, mixBufSize, 0, 8);
+		ref.setUseSIMD(false);
+		simd.setUseSIMD(true);
+		ref.clearMixerBuffer();
+		simd.clearMixerBuffer();
+
+		static const int pans[] = { 0, 30, 64, 100, 127 };
+		for (int volume = 0; volume < 128; volume++) {
+			for (int i = 0; i < ARRAYSIZE(pans); i++) {
+				ref.mix(src, frames, wordSize, channelCount, frames, 3, volume, pans[i], false);
+				simd.mix(src, frames, wordSize, channelCount, frames, 3, volume, pans[i], false);
+			}
+		}
+
+		TS_ASSERT_EQUALS(memcmp(refBuf, simdBuf, mixBufSize), 0);
+
+		delete[] src;
+		delete[] refBuf;
+		delete[] simdBuf;
+	}
+
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+#endif
+	}
+
+	void tearDown() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::uninstall_null_g_system();
+#endif
+	}
+
+	void test_mono() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		compareMix(1, 8, 1, 1021);
+		compareMix(1, 12, 1, 1022);
+		compareMix(1, 16, 1, 65536 + 5);
+#endif
+	}
+
+	void test_stereo() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		compareMix(2, 8, 2, 1021);
+		compareMix(2, 12, 2, 1021);
+		compareMix(2, 16, 2, 32768 + 5);
+#endif
+	}
+
+	void test_convert_to_stereo() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		compareMix(2, 8, 1, 1021);
+		compareMix(2, 12, 1, 1021);
+		compareMix(2, 16, 1, 65536 + 5);
+#endif
+	}
+};
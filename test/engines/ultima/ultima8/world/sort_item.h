@@ -1,5 +1,7 @@
 #include <cxxtest/TestSuite.h>
+#include "common/array.h"
 #include "engines/ultima/ultima8/world/sort_item.h"
+#include "engines/ultima/ultima8/world/sort_item_list.h"
 
 /**
  * Test suite for the functions in engines/ultima/ultima8/world/sort_item.h
@@ -8,6 +10,59 @@
  * see the notes in sort_item.h
  */
 class U8SortItemTestSuite : public CxxTest::TestSuite {
+	// Sets up an item as ItemSorter::AddItem does, using the screenspace rect of its box
+	static void setUpItem(Ultima::Ultima8::SortItem &si, uint16 itemNum, const Ultima::Ultima8::Box &box, uint32 flags) {
+		si._itemNum = itemNum;
+		si.setBoxBounds(box, 0, 0);
+		si._solid = flags & 1;
+		si._occl = flags & 2;
+		si._land = flags & 4;
+		si._roof = flags & 8;
+		si._draw = true;
+		si._order = -1;
+	}
+
+	// Adds an item by comparing it with the whole list, as ItemSorter did before binning
+	static void addLinear(Common::Array<Ultima::Ultima8::SortItem *> &list, Ultima::Ultima8::SortItem *si) {
+		si->_occluded = false;
+		si->_depends.clear();
+
+		uint addpoint = list.size();
+		for (uint i = 0; i < list.size(); i++) {
+			Ultima::Ultima8::SortItem *si2 = list[i];
+			if (addpoint == list.size() && si->listLessThan(*si2))
+				addpoint = i;
+
+			if (si2->_occluded)
+				continue;
+
+			if (si->overlap(*si2)) {
+				if (si->below(*si2)) {
+					if (si2->_occl && si2->occludes(*si)) {
+						si->_occluded = true;
+						break;
+					} else {
+						si2->_depends.insert_sorted(si);
+					}
+				} else {
+					if (si->_occl && si->occludes(*si2))
+						si2->_occluded = true;
+					else
+						si->_depends.insert_sorted(si2);
+				}
+			}
+		}
+
+		list.insert_at(addpoint, si);
+	}
+
+	static Common::Array<uint16> dependencies(const Ultima::Ultima8::SortItem &si) {
+		Common::Array<uint16> items;
+		for (Ultima::Ultima8::SortItem::DependsList::iterator it = si._depends.begin(); it != si._depends.end(); ++it)
+			items.push_back((*it)->_itemNum);
+		return items;
+	}
+
 	public:
 	U8SortItemTestSuite() {
 	}
@@ -869,4 +924,51 @@ class U8SortItemTestSuite : public CxxTest::TestSuite {
 		TS_ASSERT(!si1.overlap(si2));
 		TS_ASSERT(!si2.overlap(si1));
 	}
+
+	/**
+	 * The display list built with screenspace bins has the same order,
+	 * occlusion and dependencies as comparing each new item with the
+	 * whole list, for many overlapping items spanning several bins
+	 */
+	void test_binned_sort_matches_linear_sort() {
+		static const uint kItems = 300;
+		Ultima::Ultima8::SortItem reference[kItems], binned[kItems];
+		Common::Array<Ultima::Ultima8::SortItem *> list;
+
+		Ultima::Ultima8::SortItemList sorted;
+		sorted.reset(Common::Rect32(-320, -240, 320, 240));
+
+		uint32 seed = 12345;
+		for (uint i = 0; i < kItems; i++) {
+			seed = seed * 1103515245 + 12345;
+			const int x = (int)((seed >> 4) % 32) * 32;
+			const int y = (int)((seed >> 9) % 32) * 32;
+			const int z = (int)((seed >> 14) % 6) * 8;
+			const int xd = 32 << ((seed >> 17) % 3);
+			const int yd = 32 << ((seed >> 19) % 3);
+			const int zd = (int)((seed >> 21) % 5) * 8;
+			const Ultima::Ultima8::Box box(x, y, z, xd, yd, zd);
+			const uint32 flags = seed >> 24;
+
+			setUpItem(reference[i], i + 1, box, flags);
+			addLinear(list, &reference[i]);
+			setUpItem(binned[i], i + 1, box, flags);
+			sorted.add(&binned[i]);
+		}
+
+		uint count = 0, occluded = 0;
+		for (const Ultima::Ultima8::SortItem *si = sorted.front(); si != nullptr; si = si->_next, count++) {
+			if (count >= list.size())
+				break;
+			TS_ASSERT_EQUALS(si->_itemNum, list[count]->_itemNum);
+			TS_ASSERT_EQUALS(si->_occluded, list[count]->_occluded);
+			TS_ASSERT(dependencies(*si) == dependencies(*list[count]));
+			if (si->_occluded)
+				occluded++;
+		}
+		TS_ASSERT_EQUALS(count, kItems);
+
+		// Make sure the items did overlap and occlude each other
+		TS_ASSERT_LESS_THAN(0u, occluded);
+	}
 };
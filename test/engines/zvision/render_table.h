@@ -0,0 +1,199 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "common/system.h"
+#include "math/utils.h"
+#include "zvision/graphics/render_table.h"
+#include "../../system/null_osystem.h"
+
+/**
+ * Compares the fixed point render table against the floating point
+ * implementation it replaced.
+ */
+class ZVisionRenderTableTestSuite : public CxxTest::TestSuite {
+	static const int kColumns = 160;
+	static const int kRows = 120;
+
+	// Offsets as computed by the floating point generator
+	Common::Array<float> _refX, _refY;
+
+	void generateReference(bool tilt, float fovDegrees, float scale) {
+		_refX.resize(kColumns * kRows);
+		_refY.resize(kColumns * kRows);
+
+		const uint halfRows = (kRows - 1) / 2;
+		const uint halfColumns = (kColumns - 1) / 2;
+		const float halfWidth = (float)kColumns / 2.0f - 0.5f;
+		const float halfHeight = (float)kRows / 2.0f - 0.5f;
+		const float fov = Math::deg2rad<float>(fovDegrees);
+
+		const uint halfPolar = tilt ? halfRows : halfColumns;
+		const uint halfLinear = tilt ? halfColumns : halfRows;
+		const float halfPolarSize = tilt ? halfHeight : halfWidth;
+		const float halfLinearSize = tilt ? halfWidth : halfHeight;
+		const float cylinderRadius = (halfLinearSize + 0.5f) / tan(fov);
+
+		for (uint polar = 0; polar <= halfPolar; ++polar) {
+			const float alpha = atan(((float)polar - halfPolarSize) / cylinderRadius);
+			const float polarInCylinder = (cylinderRadius * scale * alpha) + halfPolarSize;
+			const float cosAlpha = cos(alpha);
+			for (uint linear = 0; linear <= halfLinear; ++linear) {
+				const float linearInCylinder = halfLinearSize + ((float)linear - halfLinearSize) * cosAlpha;
+				const float polarOffset = polarInCylinder - polar;
+				const float linearOffset = linearInCylinder - linear;
+				const uint x = tilt ? linear : polar;
+				const uint y = tilt ? polar : linear;
+				const float xOffset = tilt ? linearOffset : polarOffset;
+				const float yOffset = tilt ? polarOffset : linearOffset;
+
+				// The float version mirrored a quarter of the table by negating the offsets
+				setReference(x, y, xOffset, yOffset);
+				setReference(x, kRows - 1 - y, xOffset, -yOffset);
+				setReference(kColumns - 1 - x, y, -xOffset, yOffset);
+				setReference(kColumns - 1 - x, kRows - 1 - y, -xOffset, -yOffset);
+			}
+		}
+	}
+
+	void setReference(uint x, uint y, float xOffset, float yOffset) {
+		_refX[y * kColumns + x] = xOffset;
+		_refY[y * kColumns + x] = yOffset;
+	}
+
+	static bool nearMidpoint(float coord) {
+		// Offsets are rounded to 1/32 pixel, so nearest neighbour may pick
+		// either pixel when the exact coordinate is that close to a midpoint
+		const float frac = coord - floor(coord);
+		return fabs(frac - 0.5f) <= 1.0f / 32;
+	}
+
+	void checkNearest(ZVision::RenderTable &table) {
+		// Each source pixel holds its own index, so the output tells which one was sampled
+		Graphics::Surface src, dst;
+		const Graphics::PixelFormat format(2, 5, 5, 5, 0, 10, 5, 0, 0);
+		src.create(kColumns, kRows, format);
+		dst.create(kColumns, kRows, format);
+		for (int y = 0; y < kRows; ++y)
+			for (int x = 0; x < kColumns; ++x)
+				*(uint16 *)src.getBasePtr(x, y) = y * kColumns + x;
+
+		table.mutateImage(&dst, &src, false);
+
+		for (int y = 0; y < kRows; ++y) {
+			for (int x = 0; x < kColumns; ++x) {
+				const uint16 index = *(const uint16 *)dst.getBasePtr(x, y);
+				const float refX = x + _refX[y * kColumns + x];
+				const float refY = y + _refY[y * kColumns + x];
+				// The float version rounded exact midpoints towards the top left
+				const int expectedX = (int)floor(refX) + (refX - floor(refX) > 0.5f ? 1 : 0);
+				const int expectedY = (int)floor(refY) + (refY - floor(refY) > 0.5f ? 1 : 0);
+				if (!nearMidpoint(refX))
+					TS_ASSERT_EQUALS(index % kColumns, expectedX);
+				if (!nearMidpoint(refY))
+					TS_ASSERT_EQUALS(index / kColumns, expectedY);
+
+				const Common::Point flat = table.convertWarpedCoordToFlatCoord(Common::Point(x, y));
+				TS_ASSERT_EQUALS(flat.x, index % kColumns);
+				TS_ASSERT_EQUALS(flat.y, index / kColumns);
+			}
+		}
+
+		src.free();
+		dst.free();
+	}
+
+	void checkBilinear(ZVision::RenderTable &table) {
+		Graphics::Surface src, dst;
+		const Graphics::PixelFormat format(2, 5, 5, 5, 0, 10, 5, 0, 0);
+		src.create(kColumns, kRows, format);
+		dst.create(kColumns, kRows, format);
+		// Smooth gradients in all three channels
+		for (int y = 0; y < kRows; ++y) {
+			for (int x = 0; x < kColumns; ++x) {
+				const uint r = x * 31 / (kColumns - 1);
+				const uint g = y * 31 / (kRows - 1);
+				const uint b = ((x + y) * 31) / (kColumns + kRows - 2);
+				*(uint16 *)src.getBasePtr(x, y) = r | (g << 5) | (b << 10);
+			}
+		}
+
+		table.mutateImage(&dst, &src, true);
+
+		for (int y = 0; y < kRows; ++y) {
+			for (int x = 0; x < kColumns; ++x) {
+				// Bilinear filter as done by the float version
+				const float srcX = x + _refX[y * kColumns + x];
+				const float srcY = y + _refY[y * kColumns + x];
+				const int left = (int)floor(srcX), right = (int)ceil(srcX);
+				const int top = (int)floor(srcY), bottom = (int)ceil(srcY);
+				const float fX = srcX - left, fY = srcY - top;
+				const float w[4] = { (1 - fX) * (1 - fY), fX * (1 - fY), (1 - fX) * fY, fX * fY };
+				const uint16 p[4] = {
+					*(const uint16 *)src.getBasePtr(left, top), *(const uint16 *)src.getBasePtr(right, top),
+					*(const uint16 *)src.getBasePtr(left, bottom), *(const uint16 *)src.getBasePtr(right, bottom)
+				};
+				float expected[3] = { 0.0f, 0.0f, 0.0f };
+				for (int i = 0; i < 4; ++i)
+					for (int c = 0; c < 3; ++c)
+						expected[c] += w[i] * ((p[i] >> (c * 5)) & 0x1f);
+
+				const uint16 pixel = *(const uint16 *)dst.getBasePtr(x, y);
+				for (int c = 0; c < 3; ++c) {
+					const int value = (pixel >> (c * 5)) & 0x1f;
+					TS_ASSERT_LESS_THAN_EQUALS(fabs(value - expected[c]), 1.0f);
+				}
+			}
+		}
+
+		src.free();
+		dst.free();
+	}
+
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+#endif
+	}
+
+	void tearDown() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::uninstall_null_g_system();
+#endif
+	}
+
+	void test_panorama() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		ZVision::RenderTable table(g_system, kColumns, kRows, Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0));
+		table.setRenderState(ZVision::RenderTable::PANORAMA);
+		table.generateRenderTable();
+		generateReference(false, 27.0f, 0.55f);
+		checkNearest(table);
+		checkBilinear(table);
+
+		// Changing the scale alone only regenerates part of the table
+		table.setPanoramaScale(0.7f);
+		table.generateRenderTable();
+		generateReference(false, 27.0f, 0.7f);
+		checkNearest(table);
+		checkBilinear(table);
+#endif
+	}
+
+	void test_tilt() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		ZVision::RenderTable table(g_system, kColumns, kRows, Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0));
+		table.setRenderState(ZVision::RenderTable::TILT);
+		table.generateRenderTable();
+		generateReference(true, 27.0f, 0.65f);
+		checkNearest(table);
+		checkBilinear(table);
+
+		table.setTiltFoV(35.0f);
+		table.generateRenderTable();
+		generateReference(true, 35.0f, 0.65f);
+		checkNearest(table);
+		checkBilinear(table);
+#endif
+	}
+};
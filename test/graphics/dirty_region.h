@@ -0,0 +1,124 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/dirty_region.h"
+
+class DirtyRegionTestSuite : public CxxTest::TestSuite {
+	// Checks that the rects don't overlap, and returns the area they cover
+	static int checkRects(const Common::List<Common::Rect> &rects) {
+		int area = 0;
+		for (Common::List<Common::Rect>::const_iterator i = rects.begin(); i != rects.end(); ++i) {
+			TS_ASSERT(!i->isEmpty());
+			area += i->width() * i->height();
+
+			Common::List<Common::Rect>::const_iterator j = i;
+			for (++j; j != rects.end(); ++j)
+				TS_ASSERT(!i->intersects(*j));
+		}
+		return area;
+	}
+
+public:
+	void test_empty() {
+		Graphics::DirtyRegion region;
+		region.setSize(320, 200);
+		TS_ASSERT(region.empty());
+
+		Common::List<Common::Rect> rects;
+		region.getRects(rects);
+		TS_ASSERT(rects.empty());
+
+		// Nothing inside the area
+		region.addRect(Common::Rect(320, 0, 400, 10));
+		region.addRect(Common::Rect(-10, -10, 0, 0));
+		region.addRect(Common::Rect(10, 10, 10, 20));
+		TS_ASSERT(region.empty());
+	}
+
+	void test_tiles() {
+		Graphics::DirtyRegion region(8, 8);
+		region.setSize(320, 200);
+
+		region.addRect(Common::Rect(3, 3, 5, 5));
+		TS_ASSERT(!region.empty());
+
+		Common::List<Common::Rect> rects;
+		region.getRects(rects);
+		TS_ASSERT_EQUALS(rects.size(), 1u);
+		TS_ASSERT_EQUALS(rects.front(), Common::Rect(0, 0, 8, 8));
+
+		// Clipped to the size at the edges
+		region.clear();
+		TS_ASSERT(region.empty());
+		region.addRect(Common::Rect(315, 195, 330, 210));
+		rects.clear();
+		region.getRects(rects);
+		TS_ASSERT_EQUALS(rects.size(), 1u);
+		TS_ASSERT_EQUALS(rects.front(), Common::Rect(312, 192, 320, 200));
+	}
+
+	void test_merge() {
+		Graphics::DirtyRegion region(8, 8);
+		region.setSize(320, 200);
+
+		// Many overlapping small sprites make up a single rect
+		for (int i = 0; i < 100; i++)
+			region.addRect(Common::Rect(16 + (i % 10) * 4, 16 + (i / 10) * 4, 24 + (i % 10) * 4, 24 + (i / 10) * 4));
+
+		Common::List<Common::Rect> rects;
+		region.getRects(rects);
+		TS_ASSERT_EQUALS(rects.size(), 1u);
+		TS_ASSERT_EQUALS(rects.front(), Common::Rect(16, 16, 64, 64));
+
+		// An L shape, with a separate rect to the side
+		region.clear();
+		region.addRect(Common::Rect(0, 0, 16, 32));
+		region.addRect(Common::Rect(0, 32, 48, 40));
+		region.addRect(Common::Rect(104, 8, 112, 24));
+		rects.clear();
+		region.getRects(rects);
+		TS_ASSERT_EQUALS(rects.size(), 3u);
+		TS_ASSERT_EQUALS(checkRects(rects), 16 * 32 + 48 * 8 + 8 * 16);
+
+		// Every other tile of a checkerboard
+		region.clear();
+		for (int y = 0; y < 200; y += 8)
+			for (int x = (y / 8) & 1 ? 8 : 0; x < 320; x += 16)
+				region.addRect(Common::Rect(x, y, x + 8, y + 8));
+		rects.clear();
+		region.getRects(rects);
+		TS_ASSERT_EQUALS(rects.size(), 25u * 20u);
+		TS_ASSERT_EQUALS(checkRects(rects), 320 * 200 / 2);
+	}
+
+	void test_mark_all() {
+		Graphics::DirtyRegion region(16, 16);
+		region.setSize(100, 50);
+		region.addRect(Common::Rect(20, 20, 30, 30));
+		region.markAll();
+
+		Common::List<Common::Rect> rects;
+		region.getRects(rects);
+		TS_ASSERT_EQUALS(rects.size(), 1u);
+		TS_ASSERT_EQUALS(rects.front(), Common::Rect(0, 0, 100, 50));
+	}
+
+	void test_resize() {
+		Graphics::DirtyRegion region(8, 8);
+		region.setSize(64, 64);
+		region.addRect(Common::Rect(8, 8, 16, 16));
+		region.addRect(Common::Rect(48, 48, 64, 64));
+
+		// Areas still inside are kept
+		region.setSize(32, 128);
+		Common::List<Common::Rect> rects;
+		region.getRects(rects);
+		TS_ASSERT_EQUALS(rects.size(), 1u);
+		TS_ASSERT_EQUALS(rects.front(), Common::Rect(8, 8, 16, 16));
+
+		region.addRect(Common::Rect(0, 96, 32, 128));
+		rects.clear();
+		region.getRects(rects);
+		TS_ASSERT_EQUALS(rects.size(), 2u);
+		TS_ASSERT_EQUALS(checkRects(rects), 8 * 8 + 32 * 32);
+	}
+};
@@ -0,0 +1,185 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/system.h"
+#include "graphics/fontman.h"
+#include "graphics/macgui/macwindowmanager.h"
+#include "graphics/macgui/mactext.h"
+#include "graphics/managed_surface.h"
+#include "../system/null_osystem.h"
+
+/**
+ * Checks that color changes on MacText only repaint what they affect,
+ * that font changes repaint everything, and that the result matches a
+ * full repaint.
+ */
+class MacTextTestSuite : public CxxTest::TestSuite {
+#if NULL_OSYSTEM_IS_AVAILABLE
+	class TestMacText : public Graphics::MacText {
+	public:
+		TestMacText(const Common::U32String &s, Graphics::MacWindowManager *wm, const Graphics::Font *font, uint32 fgcolor, uint32 bgcolor, int maxWidth) :
+			Graphics::MacText(s, wm, font, fgcolor, bgcolor, maxWidth, Graphics::kTextAlignLeft) {}
+
+		int getRowY(int row) { return _canvas._text[row].y; }
+
+		int getParagraphRow(int paragraph) {
+			int row = 0;
+			for (; paragraph > 0; row++) {
+				if (_canvas._text[row].paragraphEnd)
+					paragraph--;
+			}
+			return row;
+		}
+
+		// Character index of the start of the row, as taken by setTextColor() and friends
+		int getRowIndex(int row) {
+			int index = 0;
+			for (int i = 0; i < row; i++)
+				index += _canvas.getLineCharWidth(i);
+			return index;
+		}
+	};
+
+	Graphics::MacWindowManager *_wm;
+	uint32 _black, _white;
+
+	static bool sameRows(const Graphics::ManagedSurface &a, int aY, const Graphics::ManagedSurface &b, int bY, int height) {
+		const int bytes = MIN(a.w, b.w) * a.format.bytesPerPixel;
+		for (int y = 0; y < height; y++) {
+			if (memcmp(a.getBasePtr(0, aY + y), b.getBasePtr(0, bY + y), bytes))
+				return false;
+		}
+		return true;
+	}
+
+	static bool hasColor(const Graphics::ManagedSurface &surface, int top, int bottom, uint32 color) {
+		for (int y = top; y < bottom; y++) {
+			for (int x = 0; x < surface.w; x++) {
+				if (*(const uint32 *)surface.getBasePtr(x, y) == color)
+					return true;
+			}
+		}
+		return false;
+	}
+
+	static void setPixel(Graphics::ManagedSurface *surface, int x, int y, uint32 color) {
+		*(uint32 *)surface->getBasePtr(x, y) = color;
+	}
+
+	static uint32 getPixel(const Graphics::ManagedSurface *surface, int x, int y) {
+		return *(const uint32 *)surface->getBasePtr(x, y);
+	}
+
+	// Repaints the whole text and checks that nothing changes
+	static void checkFullRepaint(TestMacText &text) {
+		Graphics::ManagedSurface partial;
+		partial.copyFrom(*text.getSurface());
+
+		text._fullRefresh = true;
+		text.render();
+
+		TS_ASSERT_EQUALS(partial.h, text.getSurface()->h);
+		TS_ASSERT(sameRows(partial, 0, *text.getSurface(), 0, partial.h));
+		partial.free();
+	}
+#endif
+
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+		_wm = new Graphics::MacWindowManager(Graphics::kWMModeNoDesktop | Graphics::kWMModeForceBuiltinFonts |
+			Graphics::kWMModeNoCursorOverride | Graphics::kWMNoScummVMWallpaper | Graphics::kWMMode32bpp);
+		_black = _wm->_pixelformat.RGBToColor(0, 0, 0);
+		_white = _wm->_pixelformat.RGBToColor(0xff, 0xff, 0xff);
+#endif
+	}
+
+	void tearDown() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		delete _wm;
+		Common::uninstall_null_g_system();
+#endif
+	}
+
+	void test_font_change_repaints_all() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		TestMacText text(Common::U32String("First\nThis paragraph is long enough to be wrapped onto several rows\nThird"), _wm,
+			FontMan.getFontByUsage(Graphics::FontManager::kConsoleFont), _black, _white, 160);
+		const uint32 red = _wm->_pixelformat.RGBToColor(0xff, 0, 0);
+		const int middle = text.getParagraphRow(1), last = text.getParagraphRow(2);
+		const int rows = text.getLineCount();
+
+		// A repaint clears this
+		setPixel(text.getSurface(), text.getSurface()->w - 1, 0, red);
+
+		// The text is repainted, but not wrapped again
+		text.setTextSize(14, text.getRowIndex(middle), text.getRowIndex(last));
+
+		TS_ASSERT_EQUALS(getPixel(text.getSurface(), text.getSurface()->w - 1, 0), _white);
+		TS_ASSERT_EQUALS(text.getLineCount(), rows);
+		TS_ASSERT_EQUALS(text.getParagraphRow(2), last);
+		TS_ASSERT(!text._fullRefresh);
+		TS_ASSERT_EQUALS(text._dirtyFrom, -1);
+
+		checkFullRepaint(text);
+#endif
+	}
+
+	void test_recolor_repaints_only_its_rows() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		TestMacText text(Common::U32String("First\nSecond\nThird"), _wm, FontMan.getFontByUsage(Graphics::FontManager::kConsoleFont), _black, _white, 160);
+		const uint32 red = _wm->_pixelformat.RGBToColor(0xff, 0, 0);
+		const int middle = text.getParagraphRow(1), last = text.getParagraphRow(2);
+		const int middleY = text.getRowY(middle), lastY = text.getRowY(last);
+		Graphics::ManagedSurface *surface = text.getSurface();
+
+		// A repaint would clear these
+		const int right = surface->w - 1;
+		setPixel(surface, right, 0, red);
+		setPixel(surface, right, lastY, red);
+
+		text.setTextColor(red, text.getRowIndex(middle), text.getRowIndex(last));
+
+		TS_ASSERT_EQUALS(getPixel(surface, right, 0), red);
+		TS_ASSERT_EQUALS(getPixel(surface, right, lastY), red);
+		TS_ASSERT(hasColor(*surface, middleY, lastY, red));
+		TS_ASSERT(!hasColor(*surface, middleY, lastY, _black));
+		TS_ASSERT(hasColor(*surface, lastY, surface->h, _black));
+		TS_ASSERT(!text._fullRefresh);
+		TS_ASSERT_EQUALS(text._dirtyFrom, -1);
+
+		setPixel(surface, right, 0, _white);
+		setPixel(surface, right, lastY, _white);
+		checkFullRepaint(text);
+#endif
+	}
+
+	void test_noop_setters() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		const Graphics::Font *font = FontMan.getFontByUsage(Graphics::FontManager::kConsoleFont);
+		TestMacText text(Common::U32String("First\nSecond\nThird"), _wm, font, _black, _white, 160);
+		const uint32 red = _wm->_pixelformat.RGBToColor(0xff, 0, 0);
+		const int middle = text.getParagraphRow(1), last = text.getParagraphRow(2);
+		Graphics::ManagedSurface *surface = text.getSurface();
+
+		const int right = surface->w - 1, bottom = surface->h - 1;
+		setPixel(surface, right, 0, red);
+		setPixel(surface, right, bottom, red);
+
+		// None of these change anything, so nothing gets laid out or repainted
+		text.setColors(_black, _white);
+		text.setTextColor(_black, text.getRowIndex(middle), text.getRowIndex(last));
+		text.enforceTextFont(0);
+		text.setTextSize(font->getFontHeight());
+		text.setTextSize(font->getFontHeight(), text.getRowIndex(middle), text.getRowIndex(last));
+		text.enforceTextSlant(Graphics::kMacFontRegular);
+		text.setInterLinear(0);
+
+		TS_ASSERT_EQUALS(getPixel(surface, right, 0), red);
+		TS_ASSERT_EQUALS(getPixel(surface, right, bottom), red);
+		TS_ASSERT(!text._fullRefresh);
+		TS_ASSERT_EQUALS(text._dirtyFrom, -1);
+		TS_ASSERT_EQUALS(text.getSurface(), surface);
+#endif
+	}
+};
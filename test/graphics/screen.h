@@ -0,0 +1,58 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/screen.h"
+
+class ScreenTestSuite : public CxxTest::TestSuite {
+	class TestScreen : public Graphics::Screen {
+	public:
+		TestScreen(int width, int height) : Graphics::Screen(width, height) {}
+
+		// Merges the dirty areas as update() does, and returns the area they cover
+		int getDirtyArea(Common::Rect &bounds) {
+			mergeDirtyRects();
+
+			int area = 0;
+			bounds = Common::Rect();
+			for (Common::List<Common::Rect>::const_iterator i = _dirtyRects.begin(); i != _dirtyRects.end(); ++i) {
+				area += i->width() * i->height();
+				if (i == _dirtyRects.begin())
+					bounds = *i;
+				else
+					bounds.extend(*i);
+			}
+			return area;
+		}
+
+		void addToDirtyRects(const Common::Rect &r) { _dirtyRects.push_back(r); }
+	};
+
+public:
+	void test_dirty_area_follows_size() {
+		TestScreen screen(320, 200);
+		Common::Rect bounds;
+
+		// A new surface is all dirty
+		TS_ASSERT_EQUALS(screen.getDirtyArea(bounds), 320 * 200);
+		screen.clearDirtyRects();
+
+		screen.addDirtyRect(Common::Rect(304, 184, 320, 200));
+		TS_ASSERT_EQUALS(screen.getDirtyArea(bounds), 16 * 16);
+
+		// Dirty areas left from the larger screen are dropped
+		screen.addDirtyRect(Common::Rect(304, 184, 320, 200));
+		screen.create(160, 100);
+		TS_ASSERT_EQUALS(screen.getDirtyArea(bounds), 160 * 100);
+		TS_ASSERT_EQUALS(bounds, Common::Rect(0, 0, 160, 100));
+
+		// As are rects added to the list directly
+		screen.clearDirtyRects();
+		screen.addToDirtyRects(Common::Rect(0, 0, 640, 480));
+		TS_ASSERT_EQUALS(screen.getDirtyArea(bounds), 160 * 100);
+		TS_ASSERT_EQUALS(bounds, Common::Rect(0, 0, 160, 100));
+
+		// And it grows again with the screen
+		screen.create(640, 480);
+		TS_ASSERT_EQUALS(screen.getDirtyArea(bounds), 640 * 480);
+		TS_ASSERT_EQUALS(bounds, Common::Rect(0, 0, 640, 480));
+	}
+};
@@ -0,0 +1,60 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "gui/recorderbenchmark.h"
+
+class RecorderBenchmarkTestSuite : public CxxTest::TestSuite {
+	static Common::String report(const GUI::RecorderBenchmark &benchmark, const char *target, uint64 now) {
+		Common::MemoryWriteStreamDynamic out(DisposeAfterUse::YES);
+		benchmark.writeReport(out, target, "game.rec", now);
+		return Common::String((const char *)out.getData(), out.size());
+	}
+
+public:
+	void test_empty() {
+		GUI::RecorderBenchmark benchmark;
+		benchmark.start(500);
+		TS_ASSERT_EQUALS(benchmark.getFrameCount(), 0u);
+
+		const Common::String json = report(benchmark, "target", 500);
+		TS_ASSERT(json.contains("\t\"frames\": 0,\n"));
+		TS_ASSERT(json.contains("\t\"fps\": 0.00,\n"));
+		TS_ASSERT(!json.contains("frameTimeUs"));
+		TS_ASSERT(json.contains("\t\"perFrame\": [\n\t]\n}\n"));
+	}
+
+	void test_frames() {
+		GUI::RecorderBenchmark benchmark;
+		benchmark.start(1000);
+
+		// Each frame spends 1000us in the engine, and i us rendering
+		uint64 now = 1000;
+		for (uint i = 0; i < 100; i++) {
+			now += 1000;
+			benchmark.beginRender(now);
+			now += i;
+			benchmark.endFrame(i * 16, now);
+		}
+		TS_ASSERT_EQUALS(benchmark.getFrameCount(), 100u);
+
+		TS_ASSERT_EQUALS(benchmark.getSummary(now),
+			"frames=100 gametime=1584ms walltime=104ms engine=100ms render=4ms fps=952.8");
+
+		const Common::String json = report(benchmark, "a\"b\\c", now);
+		TS_ASSERT(json.contains("\t\"target\": \"a\\\"b\\\\c\",\n"));
+		TS_ASSERT(json.contains("\t\"record\": \"game.rec\",\n"));
+		TS_ASSERT(json.contains("\t\"frames\": 100,\n"));
+		TS_ASSERT(json.contains("\t\"gameTimeMs\": 1584,\n"));
+		TS_ASSERT(json.contains("\t\"wallTimeUs\": 104950,\n"));
+		TS_ASSERT(json.contains("\t\"engineTimeUs\": 100000,\n"));
+		TS_ASSERT(json.contains("\t\"renderTimeUs\": 4950,\n"));
+		TS_ASSERT(json.contains("\t\"fps\": 952.83,\n"));
+		TS_ASSERT(json.contains("{ \"min\": 1000, \"median\": 1050, \"p95\": 1095, \"p99\": 1099, \"max\": 1099 }"));
+		TS_ASSERT(json.contains("\t\"perFrame\": [\n\t\t[0, 1000, 0],\n\t\t[16, 1000, 1],"));
+		TS_ASSERT(json.contains(",\n\t\t[1584, 1000, 99]\n\t]\n}\n"));
+
+		// Starting again forgets the frames
+		benchmark.start(now);
+		TS_ASSERT_EQUALS(benchmark.getFrameCount(), 0u);
+	}
+};
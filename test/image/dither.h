@@ -0,0 +1,219 @@
+#include <cxxtest/TestSuite.h>
+
+#include "image/codecs/dither.h"
+#include "graphics/surface.h"
+#include "common/memstream.h"
+#include "common/threadpool.h"
+#include "../system/null_osystem.h"
+
+namespace {
+
+uint32 hashBytes(const byte *data, uint size) {
+	uint32 hash = 2166136261u;
+	for (uint i = 0; i < size; i++)
+		hash = (hash ^ data[i]) * 16777619u;
+	return hash;
+}
+
+// Pseudo random palette, so all of the table is exercised
+void makeRandomPalette(byte *palette, uint32 seed) {
+	for (int i = 0; i < 256 * 3; i++) {
+		seed = seed * 1103515245 + 12345;
+		palette[i] = (seed >> 16) & 0xFF;
+	}
+}
+
+// A 6x6x6 color cube with black and white, like the Mac system palettes
+void makeCubePalette(byte *palette) {
+	memset(palette, 0, 256 * 3);
+	for (int i = 0; i < 216; i++) {
+		palette[i * 3 + 0] = 0xFF - (i / 36) * 0x33;
+		palette[i * 3 + 1] = 0xFF - ((i / 6) % 6) * 0x33;
+		palette[i * 3 + 2] = 0xFF - (i % 6) * 0x33;
+	}
+	for (int i = 216; i < 255; i++)
+		palette[i * 3 + 0] = palette[i * 3 + 1] = palette[i * 3 + 2] = (i - 216) * 6;
+}
+
+class TestFrameCodec : public Image::Codec {
+public:
+	TestFrameCodec(const Graphics::PixelFormat &format) : _format(format) {
+		_frame.create(13, 7, format);
+		for (int y = 0; y < _frame.h; y++) {
+			for (int x = 0; x < _frame.w; x++) {
+				uint32 color;
+				if (format.isCLUT8())
+					color = (x * 7 + y * 29) & 0xFF;
+				else
+					color = format.RGBToColor(x * 19, y * 37, (x * y * 11) & 0xFF);
+				if (format.bytesPerPixel == 1)
+					*(byte *)_frame.getBasePtr(x, y) = color;
+				else if (format.bytesPerPixel == 2)
+					*(uint16 *)_frame.getBasePtr(x, y) = color;
+				else
+					*(uint32 *)_frame.getBasePtr(x, y) = color;
+			}
+		}
+	}
+
+	~TestFrameCodec() override {
+		_frame.free();
+	}
+
+	const Graphics::Surface *decodeFrame(Common::SeekableReadStream &stream) override { return &_frame; }
+	Graphics::PixelFormat getPixelFormat() const override { return _format; }
+
+private:
+	Graphics::PixelFormat _format;
+	Graphics::Surface _frame;
+};
+
+uint32 ditherFrame(const Graphics::PixelFormat &format, const byte *palette, const byte *srcPalette = nullptr) {
+	Image::DitherCodec codec(new TestFrameCodec(format));
+	codec.setDither(Image::Codec::kDitherTypeQT, palette);
+	codec.setPalette(srcPalette);
+
+	Common::MemoryReadStream stream(nullptr, 0);
+	const Graphics::Surface *frame = codec.decodeFrame(stream);
+	if (!frame || !frame->format.isCLUT8())
+		return 0;
+
+	uint32 hash = 2166136261u;
+	for (int y = 0; y < frame->h; y++) {
+		const byte *row = (const byte *)frame->getBasePtr(0, y);
+		for (int x = 0; x < frame->w; x++)
+			hash = (hash ^ row[x]) * 16777619u;
+	}
+	return hash;
+}
+
+} // End of anonymous namespace
+
+class DitherTestSuite : public CxxTest::TestSuite {
+	enum {
+		kPalettes = 12
+	};
+
+	// Gets the table of palette i % kPalettes for each i, and checks it
+	struct CreateTables {
+		Image::QuickTimeDitherTableCache &_cache;
+		const uint32 *_expected;
+		bool *_same;
+
+		CreateTables(Image::QuickTimeDitherTableCache &cache, const uint32 *expected, bool *same) :
+			_cache(cache), _expected(expected), _same(same) {}
+
+		void operator()(uint first, uint last) const {
+			for (uint i = first; i < last; i++) {
+				byte palette[256 * 3];
+				makeRandomPalette(palette, i % kPalettes + 1);
+				byte *table = _cache.createQuickTimeDitherTable(palette, 256);
+				_same[i] = hashBytes(table, 0x10000) == _expected[i % kPalettes];
+				delete[] table;
+			}
+		}
+	};
+
+public:
+	void test_quicktime_dither_table() {
+		byte palette[256 * 3];
+
+		makeCubePalette(palette);
+		byte *table = Image::DitherCodec::createQuickTimeDitherTable(palette, 256);
+		TS_ASSERT_EQUALS(hashBytes(table, 0x10000), 2193483432u);
+		delete[] table;
+
+		makeRandomPalette(palette, 1);
+		table = Image::DitherCodec::createQuickTimeDitherTable(palette, 256);
+		TS_ASSERT_EQUALS(hashBytes(table, 0x10000), 752875997u);
+		delete[] table;
+
+		// Only the first colors are used
+		table = Image::DitherCodec::createQuickTimeDitherTable(palette, 16);
+		TS_ASSERT_EQUALS(hashBytes(table, 0x10000), 3778298698u);
+		delete[] table;
+	}
+
+	void test_quicktime_dither_table_cache() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+		Image::QuickTimeDitherTableCache cache;
+		byte palette[256 * 3];
+
+		makeCubePalette(palette);
+		byte *table = cache.createQuickTimeDitherTable(palette, 256);
+		TS_ASSERT_EQUALS(hashBytes(table, 0x10000), 2193483432u);
+
+		// A cached table is handed out as a copy of its own
+		byte *again = cache.createQuickTimeDitherTable(palette, 256);
+		TS_ASSERT_DIFFERS(table, again);
+		TS_ASSERT_SAME_DATA(table, again, 0x10000);
+		delete[] again;
+		delete[] table;
+
+		// Evicting the least recently used palettes still gives the right tables
+		for (uint32 seed = 1; seed <= 10; seed++) {
+			makeRandomPalette(palette, seed);
+			delete[] cache.createQuickTimeDitherTable(palette, 256);
+		}
+		makeRandomPalette(palette, 1);
+		table = cache.createQuickTimeDitherTable(palette, 256);
+		TS_ASSERT_EQUALS(hashBytes(table, 0x10000), 752875997u);
+		delete[] table;
+
+		table = cache.createQuickTimeDitherTable(palette, 16);
+		TS_ASSERT_EQUALS(hashBytes(table, 0x10000), 3778298698u);
+		delete[] table;
+
+		// Regenerated the same after the cache was freed
+		cache.clear();
+		table = cache.createQuickTimeDitherTable(palette, 16);
+		TS_ASSERT_EQUALS(hashBytes(table, 0x10000), 3778298698u);
+		delete[] table;
+
+		cache.clear();
+		Common::uninstall_null_g_system();
+#endif
+	}
+
+	void test_quicktime_dither_table_cache_threads() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		// More palettes than the cache keeps, so that threads evict each other's tables
+		uint32 expected[kPalettes];
+		for (uint i = 0; i < kPalettes; i++) {
+			byte palette[256 * 3];
+			makeRandomPalette(palette, i + 1);
+			byte *table = Image::DitherCodec::createQuickTimeDitherTable(palette, 256);
+			expected[i] = hashBytes(table, 0x10000);
+			delete[] table;
+		}
+
+		bool same[kPalettes * 4];
+		{
+			Image::QuickTimeDitherTableCache cache;
+			Common::ThreadPool pool(4);
+			pool.parallelFor(0, kPalettes * 4, CreateTables(cache, expected, same));
+			cache.clear();
+		}
+
+		for (uint i = 0; i < kPalettes * 4; i++)
+			TS_ASSERT(same[i]);
+
+		Common::uninstall_null_g_system();
+#endif
+	}
+
+	void test_quicktime_dither_frame() {
+		byte palette[256 * 3], srcPalette[256 * 3];
+		makeCubePalette(palette);
+		makeRandomPalette(srcPalette, 2);
+
+		TS_ASSERT_EQUALS(ditherFrame(Graphics::PixelFormat(2, 5, 5, 4, 0, 9, 4, 0, 0), palette), 4163945852u);
+		TS_ASSERT_EQUALS(ditherFrame(Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0), palette), 4163945852u);
+		TS_ASSERT_EQUALS(ditherFrame(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0), palette), 4163945852u);
+		TS_ASSERT_EQUALS(ditherFrame(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0), palette), 4163945852u);
+		TS_ASSERT_EQUALS(ditherFrame(Graphics::PixelFormat::createFormatCLUT8(), palette, srcPalette), 4125183746u);
+	}
+};
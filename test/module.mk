@@ -10,17 +10,23 @@ TESTS        := $(srcdir)/test/common/*.h \
 	$(srcdir)/test/common/formats/*.h \
 	$(srcdir)/test/audio/*.h \
 	$(srcdir)/test/math/*.h \
-	$(srcdir)/test/image/*.h
+	$(srcdir)/test/image/*.h \
+	$(srcdir)/test/graphics/dirty_region.h \
+	$(srcdir)/test/graphics/mactext.h \
+	$(srcdir)/test/graphics/screen.h
 TEST_LIBS    :=
 
 ifdef POSIX
+TESTS += $(srcdir)/test/backends/fs/posix/*.h
 TEST_LIBS += test/system/null_osystem.o \
 	backends/fs/posix/posix-fs-factory.o \
 	backends/fs/posix/posix-fs.o \
 	backends/fs/posix/posix-iostream.o \
 	backends/fs/abstract-fs.o \
 	backends/fs/stdiostream.o \
-	backends/modular-backend.o
+	backends/modular-backend.o \
+	backends/mutex/pthread/pthread-mutex.o \
+	backends/threads/pthread/pthread-threads.o
 endif
 
 ifdef WIN32
@@ -37,7 +43,12 @@ ifdef USE_TINYGL
 TESTS += $(srcdir)/test/graphics/tinygl*.h
 endif
 
-TEST_LIBS +=	audio/libaudio.a math/libmath.a common/formats/libformats.a common/compression/libcompression.a common/libcommon.a image/libimage.a graphics/libgraphics.a
+ifdef ENABLE_EVENTRECORDER
+TESTS += $(srcdir)/test/gui/*.h
+TEST_LIBS += gui/recorderbenchmark.o
+endif
+
+TEST_LIBS +=	audio/libaudio.a math/libmath.a graphics/libgraphics.a image/libimage.a graphics/libgraphics.a common/formats/libformats.a common/compression/libcompression.a common/libcommon.a
 
 ifeq ($(ENABLE_WINTERMUTE), STATIC_PLUGIN)
 	TESTS += $(srcdir)/test/engines/wintermute/*.h
@@ -51,6 +62,23 @@ endif
 	TEST_LIBS += engines/ultima/libultima.a
 endif
 
+ifeq ($(ENABLE_SCUMM), STATIC_PLUGIN)
+ifdef ENABLE_SCUMM_7_8
+	TESTS += $(srcdir)/test/engines/scumm/*.h
+	TEST_LIBS += engines/scumm/libscumm.a
+endif
+endif
+
+ifeq ($(ENABLE_GLK), STATIC_PLUGIN)
+	TESTS += $(srcdir)/test/engines/glk/*.h
+	TEST_LIBS += engines/glk/libglk.a
+endif
+
+ifeq ($(ENABLE_ZVISION), STATIC_PLUGIN)
+	TESTS += $(srcdir)/test/engines/zvision/*.h
+	TEST_LIBS += engines/zvision/libzvision.a
+endif
+
 ifeq ($(ENABLE_TWINE), STATIC_PLUGIN)
 	TESTS += $(srcdir)/test/engines/twine/*.h
 	TEST_LIBS += engines/twine/libtwine.a
@@ -63,6 +91,11 @@ TEST_LDFLAGS := $(LDFLAGS) $(LIBS)
 TEST_CXXFLAGS  := $(filter-out -Wglobal-constructors,$(CXXFLAGS))
 TEST_CXXFLAGS += -Wno-self-assign-overloaded
 
+ifdef POSIX
+# The null OSystem runs threads with pthreads
+TEST_LDFLAGS += -lpthread
+endif
+
 ifdef WIN32
 TEST_LDFLAGS := $(filter-out -mwindows,$(TEST_LDFLAGS))
 endif
@@ -92,7 +125,8 @@ test/runner.cpp: $(TESTS) $(srcdir)/test/module.mk
 
 clean: clean-test
 clean-test:
-	-$(RM) test/runner.cpp test/runner test/engine-data/encoding.dat test/system/null_osystem.o
+	-$(RM) test/runner.cpp test/runner test/engine-data/encoding.dat test/system/null_osystem.o test/mapped-large.dat test/mapped-small.dat
+	-$(RM_REC) test/fs-tree
 	-rmdir test/engine-data
 
 test/engine-data/encoding.dat: $(srcdir)/dists/engine-data/encoding.dat
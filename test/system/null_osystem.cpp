@@ -8,6 +8,9 @@
 #undef USE_CLOUD
 #endif
 #include "../backends/saves/savefile.cpp"
+#include "../backends/mixer/null/null-mixer.cpp"
+#include "../backends/timer/default/default-timer.cpp"
+#include "engines/engine.h"
 
 //#define DISPLAY_ERROR_MESSAGES
 
@@ -51,3 +54,14 @@ void BaseBackend::fillScreen(const Common::Rect &r, uint32 col) {
 void EventsBaseBackend::initBackend() {
 	BaseBackend::initBackend();
 }
+
+// The Mac GUI pauses the engine while a menu is open, which the tests never do
+PauseToken::~PauseToken() {
+}
+
+void PauseToken::clear() {
+}
+
+PauseToken Engine::pauseEngine() {
+	return PauseToken();
+}